@@ -45,6 +45,8 @@
 #include <Graphics\GraphicsEngine\interface\RenderDevice.h>
 #include <Graphics\GraphicsEngine\interface\DeviceContext.h>
 #include <Graphics\GraphicsEngine\interface\SwapChain.h>
+#include <Graphics\GraphicsEngineVulkan\interface\SwapChainVk.h>
+#include <Common\interface\RefCntAutoPtr.hpp>
 using namespace Diligent;
 using namespace Assimp;
 using namespace glm;
@@ -114,6 +116,16 @@ int main(int argc, char** argv)
     Win32NativeWindow windowToRenderTo{ glfwGetWin32Window(window) };
     engineFactoryVk->CreateSwapChainVk(*renderDevice, *deviceContext, swapChainDesc, windowToRenderTo, swapChain);
 
+    //limit the number of frames in flight so that input is sampled close to when the frame is displayed
+    RefCntAutoPtr<ISwapChainVk> swapChainVk{ *swapChain, IID_SwapChainVk };
+    if (swapChainVk)
+    {
+        FramePacingAttribsVk framePacing;
+        framePacing.PresentMode = PRESENT_MODE_VK_FIFO_RELAXED;
+        framePacing.MaxFramesInFlight = 2;
+        swapChainVk->SetFramePacing(framePacing);
+    }
+
     /***DILIGENT GRAPHICS PIPELINE CONFIGURATION***/
     GraphicsPipelineStateCreateInfo graphicsPipelineCreateInfo;
     graphicsPipelineCreateInfo.PSODesc.Name = "Sekhmet Pipeline State Object";
@@ -275,6 +287,9 @@ int main(int argc, char** argv)
         drawAttrs.NumIndices = indices.size();
         drawAttrs.Flags = DRAW_FLAG_VERIFY_ALL;
         (*deviceContext)->DrawIndexed(drawAttrs);
+
+        //present the frame, this waits for the frame pacing limit before the next input is polled
+        (*swapChain)->Present();
     }
 
     return 0;
@@ -51,6 +51,8 @@ bool VerifyDrawIndexedAttribs        (const DrawIndexedAttribs&         Attribs)
 bool VerifyDrawIndirectAttribs       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer);
 bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 
+bool VerifyDrawIndexedIndirectCountAttribs(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer);
+
 bool VerifyDispatchComputeAttribs        (const DispatchComputeAttribs&         Attribs);
 bool VerifyDispatchComputeIndirectAttribs(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 // clang-format on
@@ -226,6 +228,18 @@ public:
         return m_FrameNumber;
     }
 
+    /// Implementation of IDeviceContext::GetBindStats().
+    virtual DeviceContextBindStats DILIGENT_CALL_TYPE GetBindStats() const override final
+    {
+        return m_BindStats;
+    }
+
+    /// Implementation of IDeviceContext::ResetBindStats().
+    virtual void DILIGENT_CALL_TYPE ResetBindStats() override final
+    {
+        m_BindStats = DeviceContextBindStats{};
+    }
+
     /// Returns currently bound pipeline state and blend factors
     inline void GetPipelineState(IPipelineState** ppPSO, float* BlendFactors, Uint32& StencilRef);
 
@@ -260,6 +274,22 @@ protected:
 
     inline void SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/);
 
+    /// Returns true if the pipeline state is already bound to the context, in which case
+    /// IDeviceContext::SetPipelineState() should do nothing. Updates binding statistics.
+    inline bool IsRedundantPipelineState(PipelineStateImplType* pPipelineState);
+
+    /// Returns true if binding the vertex buffers would leave the cached vertex streams
+    /// unchanged. Updates binding statistics.
+    inline bool IsRedundantVertexBufferBinding(Uint32                   StartSlot,
+                                               Uint32                   NumBuffersSet,
+                                               IBuffer**                ppBuffers,
+                                               Uint32*                  pOffsets,
+                                               SET_VERTEX_BUFFERS_FLAGS Flags);
+
+    /// Returns true if the index buffer and the offset match the cached values.
+    /// Updates binding statistics.
+    inline bool IsRedundantIndexBufferBinding(IBuffer* pIndexBuffer, Uint32 ByteOffset);
+
     /// Clears all cached resources
     inline void ClearStateCache();
 
@@ -294,9 +324,13 @@ protected:
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const;
     bool DvpVerifyDrawMeshIndirectArguments   (const DrawMeshIndirectAttribs&    Attribs, const IBuffer* pAttribsBuffer) const;
 
+    bool DvpVerifyDrawIndexedIndirectCountArguments(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer) const;
+
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const;
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer) const;
 
+    bool DvpVerifyPushConstantsArguments(const void* pData, Uint32 Offset, Uint32 Size, Uint32 BlockSize) const;
+
     bool DvpVerifyRenderTargets() const;
     bool DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier) const;
     bool DvpVerifyTextureState(const TextureImplType&   Texture, RESOURCE_STATE RequiredState, const char* OperationName) const;
@@ -311,9 +345,13 @@ protected:
     bool DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
     bool DvpVerifyDrawMeshIndirectArguments   (const DrawMeshIndirectAttribs&    Attribs, const IBuffer* pAttribsBuffer)const {return true;}
 
+    bool DvpVerifyDrawIndexedIndirectCountArguments(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)const {return true;}
+
     bool DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs)const {return true;}
     bool DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)const {return true;}
 
+    bool DvpVerifyPushConstantsArguments(const void* pData, Uint32 Offset, Uint32 Size, Uint32 BlockSize)const {return true;}
+
     bool DvpVerifyRenderTargets()const {return true;}
     bool DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier)const {return true;}
     bool DvpVerifyTextureState(const TextureImplType&   Texture, RESOURCE_STATE RequiredState, const char* OperationName)const {return true;}
@@ -403,6 +441,9 @@ protected:
 
     Uint64 m_FrameNumber = 0;
 
+    /// Redundant state binding statistics
+    DeviceContextBindStats m_BindStats;
+
 #ifdef DILIGENT_DEBUG
     // std::unordered_map is unbelievably slow. Keeping track of mapped buffers
     // in release builds is not feasible
@@ -474,6 +515,51 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetVertexBuf
     // Remove null buffers from the end of the array
     while (m_NumVertexStreams > 0 && !m_VertexStreams[m_NumVertexStreams - 1].pBuffer)
         m_VertexStreams[m_NumVertexStreams--] = VertexStreamInfo<BufferImplType>{};
+
+    ++m_BindStats.VertexBuffersIssued;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::IsRedundantVertexBufferBinding(
+    Uint32                   StartSlot,
+    Uint32                   NumBuffersSet,
+    IBuffer**                ppBuffers,
+    Uint32*                  pOffsets,
+    SET_VERTEX_BUFFERS_FLAGS Flags)
+{
+    ++m_BindStats.VertexBuffersRequested;
+
+    // Let SetVertexBuffers() report invalid slot ranges
+    if (StartSlot >= MAX_BUFFER_SLOTS || StartSlot + NumBuffersSet > MAX_BUFFER_SLOTS)
+        return false;
+
+    if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
+    {
+        // The slots that are not being set will be reset, which only
+        // keeps the state intact if they are already empty
+        for (Uint32 s = 0; s < StartSlot; ++s)
+        {
+            if (m_VertexStreams[s].pBuffer)
+                return false;
+        }
+        for (Uint32 s = StartSlot + NumBuffersSet; s < m_NumVertexStreams; ++s)
+        {
+            if (m_VertexStreams[s].pBuffer)
+                return false;
+        }
+    }
+
+    for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
+    {
+        const auto& CurrStream = m_VertexStreams[StartSlot + Buff];
+
+        const IBuffer* pBuffer = ppBuffers ? ppBuffers[Buff] : nullptr;
+        const Uint32   Offset  = pOffsets ? pOffsets[Buff] : 0;
+        if (static_cast<const IBuffer*>(CurrStream.pBuffer.RawPtr()) != pBuffer || CurrStream.Offset != Offset)
+            return false;
+    }
+
+    return true;
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -482,6 +568,14 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetPipelineS
     int /*Dummy*/)
 {
     m_pPipelineState = pPipelineState;
+    ++m_BindStats.PipelineStatesIssued;
+}
+
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::IsRedundantPipelineState(PipelineStateImplType* pPipelineState)
+{
+    ++m_BindStats.PipelineStatesRequested;
+    return PipelineStateImplType::IsSameObject(m_pPipelineState, pPipelineState);
 }
 
 template <typename BaseInterface, typename ImplementationTraits>
@@ -490,6 +584,8 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::CommitShader
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
     int)
 {
+    ++m_BindStats.ShaderResourcesRequested;
+
 #ifdef DILIGENT_DEVELOPMENT
     DEV_CHECK_ERR(!(m_pActiveRenderPass != nullptr && StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
                   "Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
@@ -531,6 +627,7 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetIndexBuff
 {
     m_pIndexBuffer         = ValidatedCast<BufferImplType>(pIndexBuffer);
     m_IndexDataStartOffset = ByteOffset;
+    ++m_BindStats.IndexBuffersIssued;
 #ifdef DILIGENT_DEVELOPMENT
     DEV_CHECK_ERR(!(m_pActiveRenderPass != nullptr && StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
                   "Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
@@ -547,6 +644,13 @@ inline void DeviceContextBase<BaseInterface, ImplementationTraits>::SetIndexBuff
 #endif
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::IsRedundantIndexBufferBinding(IBuffer* pIndexBuffer, Uint32 ByteOffset)
+{
+    ++m_BindStats.IndexBuffersRequested;
+    return static_cast<IBuffer*>(m_pIndexBuffer.RawPtr()) == pIndexBuffer && m_IndexDataStartOffset == ByteOffset;
+}
+
 
 template <typename BaseInterface, typename ImplementationTraits>
 inline void DeviceContextBase<BaseInterface, ImplementationTraits>::GetPipelineState(IPipelineState** ppPSO, float* BlendFactors, Uint32& StencilRef)
@@ -1825,6 +1929,52 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDra
     return VerifyDrawIndexedIndirectAttribs(Attribs, pAttribsBuffer);
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDrawIndexedIndirectCountArguments(
+    const DrawIndexedIndirectCountAttribs& Attribs,
+    const IBuffer*                         pAttribsBuffer,
+    const IBuffer*                         pCountBuffer) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return true;
+
+    if (m_pDevice->GetDeviceCaps().Features.DrawIndirectCount != DEVICE_FEATURE_STATE_ENABLED)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirectCount: indirect draw count is not supported by this device");
+        return false;
+    }
+
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirectCount command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    if (m_pPipelineState->GetDesc().PipelineType != PIPELINE_TYPE_GRAPHICS)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirectCount command arguments are invalid: pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+        return false;
+    }
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirectCount command arguments are invalid: no index buffer is bound.");
+        return false;
+    }
+
+    if (m_pActiveRenderPass != nullptr &&
+        (Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION ||
+         Attribs.CountBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION))
+    {
+        LOG_ERROR_MESSAGE("Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
+                          "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+        return false;
+    }
+
+    return VerifyDrawIndexedIndirectCountAttribs(Attribs, pAttribsBuffer, pCountBuffer);
+}
+
 template <typename BaseInterface, typename ImplementationTraits>
 inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDrawMeshIndirectArguments(
     const DrawMeshIndirectAttribs& Attribs,
@@ -1968,6 +2118,47 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDis
     return VerifyDispatchComputeIndirectAttribs(Attribs, pAttribsBuffer);
 }
 
+template <typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyPushConstantsArguments(
+    const void* pData,
+    Uint32      Offset,
+    Uint32      Size,
+    Uint32      BlockSize) const
+{
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE("SetPushConstants: no pipeline state is bound.");
+        return false;
+    }
+
+    if (BlockSize == 0)
+    {
+        LOG_ERROR_MESSAGE("SetPushConstants: pipeline state '", m_pPipelineState->GetDesc().Name, "' does not use push constants.");
+        return false;
+    }
+
+    if (pData == nullptr || Size == 0)
+    {
+        LOG_ERROR_MESSAGE("SetPushConstants: data must not be null and size must not be zero.");
+        return false;
+    }
+
+    if ((Offset % 4) != 0 || (Size % 4) != 0)
+    {
+        LOG_ERROR_MESSAGE("SetPushConstants: offset (", Offset, ") and size (", Size, ") must be multiples of 4.");
+        return false;
+    }
+
+    if (Offset + Size > BlockSize)
+    {
+        LOG_ERROR_MESSAGE("SetPushConstants: range [", Offset, ", ", Offset + Size, ") is out of the push constant block of pipeline state '",
+                          m_pPipelineState->GetDesc().Name, "' (", BlockSize, " bytes).");
+        return false;
+    }
+
+    return true;
+}
+
 
 template <typename BaseInterface, typename ImplementationTraits>
 bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier) const
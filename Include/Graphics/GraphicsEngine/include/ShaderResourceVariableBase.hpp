@@ -438,6 +438,33 @@ inline void VerifyAndCorrectSetArrayArguments(const char* Name, Uint32 ArraySize
     }
 }
 
+// Implements IShaderResourceVariable::SetBufferRange() in backends that do not support uniform buffer
+// ranges: the whole buffer is bound, and non-zero offsets are rejected.
+inline void SetWholeBufferRange(IShaderResourceVariable& Var, IDeviceObject* pBuffer, Uint32 Offset, Uint32 Size, Uint32 ArrayIndex)
+{
+    if (Offset != 0)
+    {
+        ShaderResourceDesc ResDesc;
+        Var.GetResourceDesc(ResDesc);
+        LOG_ERROR_MESSAGE("Unable to bind buffer range to variable '", ResDesc.Name, "': non-zero buffer offsets are not supported by this backend.");
+        return;
+    }
+    (void)Size;
+    Var.SetArray(&pBuffer, ArrayIndex, 1);
+}
+
+// Implements IShaderResourceVariable::SetBufferOffset() in backends that do not support dynamic offsets
+inline void SetZeroBufferOffset(IShaderResourceVariable& Var, Uint32 Offset, Uint32 ArrayIndex)
+{
+    if (Offset != 0)
+    {
+        ShaderResourceDesc ResDesc;
+        Var.GetResourceDesc(ResDesc);
+        LOG_ERROR_MESSAGE("Unable to set offset ", Offset, " for element ", ArrayIndex, " of variable '", ResDesc.Name,
+                          "': dynamic buffer offsets are not supported by this backend.");
+    }
+}
+
 template <typename ShaderVectorType>
 std::string GetShaderGroupName(const ShaderVectorType& Shaders)
 {
@@ -507,6 +534,16 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         return m_ParentResLayout.GetOwner().GetReferenceCounters();
     }
 
+    virtual void DILIGENT_CALL_TYPE SetBufferRange(IDeviceObject* pBuffer, Uint32 Offset, Uint32 Size, Uint32 ArrayIndex) override
+    {
+        SetWholeBufferRange(*this, pBuffer, Offset, Size, ArrayIndex);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetBufferOffset(Uint32 Offset, Uint32 ArrayIndex) override
+    {
+        SetZeroBufferOffset(*this, Offset, ArrayIndex);
+    }
+
 protected:
     ResourceLayoutType& m_ParentResLayout;
 };
@@ -370,6 +370,76 @@ struct DrawIndexedIndirectAttribs
 typedef struct DrawIndexedIndirectAttribs DrawIndexedIndirectAttribs;
 
 
+/// Defines the indexed indirect draw command attributes with the draw count read from a GPU buffer.
+
+/// This structure is used by IDeviceContext::DrawIndexedIndirectCount().
+struct DrawIndexedIndirectCountAttribs
+{
+    /// The type of the elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE IndexType            DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the first draw command attributes.
+    Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// Stride, in bytes, between consecutive draw commands in the indirect draw arguments buffer.
+    /// Must be a multiple of 4 and not less than 20 (the size of one draw command).
+    Uint32 IndirectDrawArgsStride   DEFAULT_INITIALIZER(20);
+
+    /// The maximum number of draws that will be executed. The actual number of draws
+    /// is the minimum of this value and the count read from the count buffer.
+    Uint32 MaxDrawCount             DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the count buffer to the location of the Uint32 draw count.
+    Uint32 CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values
+
+    /// Default values:
+    /// Member                                   | Default value
+    /// -----------------------------------------|--------------------------------------
+    /// IndexType                                | VT_UNDEFINED
+    /// Flags                                    | DRAW_FLAG_NONE
+    /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
+    /// IndirectDrawArgsOffset                   | 0
+    /// IndirectDrawArgsStride                   | 20
+    /// MaxDrawCount                             | 0
+    /// CountBufferStateTransitionMode           | RESOURCE_STATE_TRANSITION_MODE_NONE
+    /// CountBufferOffset                        | 0
+    DrawIndexedIndirectCountAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    DrawIndexedIndirectCountAttribs(VALUE_TYPE                     _IndexType,
+                                    DRAW_FLAGS                     _Flags,
+                                    Uint32                         _MaxDrawCount,
+                                    RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                                    RESOURCE_STATE_TRANSITION_MODE _CountBufferStateTransitionMode,
+                                    Uint32                         _IndirectDrawArgsOffset = 0,
+                                    Uint32                         _CountBufferOffset      = 0)noexcept : 
+        IndexType                               {_IndexType                               },
+        Flags                                   {_Flags                                   },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        MaxDrawCount                            {_MaxDrawCount                            },
+        CountBufferStateTransitionMode          {_CountBufferStateTransitionMode          },
+        CountBufferOffset                       {_CountBufferOffset                       }
+    {}
+#endif
+};
+typedef struct DrawIndexedIndirectCountAttribs DrawIndexedIndirectCountAttribs;
+
+
 /// Defines the mesh draw command attributes.
 
 /// This structure is used by IDeviceContext::DrawMesh().
@@ -1355,6 +1425,42 @@ struct StateTransitionDesc
 typedef struct StateTransitionDesc StateTransitionDesc;
 
 
+/// Redundant state binding statistics, see IDeviceContext::GetBindStats().
+
+/// A device context keeps a shadow copy of the bound pipeline state, vertex and index buffers and
+/// committed shader resources. Binding requests that match the shadow state are filtered out and
+/// are not forwarded to the underlying graphics API. For every kind of binding, *Requested counts
+/// the calls made by the application, while *Issued counts the calls that actually changed the state.
+struct DeviceContextBindStats
+{
+    /// The number of IDeviceContext::SetPipelineState() calls.
+    Uint32 PipelineStatesRequested  DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that were actually bound.
+    Uint32 PipelineStatesIssued     DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetVertexBuffers() calls.
+    Uint32 VertexBuffersRequested   DEFAULT_INITIALIZER(0);
+
+    /// The number of vertex buffer bindings that changed the bound buffers or offsets.
+    Uint32 VertexBuffersIssued      DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetIndexBuffer() calls.
+    Uint32 IndexBuffersRequested    DEFAULT_INITIALIZER(0);
+
+    /// The number of index buffer bindings that changed the bound buffer or offset.
+    Uint32 IndexBuffersIssued       DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::CommitShaderResources() calls.
+    Uint32 ShaderResourcesRequested DEFAULT_INITIALIZER(0);
+
+    /// The number of shader resource commits that were not skipped because
+    /// the same up-to-date shader resource binding was already committed.
+    Uint32 ShaderResourcesIssued    DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextBindStats DeviceContextBindStats;
+
+
 #define DILIGENT_INTERFACE_NAME IDeviceContext
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -1440,6 +1546,44 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                IShaderResourceBinding*        pShaderResourceBinding,
                                                RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) PURE;
 
+    /// Sets push constants of the currently bound pipeline state.
+
+    /// \param [in] pData  - Pointer to the data to copy.
+    /// \param [in] Offset - Offset, in bytes, of the first push constant to update. Must be a multiple of 4.
+    /// \param [in] Size   - Size of the data, in bytes. Must be a multiple of 4.
+    ///
+    /// \remarks Push constants are a small block of data that is passed with the command stream and does
+    ///          not require a buffer or a descriptor, which makes them the cheapest way to set per-draw
+    ///          data such as object transforms. All shader stages of the pipeline share the same block.
+    ///
+    ///          The values are only valid for the pipeline state bound by the last IDeviceContext::SetPipelineState()
+    ///          call and must be set again after the pipeline state is changed. The values are retained
+    ///          by the context when it is flushed or its state is invalidated, and are recorded again
+    ///          with the next command.
+    ///
+    ///          In Vulkan backend, the block is declared in the shader with the push_constant layout qualifier
+    ///          (`[[vk::push_constant]]` attribute in HLSL), and the data is recorded with vkCmdPushConstants.
+    ///          Vulkan guarantees at least 128 bytes of push constants.
+    ///
+    ///          OpenGL backend emulates push constants with a uniform buffer that is suballocated for every draw
+    ///          or dispatch command that follows a change of the data. The block must be declared as a regular
+    ///          uniform block (constant buffer) named `cbPushConstants`, so a declaration like the following
+    ///          works in both backends:
+    ///
+    ///              #ifdef VULKAN
+    ///              [[vk::push_constant]]
+    ///              #endif
+    ///              cbuffer cbPushConstants
+    ///              {
+    ///                  float4x4 g_WorldViewProj;
+    ///              }
+    ///
+    ///          Direct3D backends do not support push constants.
+    VIRTUAL void METHOD(SetPushConstants)(THIS_
+                                          const void* pData,
+                                          Uint32      Offset,
+                                          Uint32      Size) PURE;
+
     /// Sets the stencil reference value.
 
     /// \param [in] StencilRef - Stencil reference value.
@@ -1704,6 +1848,28 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                              IBuffer*                             pAttribsBuffer) PURE;
     
 
+    /// Executes a multi-draw indexed indirect command with the draw count read from a GPU buffer.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::DrawIndexedIndirectCountAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///                              Every draw command in the buffer has the same layout as
+    ///                              the arguments of IDeviceContext::DrawIndexedIndirect().
+    /// \param [in] pCountBuffer   - Pointer to the buffer, from which the Uint32 draw count will be read.
+    ///
+    /// \remarks  The method requires DeviceFeatures::DrawIndirectCount feature. It allows the GPU
+    ///           to generate both the draw commands and their number (for example, in a culling compute pass),
+    ///           so that the CPU does not need to know how many objects are visible.
+    ///
+    ///           If IndirectAttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of
+    ///           the corresponding buffer. This is not a thread safe operation, so no other thread is allowed
+    ///           to read or write the state of the buffer.
+    VIRTUAL void METHOD(DrawIndexedIndirectCount)(THIS_
+                                                  const DrawIndexedIndirectCountAttribs REF Attribs,
+                                                  IBuffer*                                  pAttribsBuffer,
+                                                  IBuffer*                                  pCountBuffer) PURE;
+
+
     /// Executes a mesh draw command.
     
     /// \param [in] Attribs - Draw command attributes, see Diligent::DrawMeshAttribs for details.
@@ -2200,6 +2366,15 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///           to the shader binding table passed as an argument to the function.
     VIRTUAL void METHOD(TraceRays)(THIS_
                                    const TraceRaysAttribs REF Attribs) PURE;
+
+
+    /// Returns redundant state binding statistics accumulated since the context was
+    /// created or since the last call to IDeviceContext::ResetBindStats().
+    VIRTUAL DeviceContextBindStats METHOD(GetBindStats)(THIS) CONST PURE;
+
+
+    /// Resets redundant state binding statistics.
+    VIRTUAL void METHOD(ResetBindStats)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -2212,6 +2387,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_SetPipelineState(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetPipelineState,          This, __VA_ARGS__)
 #    define IDeviceContext_TransitionShaderResources(This, ...) CALL_IFACE_METHOD(DeviceContext, TransitionShaderResources, This, __VA_ARGS__)
 #    define IDeviceContext_CommitShaderResources(This, ...)     CALL_IFACE_METHOD(DeviceContext, CommitShaderResources,     This, __VA_ARGS__)
+#    define IDeviceContext_SetPushConstants(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetPushConstants,          This, __VA_ARGS__)
 #    define IDeviceContext_SetStencilRef(This, ...)             CALL_IFACE_METHOD(DeviceContext, SetStencilRef,             This, __VA_ARGS__)
 #    define IDeviceContext_SetBlendFactors(This, ...)           CALL_IFACE_METHOD(DeviceContext, SetBlendFactors,           This, __VA_ARGS__)
 #    define IDeviceContext_SetVertexBuffers(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetVertexBuffers,          This, __VA_ARGS__)
@@ -2224,6 +2400,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexed(This, ...)               CALL_IFACE_METHOD(DeviceContext, DrawIndexed,               This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawIndirect,              This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
+#    define IDeviceContext_DrawIndexedIndirectCount(This, ...)  CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirectCount,  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirect(This, ...)          CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirect,          This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)           CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
@@ -2258,6 +2435,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_WriteBLASCompactedSize(This, ...)    CALL_IFACE_METHOD(DeviceContext, WriteBLASCompactedSize,    This, __VA_ARGS__)
 #    define IDeviceContext_WriteTLASCompactedSize(This, ...)    CALL_IFACE_METHOD(DeviceContext, WriteTLASCompactedSize,    This, __VA_ARGS__)
 #    define IDeviceContext_TraceRays(This, ...)                 CALL_IFACE_METHOD(DeviceContext, TraceRays,                 This, __VA_ARGS__)
+#    define IDeviceContext_GetBindStats(This)                   CALL_IFACE_METHOD(DeviceContext, GetBindStats,              This)
+#    define IDeviceContext_ResetBindStats(This)                 CALL_IFACE_METHOD(DeviceContext, ResetBindStats,            This)
 
 // clang-format on
 
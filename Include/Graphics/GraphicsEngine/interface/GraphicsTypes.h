@@ -935,7 +935,16 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01,
+
+    /// The texture is only accessed as a render pass attachment, and its contents
+    /// do not need to be preserved outside of the render pass.
+
+    /// \note Only BIND_RENDER_TARGET, BIND_DEPTH_STENCIL and BIND_INPUT_ATTACHMENT bind flags are allowed.
+    ///       In Vulkan backend, the texture is created with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT usage
+    ///       and is placed in lazily allocated memory when the device supports it, so that on tiled GPUs
+    ///       the attachment may never be backed by physical memory. Other backends ignore the flag.
+    MISC_TEXTURE_FLAG_TRANSIENT     = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -1538,6 +1547,14 @@ struct DeviceFeatures
     /// Indicates if device supports indirect draw commands
     DEVICE_FEATURE_STATE IndirectRendering             DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports indirect draw commands that read the draw count
+    /// from a GPU buffer (see IDeviceContext::DrawIndexedIndirectCount()).
+    DEVICE_FEATURE_STATE DrawIndirectCount             DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports non-zero FirstInstanceLocation in indirect draw arguments.
+    /// Without this feature, the first instance of every indirect draw command must be zero.
+    DEVICE_FEATURE_STATE DrawIndirectFirstInstance     DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
     /// Indicates if device supports wireframe fill mode
     DEVICE_FEATURE_STATE WireframeFill                 DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
@@ -1641,6 +1658,8 @@ struct DeviceFeatures
         SeparablePrograms                 {State},
         ShaderResourceQueries             {State},
         IndirectRendering                 {State},
+        DrawIndirectCount                 {State},
+        DrawIndirectFirstInstance         {State},
         WireframeFill                     {State},
         MultithreadedResourceCreation     {State},
         ComputeShaders                    {State},
@@ -1672,7 +1691,7 @@ struct DeviceFeatures
         UniformBuffer8BitAccess           {State}
     {
 #   if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(*this) == 32, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
+        static_assert(sizeof(*this) == 34, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
 #   endif
     }
 #endif
@@ -1914,6 +1933,21 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
     /// Setting this to true is typically needed for testing purposes only.
     bool ForceNonSeparablePrograms DEFAULT_INITIALIZER(false);
+
+    /// Directory of the persistent program binary cache.
+
+    /// When not null and the driver supports program binaries, linked GL programs are
+    /// retrieved with glGetProgramBinary() and stored in this directory. Subsequent runs
+    /// load them with glProgramBinary() instead of compiling and linking GLSL. Entries are
+    /// keyed by the final GLSL source of all attached shaders and the driver identification
+    /// strings. If the driver rejects a binary, the program is built from source as usual.
+    /// The directory is created if it does not exist.
+    ///
+    /// With separable programs, a cache hit skips both GLSL compilation and linking. When separable
+    /// programs are not available or ForceNonSeparablePrograms is true, shaders are still compiled
+    /// when they are created, so that compilation errors are reported by IRenderDevice::CreateShader(),
+    /// and the cache only skips linking.
+    const char* pProgramBinaryCacheDirectory DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct EngineGLCreateInfo EngineGLCreateInfo;
 
@@ -2169,6 +2203,28 @@ struct VulkanDescriptorPoolSize
 typedef struct VulkanDescriptorPoolSize VulkanDescriptorPoolSize;
 
 
+/// SPIR-V post-processing flags used by the Vulkan backend.
+DILIGENT_TYPED_ENUM(SPIRV_OPTIMIZATION_FLAGS, Uint32)
+{
+    /// Do not process SPIR-V bytecode.
+    SPIRV_OPTIMIZATION_FLAG_NONE             = 0x00,
+
+    /// Run the performance passes of the SPIR-V optimizer (inlining, constant
+    /// propagation and folding, dead code elimination, etc.) on the bytecode
+    /// compiled by DXC. Bytecode compiled by glslang is always optimized.
+    SPIRV_OPTIMIZATION_FLAG_PERFORMANCE      = 0x01,
+
+    /// Strip debug names from the bytecode when the shader module is created.
+    /// The names are only needed for reflection, which has been done by then.
+    SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO = 0x02,
+
+    /// Select the flags by the build configuration: no processing in debug builds,
+    /// so that shader debuggers see the original code, and all passes otherwise.
+    SPIRV_OPTIMIZATION_FLAG_DEFAULT          = 0x80000000u
+};
+DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS)
+
+
 /// Attributes specific to Vulkan engine
 struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     
@@ -2230,6 +2286,28 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// pages when resources are released
     Uint32 HostVisibleMemoryReserveSize     DEFAULT_INITIALIZER(256 << 20);
 
+    /// Allocations of this size or larger are given their own memory object
+    /// instead of being suballocated from a shared page. This avoids wasting the
+    /// remainder of an oversized page on large textures and buffers.
+    /// Zero (the default) disables dedicated allocations.
+    Uint32 DedicatedAllocationThreshold     DEFAULT_INITIALIZER(0);
+
+    /// Maximum number of bytes of device-local memory that the immediate context
+    /// moves per frame to compact sparsely used memory pages. Zero disables defragmentation.
+
+    /// \remarks   Only default and immutable buffers that are bound exclusively as vertex, index or
+    ///             indirect argument buffers are relocated, because they are never referenced by
+    ///             descriptors or views. Relocation replaces the buffer's VkBuffer handle, so
+    ///             an application must not cache the handle returned by IBufferVk::GetVkBuffer()
+    ///             for such buffers across frames when defragmentation is enabled.
+    ///             Buffers are only relocated in IDeviceContext::FinishFrame() of the immediate
+    ///             context when no deferred context has unexecuted commands.
+    Uint32 DefragmentationBytesPerFrame     DEFAULT_INITIALIZER(0);
+
+    /// Device-local pages with the ratio of used memory below this threshold
+    /// are evacuated by the defragmentation.
+    Float32 DefragmentationPageOccupancy    DEFAULT_INITIALIZER(0.25f);
+
     /// Page size of the upload heap that is allocated by immediate/deferred
     /// contexts from the global memory manager to perform lock-free dynamic
     /// suballocations.
@@ -2262,6 +2340,34 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Path to DirectX Shader Compiler, which is required to use Shader Model 6.0+
     /// features when compiling shaders from HLSL.
     const char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
+
+    /// Directory of the persistent SPIR-V shader cache.
+
+    /// When not null, SPIR-V bytecode compiled from shader source code is stored in this
+    /// directory and is reused by subsequent shader creations, including those in other
+    /// processes. Entries are keyed by the shader source with all its includes, macros,
+    /// entry point, stage and compiler settings, so stale entries are never used.
+    /// The directory is created if it does not exist.
+    const char* pShaderCacheDirectory DEFAULT_INITIALIZER(nullptr);
+
+    /// SPIR-V post-processing performed before shader modules are created, see Diligent::SPIRV_OPTIMIZATION_FLAGS.
+
+    /// Smaller modules take less time to compile by the driver and less memory to keep.
+    /// Optimized bytecode is stored in the shader cache, so the optimization cost is only paid once.
+    SPIRV_OPTIMIZATION_FLAGS SPIRVOptimizationFlags DEFAULT_INITIALIZER(SPIRV_OPTIMIZATION_FLAG_DEFAULT);
+
+    /// Enables the global bindless descriptor set.
+
+    /// When enabled, the engine creates a single update-after-bind descriptor set
+    /// that is bound at index BINDLESS_DESCRIPTOR_SET_INDEX of every pipeline that
+    /// declares unsized (runtime) resource arrays. Resources are added to the set with
+    /// IRenderDeviceVk::RegisterBindlessResource() and are addressed in shaders by the
+    /// returned index. Requires VK_EXT_descriptor_indexing.
+    bool EnableBindlessDescriptors          DEFAULT_INITIALIZER(false);
+
+    /// The maximum number of resources that can be registered in the bindless descriptor set.
+    /// The value is clamped by the device's update-after-bind descriptor limits.
+    Uint32 BindlessDescriptorCount          DEFAULT_INITIALIZER(16384);
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
 
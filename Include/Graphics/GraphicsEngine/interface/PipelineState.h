@@ -320,7 +320,7 @@ typedef struct RayTracingPipelineDesc RayTracingPipelineDesc;
 DILIGENT_TYPED_ENUM(PIPELINE_TYPE, Uint8)
 {
     /// Graphics pipeline, which is used by IDeviceContext::Draw(), IDeviceContext::DrawIndexed(),
-    /// IDeviceContext::DrawIndirect(), IDeviceContext::DrawIndexedIndirect().
+    /// IDeviceContext::DrawIndirect(), IDeviceContext::DrawIndexedIndirect(), IDeviceContext::DrawIndexedIndirectCount().
     PIPELINE_TYPE_GRAPHICS,
 
     /// Compute pipeline, which is used by IDeviceContext::DispatchCompute(), IDeviceContext::DispatchComputeIndirect().
@@ -388,6 +388,48 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Specialization constant value.
+
+/// Specialization constants let a single compiled shader produce cheap pipeline variants:
+/// the value is baked into the pipeline when it is created, so the driver can fold it
+/// without recompiling the shader source. In GLSL, a constant is declared as
+/// `layout(constant_id = N) const uint Name = 0u;`; in HLSL compiled with DXC, as
+/// `[[vk::constant_id(N)]] const uint Name = 0;`.
+///
+/// \remarks Specialization constants are only supported by the Vulkan backend.
+///          Other backends ignore them and the constants keep their default values.
+struct SpecializationConstant
+{
+    /// Shader stages this constant applies to. More than one shader stage can be specified.
+    SHADER_TYPE ShaderStages DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Constant name as declared in the shader.
+    const Char* Name         DEFAULT_INITIALIZER(nullptr);
+
+    /// Size of the constant data, in bytes. Must match the size of the constant type
+    /// (4 bytes for bool, int, uint and float; 8 bytes for 64-bit types).
+    Uint32      Size         DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the constant data.
+    const void* pData        DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    SpecializationConstant()noexcept{}
+
+    SpecializationConstant(SHADER_TYPE _ShaderStages,
+                           const Char* _Name,
+                           Uint32      _Size,
+                           const void* _pData)noexcept :
+        ShaderStages{_ShaderStages},
+        Name        {_Name        },
+        Size        {_Size        },
+        pData       {_pData       }
+    {}
+#endif
+};
+typedef struct SpecializationConstant SpecializationConstant;
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -396,6 +438,12 @@ struct PipelineStateCreateInfo
 
     /// Pipeline state creation flags, see Diligent::PSO_CREATE_FLAGS.
     PSO_CREATE_FLAGS  Flags      DEFAULT_INITIALIZER(PSO_CREATE_FLAG_NONE);
+
+    /// The number of specialization constants in pSpecializationConstants array.
+    Uint32                        NumSpecializationConstants DEFAULT_INITIALIZER(0);
+
+    /// An array of NumSpecializationConstants specialization constants, see Diligent::SpecializationConstant.
+    const SpecializationConstant* pSpecializationConstants   DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCreateInfo PipelineStateCreateInfo;
 
@@ -154,6 +154,44 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceVariable, IObject)
     ///                          non-array variables.
     VIRTUAL bool METHOD(IsBound)(THIS_
                                  Uint32 ArrayIndex) CONST PURE;
+
+    /// Binds a range of the uniform buffer to the variable
+
+    /// \param [in] pBuffer    - uniform buffer to bind.
+    /// \param [in] Offset     - offset of the range, in bytes. Must be a multiple of
+    ///                          the device uniform buffer offset alignment
+    ///                          (256 bytes is sufficient on all devices).
+    /// \param [in] Size       - size of the range, in bytes. Zero means the
+    ///                          remainder of the buffer.
+    /// \param [in] ArrayIndex - resource array index. Must be 0 for
+    ///                          non-array variables.
+    ///
+    /// \remark Buffer ranges are only supported in Vulkan backend. Other backends
+    ///         bind the whole buffer and fail if the offset is not zero.
+    VIRTUAL void METHOD(SetBufferRange)(THIS_
+                                        IDeviceObject* pBuffer,
+                                        Uint32         Offset,
+                                        Uint32         Size,
+                                        Uint32         ArrayIndex DEFAULT_VALUE(0)) PURE;
+
+    /// Sets the offset that is added to the bound uniform buffer range
+
+    /// \param [in] Offset     - offset, in bytes. Must be a multiple of
+    ///                          the device uniform buffer offset alignment.
+    /// \param [in] ArrayIndex - resource array index. Must be 0 for
+    ///                          non-array variables.
+    ///
+    /// \remark The offset is applied when the next draw or dispatch command binds
+    ///         the resources, so it can be changed for every draw call without
+    ///         committing the shader resource binding again. Offsets are not reset when
+    ///         the binding is committed. The bound range plus the offset must not exceed
+    ///         the buffer size, so a buffer that is suballocated per draw should be bound
+    ///         with SetBufferRange() that covers a single block.
+    ///         Only mutable and dynamic variables are supported, and only Vulkan backend
+    ///         implements non-zero offsets.
+    VIRTUAL void METHOD(SetBufferOffset)(THIS_
+                                         Uint32 Offset,
+                                         Uint32 ArrayIndex DEFAULT_VALUE(0)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -169,6 +207,8 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceVariable_GetResourceDesc(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, GetResourceDesc, This, __VA_ARGS__)
 #    define IShaderResourceVariable_GetIndex(This)             CALL_IFACE_METHOD(ShaderResourceVariable, GetIndex,        This)
 #    define IShaderResourceVariable_IsBound(This, ...)         CALL_IFACE_METHOD(ShaderResourceVariable, IsBound,         This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferRange(This, ...)  CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferRange,  This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferOffset(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferOffset, This, __VA_ARGS__)
 
 // clang-format on
 
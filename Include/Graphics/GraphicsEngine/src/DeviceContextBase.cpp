@@ -122,6 +122,33 @@ bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs,
     return true;
 }
 
+bool VerifyDrawIndexedIndirectCountAttribs(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuffer)
+{
+#define CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Draw indexed indirect count attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(pAttribsBuffer != nullptr, "indirect draw arguments buffer must not be null.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(pCountBuffer != nullptr, "count buffer must not be null.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                                              "IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(Attribs.IndirectDrawArgsStride >= sizeof(Uint32) * 5 && (Attribs.IndirectDrawArgsStride % 4) == 0,
+                                              "IndirectDrawArgsStride (", Attribs.IndirectDrawArgsStride, ") must be a multiple of 4 and at least 20.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS((Attribs.CountBufferOffset % 4) == 0,
+                                              "CountBufferOffset (", Attribs.CountBufferOffset, ") must be a multiple of 4.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS((pAttribsBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                              "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name,
+                                              "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS((pCountBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                              "count buffer '", pCountBuffer->GetDesc().Name,
+                                              "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS(Attribs.MaxDrawCount == 0 ||
+                                                  Attribs.IndirectDrawArgsOffset + Uint64{Attribs.MaxDrawCount - 1} * Attribs.IndirectDrawArgsStride + sizeof(Uint32) * 5 <= pAttribsBuffer->GetDesc().uiSizeInBytes,
+                                              "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' is too small to hold ", Attribs.MaxDrawCount, " draw commands.");
+
+#undef CHECK_DRAW_INDEXED_INDIRECT_COUNT_ATTRIBS
+
+    return true;
+}
+
 bool VerifyDrawMeshIndirectAttribs(const DrawMeshIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)
 {
 #define CHECK_DRAW_MESH_INDIRECT_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Draw mesh indirect attribs are invalid: ", __VA_ARGS__)
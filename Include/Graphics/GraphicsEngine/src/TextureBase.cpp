@@ -130,6 +130,19 @@ void ValidateTextureDesc(const TextureDesc& Desc) noexcept(false)
                                      "Use UNORM format instead.");
     }
 
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT)
+    {
+        if (Desc.Usage != USAGE_DEFAULT)
+            LOG_TEXTURE_ERROR_AND_THROW("Transient textures must use USAGE_DEFAULT.");
+
+        if ((Desc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL)) == 0 ||
+            (Desc.BindFlags & ~(BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_INPUT_ATTACHMENT)) != 0)
+            LOG_TEXTURE_ERROR_AND_THROW("Transient textures can only be bound as render target, depth-stencil or input attachments.");
+
+        if (Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS)
+            LOG_TEXTURE_ERROR_AND_THROW("Mipmaps cannot be autogenerated for transient textures.");
+    }
+
     if (Desc.Usage == USAGE_STAGING)
     {
         if (Desc.BindFlags != 0)
@@ -89,6 +89,9 @@ public:
     virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::SetPushConstants() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size) override final;
+
     /// Implementation of IDeviceContext::SetStencilRef() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final;
 
@@ -146,6 +149,8 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh(const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D11 backend.
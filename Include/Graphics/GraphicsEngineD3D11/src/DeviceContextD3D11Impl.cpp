@@ -70,7 +70,7 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDevic
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateD3D11 = ValidatedCast<PipelineStateD3D11Impl>(pPipelineState);
-    if (PipelineStateD3D11Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D11))
+    if (IsRedundantPipelineState(pPipelineStateD3D11))
         return;
 
     TDeviceContextBase::SetPipelineState(pPipelineStateD3D11, 0 /*Dummy*/);
@@ -650,12 +650,18 @@ void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShad
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
         return;
 
+    ++m_BindStats.ShaderResourcesIssued;
     if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
         TransitionAndCommitShaderResources<true, true>(m_pPipelineState, pShaderResourceBinding, false);
     else
         TransitionAndCommitShaderResources<false, true>(m_pPipelineState, pShaderResourceBinding, StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 }
 
+void DeviceContextD3D11Impl::SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size)
+{
+    UNSUPPORTED("Push constants are not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::SetStencilRef(Uint32 StencilRef)
 {
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
@@ -885,6 +891,11 @@ void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
     m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
 }
 
+void DeviceContextD3D11Impl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    UNSUPPORTED("DrawIndexedIndirectCount is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     UNSUPPORTED("DrawMesh is not supported in DirectX 11");
@@ -1198,7 +1209,11 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffers that are already bound still need to be unbound from UAV slots
+    const bool StreamsChanged = !IsRedundantVertexBufferBinding(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags);
+    if (StreamsChanged)
+        TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
         auto& CurrStream = m_VertexStreams[Slot];
@@ -1225,12 +1240,15 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
         }
     }
 
-    m_bCommittedD3D11VBsUpToDate = false;
+    if (StreamsChanged)
+        m_bCommittedD3D11VBsUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = !IsRedundantIndexBufferBinding(pIndexBuffer, ByteOffset);
+    if (IndexBufferChanged)
+        TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
 
     if (m_pIndexBuffer)
     {
@@ -1254,7 +1272,8 @@ void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOf
 #endif
     }
 
-    m_bCommittedD3D11IBUpToDate = false;
+    if (IndexBufferChanged)
+        m_bCommittedD3D11IBUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
@@ -169,6 +169,12 @@ public:
         m_pCommandList->ExecuteIndirect(pCmdSignature, 1, pBuff, ArgsOffset, nullptr, 0);
     }
 
+    void ExecuteIndirect(ID3D12CommandSignature* pCmdSignature, UINT MaxCommandCount, ID3D12Resource* pBuff, Uint64 ArgsOffset, ID3D12Resource* pCountBuff, Uint64 CountOffset)
+    {
+        FlushResourceBarriers();
+        m_pCommandList->ExecuteIndirect(pCmdSignature, MaxCommandCount, pBuff, ArgsOffset, pCountBuff, CountOffset);
+    }
+
     void                       SetID(const Char* ID) { m_ID = ID; }
     ID3D12GraphicsCommandList* GetCommandList() { return m_pCommandList; }
 
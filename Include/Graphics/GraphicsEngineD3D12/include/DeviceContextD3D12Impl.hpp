@@ -89,6 +89,9 @@ public:
     virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::SetPushConstants() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size) override final;
+
     /// Implementation of IDeviceContext::SetStencilRef() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final;
 
@@ -147,6 +150,8 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D12 backend.
@@ -383,6 +388,8 @@ private:
                                                  ID3D12Resource*&               pd3d12ArgsBuff,
                                                  Uint64&                        BuffDataStartByteOffset);
 
+    ID3D12CommandSignature* GetDrawIndexedIndirectSignature(Uint32 ByteStride);
+
     struct TextureUploadSpace
     {
         D3D12DynamicAllocation Allocation;
@@ -433,6 +440,10 @@ private:
     CComPtr<ID3D12CommandSignature> m_pDispatchIndirectSignature;
     CComPtr<ID3D12CommandSignature> m_pDrawMeshIndirectSignature;
 
+    // Command signature stride must match the stride of the arguments in the buffer, so signatures
+    // for non-default strides used by DrawIndexedIndirectCount() are created on demand
+    std::unordered_map<Uint32, CComPtr<ID3D12CommandSignature>> m_DrawIndexedIndirectSignatures;
+
     D3D12DynamicHeap m_DynamicHeap;
 
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
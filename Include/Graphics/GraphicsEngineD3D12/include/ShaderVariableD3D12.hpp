@@ -211,6 +211,16 @@ public:
         return m_Resource.IsBound(ArrayIndex, m_ParentManager.m_ResourceCache);
     }
 
+    virtual void DILIGENT_CALL_TYPE SetBufferRange(IDeviceObject* pBuffer, Uint32 Offset, Uint32 Size, Uint32 ArrayIndex) override final
+    {
+        SetWholeBufferRange(*this, pBuffer, Offset, Size, ArrayIndex);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetBufferOffset(Uint32 Offset, Uint32 ArrayIndex) override final
+    {
+        SetZeroBufferOffset(*this, Offset, ArrayIndex);
+    }
+
     const ShaderResourceLayoutD3D12::D3D12Resource& GetResource() const
     {
         return m_Resource;
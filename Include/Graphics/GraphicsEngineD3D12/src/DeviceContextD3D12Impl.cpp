@@ -184,7 +184,7 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
 void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateD3D12 = ValidatedCast<PipelineStateD3D12Impl>(pPipelineState);
-    if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
+    if (IsRedundantPipelineState(pPipelineStateD3D12))
         return;
 
     // Never flush deferred context!
@@ -303,6 +303,8 @@ void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShad
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
         return;
 
+    ++m_BindStats.ShaderResourcesIssued;
+
     auto& Ctx = GetCmdContext();
 
     PipelineStateD3D12Impl::CommitAndTransitionResourcesAttribs Attribs;
@@ -315,6 +317,11 @@ void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShad
     m_State.bRootViewsCommitted     = false;
 }
 
+void DeviceContextD3D12Impl::SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size)
+{
+    UNSUPPORTED("Push constants are not supported in DirectX 12");
+}
+
 void DeviceContextD3D12Impl::SetStencilRef(Uint32 StencilRef)
 {
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
@@ -579,6 +586,53 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
     ++m_State.NumCommands;
 }
 
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndexedIndirectSignature(Uint32 ByteStride)
+{
+    if (ByteStride == sizeof(UINT) * 5)
+        return m_pDrawIndexedIndirectSignature;
+
+    auto& pSignature = m_DrawIndexedIndirectSignatures[ByteStride];
+    if (!pSignature)
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC IndirectArg = {};
+        IndirectArg.Type                         = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+        D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc = {};
+        CmdSignatureDesc.NodeMask                     = 0;
+        CmdSignatureDesc.NumArgumentDescs             = 1;
+        CmdSignatureDesc.pArgumentDescs               = &IndirectArg;
+        CmdSignatureDesc.ByteStride                   = ByteStride;
+
+        auto* pd3d12Device = m_pDevice->GetD3D12Device();
+        auto  hr           = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(pSignature), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pSignature)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create draw indexed indirect command signature");
+    }
+    return pSignature;
+}
+
+void DeviceContextD3D12Impl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+
+    ID3D12Resource* pd3d12ArgsBuff;
+    Uint64          ArgsBuffDataStartByteOffset;
+    PrepareDrawIndirectBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, ArgsBuffDataStartByteOffset);
+
+    // The count buffer must be in D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT state as well
+    ID3D12Resource* pd3d12CountBuff;
+    Uint64          CountBuffDataStartByteOffset;
+    PrepareDrawIndirectBuffer(GraphCtx, pCountBuffer, Attribs.CountBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset);
+
+    GraphCtx.ExecuteIndirect(GetDrawIndexedIndirectSignature(Attribs.IndirectDrawArgsStride), Attribs.MaxDrawCount,
+                             pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + ArgsBuffDataStartByteOffset,
+                             pd3d12CountBuff, Attribs.CountBufferOffset + CountBuffDataStartByteOffset);
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     if (!DvpVerifyDrawMeshArguments(Attribs))
@@ -887,7 +941,11 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffers that are already bound still need to be transitioned, but
+    // the vertex buffers committed to the command list remain valid
+    const bool StreamsChanged = !IsRedundantVertexBufferBinding(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags);
+    if (StreamsChanged)
+        TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
 
     auto& CmdCtx = GetCmdContext();
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
@@ -897,7 +955,8 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
             TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, "Setting vertex buffers (DeviceContextD3D12Impl::SetVertexBuffers)");
     }
 
-    m_State.bCommittedD3D12VBsUpToDate = false;
+    if (StreamsChanged)
+        m_State.bCommittedD3D12VBsUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::InvalidateState()
@@ -911,13 +970,18 @@ void DeviceContextD3D12Impl::InvalidateState()
 
 void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = !IsRedundantIndexBufferBinding(pIndexBuffer, ByteOffset);
+    if (IndexBufferChanged)
+        TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
     if (m_pIndexBuffer)
     {
         auto& CmdCtx = GetCmdContext();
         TransitionOrVerifyBufferState(CmdCtx, *m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, "Setting index buffer (DeviceContextD3D12Impl::SetIndexBuffer)");
     }
-    m_State.bCommittedD3D12IBUpToDate = false;
+
+    if (IndexBufferChanged)
+        m_State.bCommittedD3D12IBUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::CommitViewports()
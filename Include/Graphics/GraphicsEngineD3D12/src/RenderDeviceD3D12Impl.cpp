@@ -211,6 +211,9 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
 
         m_DeviceCaps.Features.VertexPipelineUAVWritesAndAtomics = DEVICE_FEATURE_STATE_ENABLED;
 
+        // ExecuteIndirect always accepts an optional count buffer
+        m_DeviceCaps.Features.DrawIndirectCount = DEVICE_FEATURE_STATE_ENABLED;
+
         // Detect maximum  shader model.
         D3D_SHADER_MODEL MaxShaderModel = D3D_SHADER_MODEL_5_1;
         {
@@ -330,7 +333,7 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
 #undef CHECK_REQUIRED_FEATURE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 34, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         auto& TexCaps = m_DeviceCaps.TexCaps;
@@ -162,6 +162,7 @@ public:
         Features.SeparablePrograms             = DEVICE_FEATURE_STATE_ENABLED;
         Features.ShaderResourceQueries         = DEVICE_FEATURE_STATE_ENABLED;
         Features.IndirectRendering             = DEVICE_FEATURE_STATE_ENABLED;
+        Features.DrawIndirectFirstInstance     = DEVICE_FEATURE_STATE_ENABLED;
         Features.WireframeFill                 = DEVICE_FEATURE_STATE_ENABLED;
         Features.MultithreadedResourceCreation = DEVICE_FEATURE_STATE_ENABLED;
         Features.ComputeShaders                = DEVICE_FEATURE_STATE_ENABLED;
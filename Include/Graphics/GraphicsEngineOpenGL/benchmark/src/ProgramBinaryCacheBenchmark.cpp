@@ -0,0 +1,418 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Persistent GL program binary cache benchmark and test.
+//
+// Usage:
+//
+//     Diligent-ProgramBinaryCacheBenchmark [-n] [<number of pipelines>]
+//
+//     -n  Force non-separable programs
+//
+// The harness creates an OpenGL 4.3 core context with GLX and attaches a device to it with the program
+// binary cache enabled in a new temporary directory. The same set of pipelines is created by two devices
+// one after another: the first pass compiles and links all programs and fills the cache, the second pass
+// loads them from the cache. For every pass, the harness verifies that
+//  - a shader with invalid GLSL fails to be created,
+//  - the pipelines render the expected color.
+// It also verifies that the first pass has stored the binaries. The times of both passes are printed.
+//
+// No GPU is needed; Mesa's software rasterizer exposes program binaries:
+//
+//     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./Diligent-ProgramBinaryCacheBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "EngineFactoryOpenGL.h"
+#include "RefCntAutoPtr.hpp"
+
+// X11 headers define macros (None, Bool, Status, ...) that conflict with the engine headers,
+// so they are included last
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 RenderTargetSize = 4;
+
+constexpr char VSSource[] = R"(
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    // Full-screen triangle
+    vec2 UV     = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// VARIANT makes the source of every pixel shader unique and is encoded in the red channel
+constexpr char PSSource[] = R"(
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = vec4(float(VARIANT % 256) / 255.0, 0.25, 0.5, 1.0);
+}
+)";
+
+constexpr char InvalidPSSource[] = R"(
+void main()
+{
+    this is not GLSL;
+}
+)";
+
+typedef GLXContext (*CreateContextAttribsProcType)(::Display*, GLXFBConfig, GLXContext, int, const int*);
+
+bool CreateGLContext(::Display*& pDisplay, ::Window& Window, GLXContext& Context)
+{
+    pDisplay = XOpenDisplay(nullptr);
+    if (pDisplay == nullptr)
+    {
+        std::cerr << "Failed to open X display. Run the benchmark with xvfb-run if there is no X server.\n";
+        return false;
+    }
+
+    // clang-format off
+    static const int VisualAttribs[] =
+    {
+        GLX_RENDER_TYPE,   GLX_RGBA_BIT,
+        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+        GLX_RED_SIZE,      8,
+        GLX_GREEN_SIZE,    8,
+        GLX_BLUE_SIZE,     8,
+        GLX_ALPHA_SIZE,    8,
+        None
+    };
+    // clang-format on
+
+    int   NumConfigs = 0;
+    auto* pConfigs   = glXChooseFBConfig(pDisplay, DefaultScreen(pDisplay), VisualAttribs, &NumConfigs);
+    if (pConfigs == nullptr || NumConfigs == 0)
+    {
+        std::cerr << "Failed to find a suitable framebuffer configuration\n";
+        return false;
+    }
+    const auto Config = pConfigs[0];
+    XFree(pConfigs);
+
+    auto* pVisualInfo = glXGetVisualFromFBConfig(pDisplay, Config);
+
+    XSetWindowAttributes WindowAttribs = {};
+    WindowAttribs.colormap             = XCreateColormap(pDisplay, RootWindow(pDisplay, pVisualInfo->screen), pVisualInfo->visual, AllocNone);
+    // The window is never mapped; it only provides the drawable for the context
+    Window = XCreateWindow(pDisplay, RootWindow(pDisplay, pVisualInfo->screen), 0, 0, RenderTargetSize, RenderTargetSize, 0,
+                           pVisualInfo->depth, InputOutput, pVisualInfo->visual, CWColormap, &WindowAttribs);
+    XFree(pVisualInfo);
+
+    auto CreateContextAttribs = reinterpret_cast<CreateContextAttribsProcType>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB")));
+    if (CreateContextAttribs == nullptr)
+    {
+        std::cerr << "glXCreateContextAttribsARB is not supported\n";
+        return false;
+    }
+
+    // clang-format off
+    static const int ContextAttribs[] =
+    {
+        GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
+        GLX_CONTEXT_MINOR_VERSION_ARB, 3,
+        GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+        None
+    };
+    // clang-format on
+
+    Context = CreateContextAttribs(pDisplay, Config, nullptr, True, ContextAttribs);
+    if (Context == nullptr || !glXMakeCurrent(pDisplay, Window, Context))
+    {
+        std::cerr << "Failed to create OpenGL 4.3 core context\n";
+        return false;
+    }
+
+    return true;
+}
+
+size_t CountFiles(const std::string& Directory)
+{
+    size_t NumFiles = 0;
+    if (auto* pDir = opendir(Directory.c_str()))
+    {
+        while (const auto* pEntry = readdir(pDir))
+        {
+            if (pEntry->d_name[0] != '.')
+                ++NumFiles;
+        }
+        closedir(pDir);
+    }
+    return NumFiles;
+}
+
+void RemoveDirectory(const std::string& Directory)
+{
+    if (auto* pDir = opendir(Directory.c_str()))
+    {
+        while (const auto* pEntry = readdir(pDir))
+        {
+            if (strcmp(pEntry->d_name, ".") != 0 && strcmp(pEntry->d_name, "..") != 0)
+                std::remove((Directory + '/' + pEntry->d_name).c_str());
+        }
+        closedir(pDir);
+    }
+    rmdir(Directory.c_str());
+}
+
+// Renders a full-screen triangle with the pipeline and returns the value of the red channel
+int ReadRenderedRed(IRenderDevice* pDevice, IDeviceContext* pContext, IPipelineState* pPSO, ITextureView* pRTV)
+{
+    TextureDesc StagingDesc    = pRTV->GetTexture()->GetDesc();
+    StagingDesc.Name           = "Program binary cache benchmark staging texture";
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.BindFlags      = BIND_NONE;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    if (!pStagingTex)
+        return -1;
+
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    const float ClearColor[] = {0, 0, 0, 0};
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+    CopyTextureAttribs CopyAttribs{pRTV->GetTexture(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->CopyTexture(CopyAttribs);
+    pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_NONE, nullptr, MappedData);
+    const int Red = MappedData.pData != nullptr ? static_cast<const Uint8*>(MappedData.pData)[0] : -1;
+    pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+
+    return Red;
+}
+
+bool RunPass(const char* Name, const std::string& CacheDirectory, bool ForceNonSeparablePrograms, Uint32 NumPipelines, double& Time)
+{
+    EngineGLCreateInfo EngineCI;
+    EngineCI.ForceNonSeparablePrograms    = ForceNonSeparablePrograms;
+    EngineCI.pProgramBinaryCacheDirectory = CacheDirectory.c_str();
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    GetEngineFactoryOpenGL()->AttachToActiveGLContext(EngineCI, &pDevice, &pContext);
+    if (!pDevice)
+    {
+        std::cerr << "Failed to attach to the GL context\n";
+        return false;
+    }
+
+    TextureDesc RTDesc;
+    RTDesc.Name      = "Program binary cache benchmark render target";
+    RTDesc.Type      = RESOURCE_DIM_TEX_2D;
+    RTDesc.Width     = RenderTargetSize;
+    RTDesc.Height    = RenderTargetSize;
+    RTDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    RTDesc.BindFlags = BIND_RENDER_TARGET;
+
+    RefCntAutoPtr<ITexture> pRT;
+    pDevice->CreateTexture(RTDesc, nullptr, &pRT);
+    if (!pRT)
+    {
+        std::cerr << "Failed to create render target\n";
+        return false;
+    }
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.EntryPoint     = "main";
+
+    // A shader that fails to compile must not be created, whether or not compilation is deferred
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Invalid PS";
+        ShaderCI.Source          = InvalidPSSource;
+
+        RefCntAutoPtr<IShader> pInvalidPS;
+        pDevice->CreateShader(ShaderCI, &pInvalidPS);
+        if (pInvalidPS)
+        {
+            std::cerr << Name << ": shader with invalid GLSL was created\n";
+            return false;
+        }
+    }
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs(NumPipelines);
+
+    const auto StartTime = std::chrono::high_resolution_clock::now();
+
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+    ShaderCI.Desc.Name       = "Program binary cache benchmark VS";
+    ShaderCI.Source          = VSSource;
+
+    RefCntAutoPtr<IShader> pVS;
+    pDevice->CreateShader(ShaderCI, &pVS);
+
+    for (Uint32 i = 0; i < NumPipelines && pVS; ++i)
+    {
+        const auto  Variant  = std::to_string(i);
+        ShaderMacro Macros[] = {{"VARIANT", Variant.c_str()}, {nullptr, nullptr}};
+
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Program binary cache benchmark PS";
+        ShaderCI.Source          = PSSource;
+        ShaderCI.Macros          = Macros;
+
+        RefCntAutoPtr<IShader> pPS;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ShaderCI.Macros = nullptr;
+        if (!pPS)
+            break;
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                                  = "Program binary cache benchmark PSO";
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0]                = RTDesc.Format;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        PSOCreateInfo.pVS                                           = pVS;
+        PSOCreateInfo.pPS                                           = pPS;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &PSOs[i]);
+        if (!PSOs[i])
+            break;
+    }
+
+    Time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - StartTime).count();
+
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        if (!PSOs[i])
+        {
+            std::cerr << Name << ": failed to create pipeline " << i << '\n';
+            return false;
+        }
+    }
+
+    // Programs loaded from binaries must produce the same result as the programs built from source
+    for (Uint32 i : {Uint32{0}, NumPipelines - 1})
+    {
+        const auto Red      = ReadRenderedRed(pDevice, pContext, PSOs[i], pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET));
+        const auto Expected = static_cast<int>(i % 256);
+        if (Red < 0 || std::abs(Red - Expected) > 1)
+        {
+            std::cerr << Name << ": pipeline " << i << " rendered red = " << Red << ", expected " << Expected << '\n';
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool   ForceNonSeparablePrograms = false;
+    Uint32 NumPipelines              = 200;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-n") == 0)
+            ForceNonSeparablePrograms = true;
+        else
+            NumPipelines = static_cast<Uint32>(std::max(std::atoi(argv[i]), 1));
+    }
+
+    ::Display* pDisplay = nullptr;
+    ::Window   Window   = 0;
+    GLXContext Context  = nullptr;
+    if (!CreateGLContext(pDisplay, Window, Context))
+        return EXIT_FAILURE;
+
+    char CacheDirTemplate[] = "/tmp/DiligentProgramBinaryCacheXXXXXX";
+    if (mkdtemp(CacheDirTemplate) == nullptr)
+    {
+        std::cerr << "Failed to create temporary cache directory\n";
+        return EXIT_FAILURE;
+    }
+    const std::string CacheDirectory = CacheDirTemplate;
+
+    double ColdTime = 0;
+    double WarmTime = 0;
+
+    bool Passed = RunPass("Cold pass", CacheDirectory, ForceNonSeparablePrograms, NumPipelines, ColdTime);
+
+    const auto NumCachedPrograms = CountFiles(CacheDirectory);
+    if (Passed && NumCachedPrograms == 0)
+    {
+        std::cerr << "No program binaries were stored. The driver may not support program binaries.\n";
+        Passed = false;
+    }
+
+    Passed = Passed && RunPass("Warm pass", CacheDirectory, ForceNonSeparablePrograms, NumPipelines, WarmTime);
+
+    if (Passed)
+    {
+        std::cout << (ForceNonSeparablePrograms ? "Non-separable" : "Separable") << " programs, "
+                  << NumPipelines << " pipelines, " << NumCachedPrograms << " cached programs\n"
+                  << "Cold (compile and link): " << ColdTime * 1000.0 << " ms\n"
+                  << "Warm (program binaries): " << WarmTime * 1000.0 << " ms\n";
+    }
+
+    RemoveDirectory(CacheDirectory);
+
+    glXMakeCurrent(pDisplay, 0, nullptr);
+    glXDestroyContext(pDisplay, Context);
+    XDestroyWindow(pDisplay, Window);
+    XCloseDisplay(pDisplay);
+
+    return Passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
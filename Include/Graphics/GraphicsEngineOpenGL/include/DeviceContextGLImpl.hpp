@@ -80,6 +80,9 @@ public:
     virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::SetPushConstants() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size) override final;
+
     /// Implementation of IDeviceContext::SetStencilRef() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final;
 
@@ -139,6 +142,8 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in OpenGL backend.
@@ -295,11 +300,24 @@ private:
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
     __forceinline void PostDraw();
 
+    void CommitPushConstants();
+
     void BeginSubpass();
     void EndSubpass();
 
     Uint32 m_CommitedResourcesTentativeBarriers = 0;
 
+    /// Shader resource binding whose resources are currently bound to the GL context and
+    /// the revision of its resource cache at the time of binding. Reset when the pipeline changes.
+    RefCntAutoPtr<IShaderResourceBinding> m_pCommittedSRB;
+    Uint32                                m_CommittedSRBRevision = 0;
+
+    /// CPU copy of the push constants and the uniform buffer they are uploaded to before
+    /// the next draw or dispatch command if m_PushConstantsDirty is set.
+    std::vector<Uint8>     m_PushConstantsData;
+    RefCntAutoPtr<IBuffer> m_pPushConstantsBuffer;
+    bool                   m_PushConstantsDirty = false;
+
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
     std::vector<class BufferGLImpl*>  m_BoundWritableBuffers;
 
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Persistent on-disk cache of linked GL program binaries
+
+#include <string>
+
+#include "Shader.h"
+#include "PersistentCacheUtils.hpp"
+
+namespace Diligent
+{
+
+/// Cache that stores linked GL programs on disk using glGetProgramBinary() and restores them with glProgramBinary().
+
+/// Every entry is identified by a 128-bit key that is computed from the final GLSL source of all
+/// shaders attached to the program, the program type (separable or monolithic) and the driver
+/// identification strings (vendor, renderer, version and supported binary formats), so that a driver
+/// update never picks up a binary produced by a different driver. Entries are written to a temporary
+/// file first and are then atomically renamed, so the same directory may be shared by multiple processes.
+/// Drivers are allowed to reject binaries at any time; Load() reports this by returning false, in which
+/// case the program must be linked from source.
+class GLProgramBinaryCache
+{
+public:
+    using Key = CacheEntryKey;
+
+    /// Creates the cache. Must be called on the thread that owns the GL context.
+
+    /// \param [in] CacheDirectory - Directory where cache entries are stored. The directory is created if it does not exist.
+    explicit GLProgramBinaryCache(const char* CacheDirectory) noexcept(false);
+
+    /// Returns true if the driver reports at least one program binary format.
+    static bool IsSupported();
+
+    /// Computes the hash of the shader source that is passed to glShaderSource().
+    static Key ComputeSourceHash(SHADER_TYPE ShaderType, const char* Source, size_t SourceLen);
+
+    /// Computes the cache key for the program that links the shaders with the given source hashes.
+    Key ComputeProgramKey(const Key* pShaderHashes, Uint32 NumShaders, bool IsSeparableProgram) const;
+
+    /// Loads the binary into the program. Returns false if there is no valid entry for the key
+    /// or the driver rejected the binary. In the latter case, the entry is removed.
+
+    /// \note For separable programs, GL_PROGRAM_SEPARABLE must be set before calling this method.
+    ///       If the method fails, the program object should be discarded.
+    bool Load(const Key& ProgramKey, GLuint Program) const;
+
+    /// Retrieves the binary of the successfully linked program and stores it in the cache.
+
+    /// \note For the binary to be retrievable on all drivers, GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    ///       should be set before the program is linked.
+    void Store(const Key& ProgramKey, GLuint Program) const;
+
+    const std::string& GetDirectory() const { return m_Directory; }
+
+private:
+    std::string GetEntryPath(const Key& ProgramKey) const;
+
+    std::string m_Directory;
+    std::string m_DriverInfo;
+};
+
+} // namespace Diligent
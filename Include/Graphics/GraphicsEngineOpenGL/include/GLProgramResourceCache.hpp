@@ -121,46 +121,55 @@ public:
     void SetUniformBuffer(Uint32 Binding, RefCntAutoPtr<BufferGLImpl>&& pBuff)
     {
         GetUB(Binding).pBuffer = std::move(pBuff);
+        ++m_Revision;
     }
 
     void SetTexSampler(Uint32 Binding, RefCntAutoPtr<TextureViewGLImpl>&& pTexView, bool SetSampler)
     {
         GetSampler(Binding).Set(std::move(pTexView), SetSampler);
+        ++m_Revision;
     }
 
     void SetImmutableSampler(Uint32 Binding, ISampler* pImtblSampler)
     {
         GetSampler(Binding).pSampler = ValidatedCast<SamplerGLImpl>(pImtblSampler);
+        ++m_Revision;
     }
 
     void CopySampler(Uint32 Binding, const CachedResourceView& SrcSam)
     {
         GetSampler(Binding) = SrcSam;
+        ++m_Revision;
     }
 
     void SetBufSampler(Uint32 Binding, RefCntAutoPtr<BufferViewGLImpl>&& pBuffView)
     {
         GetSampler(Binding).Set(std::move(pBuffView));
+        ++m_Revision;
     }
 
     void SetTexImage(Uint32 Binding, RefCntAutoPtr<TextureViewGLImpl>&& pTexView)
     {
         GetImage(Binding).Set(std::move(pTexView), false);
+        ++m_Revision;
     }
 
     void SetBufImage(Uint32 Binding, RefCntAutoPtr<BufferViewGLImpl>&& pBuffView)
     {
         GetImage(Binding).Set(std::move(pBuffView));
+        ++m_Revision;
     }
 
     void CopyImage(Uint32 Binding, const CachedResourceView& SrcImg)
     {
         GetImage(Binding) = SrcImg;
+        ++m_Revision;
     }
 
     void SetSSBO(Uint32 Binding, RefCntAutoPtr<BufferViewGLImpl>&& pBuffView)
     {
         GetSSBO(Binding).pBufferView = std::move(pBuffView);
+        ++m_Revision;
     }
 
     bool IsUBBound(Uint32 Binding) const
@@ -237,6 +246,10 @@ public:
         return m_MemoryEndOffset != InvalidResourceOffset;
     }
 
+    /// Returns the revision that is incremented every time a resource in the cache changes.
+    /// Device context uses it to skip redundant commits of the same resources.
+    Uint32 GetRevision() const { return m_Revision; }
+
 private:
     CachedUB& GetUB(Uint32 Binding)
     {
@@ -268,6 +281,8 @@ private:
 
     Uint8* m_pResourceData = nullptr;
 
+    Uint32 m_Revision = 0;
+
 #ifdef DILIGENT_DEBUG
     IMemoryAllocator* m_pdbgMemoryAllocator = nullptr;
 #endif
@@ -338,8 +338,15 @@ public:
     Uint32 GetNumSamplers()      const { return m_NumSamplers;       }
     Uint32 GetNumImages()        const { return m_NumImages;         }
     Uint32 GetNumStorageBlocks() const { return m_NumStorageBlocks;  }
+    Uint32 GetPushConstantsSize()const { return m_PushConstantsSize; }
     // clang-format on
 
+    /// Name of the uniform block that emulates Vulkan push constants, see IDeviceContext::SetPushConstants().
+    /// The block is not exposed as a shader resource and is always bound to the last uniform buffer binding.
+    static const Char* const PushConstantsBlockName;
+
+    static Uint32 GetPushConstantsBinding(class GLContextState& State);
+
     UniformBufferInfo& GetUniformBuffer(Uint32 Index)
     {
         VERIFY(Index < m_NumUniformBuffers, "Uniform buffer index (", Index, ") is out of range");
@@ -514,6 +521,9 @@ private:
     Uint32              m_NumSamplers       = 0;
     Uint32              m_NumImages         = 0;
     Uint32              m_NumStorageBlocks  = 0;
+
+    // Size of the cbPushConstants uniform block, or 0 if the program does not use it
+    Uint32              m_PushConstantsSize = 0;
     // clang-format on
     // When adding new member DO NOT FORGET TO UPDATE GLProgramResources( GLProgramResources&& ProgramResources )!!!
 };
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include "PipelineStateGL.h"
 #include "PipelineStateBase.hpp"
 #include "RenderDevice.h"
@@ -92,6 +93,9 @@ public:
     const GLPipelineResourceLayout& GetStaticResourceLayout() const { return m_StaticResourceLayout; }
     const GLProgramResourceCache&   GetStaticResourceCache() const { return m_StaticResourceCache; }
 
+    /// Returns the size of the largest push constants block used by the pipeline shaders, or 0.
+    Uint32 GetPushConstantsSize() const { return m_PushConstantsSize; }
+
 private:
     GLObjectWrappers::GLPipelineObj& GetGLProgramPipeline(GLContext::NativeGLContextType Context);
 
@@ -105,11 +109,12 @@ private:
 
     void Destruct();
 
-    // Linked GL programs for every shader stage. Every pipeline needs to have its own programs
-    // because resource bindings assigned by GLProgramResources::LoadUniforms depend on other
-    // shader stages.
+    // Linked GL programs for every shader stage. Resource bindings assigned by GLProgramResources::LoadUniforms
+    // depend on other shader stages, so separable programs are only shared with other pipelines that
+    // assign the same bindings, see RenderDeviceGLImpl::GetSeparableProgram().
     using GLProgramObj         = GLObjectWrappers::GLProgramObj;
-    GLProgramObj* m_GLPrograms = nullptr; // [m_NumShaderStages]
+    using GLProgramPtr         = std::shared_ptr<GLProgramObj>;
+    GLProgramPtr* m_GLPrograms = nullptr; // [m_NumShaderStages]
 
     ThreadingTools::LockFlag m_ProgPipelineLockFlag;
 
@@ -133,6 +138,7 @@ private:
     Uint32 m_TotalSamplerBindings       = 0;
     Uint32 m_TotalImageBindings         = 0;
     Uint32 m_TotalStorageBufferBindings = 0;
+    Uint32 m_PushConstantsSize          = 0;
 
     using SamplerPtr                = RefCntAutoPtr<ISampler>;
     SamplerPtr* m_ImmutableSamplers = nullptr; // [m_Desc.ResourceLayout.NumImmutableSamplers]
@@ -34,10 +34,14 @@
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
 #include "TexRegionRender.hpp"
+#include "GLProgramBinaryCache.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
 
+class ShaderGLImpl;
+
 /// Render device implementation in OpenGL backend.
 // RenderDeviceGLESImpl is inherited from RenderDeviceGLImpl
 class RenderDeviceGLImpl : public RenderDeviceBase<IGLDeviceBaseInterface>
@@ -162,11 +166,31 @@ public:
     void      OnDestroyPSO(IPipelineState* pPSO);
     void      OnDestroyBuffer(IBuffer* pBuffer);
 
+    /// Returns the separable program of the shader whose resource bindings start at the given offsets.
+
+    /// Bindings that GLProgramResources::LoadUniforms() assigns to a separable program depend on the
+    /// bindings used by the preceding pipeline stages, so the same program can be shared by all pipelines
+    /// that place the shader's resources at the same offsets. The program is linked on the first request
+    /// and is released when the last pipeline or shader that references it is destroyed.
+    ///
+    /// \note Sharing is only correct because GLProgramResources::LoadUniforms() is deterministic:
+    ///       for the same program and the same starting binding offsets, it always assigns the
+    ///       same bindings. Every pipeline calls it again on the shared program and must not
+    ///       change any program state that another pipeline relies on.
+    std::shared_ptr<GLObjectWrappers::GLProgramObj> GetSeparableProgram(ShaderGLImpl* pShader,
+                                                                        Uint32        UniformBufferBinding,
+                                                                        Uint32        SamplerBinding,
+                                                                        Uint32        ImageBinding,
+                                                                        Uint32        StorageBufferBinding);
+    void OnDestroyShader(IShader* pShader);
+
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
     void InitTexRegionRender();
 
+    GLProgramBinaryCache* GetProgramBinaryCache() const { return m_pProgramBinaryCache.get(); }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -188,8 +212,44 @@ protected:
     ThreadingTools::LockFlag                                     m_FBOCacheLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
 
+    struct SeparableProgramKey
+    {
+        // Unlike pointers, unique IDs are never reused by other shaders
+        UniqueIdentifier ShaderUID;
+
+        Uint32 UniformBufferBinding;
+        Uint32 SamplerBinding;
+        Uint32 ImageBinding;
+        Uint32 StorageBufferBinding;
+
+        bool operator==(const SeparableProgramKey& rhs) const
+        {
+            // clang-format off
+            return ShaderUID            == rhs.ShaderUID            &&
+                   UniformBufferBinding == rhs.UniformBufferBinding &&
+                   SamplerBinding       == rhs.SamplerBinding       &&
+                   ImageBinding         == rhs.ImageBinding         &&
+                   StorageBufferBinding == rhs.StorageBufferBinding;
+            // clang-format on
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const SeparableProgramKey& Key) const
+            {
+                return ComputeHash(Key.ShaderUID, Key.UniformBufferBinding, Key.SamplerBinding, Key.ImageBinding, Key.StorageBufferBinding);
+            }
+        };
+    };
+    ThreadingTools::LockFlag m_SeparableProgramsLockFlag;
+    // Programs are owned by pipelines and shaders, so the cache never keeps them alive.
+    // Must be declared before m_pTexRegionRender, whose shaders unregister themselves on destruction.
+    std::unordered_map<SeparableProgramKey, std::weak_ptr<GLObjectWrappers::GLProgramObj>, SeparableProgramKey::Hasher> m_SeparablePrograms;
+
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
 
+    std::unique_ptr<GLProgramBinaryCache> m_pProgramBinaryCache;
+
 private:
     template <typename PSOCreateInfoType>
     void CreatePipelineState(const PSOCreateInfoType& PSOCreateInfo, IPipelineState** ppPipelineState, bool bIsDeviceInternal);
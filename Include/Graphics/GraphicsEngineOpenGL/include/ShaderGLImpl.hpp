@@ -92,11 +92,30 @@ public:
     /// Implementation of IShader::GetResource() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
+    /// Links the program from the shaders or loads it from the program binary cache, if the cache is enabled.
+
+    /// Shaders whose compilation has been deferred are compiled only when the program is not found
+    /// in the cache. In this case, compilation errors are reported by throwing an exception.
     static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl** ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
 
 private:
+    void Compile(const char* Source, GLint SourceLength, IDataBlob** ppCompilerOutput) noexcept(false);
+    void CompileIfPending() noexcept(false);
+
     GLObjectWrappers::GLShaderObj m_GLShaderObj;
     GLProgramResources            m_Resources;
+
+    // Separable program with resource bindings starting at zero that is used for reflection.
+    // It is kept alive to be shared with pipelines that use the shader as their first stage.
+    std::shared_ptr<GLObjectWrappers::GLProgramObj> m_pSeparableProgram;
+
+    // Hash of the final GLSL source. Only computed when the program binary cache is enabled.
+    GLProgramBinaryCache::Key m_SourceHash;
+
+    // When the program binary cache is enabled, compilation is deferred until the shader is
+    // linked into a program that is not found in the cache.
+    std::string m_PendingSource;
+    bool        m_CompilationPending = false;
 };
 
 } // namespace Diligent
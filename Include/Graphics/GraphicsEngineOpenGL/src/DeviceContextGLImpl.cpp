@@ -79,10 +79,13 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateGLImpl = ValidatedCast<PipelineStateGLImpl>(pPipelineState);
-    if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
+    if (IsRedundantPipelineState(pPipelineStateGLImpl))
         return;
 
     TDeviceContextBase::SetPipelineState(pPipelineStateGLImpl, 0 /*Dummy*/);
+    m_pCommittedSRB.Release();
+    // Make sure the push constants buffer is large enough for the new pipeline's block
+    m_PushConstantsDirty = pPipelineStateGLImpl->GetPushConstantsSize() != 0;
 
     const auto& Desc = pPipelineStateGLImpl->GetDesc();
     if (Desc.PipelineType == PIPELINE_TYPE_COMPUTE)
@@ -170,6 +173,23 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0))
         return;
 
+    const GLProgramResourceCache* pResourceCache = nullptr;
+    if (pShaderResourceBinding != nullptr)
+    {
+        pResourceCache = &ValidatedCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding)->GetResourceCache(m_pPipelineState);
+        // Images and storage blocks produce memory barriers that must follow every draw
+        // command, so resources of the SRB can only be skipped when it has none of them.
+        if (m_pCommittedSRB.RawPtr() == pShaderResourceBinding &&
+            m_CommittedSRBRevision == pResourceCache->GetRevision() &&
+            pResourceCache->GetImageCount() == 0 &&
+            pResourceCache->GetSSBOCount() == 0)
+        {
+            return;
+        }
+    }
+
+    ++m_BindStats.ShaderResourcesIssued;
+
     if (m_CommitedResourcesTentativeBarriers != 0)
         LOG_INFO_MESSAGE("Not all tentative resource barriers have been executed since the last call to CommitShaderResources(). Did you forget to call Draw()/DispatchCompute() ?");
 
@@ -177,6 +197,63 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     BindProgramResources(m_CommitedResourcesTentativeBarriers, pShaderResourceBinding);
     // m_CommitedResourcesTentativeBarriers will contain memory barriers that will be required
     // AFTER the actual draw/dispatch command is executed. Before that they have no meaning
+
+    m_pCommittedSRB        = pShaderResourceBinding;
+    m_CommittedSRBRevision = pResourceCache != nullptr ? pResourceCache->GetRevision() : 0;
+}
+
+void DeviceContextGLImpl::SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    if (!DvpVerifyPushConstantsArguments(pData, Offset, Size, m_pPipelineState ? m_pPipelineState->GetPushConstantsSize() : 0))
+        return;
+#endif
+
+    // Push constants are emulated with the cbPushConstants uniform block. The data is kept on the CPU
+    // and uploaded to a dynamic uniform buffer by CommitPushConstants() when the next command is issued.
+    if (m_PushConstantsData.size() < Offset + Size)
+        m_PushConstantsData.resize(Offset + Size);
+    memcpy(m_PushConstantsData.data() + Offset, pData, Size);
+    m_PushConstantsDirty = true;
+}
+
+void DeviceContextGLImpl::CommitPushConstants()
+{
+    const auto BlockSize = m_pPipelineState->GetPushConstantsSize();
+    if (!m_PushConstantsDirty || BlockSize == 0)
+        return;
+
+    if (m_PushConstantsData.size() < BlockSize)
+        m_PushConstantsData.resize(BlockSize);
+
+    if (!m_pPushConstantsBuffer || m_pPushConstantsBuffer->GetDesc().uiSizeInBytes < BlockSize)
+    {
+        m_pPushConstantsBuffer.Release();
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Push constants emulation buffer";
+        BuffDesc.uiSizeInBytes  = BlockSize;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pPushConstantsBuffer);
+        if (!m_pPushConstantsBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create push constants emulation buffer");
+            return;
+        }
+    }
+
+    // Discarding the buffer orphans the previous storage, so draw commands that are still
+    // in flight keep reading the values that were current when they were issued.
+    void* pMappedData = nullptr;
+    MapBuffer(m_pPushConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+    memcpy(pMappedData, m_PushConstantsData.data(), BlockSize);
+    UnmapBuffer(m_pPushConstantsBuffer, MAP_WRITE);
+
+    auto* pBufferGL = m_pPushConstantsBuffer.RawPtr<BufferGLImpl>();
+    m_ContextState.BindUniformBuffer(GLProgramResources::GetPushConstantsBinding(m_ContextState), pBufferGL->m_GlBuffer);
+    m_PushConstantsDirty = false;
 }
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
@@ -203,6 +280,9 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBufferBinding(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     m_ContextState.InvalidateVAO();
 }
@@ -212,13 +292,19 @@ void DeviceContextGLImpl::InvalidateState()
     TDeviceContextBase::InvalidateState();
 
     m_ContextState.Invalidate();
+    m_pCommittedSRB.Release();
     m_BoundWritableTextures.clear();
     m_BoundWritableBuffers.clear();
     m_IsDefaultFBOBound = false;
+    // Invalidating the context state drops the uniform buffer binding of the push constants block
+    m_PushConstantsDirty = true;
 }
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBufferBinding(pIndexBuffer, ByteOffset))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     m_ContextState.InvalidateVAO();
 }
@@ -894,6 +980,7 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (GLProgramResources needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    CommitPushConstants();
 
     auto        CurrNativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     const auto& PipelineDesc        = m_pPipelineState->GetGraphicsPipelineDesc();
@@ -1106,6 +1193,49 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 #endif
 }
 
+void DeviceContextGLImpl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+#if GL_ARB_draw_indirect && GL_ARB_indirect_parameters
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    Uint32 FirstIndexByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, FirstIndexByteOffset);
+
+    PrepareForIndirectDraw(pAttribsBuffer);
+
+    // The draw count is sourced from the buffer bound to GL_PARAMETER_BUFFER_ARB binding.
+    // GL_COMMAND_BARRIER_BIT covers this binding as well.
+    auto* pCountBufferGL = ValidatedCast<BufferGLImpl>(pCountBuffer);
+    pCountBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+    constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER and GL_PARAMETER_BUFFER_ARB do not affect VAO
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, pCountBufferGL->m_GlBuffer, ResetVAO);
+
+    // GL 4.6 drivers are not required to expose ARB_indirect_parameters, in which case only the core entry point is loaded
+#    if GL_VERSION_4_6
+    auto MultiDrawElementsIndirectCount = glMultiDrawElementsIndirectCount != nullptr ? glMultiDrawElementsIndirectCount : glMultiDrawElementsIndirectCountARB;
+#    else
+    auto MultiDrawElementsIndirectCount = glMultiDrawElementsIndirectCountARB;
+#    endif
+    MultiDrawElementsIndirectCount(GlTopology, GLIndexType,
+                                   reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)),
+                                   static_cast<GLintptr>(Attribs.CountBufferOffset),
+                                   static_cast<GLsizei>(Attribs.MaxDrawCount),
+                                   static_cast<GLsizei>(Attribs.IndirectDrawArgsStride));
+    DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCount() failed");
+
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    LOG_ERROR_MESSAGE("Indirect draw count is not supported");
+#endif
+}
+
 void DeviceContextGLImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     UNSUPPORTED("DrawMesh is not supported in OpenGL");
@@ -1126,6 +1256,7 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (GLProgramResources needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    CommitPushConstants();
     glDispatchCompute(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
     DEV_CHECK_GL_ERROR("glDispatchCompute() failed");
 
@@ -1144,6 +1275,7 @@ void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (GLProgramResources needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    CommitPushConstants();
 
     auto* pBufferGL = ValidatedCast<BufferGLImpl>(pAttribsBuffer);
     pBufferGL->BufferMemoryBarrier(
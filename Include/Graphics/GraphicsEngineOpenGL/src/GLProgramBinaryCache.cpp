@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "GLProgramBinaryCache.hpp"
+
+#include <cstdio>
+
+#include "APIInfo.h"
+#include "FileSystem.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Increment when the key derivation or the entry layout changes
+constexpr Uint32 CacheFormatVersion = 2;
+
+constexpr Uint32 CacheEntryMagic = 0x42504C47; // 'GLPB'
+
+void AppendGLString(std::string& Str, GLenum Name)
+{
+    const auto* GLStr = reinterpret_cast<const char*>(glGetString(Name));
+    if (GLStr != nullptr)
+        Str.append(GLStr);
+    Str.push_back('\n');
+}
+
+} // namespace
+
+
+bool GLProgramBinaryCache::IsSupported()
+{
+    GLint NumFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+    return glGetError() == GL_NO_ERROR && NumFormats > 0;
+}
+
+GLProgramBinaryCache::GLProgramBinaryCache(const char* CacheDirectory) noexcept(false) :
+    m_Directory{CacheDirectory != nullptr ? CacheDirectory : ""}
+{
+    if (m_Directory.empty())
+        LOG_ERROR_AND_THROW("Program binary cache directory must not be empty");
+
+    if (m_Directory.back() == '/' || m_Directory.back() == '\\')
+        m_Directory.pop_back();
+
+    if (!FileSystem::PathExists(m_Directory.c_str()))
+    {
+        if (!FileSystem::CreateDirectory(m_Directory.c_str()))
+            LOG_ERROR_AND_THROW("Failed to create program binary cache directory '", m_Directory, '\'');
+    }
+
+    // Binaries are only valid for the exact driver that produced them. Drivers are supposed
+    // to reject foreign binaries, but not all of them do it reliably, so the driver strings
+    // become part of every key.
+    AppendGLString(m_DriverInfo, GL_VENDOR);
+    AppendGLString(m_DriverInfo, GL_RENDERER);
+    AppendGLString(m_DriverInfo, GL_VERSION);
+    AppendGLString(m_DriverInfo, GL_SHADING_LANGUAGE_VERSION);
+
+    GLint NumFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+    CHECK_GL_ERROR("Failed to get the number of program binary formats");
+    if (NumFormats > 0)
+    {
+        std::vector<GLint> Formats(NumFormats);
+        glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, Formats.data());
+        CHECK_GL_ERROR("Failed to get program binary formats");
+        for (auto Format : Formats)
+            m_DriverInfo.append(std::to_string(Format)).push_back(' ');
+    }
+}
+
+std::string GLProgramBinaryCache::GetEntryPath(const Key& ProgramKey) const
+{
+    std::string Path = m_Directory;
+    Path += FileSystem::GetSlashSymbol();
+    Path += ProgramKey.ToString();
+    Path += ".glbin";
+    return Path;
+}
+
+GLProgramBinaryCache::Key GLProgramBinaryCache::ComputeSourceHash(SHADER_TYPE ShaderType, const char* Source, size_t SourceLen)
+{
+    CacheKeyHasher Hasher;
+    Hasher.Update(ShaderType);
+    Hasher.UpdateStr(Source, SourceLen);
+    return Hasher.Get();
+}
+
+GLProgramBinaryCache::Key GLProgramBinaryCache::ComputeProgramKey(const Key* pShaderHashes, Uint32 NumShaders, bool IsSeparableProgram) const
+{
+    CacheKeyHasher Hasher;
+    Hasher.Update(CacheFormatVersion);
+    Hasher.Update(static_cast<Uint32>(DILIGENT_API_VERSION));
+    Hasher.UpdateStr(m_DriverInfo.c_str(), m_DriverInfo.length());
+    Hasher.Update(IsSeparableProgram);
+    Hasher.Update(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        Hasher.Update(pShaderHashes[i].Hash[0]);
+        Hasher.Update(pShaderHashes[i].Hash[1]);
+    }
+    return Hasher.Get();
+}
+
+bool GLProgramBinaryCache::Load(const Key& ProgramKey, GLuint Program) const
+{
+    const auto Path = GetEntryPath(ProgramKey);
+
+    // Params[0] is the binary format
+    CacheEntryHeader   Header;
+    std::vector<Uint8> Binary;
+    if (!ReadCacheEntry(Path, CacheEntryMagic, CacheFormatVersion, ProgramKey, Header, Binary))
+        return false;
+
+    if (Binary.empty())
+    {
+        LOG_WARNING_MESSAGE("Program binary cache entry '", Path, "' is invalid and will be ignored");
+        return false;
+    }
+
+    glProgramBinary(Program, static_cast<GLenum>(Header.Params[0]), Binary.data(), static_cast<GLsizei>(Binary.size()));
+    // Rejection is reported either through GL_INVALID_ENUM (unsupported format) or the link status
+    const auto Err      = glGetError();
+    GLint      IsLinked = GL_FALSE;
+    if (Err == GL_NO_ERROR)
+    {
+        glGetProgramiv(Program, GL_LINK_STATUS, &IsLinked);
+        CHECK_GL_ERROR("glGetProgramiv() failed");
+    }
+
+    if (!IsLinked)
+    {
+        // This is expected after driver updates that keep the identification strings intact.
+        // Remove the entry so that the binary produced by relinking can replace it on all platforms.
+        LOG_INFO_MESSAGE("Driver rejected program binary '", Path, "'. The program will be linked from source.");
+        std::remove(Path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void GLProgramBinaryCache::Store(const Key& ProgramKey, GLuint Program) const
+{
+    GLint BinaryLength = 0;
+    glGetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+    {
+        LOG_WARNING_MESSAGE("Driver did not provide the program binary; the program will not be cached");
+        return;
+    }
+
+    std::vector<Uint8> Binary(static_cast<size_t>(BinaryLength));
+
+    GLsizei Length       = 0;
+    GLenum  BinaryFormat = 0;
+    glGetProgramBinary(Program, BinaryLength, &Length, &BinaryFormat, Binary.data());
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to retrieve the program binary; the program will not be cached");
+        return;
+    }
+    Binary.resize(static_cast<size_t>(Length));
+
+    CacheEntryHeader Header;
+    Header.Magic         = CacheEntryMagic;
+    Header.FormatVersion = CacheFormatVersion;
+    Header.Key           = ProgramKey;
+    Header.Params[0]     = static_cast<Uint32>(BinaryFormat);
+
+    WriteCacheEntry(GetEntryPath(ProgramKey), Header, {{Binary.data(), Binary.size()}});
+}
+
+} // namespace Diligent
@@ -47,7 +47,8 @@ GLProgramResources::GLProgramResources(GLProgramResources&& Program) noexcept :
     m_NumUniformBuffers{Program.m_NumUniformBuffers    },
     m_NumSamplers      {Program.m_NumSamplers          },
     m_NumImages        {Program.m_NumImages            },        
-    m_NumStorageBlocks {Program.m_NumStorageBlocks     }
+    m_NumStorageBlocks {Program.m_NumStorageBlocks     },
+    m_PushConstantsSize{Program.m_PushConstantsSize    }
 // clang-format on
 {
     Program.m_UniformBuffers = nullptr;
@@ -59,6 +60,14 @@ GLProgramResources::GLProgramResources(GLProgramResources&& Program) noexcept :
     Program.m_NumSamplers       = 0;
     Program.m_NumImages         = 0;
     Program.m_NumStorageBlocks  = 0;
+    Program.m_PushConstantsSize = 0;
+}
+
+const Char* const GLProgramResources::PushConstantsBlockName = "cbPushConstants";
+
+Uint32 GLProgramResources::GetPushConstantsBinding(GLContextState& State)
+{
+    return static_cast<Uint32>(State.GetContextCaps().m_iMaxUniformBufferBindings - 1);
 }
 
 inline void RemoveArrayBrackets(char* Str)
@@ -492,6 +501,20 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
         // is equivalent to
         // glGetProgramResourceIndex( program, GL_UNIFORM_BLOCK, uniformBlockName );
 
+        if (strcmp(Name.data(), PushConstantsBlockName) == 0)
+        {
+            // Push constants are emulated with a uniform block that is fed by the device context
+            // directly and is not visible through shader resource variables.
+            GLint DataSize = 0;
+            glGetActiveUniformBlockiv(GLProgram, UniformBlockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &DataSize);
+            CHECK_GL_ERROR_AND_THROW("Unable to get the size of the push constants block\n");
+            m_PushConstantsSize = static_cast<Uint32>(DataSize);
+
+            glUniformBlockBinding(GLProgram, UniformBlockIndex, GetPushConstantsBinding(State));
+            CHECK_GL_ERROR("glUniformBlockBinding() failed");
+            continue;
+        }
+
         bool IsNewBlock = true;
 
         GLint ArraySize     = 1;
@@ -47,7 +47,7 @@ void PipelineStateGLImpl::Initialize(const PSOCreateInfoType& CreateInfo, std::v
 
     const auto NumPrograms = GetNumShaderStages();
 
-    MemPool.AddSpace<GLProgramObj>(NumPrograms);
+    MemPool.AddSpace<GLProgramPtr>(NumPrograms);
     MemPool.AddSpace<GLProgramResources>(NumPrograms);
     MemPool.AddSpace<SamplerPtr>(m_Desc.ResourceLayout.NumImmutableSamplers);
 
@@ -55,7 +55,7 @@ void PipelineStateGLImpl::Initialize(const PSOCreateInfoType& CreateInfo, std::v
 
     MemPool.Reserve();
 
-    m_GLPrograms = MemPool.ConstructArray<GLProgramObj>(NumPrograms, false);
+    m_GLPrograms = MemPool.ConstructArray<GLProgramPtr>(NumPrograms);
 
     // The memory is now owned by PipelineStateVkImpl and will be freed by Destruct().
     auto* Ptr = MemPool.ReleaseOwnership();
@@ -172,7 +172,7 @@ void PipelineStateGLImpl::Destruct()
     {
         if (m_GLPrograms != nullptr)
         {
-            m_GLPrograms[i].~GLProgramObj();
+            m_GLPrograms[i].~GLProgramPtr();
         }
         if (m_ProgramResources != nullptr)
         {
@@ -214,9 +214,14 @@ void PipelineStateGLImpl::InitResourceLayouts(std::vector<ShaderGLImpl*>& Shader
             {
                 auto*       pShaderGL  = Shaders[i];
                 const auto& ShaderDesc = pShaderGL->GetDesc();
-                m_GLPrograms[i]        = GLProgramObj{ShaderGLImpl::LinkProgram(&pShaderGL, 1, true)};
-                // Load uniforms and assign bindings
-                m_ProgramResources[i].LoadUniforms(ShaderDesc.ShaderType, m_GLPrograms[i], GLState,
+                // Reuse the program linked by another pipeline if the stage's bindings start at the same offsets
+                m_GLPrograms[i] = pDeviceGL->GetSeparableProgram(pShaderGL,
+                                                                 m_TotalUniformBufferBindings,
+                                                                 m_TotalSamplerBindings,
+                                                                 m_TotalImageBindings,
+                                                                 m_TotalStorageBufferBindings);
+                // Load uniforms and assign bindings. For a shared program, the bindings are the same.
+                m_ProgramResources[i].LoadUniforms(ShaderDesc.ShaderType, *m_GLPrograms[i], GLState,
                                                    m_TotalUniformBufferBindings,
                                                    m_TotalSamplerBindings,
                                                    m_TotalImageBindings,
@@ -235,9 +240,9 @@ void PipelineStateGLImpl::InitResourceLayouts(std::vector<ShaderGLImpl*>& Shader
                 ActiveStages |= ShaderType;
             }
 
-            m_GLPrograms[0] = ShaderGLImpl::LinkProgram(Shaders.data(), static_cast<Uint32>(Shaders.size()), false);
+            m_GLPrograms[0] = std::make_shared<GLProgramObj>(ShaderGLImpl::LinkProgram(Shaders.data(), static_cast<Uint32>(Shaders.size()), false));
 
-            m_ProgramResources[0].LoadUniforms(ActiveStages, m_GLPrograms[0], GLState,
+            m_ProgramResources[0].LoadUniforms(ActiveStages, *m_GLPrograms[0], GLState,
                                                m_TotalUniformBufferBindings,
                                                m_TotalSamplerBindings,
                                                m_TotalImageBindings,
@@ -246,6 +251,15 @@ void PipelineStateGLImpl::InitResourceLayouts(std::vector<ShaderGLImpl*>& Shader
             m_ShaderResourceLayoutHash = m_ProgramResources[0].GetHash();
         }
 
+        for (Uint32 s = 0; s < GetNumShaderStages(); ++s)
+            m_PushConstantsSize = std::max(m_PushConstantsSize, m_ProgramResources[s].GetPushConstantsSize());
+
+        if (m_PushConstantsSize != 0 && m_TotalUniformBufferBindings > GLProgramResources::GetPushConstantsBinding(GLState))
+        {
+            LOG_ERROR_AND_THROW("Pipeline '", m_Desc.Name, "' uses ", m_TotalUniformBufferBindings,
+                                " uniform buffer bindings, which overlaps the binding reserved for push constants");
+        }
+
         // Initialize master resource layout that keeps all variable types and does not reference a resource cache
         m_ResourceLayout.Initialize(m_ProgramResources, GetNumShaderStages(), m_Desc.PipelineType, m_Desc.ResourceLayout, nullptr, 0, nullptr);
     }
@@ -313,7 +327,7 @@ void PipelineStateGLImpl::CommitProgram(GLContextState& State)
     else
     {
         VERIFY_EXPR(m_GLPrograms != nullptr);
-        State.SetProgram(m_GLPrograms[0]);
+        State.SetProgram(*m_GLPrograms[0]);
     }
 }
 
@@ -336,7 +350,7 @@ GLObjectWrappers::GLPipelineObj& PipelineStateGLImpl::GetGLProgramPipeline(GLCon
         // If the program has an active code for each stage mentioned in set flags,
         // then that code will be used by the pipeline. If program is 0, then the given
         // stages are cleared from the pipeline.
-        glUseProgramStages(Pipeline, GLShaderBit, m_GLPrograms[i]);
+        glUseProgramStages(Pipeline, GLShaderBit, *m_GLPrograms[i]);
         CHECK_GL_ERROR("glUseProgramStages() failed");
     }
     return ctx_pipeline.second;
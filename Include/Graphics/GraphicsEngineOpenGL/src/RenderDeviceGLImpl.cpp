@@ -355,6 +355,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(GeometryShaders,               MajorVersion >= 4 || CheckExtension("GL_ARB_geometry_shader4"),    "Geometry shaders are");
         SET_FEATURE_STATE(Tessellation,                  MajorVersion >= 4 || CheckExtension("GL_ARB_tessellation_shader"), "Tessellation is");
         SET_FEATURE_STATE(BindlessResources,             false,                                                             "Bindless resources are");
+        SET_FEATURE_STATE(DrawIndirectCount,             IsGL46OrAbove     || CheckExtension("GL_ARB_indirect_parameters"), "Indirect draw count is");
+        SET_FEATURE_STATE(DrawIndirectFirstInstance,     IsGL42OrAbove     || CheckExtension("GL_ARB_base_instance"),       "Indirect draw first instance is");
         // clang-format on
         Features.OcclusionQueries          = DEVICE_FEATURE_STATE_ENABLED; // Present since 3.3
         Features.BinaryOcclusionQueries    = DEVICE_FEATURE_STATE_ENABLED; // Present since 3.3
@@ -414,6 +416,8 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(GeometryShaders,               IsGLES32OrAbove || strstr(Extensions, "geometry_shader"),     "Geometry shaders are");
         SET_FEATURE_STATE(Tessellation,                  IsGLES32OrAbove || strstr(Extensions, "tessellation_shader"), "Tessellation is");
         SET_FEATURE_STATE(BindlessResources,             false, "Bindless resources are");
+        SET_FEATURE_STATE(DrawIndirectCount,             false, "Indirect draw count is");
+        SET_FEATURE_STATE(DrawIndirectFirstInstance,     false, "Indirect draw first instance is"); // baseInstance is reserved in GLES
         SET_FEATURE_STATE(OcclusionQueries,              false, "Occlusion queries are");
         SET_FEATURE_STATE(BinaryOcclusionQueries,        true,  "Binary occlusion queries are"); // Supported in GLES3.0
 #if GL_TIMESTAMP
@@ -467,12 +471,34 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #undef SET_FEATURE_STATE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 34, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
+
+    if (InitAttribs.pProgramBinaryCacheDirectory != nullptr)
+    {
+        if (GLProgramBinaryCache::IsSupported())
+        {
+            try
+            {
+                m_pProgramBinaryCache.reset(new GLProgramBinaryCache{InitAttribs.pProgramBinaryCacheDirectory});
+            }
+            catch (...)
+            {
+                LOG_WARNING_MESSAGE("Failed to initialize the program binary cache in '", InitAttribs.pProgramBinaryCacheDirectory, "'. Programs will always be linked from source.");
+            }
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("The driver does not support program binaries. Programs will always be linked from source.");
+        }
+    }
 }
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
 {
+    // Shaders owned by the helper notify the device through OnDestroyShader(), so
+    // the helper must be destroyed while the separable program cache is still alive.
+    m_pTexRegionRender.reset();
 }
 
 IMPLEMENT_QUERY_INTERFACE(RenderDeviceGLImpl, IID_RenderDeviceGL, TRenderDeviceBase)
@@ -1313,6 +1339,50 @@ void RenderDeviceGLImpl::OnDestroyBuffer(IBuffer* pBuffer)
         VAOCacheIt.second.OnDestroyBuffer(pBuffer);
 }
 
+std::shared_ptr<GLObjectWrappers::GLProgramObj> RenderDeviceGLImpl::GetSeparableProgram(ShaderGLImpl* pShader,
+                                                                                         Uint32        UniformBufferBinding,
+                                                                                         Uint32        SamplerBinding,
+                                                                                         Uint32        ImageBinding,
+                                                                                         Uint32        StorageBufferBinding)
+{
+    VERIFY_EXPR(pShader != nullptr);
+    const SeparableProgramKey Key{pShader->GetUniqueID(), UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding};
+
+    {
+        ThreadingTools::LockHelper Lock(m_SeparableProgramsLockFlag);
+        auto it = m_SeparablePrograms.find(Key);
+        if (it != m_SeparablePrograms.end())
+        {
+            if (auto pProgram = it->second.lock())
+                return pProgram;
+        }
+    }
+
+    // Link outside of the lock. The bindings are assigned by the caller through LoadUniforms().
+    auto pProgram = std::make_shared<GLObjectWrappers::GLProgramObj>(ShaderGLImpl::LinkProgram(&pShader, 1, true));
+
+    {
+        ThreadingTools::LockHelper Lock(m_SeparableProgramsLockFlag);
+        m_SeparablePrograms[Key] = pProgram;
+    }
+
+    return pProgram;
+}
+
+void RenderDeviceGLImpl::OnDestroyShader(IShader* pShader)
+{
+    const auto ShaderUID = pShader->GetUniqueID();
+
+    ThreadingTools::LockHelper Lock(m_SeparableProgramsLockFlag);
+    for (auto it = m_SeparablePrograms.begin(); it != m_SeparablePrograms.end();)
+    {
+        if (it->first.ShaderUID == ShaderUID)
+            it = m_SeparablePrograms.erase(it);
+        else
+            ++it;
+    }
+}
+
 void RenderDeviceGLImpl::IdleGPU()
 {
     glFinish();
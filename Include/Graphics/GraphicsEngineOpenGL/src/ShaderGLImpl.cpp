@@ -103,8 +103,50 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     }
 
 
+    if (pDeviceGL->GetProgramBinaryCache() != nullptr)
+    {
+        m_SourceHash = GLProgramBinaryCache::ComputeSourceHash(m_Desc.ShaderType, ShaderStrings[0], Lenghts[0]);
+        // Programs that are found in the binary cache never need the compiled shader. Compilation
+        // can only be deferred when the separable program is linked below, which reports compilation
+        // errors from this constructor. In non-separable mode, programs are linked when the pipeline
+        // is created, so the shader is compiled now to not let invalid GLSL create a shader.
+        if (ShaderCI.ppCompilerOutput == nullptr && deviceCaps.Features.SeparablePrograms)
+        {
+            m_PendingSource.assign(ShaderStrings[0], Lenghts[0]);
+            m_CompilationPending = true;
+        }
+    }
+
+    if (!m_CompilationPending)
+        Compile(ShaderStrings[0], Lenghts[0], ShaderCI.ppCompilerOutput);
+
+    if (deviceCaps.Features.SeparablePrograms)
+    {
+        Uint32 UniformBufferBinding = 0;
+        Uint32 SamplerBinding       = 0;
+        Uint32 ImageBinding         = 0;
+        Uint32 StorageBufferBinding = 0;
+
+        m_pSeparableProgram = pDeviceGL->GetSeparableProgram(this, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+
+        auto pImmediateCtx = m_pDevice->GetImmediateContext();
+        VERIFY_EXPR(pImmediateCtx);
+        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
+        m_Resources.LoadUniforms(m_Desc.ShaderType, *m_pSeparableProgram, GLState, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+    }
+}
+
+ShaderGLImpl::~ShaderGLImpl()
+{
+    m_pDevice->OnDestroyShader(this);
+}
+
+IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
+
+void ShaderGLImpl::Compile(const char* Source, GLint SourceLength, IDataBlob** ppCompilerOutput) noexcept(false)
+{
     // Provide source strings (the strings will be saved in internal OpenGL memory)
-    glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lenghts.data());
+    glShaderSource(m_GLShaderObj, 1, &Source, &SourceLength);
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
     glCompileShader(m_GLShaderObj);
     GLint compiled = GL_FALSE;
@@ -112,12 +154,10 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
     if (!compiled)
     {
-        std::string FullSource;
-        for (const auto* str : ShaderStrings)
-            FullSource.append(str);
+        std::string FullSource{Source, static_cast<size_t>(SourceLength)};
 
         std::stringstream ErrorMsgSS;
-        ErrorMsgSS << "Failed to compile shader file '" << (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : "") << '\'' << std::endl;
+        ErrorMsgSS << "Failed to compile shader file '" << (m_Desc.Name != nullptr ? m_Desc.Name : "") << '\'' << std::endl;
         int infoLogLen = 0;
         // The function glGetShaderiv() tells how many bytes to allocate; the length includes the NULL terminator.
         glGetShaderiv(m_GLShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
@@ -135,7 +175,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
                        << infoLog.data() << std::endl;
         }
 
-        if (ShaderCI.ppCompilerOutput != nullptr)
+        if (ppCompilerOutput != nullptr)
         {
             // infoLogLen accounts for null terminator
             auto* pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(infoLogLen + FullSource.length() + 1);
@@ -143,7 +183,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
             if (infoLogLen > 0)
                 memcpy(DataPtr, infoLog.data(), infoLogLen);
             memcpy(DataPtr + infoLogLen, FullSource.data(), FullSource.length() + 1);
-            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ShaderCI.ppCompilerOutput));
+            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
         }
         else
         {
@@ -155,42 +195,56 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
 
         LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
     }
-
-    if (deviceCaps.Features.SeparablePrograms)
-    {
-        ShaderGLImpl*                  ThisShader[]         = {this};
-        GLObjectWrappers::GLProgramObj Program              = LinkProgram(ThisShader, 1, true);
-        Uint32                         UniformBufferBinding = 0;
-        Uint32                         SamplerBinding       = 0;
-        Uint32                         ImageBinding         = 0;
-        Uint32                         StorageBufferBinding = 0;
-        auto                           pImmediateCtx        = m_pDevice->GetImmediateContext();
-        VERIFY_EXPR(pImmediateCtx);
-        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
-        m_Resources.LoadUniforms(m_Desc.ShaderType, Program, GLState, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
-    }
 }
 
-ShaderGLImpl::~ShaderGLImpl()
+void ShaderGLImpl::CompileIfPending() noexcept(false)
 {
+    if (!m_CompilationPending)
+        return;
+
+    Compile(m_PendingSource.c_str(), static_cast<GLint>(m_PendingSource.length()), nullptr);
+    m_CompilationPending = false;
+    // The source is not needed anymore as the compiled shader is used by all subsequent links
+    m_PendingSource.clear();
+    m_PendingSource.shrink_to_fit();
 }
 
-IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
-
 
 GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl** ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
+    auto* const pProgramCache = NumShaders > 0 ? ppShaders[0]->m_pDevice->GetProgramBinaryCache() : nullptr;
+
+    GLProgramBinaryCache::Key ProgramKey;
+    if (pProgramCache != nullptr)
+    {
+        std::vector<GLProgramBinaryCache::Key> ShaderHashes(NumShaders);
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            ShaderHashes[i] = ppShaders[i]->m_SourceHash;
+        ProgramKey = pProgramCache->ComputeProgramKey(ShaderHashes.data(), NumShaders, IsSeparableProgram);
+
+        // A program object that failed to load the binary is discarded rather than relinked
+        GLObjectWrappers::GLProgramObj CachedProg(true);
+        if (IsSeparableProgram)
+            glProgramParameteri(CachedProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+        if (pProgramCache->Load(ProgramKey, CachedProg))
+            return CachedProg;
+    }
+
     GLObjectWrappers::GLProgramObj GLProg(true);
 
     // GL_PROGRAM_SEPARABLE parameter must be set before linking!
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+    if (pProgramCache != nullptr)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
+        pCurrShader->CompileIfPending();
         glAttachShader(GLProg, pCurrShader->m_GLShaderObj);
         CHECK_GL_ERROR("glAttachShader() failed");
     }
@@ -226,6 +280,10 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl** ppShader
         LOG_ERROR_MESSAGE("Failed to link shader program:\n", shaderProgramInfoLog.data(), '\n');
         UNEXPECTED("glLinkProgram failed");
     }
+    else if (pProgramCache != nullptr)
+    {
+        pProgramCache->Store(ProgramKey, GLProg);
+    }
 
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Descriptor set allocation contention benchmark.
+//
+// Usage:
+//
+//     Diligent-DescriptorAllocationBenchmark [<max threads> [<SRBs per thread>]]
+//
+// Creates a headless Vulkan device and a compute pipeline with mutable resources, so that every
+// shader resource binding allocates a descriptor set from the DescriptorSetAllocator. SRBs are then
+// created from 1, 2, 4, ... up to <max threads> threads (16 by default) and the throughput and
+// scaling relative to a single thread are printed.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "EngineFactoryVk.h"
+#include "RefCntAutoPtr.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr char ComputeShaderSource[] = R"(
+#version 450
+layout(local_size_x = 1) in;
+
+layout(std140) uniform Constants
+{
+    vec4 g_Data;
+};
+
+layout(std430) buffer Output
+{
+    vec4 g_Output[];
+};
+
+void main()
+{
+    g_Output[gl_GlobalInvocationID.x] = g_Data;
+}
+)";
+
+double RunPass(IPipelineState* pPSO, Uint32 NumThreads, Uint32 SRBsPerThread)
+{
+    std::vector<std::vector<RefCntAutoPtr<IShaderResourceBinding>>> SRBs(NumThreads);
+    for (auto& ThreadSRBs : SRBs)
+        ThreadSRBs.resize(SRBsPerThread);
+
+    std::vector<std::thread> Threads;
+    Threads.reserve(NumThreads);
+
+    const auto StartTime = std::chrono::high_resolution_clock::now();
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([pPSO, &ThreadSRBs = SRBs[t]]() {
+            for (auto& pSRB : ThreadSRBs)
+                pPSO->CreateShaderResourceBinding(&pSRB, false);
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+    const auto EndTime = std::chrono::high_resolution_clock::now();
+
+    for (const auto& ThreadSRBs : SRBs)
+    {
+        for (const auto& pSRB : ThreadSRBs)
+        {
+            if (!pSRB)
+            {
+                std::cerr << "Failed to create shader resource binding\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    return std::chrono::duration<double>(EndTime - StartTime).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Uint32 MaxThreads    = argc > 1 ? static_cast<Uint32>(std::max(std::atoi(argv[1]), 1)) : 16;
+    const Uint32 SRBsPerThread = argc > 2 ? static_cast<Uint32>(std::max(std::atoi(argv[2]), 1)) : 20000;
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+
+    auto* pFactory = GetEngineFactoryVk();
+
+    EngineVkCreateInfo EngineCI;
+    pFactory->CreateDeviceAndContextsVk(EngineCI, &pDevice, &pContext);
+    if (!pDevice)
+    {
+        std::cerr << "Failed to create Vulkan device\n";
+        return EXIT_FAILURE;
+    }
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Descriptor allocation benchmark CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = ComputeShaderSource;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name = "Descriptor allocation benchmark PSO";
+    // Mutable resources are stored in the descriptor set allocated for every SRB
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    if (pCS)
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+    {
+        std::cerr << "Failed to create compute pipeline\n";
+        return EXIT_FAILURE;
+    }
+
+    // Warm-up pass that creates the descriptor pools used by the measured passes
+    RunPass(pPSO, MaxThreads, SRBsPerThread);
+    pDevice->IdleGPU();
+
+    double SingleThreadRate = 0;
+    for (Uint32 NumThreads = 1;; NumThreads = std::min(NumThreads * 2, MaxThreads))
+    {
+        const auto Time = RunPass(pPSO, NumThreads, SRBsPerThread);
+        // Released descriptor sets are returned to their pools through the release queue
+        pDevice->IdleGPU();
+
+        const auto Rate = NumThreads * SRBsPerThread / Time;
+        if (NumThreads == 1)
+            SingleThreadRate = Rate;
+
+        std::cout << NumThreads << " thread(s): " << NumThreads * SRBsPerThread << " SRBs in "
+                  << Time * 1000.0 << " ms, " << Rate / 1000.0 << " K SRBs/s, scaling "
+                  << Rate / SingleThreadRate << "x\n";
+
+        if (NumThreads == MaxThreads)
+            break;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessDescriptorSetVk class
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "DeviceObject.h"
+#include "RefCntAutoPtr.hpp"
+#include "SPIRVShaderResources.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Global update-after-bind descriptor set that holds unbounded arrays of resources.
+
+/// Shaders access the set through unsized (runtime) resource arrays, which the
+/// resource layout remaps to BINDLESS_DESCRIPTOR_SET_INDEX. Every registered resource
+/// gets one index that is shared by all arrays the resource is compatible with, so that
+/// e.g. a shader resource view with a sampler can be accessed both as a combined
+/// image sampler and as a separate image.
+///
+/// The class is thread-safe.
+class BindlessDescriptorSetVk
+{
+public:
+    // Fixed bindings of the descriptor arrays in the set
+    enum BINDING : Uint32
+    {
+        BINDING_COMBINED_IMAGE_SAMPLER = 0,
+        BINDING_SAMPLED_IMAGE,
+        BINDING_STORAGE_IMAGE,
+        BINDING_STORAGE_BUFFER,
+        BINDING_SAMPLER,
+        BINDING_COUNT
+    };
+
+    static constexpr Uint32 InvalidBinding = ~0u;
+
+    BindlessDescriptorSetVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 DescriptorCount);
+    ~BindlessDescriptorSetVk();
+
+    // clang-format off
+    BindlessDescriptorSetVk             (const BindlessDescriptorSetVk&) = delete;
+    BindlessDescriptorSetVk             (BindlessDescriptorSetVk&&)      = delete;
+    BindlessDescriptorSetVk& operator = (const BindlessDescriptorSetVk&) = delete;
+    BindlessDescriptorSetVk& operator = (BindlessDescriptorSetVk&&)      = delete;
+    // clang-format on
+
+    // Returns true if the descriptor indexing features include everything the bindless set requires.
+    static bool IsSupported(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& DescrIndexingFeats);
+
+    // Returns the binding of the descriptor array that holds resources of the given type,
+    // or InvalidBinding if the type can't be accessed through the bindless set.
+    static Uint32 GetBinding(SPIRVShaderResourceAttribs::ResourceType Type);
+
+    Uint32 Register(IDeviceObject* pObject);
+    void   Unregister(IDeviceObject* pObject);
+
+    // Releases all registered resources and Vulkan objects. Must be called
+    // by the render device before it waits for the GPU to become idle.
+    void Destroy();
+
+    VkDescriptorSet       GetVkDescriptorSet() const { return m_vkSet; }
+    VkDescriptorSetLayout GetVkLayout() const { return m_vkLayout; }
+
+    // Layout with no bindings that fills descriptor sets between
+    // the sets of a pipeline and the bindless set
+    VkDescriptorSetLayout GetEmptyVkLayout() const { return m_vkEmptyLayout; }
+
+    Uint32 GetDescriptorCount() const { return m_DescriptorCount; }
+
+private:
+    friend class BindlessIndexDeleter;
+    void FreeIndex(Uint32 Index);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+    Uint32              m_DescriptorCount = 0;
+
+    VulkanUtilities::DescriptorPoolWrapper      m_vkPool;
+    VulkanUtilities::DescriptorSetLayoutWrapper m_vkLayout;
+    VulkanUtilities::DescriptorSetLayoutWrapper m_vkEmptyLayout;
+    VkDescriptorSet                             m_vkSet = VK_NULL_HANDLE;
+
+    struct RegisteredResource
+    {
+        Uint32                       Index = ~0u;
+        RefCntAutoPtr<IDeviceObject> pObject;
+    };
+
+    std::mutex                                             m_Mutex;
+    std::unordered_map<IDeviceObject*, RegisteredResource> m_Resources;
+    std::vector<Uint32>                                    m_FreeIndices;
+    Uint32                                                 m_NextIndex = 0;
+
+    // The number of unregistered indices that wait in the device release queues
+    Uint32 m_NumPendingIndices = 0;
+};
+
+} // namespace Diligent
@@ -72,6 +72,9 @@ public:
     void DvpVerifyDynamicAllocation(DeviceContextVkImpl* pCtx) const;
 #endif
 
+    // Alignment of the offsets the buffer may be bound at
+    Uint32 GetDynamicOffsetAlignment() const { return m_DynamicOffsetAlignment; }
+
     Uint32 GetDynamicOffset(Uint32 CtxId, DeviceContextVkImpl* pCtx) const
     {
         if (m_VulkanBuffer != VK_NULL_HANDLE)
@@ -114,6 +117,8 @@ public:
         return (GetAccessFlags() & AccessFlags) == AccessFlags;
     }
 
+    const VulkanUtilities::VulkanMemoryAllocation& GetMemoryAllocation() const { return m_MemoryAllocation; }
+
     void* GetCPUAddress()
     {
         VERIFY_EXPR(m_Desc.Usage == USAGE_STAGING || m_Desc.Usage == USAGE_UNIFIED);
@@ -127,8 +132,13 @@ private:
 
     VulkanUtilities::BufferViewWrapper CreateView(struct BufferViewDesc& ViewDesc);
 
-    Uint32       m_DynamicOffsetAlignment    = 0;
-    VkDeviceSize m_BufferMemoryAlignedOffset = 0;
+    Uint32             m_DynamicOffsetAlignment    = 0;
+    VkDeviceSize       m_BufferMemoryAlignedOffset = 0;
+    VkBufferUsageFlags m_VkUsageFlags              = 0;
+
+    // Relocatable buffers may be moved to another memory location by the defragmentation,
+    // see RenderDeviceVkImpl::DefragmentMemory()
+    bool m_IsRelocatable = false;
 
     // TODO (assiduous): move dynamic allocations to device context.
     static constexpr size_t CacheLineSize = 64;
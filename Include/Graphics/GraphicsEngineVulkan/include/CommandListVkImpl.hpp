@@ -58,6 +58,9 @@ public:
     ~CommandListVkImpl()
     {
         VERIFY(m_vkCmdBuff == VK_NULL_HANDLE && !m_pDeferredCtx, "Destroying command list that was never executed");
+        // The command buffer will never be submitted, so it must not block the defragmentation
+        if (m_vkCmdBuff != VK_NULL_HANDLE)
+            m_pDevice->OnDeferredCmdBufferReleased();
     }
 
     void Close(VkCommandBuffer&               CmdBuff,
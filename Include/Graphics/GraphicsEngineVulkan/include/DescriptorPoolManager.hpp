@@ -31,7 +31,8 @@
 #pragma once
 
 #include <vector>
-#include <deque>
+#include <array>
+#include <memory>
 #include <mutex>
 #include <atomic>
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
@@ -42,6 +43,34 @@ namespace Diligent
 class DescriptorSetAllocator;
 class RenderDeviceVkImpl;
 
+// Descriptor pool shared between threads.
+// Nodes are owned by the DescriptorPoolManager and are never destroyed before the manager,
+// so that they can be safely referenced by the lock-free free-pool list and by descriptor
+// set allocations.
+struct DescriptorPoolNode
+{
+    enum class STATE : Uint8
+    {
+        Free,  // The node is in the free-pool list
+        Owned, // The node is used by a thread cache of the DescriptorSetAllocator
+        Full   // Allocation from the pool failed; the node is not referenced by any list
+    };
+
+    explicit DescriptorPoolNode(Uint32 _Index) noexcept :
+        Index{_Index}
+    {}
+
+    VulkanUtilities::DescriptorPoolWrapper Pool;
+
+    // Descriptor pools are externally synchronized (13.2.3). The mutex is only contended
+    // when a descriptor set is released while the owning thread allocates from the same pool.
+    std::mutex Mutex;
+    STATE      State = STATE::Free;
+
+    const Uint32        Index;
+    std::atomic<Uint32> NextFree{0};
+};
+
 // This class manages descriptor set allocation.
 // The class destructor calls DescriptorSetAllocator::FreeDescriptorSet() that moves
 // the set into the release queue.
@@ -51,11 +80,11 @@ class DescriptorSetAllocation
 public:
     // clang-format off
     DescriptorSetAllocation(VkDescriptorSet         _Set,
-                            VkDescriptorPool        _Pool,
+                            DescriptorPoolNode*     _pPoolNode,
                             Uint64                  _CmdQueueMask,
                             DescriptorSetAllocator& _DescrSetAllocator)noexcept :
         Set              {_Set               },
-        Pool             {_Pool              },
+        pPoolNode        {_pPoolNode         },
         CmdQueueMask     {_CmdQueueMask      },
         DescrSetAllocator{&_DescrSetAllocator}
     {}
@@ -66,7 +95,7 @@ public:
 
     DescriptorSetAllocation(DescriptorSetAllocation&& rhs)noexcept : 
         Set              {rhs.Set              },
-        Pool             {rhs.Pool             },
+        pPoolNode        {rhs.pPoolNode        },
         CmdQueueMask     {rhs.CmdQueueMask     },
         DescrSetAllocator{rhs.DescrSetAllocator}
     {
@@ -80,7 +109,7 @@ public:
 
         Set               = rhs.Set;
         CmdQueueMask      = rhs.CmdQueueMask;
-        Pool              = rhs.Pool;
+        pPoolNode         = rhs.pPoolNode;
         DescrSetAllocator = rhs.DescrSetAllocator;
 
         rhs.Reset();
@@ -96,7 +125,7 @@ public:
     void Reset()
     {
         Set               = VK_NULL_HANDLE;
-        Pool              = VK_NULL_HANDLE;
+        pPoolNode         = nullptr;
         CmdQueueMask      = 0;
         DescrSetAllocator = nullptr;
     }
@@ -112,13 +141,15 @@ public:
 
 private:
     VkDescriptorSet         Set               = VK_NULL_HANDLE;
-    VkDescriptorPool        Pool              = VK_NULL_HANDLE;
+    DescriptorPoolNode*     pPoolNode         = nullptr;
     Uint64                  CmdQueueMask      = 0;
     DescriptorSetAllocator* DescrSetAllocator = nullptr;
 };
 
 
-// The class manages pool of descriptor set pools
+// The class manages pool of descriptor set pools.
+// Free pools are kept in a lock-free list, so that GetPool() and FreePool()
+// can be called from multiple threads without contending on a lock.
 //      ______________________________
 //     |                              |
 //     |     DescriptorPoolManager    |
@@ -160,8 +191,27 @@ public:
 #endif
 
 protected:
+    // Nodes are stored in blocks that are never moved, so that node pointers remain valid while
+    // the table grows. Block i holds FirstNodeBlockSize << i nodes, which lets MaxNodeBlocks
+    // blocks address almost 2^32 nodes.
+    static constexpr Uint32 FirstNodeBlockSize = 64;
+    static constexpr Uint32 MaxNodeBlocks      = 26;
+
     VulkanUtilities::DescriptorPoolWrapper CreateDescriptorPool(const char* DebugName) const;
 
+    // Creates a new node that is not referenced by any list.
+    // The method is called from the release queue and never throws; if the node
+    // can't be allocated, it returns null and the pool is not moved from.
+    DescriptorPoolNode* CreatePoolNode(VulkanUtilities::DescriptorPoolWrapper&& Pool) noexcept;
+
+    DescriptorPoolNode* GetNode(Uint32 Index) const;
+
+    // Lock-free push and pop operations on a node list. The list head packs
+    // the node index (plus one) in the low 32 bits and the modification tag
+    // in the high 32 bits, which protects the list from the ABA problem.
+    void                PushNode(std::atomic<Uint64>& ListHead, DescriptorPoolNode* pNode);
+    DescriptorPoolNode* PopNode(std::atomic<Uint64>& ListHead);
+
     RenderDeviceVkImpl& m_DeviceVkImpl;
     const std::string   m_PoolName;
 
@@ -169,12 +219,21 @@ protected:
     const uint32_t                          m_MaxSets;
     const bool                              m_AllowFreeing;
 
-    std::mutex                                         m_Mutex;
-    std::deque<VulkanUtilities::DescriptorPoolWrapper> m_Pools;
+    // Nodes whose pools are available for allocation
+    std::atomic<Uint64> m_FreeNodes{0};
 
 private:
     void FreePool(VulkanUtilities::DescriptorPoolWrapper&& Pool);
 
+    // Only protects node creation, which happens when a new pool is created
+    std::mutex m_NodeCreationMutex;
+
+    std::array<std::unique_ptr<std::unique_ptr<DescriptorPoolNode>[]>, MaxNodeBlocks> m_NodeBlocks;
+    std::atomic<Uint32>                                                                m_NumNodes{0};
+
+    // Nodes whose pools have been handed out by GetPool()
+    std::atomic<Uint64> m_EmptyNodes{0};
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedPoolCounter;
 #endif
@@ -182,7 +241,27 @@ private:
 
 
 // The class allocates descriptor sets from the main descriptor pool.
-// Descriptors sets can be released and returned to the pool
+// Descriptors sets can be released and returned to the pool.
+// Every thread allocates from the pool held by its own thread cache. When the pool is
+// exhausted, the thread takes another one from the lock-free free-pool list or creates
+// a new pool. An exhausted pool is put back to the free-pool list when one of its descriptor
+// sets is released through the release queue.
+// Allocation is not lock-free: it takes the mutex of the thread cache and the mutex of the pool,
+// since Vulkan requires external synchronization of descriptor pools. Neither is contended
+// unless more than NumThreadCaches threads allocate at once or a set is released from the pool
+// that is being allocated from; only the node creation mutex is shared by all threads.
+//
+//   Thread 0     Thread 1           Thread N
+//      |            |                  |
+//   ___V____________V__________________V___
+//  |        |          |      |            |
+//  | Cache0 |  Cache1  | ...  |   CacheM   |  DescriptorSetAllocator
+//  |________|__________|______|____________|
+//      |  A                           A
+//      |  | PopNode()                 | PushNode() (FreeDescriptorSet)
+//      V  |                           |
+//   | Pool[i] | -> | Pool[j] | -> ... |       Lock-free free-pool list
+//
 class DescriptorSetAllocator : public DescriptorPoolManager
 {
 public:
@@ -220,7 +299,18 @@ public:
 #endif
 
 private:
-    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
+    void FreeDescriptorSet(VkDescriptorSet Set, DescriptorPoolNode* pPoolNode, Uint64 QueueMask);
+
+    // Threads are assigned to caches in round-robin order. Threads that map
+    // to the same cache serialize on its mutex, but otherwise never block each other.
+    static constexpr Uint32 NumThreadCaches = 64;
+
+    struct ThreadCache
+    {
+        std::mutex          Mutex;
+        DescriptorPoolNode* pNode = nullptr;
+    };
+    std::array<ThreadCache, NumThreadCaches> m_ThreadCaches;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedSetCounter;
@@ -100,6 +100,9 @@ public:
     virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::SetPushConstants() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size) override final;
+
     /// Implementation of IDeviceContext::SetStencilRef() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final;
 
@@ -158,6 +161,8 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Vulkan backend.
@@ -304,6 +309,12 @@ public:
     /// Implementation of IDeviceContextVk::BufferMemoryBarrier().
     virtual void DILIGENT_CALL_TYPE BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags) override final;
 
+    /// Implementation of IDeviceContextVk::GetBarrierStats().
+    virtual BarrierStatsVk DILIGENT_CALL_TYPE GetBarrierStats() const override final;
+
+    /// Implementation of IDeviceContextVk::GenerateMaxReductionMips().
+    virtual void DILIGENT_CALL_TYPE GenerateMaxReductionMips(ITextureView* pTexView) override final;
+
 
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
@@ -361,6 +372,11 @@ public:
 
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
 
+    // Moves the buffer to a new memory allocation and records a copy of its contents.
+    // The old buffer and memory are released once the command buffer completes.
+    // Returns the number of bytes moved.
+    VkDeviceSize RelocateBuffer(BufferVkImpl& BufferVk);
+
     __forceinline VulkanUtilities::VulkanCommandBuffer& GetCommandBuffer()
     {
         EnsureVkCmdBuffer();
@@ -396,6 +412,7 @@ private:
     void               CommitVkVertexBuffers();
     void               CommitViewports();
     void               CommitScissorRects();
+    void               CommitPushConstants();
 
     __forceinline void TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -428,6 +445,10 @@ private:
         {
             auto vkCmdBuff = m_CmdPool.GetCommandBuffer();
             m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff);
+            // Commands recorded by deferred contexts reference buffer handles that must not be
+            // replaced by the defragmentation until the command list is submitted
+            if (m_bIsDeferred)
+                m_pDevice->OnDeferredCmdBufferStarted();
         }
     }
 
@@ -472,6 +493,9 @@ private:
         /// Flag indicating if currently committed index buffer is up to date
         bool CommittedIBUpToDate = false;
 
+        /// Flag indicating if push constants were recorded into the current command buffer
+        bool CommittedPushConstantsUpToDate = false;
+
         Uint32 NumCommands = 0;
     } m_State;
 
@@ -532,6 +556,11 @@ private:
     DynamicDescriptorSetAllocator            m_DynamicDescrSetAllocator;
 
     PipelineLayout::DescriptorSetBindInfo m_DescrSetBindInfo;
+    // Shader resource binding whose descriptor sets were last committed. Reset together with m_DescrSetBindInfo.
+    RefCntAutoPtr<IShaderResourceBinding> m_pCommittedSRB;
+    // CPU copy of the push constants block. Push constants do not survive the command buffer,
+    // so the whole block is recorded again after Flush() or InvalidateState() starts a new one.
+    std::vector<Uint8> m_PushConstantsData;
     std::shared_ptr<GenerateMipsVkHelper> m_GenerateMipsHelper;
     RefCntAutoPtr<IShaderResourceBinding> m_GenerateMipsSRB;
 
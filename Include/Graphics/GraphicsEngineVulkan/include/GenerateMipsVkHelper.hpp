@@ -54,21 +54,25 @@ public:
     GenerateMipsVkHelper& operator = (      GenerateMipsVkHelper&&) = delete;
     // clang-format on
 
-    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB);
+    // When ReductionMax is true, every texel of a mip level is the maximum of the texels it covers
+    // in the previous level, which is required to build hierarchical depth buffers. Only the compute
+    // path supports this mode.
+    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB, bool ReductionMax = false);
     void CreateSRB(IShaderResourceBinding** ppSRB);
     void WarmUpCache(TEXTURE_FORMAT Fmt);
 
 private:
-    std::array<RefCntAutoPtr<IPipelineState>, 4>  CreatePSOs(TEXTURE_FORMAT Fmt);
-    std::array<RefCntAutoPtr<IPipelineState>, 4>& FindPSOs(TEXTURE_FORMAT Fmt);
+    std::array<RefCntAutoPtr<IPipelineState>, 4>  CreatePSOs(TEXTURE_FORMAT Fmt, bool ReductionMax);
+    std::array<RefCntAutoPtr<IPipelineState>, 4>& FindPSOs(TEXTURE_FORMAT Fmt, bool ReductionMax = false);
 
-    VkImageLayout GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange);
+    VkImageLayout GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange, bool ReductionMax);
     VkImageLayout GenerateMipsBlit(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, VkImageSubresourceRange& SubresRange) const;
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
     std::mutex                                                                       m_PSOMutex;
     std::unordered_map<TEXTURE_FORMAT, std::array<RefCntAutoPtr<IPipelineState>, 4>> m_PSOHash;
+    std::unordered_map<TEXTURE_FORMAT, std::array<RefCntAutoPtr<IPipelineState>, 4>> m_MaxReductionPSOHash;
 
     static void GetGlImageFormat(const TextureFormatAttribs& FmtAttribs, std::array<char, 16>& GlFmt);
 
@@ -43,6 +43,7 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
+class BindlessDescriptorSetVk;
 
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
@@ -52,10 +53,23 @@ public:
 
     PipelineLayout();
     void Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQueueMask);
-    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+    // pBindlessSet must not be null if the layout uses the bindless descriptor set
+    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessDescriptorSetVk* pBindlessSet);
 
     VkPipelineLayout GetVkPipelineLayout() const { return m_LayoutMgr.GetVkPipelineLayout(); }
 
+    // Makes the pipeline layout include the global bindless descriptor set
+    // at index BINDLESS_DESCRIPTOR_SET_INDEX
+    void UseBindlessSet() { m_LayoutMgr.UseBindlessSet(); }
+    bool IsUsingBindlessSet() const { return m_LayoutMgr.IsUsingBindlessSet(); }
+
+    // Adds a push constant block of the given size used by the shader stage. All stages
+    // share a single push constant range that covers the largest block.
+    void AddPushConstants(SHADER_TYPE ShaderType, Uint32 Size) { m_LayoutMgr.AddPushConstants(ShaderType, Size); }
+
+    Uint32             GetPushConstantsSize() const { return m_LayoutMgr.GetPushConstantsSize(); }
+    VkShaderStageFlags GetPushConstantsStages() const { return m_LayoutMgr.GetPushConstantsStages(); }
+
     std::array<Uint32, 2> GetDescriptorSetSizes(Uint32& NumSets) const;
 
     void InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
@@ -101,6 +115,11 @@ public:
         Uint32                       DynamicOffsetCount      = 0;
         bool                         DynamicBuffersPresent   = false;
         bool                         DynamicDescriptorsBound = false;
+        // Resource cache dynamic offsets revision at the time the sets were bound with dynamic offsets
+        Uint32                       DynamicOffsetsRevision  = 0;
+
+        // Revisions of the resource cache descriptor sets at the time they were prepared for binding
+        std::array<Uint32, 2> SetRevisions = {};
 #ifdef DILIGENT_DEBUG
         const PipelineLayout* pDbgPipelineLayout = nullptr;
 #endif
@@ -129,6 +148,24 @@ public:
             pDbgPipelineLayout = nullptr;
 #endif
         }
+
+        // Returns true if the descriptor sets of the resource cache are currently bound
+        // and none of them has been modified since they were prepared for binding.
+        // Only the cache address is compared, so the caller must keep the owner of the bound
+        // cache alive to prevent a new cache from being allocated at the same address.
+        bool IsUpToDate(const ShaderResourceCacheVk& ResourceCache) const
+        {
+            if (pResourceCache != &ResourceCache)
+                return false;
+
+            VERIFY_EXPR(ResourceCache.GetNumDescriptorSets() <= SetRevisions.size());
+            for (Uint32 set = 0; set < ResourceCache.GetNumDescriptorSets(); ++set)
+            {
+                if (SetRevisions[set] != ResourceCache.GetDescriptorSet(set).GetRevision())
+                    return false;
+            }
+            return true;
+        }
     };
 
     // Prepares Vulkan descriptor sets for binding. Actual binding
@@ -192,9 +229,16 @@ private:
         DescriptorSetLayoutManager& operator= (DescriptorSetLayoutManager&&)      = delete;
         // clang-format on
 
-        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessDescriptorSetVk* pBindlessSet);
         void Release(RenderDeviceVkImpl* pRenderDeviceVk, Uint64 CommandQueueMask);
 
+        void UseBindlessSet() { m_UseBindlessSet = true; }
+        bool IsUsingBindlessSet() const { return m_UseBindlessSet; }
+
+        void               AddPushConstants(SHADER_TYPE ShaderType, Uint32 Size);
+        Uint32             GetPushConstantsSize() const { return m_PushConstantsSize; }
+        VkShaderStageFlags GetPushConstantsStages() const { return m_PushConstantsStages; }
+
         DescriptorSetLayout&       GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType) { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
         const DescriptorSetLayout& GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType) const { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
 
@@ -216,7 +260,10 @@ private:
         VulkanUtilities::PipelineLayoutWrapper                                                      m_VkPipelineLayout;
         std::array<DescriptorSetLayout, 2>                                                          m_DescriptorSetLayouts;
         std::vector<VkDescriptorSetLayoutBinding, STDAllocatorRawMem<VkDescriptorSetLayoutBinding>> m_LayoutBindings;
-        uint8_t                                                                                     m_ActiveSets = 0;
+        uint8_t                                                                                     m_ActiveSets          = 0;
+        bool                                                                                        m_UseBindlessSet      = false;
+        Uint32                                                                                      m_PushConstantsSize   = 0;
+        VkShaderStageFlags                                                                          m_PushConstantsStages = 0;
     };
 
     IMemoryAllocator&          m_MemAllocator;
@@ -266,6 +313,7 @@ __forceinline void PipelineLayout::BindDescriptorSetsWithDynamicOffsets(VulkanUt
                                  BindInfo.DynamicOffsets.data());
 
     BindInfo.DynamicDescriptorsBound = true;
+    BindInfo.DynamicOffsetsRevision  = BindInfo.pResourceCache->GetDynamicOffsetsRevision();
 }
 
 } // namespace Diligent
@@ -129,14 +129,30 @@ public:
 private:
     using TShaderStages = ShaderResourceLayoutVk::TShaderStages;
 
+    // Specialization constant data of a single shader module referenced by
+    // VkPipelineShaderStageCreateInfo::pSpecializationInfo. It must stay alive
+    // until the pipeline is created.
+    struct ShaderSpecialization
+    {
+        std::vector<VkSpecializationMapEntry> MapEntries;
+        std::vector<Uint8>                    Data;
+        VkSpecializationInfo                  Info = {};
+    };
+    using TShaderSpecializations = std::vector<ShaderSpecialization>;
+
     template <typename PSOCreateInfoType>
     TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
                                       std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules);
+                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
+                                      TShaderSpecializations&                            Specializations);
 
     void InitResourceLayouts(const PipelineStateCreateInfo& CreateInfo,
                              TShaderStages&                 ShaderStages);
 
+    void InitSpecializationInfo(const PipelineStateCreateInfo& CreateInfo,
+                                const TShaderStages&           ShaderStages,
+                                TShaderSpecializations&        Specializations) const;
+
     void Destruct();
 
     const ShaderResourceLayoutVk& GetStaticShaderResLayout(Uint32 ShaderInd) const
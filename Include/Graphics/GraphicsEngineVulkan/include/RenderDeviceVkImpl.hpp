@@ -30,11 +30,14 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 #include "RenderDeviceVk.h"
 #include "RenderDeviceBase.hpp"
 #include "RenderDeviceNextGenBase.hpp"
 #include "DescriptorPoolManager.hpp"
+#include "BindlessDescriptorSetVk.hpp"
 #include "VulkanDynamicHeap.hpp"
 #include "Atomics.hpp"
 #include "CommandQueueVk.h"
@@ -49,10 +52,14 @@
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
+#include "SPIRVShaderCache.hpp"
 
 namespace Diligent
 {
 
+class BufferVkImpl;
+class DeviceContextVkImpl;
+
 /// Render device implementation in Vulkan backend.
 class RenderDeviceVkImpl final : public RenderDeviceNextGenBase<RenderDeviceBase<IRenderDeviceVk>, ICommandQueueVk>
 {
@@ -163,6 +170,17 @@ public:
                                                                  RESOURCE_STATE             InitialState,
                                                                  ITopLevelAS**              ppTLAS) override final;
 
+    /// Implementation of IRenderDeviceVk::RegisterBindlessResource().
+    virtual Uint32 DILIGENT_CALL_TYPE RegisterBindlessResource(IDeviceObject* pObject) override final;
+
+    /// Implementation of IRenderDeviceVk::UnregisterBindlessResource().
+    virtual void DILIGENT_CALL_TYPE UnregisterBindlessResource(IDeviceObject* pObject) override final;
+
+    /// Implementation of IRenderDeviceVk::CreateAliasedTextures().
+    virtual void DILIGENT_CALL_TYPE CreateAliasedTextures(Uint32                      NumTextures,
+                                                          const AliasedTextureDescVk* pDescs,
+                                                          ITexture**                  ppTextures) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -182,6 +200,9 @@ public:
     }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
+    // Returns null if bindless descriptors are not enabled
+    const BindlessDescriptorSetVk* GetBindlessDescriptorSet() const { return m_pBindlessDescriptorSet.get(); }
+
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
 
     const VulkanUtilities::VulkanPhysicalDevice& GetPhysicalDevice() const { return *m_PhysicalDevice; }
@@ -203,12 +224,39 @@ public:
     }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
+    // Returns memory properties for transient attachments with the given memory type bits:
+    // lazily allocated memory if the device exposes it, and regular device-local memory otherwise.
+    VkMemoryPropertyFlags GetTransientAttachmentMemoryProperties(uint32_t MemoryTypeBits) const;
+
+    bool IsDefragmentationEnabled() const { return m_EngineAttribs.DefragmentationBytesPerFrame != 0; }
+
+    // Buffers that can be moved to another memory location by the defragmentation
+    void RegisterRelocatableBuffer(BufferVkImpl* pBuffer);
+    void UnregisterRelocatableBuffer(BufferVkImpl* pBuffer);
+
+    // Moves relocatable buffers out of sparsely used memory pages. Copy commands are recorded
+    // into the immediate context, which must be flushed afterwards. Nothing is moved while any
+    // deferred command buffer is being recorded or waits for execution.
+    // Returns the number of bytes moved.
+    VkDeviceSize DefragmentMemory(DeviceContextVkImpl& ImmediateCtx);
+
+    // Track deferred command buffers from the moment the first command is recorded until
+    // the command list is executed by the immediate context, or until the command list or
+    // the deferred context that records the buffer is destroyed
+    void OnDeferredCmdBufferStarted();
+    void OnDeferredCmdBufferReleased();
+
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
+    // Returns null if the persistent shader cache is disabled
+    SPIRVShaderCache* GetShaderCache() const { return m_pShaderCache.get(); }
+
+    SPIRV_OPTIMIZATION_FLAGS GetSPIRVOptimizationFlags() const { return m_SPIRVOptimizationFlags; }
+
     struct Properties
     {
         const Uint32 ShaderGroupHandleSize;
@@ -248,6 +296,8 @@ private:
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
+    std::unique_ptr<BindlessDescriptorSetVk> m_pBindlessDescriptorSet;
+
     // These one-time command pools are used by buffer and texture constructors to
     // issue copy commands. Vulkan requires that every command pool is used by one thread
     // at a time, so every constructor must allocate command buffer from its own pool.
@@ -255,10 +305,19 @@ private:
 
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
+    std::mutex                        m_RelocatableBuffersMtx;
+    std::unordered_set<BufferVkImpl*> m_RelocatableBuffers;
+    // Protected by m_RelocatableBuffersMtx, so that no deferred context can start recording while buffers are relocated
+    Uint32 m_NumPendingDeferredCmdBuffers = 0;
+
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 
+    std::unique_ptr<SPIRVShaderCache> m_pShaderCache;
+
+    SPIRV_OPTIMIZATION_FLAGS m_SPIRVOptimizationFlags = SPIRV_OPTIMIZATION_FLAG_NONE;
+
     Properties m_Properties;
 };
 
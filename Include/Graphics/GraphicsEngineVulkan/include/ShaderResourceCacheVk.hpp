@@ -95,7 +95,7 @@ public:
     void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, Uint32 SetSizes[]);
     void InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, SPIRVShaderResourceAttribs::ResourceType Type);
 
-    // sizeof(Resource) == 16 (x64, msvc, Release)
+    // sizeof(Resource) == 24 (x64, msvc, Release)
     struct Resource
     {
         // clang-format off
@@ -109,8 +109,13 @@ public:
         Resource& operator = (Resource&&)      = delete;
 
 /* 0 */ const SPIRVShaderResourceAttribs::ResourceType  Type;
-/*1-7*/ // Unused
+/*1-3*/ // Unused
+        // Offset added to the uniform buffer range when descriptor sets are bound (see IShaderResourceVariable::SetBufferOffset)
+/* 4 */ Uint32                                          BufferDynamicOffset = 0;
 /* 8 */ RefCntAutoPtr<IDeviceObject>                    pObject;
+        // Uniform buffer range referenced by the descriptor. Zero size means the remainder of the buffer.
+/*16 */ Uint32                                          BufferRangeOffset   = 0;
+/*20 */ Uint32                                          BufferRangeSize     = 0;
 
         VkDescriptorBufferInfo GetUniformBufferDescriptorWriteInfo ()                    const;
         VkDescriptorBufferInfo GetStorageBufferDescriptorWriteInfo ()                    const;
@@ -160,12 +165,19 @@ public:
         {
             VERIFY(m_NumResources > 0, "Descriptor set is empty");
             m_DescriptorSetAllocation = std::move(Allocation);
+            ++m_Revision;
         }
 
+        // The revision is incremented every time a resource in the set changes. Device contexts
+        // compare it with the revision they last committed to skip redundant commits.
+        Uint32 GetRevision() const { return m_Revision; }
+        void   MarkDirty() { ++m_Revision; }
+
         // clang-format off
 /* 0 */ const Uint32 m_NumResources = 0;
 
     private:
+/* 4 */ Uint32 m_Revision = 0;
 /* 8 */ Resource* const m_pResources = nullptr;
 /*16 */ DescriptorSetAllocation m_DescriptorSetAllocation;
 /*48 */ // End of structure
@@ -188,6 +200,11 @@ public:
 
     Uint16& GetDynamicBuffersCounter() { return m_NumDynamicBuffers; }
 
+    // The revision is incremented every time a uniform buffer dynamic offset changes, so that
+    // the device context knows it needs to bind descriptor sets with the new offsets.
+    inline Uint32 GetDynamicOffsetsRevision() const { return m_DynamicOffsetsRevision; }
+    void          OnDynamicOffsetChanged() { ++m_DynamicOffsetsRevision; }
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     DbgCacheContentType DbgGetContentType() const { return m_DbgContentType; }
@@ -217,6 +234,8 @@ private:
     Uint16 m_NumDynamicBuffers = 0;
     Uint32 m_TotalResources    = 0;
 
+    Uint32 m_DynamicOffsetsRevision = 0;
+
 #ifdef DILIGENT_DEBUG
     // Only for debug purposes: indicates what types of resources are stored in the cache
     const DbgCacheContentType m_DbgContentType;
@@ -251,7 +270,7 @@ __forceinline Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(Uint32
 
             const auto* pBufferVk = Res.pObject.RawPtr<const BufferVkImpl>();
             auto        Offset    = pBufferVk != nullptr ? pBufferVk->GetDynamicOffset(CtxId, pCtxVkImpl) : 0;
-            Offsets[OffsetInd++]  = Offset;
+            Offsets[OffsetInd++]  = Offset + Res.BufferDynamicOffset;
 
             ++res;
         }
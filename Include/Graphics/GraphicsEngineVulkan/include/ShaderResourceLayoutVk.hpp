@@ -251,8 +251,16 @@ public:
         // Checks if a resource is bound in ResourceCache at the given ArrayIndex
         bool IsBound(Uint32 ArrayIndex, const ShaderResourceCacheVk& ResourceCache) const;
 
-        // Binds a resource pObject in the ResourceCache
-        void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex, ShaderResourceCacheVk& ResourceCache) const;
+        // Binds a resource pObject in the ResourceCache. For uniform buffers, RangeOffset and RangeSize
+        // define the part of the buffer the descriptor references. Zero size means the remainder of the buffer.
+        void BindResource(IDeviceObject*         pObject,
+                          Uint32                 ArrayIndex,
+                          ShaderResourceCacheVk& ResourceCache,
+                          Uint32                 RangeOffset = 0,
+                          Uint32                 RangeSize   = 0) const;
+
+        // Sets the offset that is added to the uniform buffer range when descriptor sets are bound
+        void SetDynamicOffset(Uint32 ArrayIndex, Uint32 Offset, ShaderResourceCacheVk& ResourceCache) const;
 
         // Updates resource descriptor in the descriptor set
         inline void UpdateDescriptorHandle(VkDescriptorSet                                     vkDescrSet,
@@ -319,7 +327,9 @@ public:
                                 ShaderResourceCacheVk::Resource& DstRes,
                                 VkDescriptorSet                  vkDescrSet,
                                 Uint32                           ArrayInd,
-                                Uint16&                          DynamicBuffersCounter) const;
+                                Uint16&                          DynamicBuffersCounter,
+                                Uint32                           RangeOffset,
+                                Uint32                           RangeSize) const;
 
         void CacheStorageBuffer(IDeviceObject*                   pBufferView,
                                 ShaderResourceCacheVk::Resource& DstRes,
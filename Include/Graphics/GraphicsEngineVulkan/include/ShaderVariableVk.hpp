@@ -203,6 +203,22 @@ public:
         return m_Resource.IsBound(ArrayIndex, m_ParentManager.m_ResourceCache);
     }
 
+    virtual void DILIGENT_CALL_TYPE SetBufferRange(IDeviceObject* pBuffer, Uint32 Offset, Uint32 Size, Uint32 ArrayIndex) override final
+    {
+        VERIFY_EXPR(ArrayIndex < m_Resource.ArraySize);
+        if (m_Resource.Type != SPIRVShaderResourceAttribs::ResourceType::UniformBuffer)
+        {
+            LOG_ERROR_MESSAGE("Unable to bind buffer range to shader variable '", m_Resource.Name, "': the variable is not a uniform buffer.");
+            return;
+        }
+        m_Resource.BindResource(pBuffer, ArrayIndex, m_ParentManager.m_ResourceCache, Offset, Size);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetBufferOffset(Uint32 Offset, Uint32 ArrayIndex) override final
+    {
+        m_Resource.SetDynamicOffset(ArrayIndex, Offset, m_ParentManager.m_ResourceCache);
+    }
+
     const ShaderResourceLayoutVk::VkResource& GetResource() const
     {
         return m_Resource;
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::SwapChainVkImpl class
 
+#include <chrono>
+
 #include "SwapChainVk.h"
 #include "SwapChainBase.hpp"
 #include "VulkanUtilities/VulkanInstance.hpp"
@@ -69,6 +71,15 @@ public:
     /// Implementation of ISwapChainVk::GetVkSwapChain().
     virtual VkSwapchainKHR DILIGENT_CALL_TYPE GetVkSwapChain() override final { return m_VkSwapChain; }
 
+    /// Implementation of ISwapChainVk::SetFramePacing().
+    virtual void DILIGENT_CALL_TYPE SetFramePacing(const FramePacingAttribsVk& Attribs) override final;
+
+    /// Implementation of ISwapChainVk::GetFramePacing().
+    virtual const FramePacingAttribsVk& DILIGENT_CALL_TYPE GetFramePacing() const override final { return m_FramePacing; }
+
+    /// Implementation of ISwapChainVk::GetFrameTimings().
+    virtual FrameTimingsVk DILIGENT_CALL_TYPE GetFrameTimings() const override final { return m_FrameTimings; }
+
     /// Implementation of ISwapChain::GetCurrentBackBufferRTV() in Vulkan backend.
     virtual ITextureViewVk* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
     {
@@ -86,6 +97,8 @@ private:
     VkResult AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk);
     void     RecreateVulkanSwapchain(DeviceContextVkImpl* pImmediateCtxVk);
     void     WaitForImageAcquiredFences();
+    void     WaitForFrameLatency(DeviceContextVkImpl* pImmediateCtxVk);
+    void     UpdateGPUFrameTime();
     void     ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateCtxVk, bool DestroyVkSwapChain);
 
     const NativeWindow m_Window;
@@ -123,6 +136,21 @@ private:
     uint32_t m_BackBufferIndex = 0;
     bool     m_IsMinimized     = false;
     bool     m_VSyncEnabled    = true;
+
+    FramePacingAttribsVk m_FramePacing;
+    FrameTimingsVk       m_FrameTimings;
+    bool                 m_PresentModeChanged = false;
+
+    // Signaled with the frame number when the frame's commands complete on the GPU
+    RefCntAutoPtr<IFence> m_pFrameCompleteFence;
+
+    // Duration queries that measure GPU frame time. The ring is reused every
+    // m_GPUTimeQueries.size() frames. Empty if duration queries are not supported.
+    std::vector<RefCntAutoPtr<IQuery>> m_GPUTimeQueries;
+    std::vector<Uint64>                m_GPUTimeQueryFrames;
+    bool                               m_GPUTimeQueryActive = false;
+
+    std::chrono::high_resolution_clock::time_point m_LastPresentTime;
 };
 
 } // namespace Diligent
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::TextureVkImpl class
 
+#include <memory>
+
 #include "TextureVk.h"
 #include "RenderDeviceVk.h"
 #include "TextureBase.hpp"
@@ -49,12 +51,14 @@ public:
     using TTextureBase = TextureBase<ITextureVk, RenderDeviceVkImpl, TextureViewVkImpl, FixedBlockMemoryAllocator>;
     using ViewImplType = TextureViewVkImpl;
 
-    // Creates a new Vk resource
+    // Creates a new Vk resource. If bDeferMemoryBinding is true, no memory is allocated for the image
+    // and it must be bound with BindAliasedMemory() before the texture is used.
     TextureVkImpl(IReferenceCounters*        pRefCounters,
                   FixedBlockMemoryAllocator& TexViewObjAllocator,
                   RenderDeviceVkImpl*        pDeviceVk,
                   const TextureDesc&         TexDesc,
-                  const TextureData*         pInitData = nullptr);
+                  const TextureData*         pInitData           = nullptr,
+                  bool                       bDeferMemoryBinding = false);
 
     // Attaches to an existing Vk resource
     TextureVkImpl(IReferenceCounters*        pRefCounters,
@@ -99,6 +103,12 @@ public:
 
     void InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size);
 
+    // Binds the image to a memory block that is shared with other textures. The texture keeps
+    // the block alive until it is destroyed.
+    void BindAliasedMemory(std::shared_ptr<VulkanUtilities::VulkanMemoryAllocation> pMemory, VkDeviceSize Offset);
+
+    bool IsAliased() const { return m_pAliasedMemory != nullptr; }
+
     // Buffer offset must be a multiple of 4 (18.4)
     static constexpr Uint32 StagingBufferOffsetAlignment = 4;
 
@@ -113,6 +123,8 @@ protected:
     VulkanUtilities::ImageWrapper           m_VulkanImage;
     VulkanUtilities::BufferWrapper          m_StagingBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+    // Memory shared with other aliased textures (see IRenderDeviceVk::CreateAliasedTextures())
+    std::shared_ptr<VulkanUtilities::VulkanMemoryAllocation> m_pAliasedMemory;
     VkDeviceSize                            m_StagingDataAlignedOffset;
     bool                                    m_bCSBasedMipGenerationSupported = false;
 };
@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "VulkanHeaders.h"
 #include "DebugUtilities.hpp"
 
@@ -55,6 +57,7 @@ public:
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
+        FlushBarriers();
         vkCmdClearColorImage(
             m_VkCmdBuffer,
             Image,
@@ -76,6 +79,7 @@ public:
                "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_DEPTH_BIT or VK_IMAGE_ASPECT_STENCIL_BIT(17.1)");
         // clang-format on
 
+        FlushBarriers();
         vkCmdClearDepthStencilImage(
             m_VkCmdBuffer,
             Image,
@@ -138,6 +142,20 @@ public:
         vkCmdDrawIndexedIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
     }
 
+    __forceinline void DrawIndexedIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexedIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+
+        vkCmdDrawIndexedIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+#else
+        UNSUPPORTED("DrawIndexedIndirectCount is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void DrawMesh(uint32_t TaskCount, uint32_t FirstTask)
     {
 #if DILIGENT_USE_VOLK
@@ -170,6 +188,7 @@ public:
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+        FlushBarriers();
         vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
     }
 
@@ -179,6 +198,7 @@ public:
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+        FlushBarriers();
         vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
     }
 
@@ -192,6 +212,9 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
 
+        // Barriers cannot be recorded inside the render pass, so all pending barriers must be issued now
+        FlushBarriers();
+
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
             VkRenderPassBeginInfo BeginInfo;
@@ -249,13 +272,19 @@ public:
     __forceinline void EndCommandBuffer()
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkEndCommandBuffer(m_VkCmdBuffer);
     }
 
     __forceinline void Reset()
     {
+        VERIFY(!HasPendingBarriers(), "Resetting command buffer with pending barriers");
         m_VkCmdBuffer = VK_NULL_HANDLE;
         m_State       = StateCache{};
+        m_ImageBarriers.clear();
+        m_BufferBarriers.clear();
+        m_PendingSrcStages = 0;
+        m_PendingDstStages = 0;
     }
 
     __forceinline void BindComputePipeline(VkPipeline ComputePipeline)
@@ -360,7 +389,29 @@ public:
             // dependencies between attachments
             EndRenderPass();
         }
-        TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, m_EnabledShaderStages, SrcStages, DestStages);
+        // The barrier is deferred until the next command that needs it, see FlushBarriers()
+        EnqueueImageBarrier(Image, OldLayout, NewLayout, SubresRange, 0, SrcStages, DestStages);
+    }
+
+    // Same as above, but the source access mask is given explicitly and added to the one
+    // derived from OldLayout. This is required when the memory may have been written through
+    // another resource, e.g. when the image aliases the memory of other images.
+    __forceinline void TransitionImageLayout(VkImage                        Image,
+                                             VkImageLayout                  OldLayout,
+                                             VkImageLayout                  NewLayout,
+                                             const VkImageSubresourceRange& SubresRange,
+                                             VkAccessFlags                  SrcAccessMask,
+                                             VkPipelineStageFlags           SrcStages,
+                                             VkPipelineStageFlags           DestStages)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (m_State.RenderPass != VK_NULL_HANDLE)
+        {
+            // Image layout transitions within a render pass execute
+            // dependencies between attachments
+            EndRenderPass();
+        }
+        EnqueueImageBarrier(Image, OldLayout, NewLayout, SubresRange, SrcAccessMask, SrcStages, DestStages);
     }
 
 
@@ -385,7 +436,8 @@ public:
             // dependencies between attachments
             EndRenderPass();
         }
-        BufferMemoryBarrier(m_VkCmdBuffer, Buffer, srcAccessMask, dstAccessMask, m_EnabledShaderStages, SrcStages, DestStages);
+        // The barrier is deferred until the next command that needs it, see FlushBarriers()
+        EnqueueBufferBarrier(Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages);
     }
 
 
@@ -409,7 +461,10 @@ public:
             // dependencies between attachments
             EndRenderPass();
         }
+        FlushBarriers();
         ASMemoryBarrier(m_VkCmdBuffer, srcAccessMask, dstAccessMask, m_EnabledShaderStages, SrcStages, DestStages);
+        ++m_BarrierCounters.NumMemoryBarriers;
+        ++m_BarrierCounters.NumPipelineBarriers;
     }
 
     __forceinline void BindDescriptorSets(VkPipelineBindPoint    pipelineBindPoint,
@@ -424,6 +479,16 @@ public:
         vkCmdBindDescriptorSets(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
     }
 
+    __forceinline void PushConstants(VkPipelineLayout   layout,
+                                     VkShaderStageFlags stageFlags,
+                                     uint32_t           offset,
+                                     uint32_t           size,
+                                     const void*        pValues)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdPushConstants(m_VkCmdBuffer, layout, stageFlags, offset, size, pValues);
+    }
+
     __forceinline void CopyBuffer(VkBuffer            srcBuffer,
                                   VkBuffer            dstBuffer,
                                   uint32_t            regionCount,
@@ -435,6 +500,7 @@ public:
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
     }
 
@@ -452,6 +518,7 @@ public:
             EndRenderPass();
         }
 
+        FlushBarriers();
         vkCmdCopyImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -468,6 +535,7 @@ public:
             EndRenderPass();
         }
 
+        FlushBarriers();
         vkCmdCopyBufferToImage(m_VkCmdBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -484,6 +552,7 @@ public:
             EndRenderPass();
         }
 
+        FlushBarriers();
         vkCmdCopyImageToBuffer(m_VkCmdBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions);
     }
 
@@ -502,6 +571,7 @@ public:
             EndRenderPass();
         }
 
+        FlushBarriers();
         vkCmdBlitImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter);
     }
 
@@ -518,6 +588,7 @@ public:
             // Resolve must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdResolveImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
     }
 
@@ -541,6 +612,7 @@ public:
         // begin and end outside of a render pass instance (i.e. contain entire render pass instances) (17.2).
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
         if (m_State.RenderPass != VK_NULL_HANDLE)
             m_State.InsidePassQueries |= queryFlag;
@@ -553,6 +625,7 @@ public:
                                 uint32_t    queryFlag)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
         if (m_State.RenderPass != VK_NULL_HANDLE)
         {
@@ -571,6 +644,7 @@ public:
                                       uint32_t                query)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdWriteTimestamp(m_VkCmdBuffer, pipelineStage, queryPool, query);
     }
 
@@ -584,6 +658,7 @@ public:
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdResetQueryPool(m_VkCmdBuffer, queryPool, firstQuery, queryCount);
     }
 
@@ -601,6 +676,7 @@ public:
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdCopyQueryPoolResults(m_VkCmdBuffer, queryPool, firstQuery, queryCount,
                                   dstBuffer, dstOffset, stride, flags);
     }
@@ -616,6 +692,7 @@ public:
             // Build AS operations must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdBuildAccelerationStructuresKHR(m_VkCmdBuffer, infoCount, pInfos, ppBuildRangeInfos);
 #else
         UNSUPPORTED("Ray tracing is not supported when vulkan library is linked statically");
@@ -631,6 +708,7 @@ public:
             // Copy AS operations must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdCopyAccelerationStructureKHR(m_VkCmdBuffer, &Info);
 #else
         UNSUPPORTED("Ray tracing is not supported when vulkan library is linked statically");
@@ -646,6 +724,7 @@ public:
             // Write AS properties operations must be performed outside of render pass.
             EndRenderPass();
         }
+        FlushBarriers();
         vkCmdWriteAccelerationStructuresPropertiesKHR(m_VkCmdBuffer, 1, &accelerationStructure, queryType, queryPool, firstQuery);
 #else
         UNSUPPORTED("Ray tracing is not supported when vulkan library is linked statically");
@@ -664,13 +743,38 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
 
+        FlushBarriers();
         vkCmdTraceRaysKHR(m_VkCmdBuffer, &RaygenShaderBindingTable, &MissShaderBindingTable, &HitShaderBindingTable, &CallableShaderBindingTable, width, height, depth);
 #else
         UNSUPPORTED("Ray tracing is not supported when vulkan library is linked statically");
 #endif
     }
 
-    void FlushBarriers();
+    // Image and buffer barriers are not recorded immediately, but are accumulated and issued
+    // by a single vkCmdPipelineBarrier before the next command that executes outside of a render pass
+    // (render pass begin, dispatch, copy, clear, query, etc.). Draw commands are always preceded by
+    // BeginRenderPass(), so they never observe pending barriers.
+    __forceinline void FlushBarriers()
+    {
+        if (HasPendingBarriers())
+            IssuePendingBarriers();
+    }
+
+    bool HasPendingBarriers() const
+    {
+        return !m_ImageBarriers.empty() || !m_BufferBarriers.empty();
+    }
+
+    struct BarrierCounters
+    {
+        uint32_t NumImageBarriers    = 0; // Image barriers requested
+        uint32_t NumBufferBarriers   = 0; // Buffer barriers requested
+        uint32_t NumMemoryBarriers   = 0; // Acceleration structure memory barriers (not batched)
+        uint32_t NumPipelineBarriers = 0; // vkCmdPipelineBarrier commands recorded
+        uint32_t NumMergedBarriers   = 0; // Barriers that were merged into another vkCmdPipelineBarrier
+    };
+
+    const BarrierCounters& GetBarrierCounters() const { return m_BarrierCounters; }
 
     __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer)
     {
@@ -699,9 +803,31 @@ public:
     const StateCache& GetState() const { return m_State; }
 
 private:
+    void EnqueueImageBarrier(VkImage                        Image,
+                             VkImageLayout                  OldLayout,
+                             VkImageLayout                  NewLayout,
+                             const VkImageSubresourceRange& SubresRange,
+                             VkAccessFlags                  ExtraSrcAccessMask,
+                             VkPipelineStageFlags           SrcStages,
+                             VkPipelineStageFlags           DestStages);
+
+    void EnqueueBufferBarrier(VkBuffer             Buffer,
+                              VkAccessFlags        srcAccessMask,
+                              VkAccessFlags        dstAccessMask,
+                              VkPipelineStageFlags SrcStages,
+                              VkPipelineStageFlags DestStages);
+
+    void IssuePendingBarriers();
+
     StateCache                 m_State;
     VkCommandBuffer            m_VkCmdBuffer = VK_NULL_HANDLE;
     const VkPipelineStageFlags m_EnabledShaderStages;
+
+    std::vector<VkImageMemoryBarrier>  m_ImageBarriers;
+    std::vector<VkBufferMemoryBarrier> m_BufferBarriers;
+    VkPipelineStageFlags               m_PendingSrcStages = 0;
+    VkPipelineStageFlags               m_PendingDstStages = 0;
+    BarrierCounters                    m_BarrierCounters;
 };
 
 } // namespace VulkanUtilities
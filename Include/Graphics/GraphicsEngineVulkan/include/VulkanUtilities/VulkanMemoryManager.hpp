@@ -32,6 +32,7 @@
 #include <unordered_map>
 #include <atomic>
 #include <string>
+#include <functional>
 #include "MemoryAllocator.h"
 #include "VariableSizeAllocationsManager.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
@@ -99,7 +100,8 @@ public:
                      VkDeviceSize          PageSize,
                      uint32_t              MemoryTypeIndex,
                      bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags) noexcept;
+                     VkMemoryAllocateFlags AllocateFlags,
+                     bool                  IsDedicated = false) noexcept;
     ~VulkanMemoryPage();
 
     // clang-format off
@@ -107,7 +109,9 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_IsDedicated     {rhs.m_IsDedicated             },
+        m_IsEvacuating    {rhs.m_IsEvacuating.load()     }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -121,6 +125,12 @@ public:
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
 
+    // Dedicated pages hold exactly one allocation and are released as soon as it is freed
+    bool IsDedicated()  const { return m_IsDedicated; }
+
+    // No new allocations are placed into evacuating pages, see VulkanMemoryManager::BeginPageEvacuation()
+    bool IsEvacuating() const { return m_IsEvacuating.load(); }
+
     // clang-format on
 
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
@@ -132,6 +142,7 @@ private:
     using AllocationsMgrOffsetType = Diligent::VariableSizeAllocationsManager::OffsetType;
 
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
 
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
@@ -141,6 +152,8 @@ private:
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+    const bool                               m_IsDedicated;
+    std::atomic_bool                         m_IsEvacuating{false};
 };
 
 class VulkanMemoryManager
@@ -154,15 +167,17 @@ public:
                         VkDeviceSize                 DeviceLocalPageSize,
                         VkDeviceSize                 HostVisiblePageSize,
                         VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) : 
-        m_MgrName               {std::move(MgrName)    },
-        m_LogicalDevice         {LogicalDevice         },
-        m_PhysicalDevice        {PhysicalDevice        },
-        m_Allocator             {Allocator             },
-        m_DeviceLocalPageSize   {DeviceLocalPageSize   },
-        m_HostVisiblePageSize   {HostVisiblePageSize   },
-        m_DeviceLocalReserveSize{DeviceLocalReserveSize},
-        m_HostVisibleReserveSize{HostVisibleReserveSize}
+                        VkDeviceSize                 HostVisibleReserveSize,
+                        VkDeviceSize                 DedicatedAllocationThreshold = 0) : 
+        m_MgrName                     {std::move(MgrName)          },
+        m_LogicalDevice               {LogicalDevice               },
+        m_PhysicalDevice              {PhysicalDevice              },
+        m_Allocator                   {Allocator                   },
+        m_DeviceLocalPageSize         {DeviceLocalPageSize         },
+        m_HostVisiblePageSize         {HostVisiblePageSize         },
+        m_DeviceLocalReserveSize      {DeviceLocalReserveSize      },
+        m_HostVisibleReserveSize      {HostVisibleReserveSize      },
+        m_DedicatedAllocationThreshold{DedicatedAllocationThreshold}
     {}
 
 
@@ -180,11 +195,14 @@ public:
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
+        m_DedicatedAllocationThreshold{rhs.m_DedicatedAllocationThreshold},
     
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+
+        m_NumUnreservedPages{rhs.m_NumUnreservedPages}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
@@ -203,6 +221,19 @@ public:
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
     void                   ShrinkMemory();
 
+    // Marks sparsely used device-local pages for evacuation. A page is selected if the ratio of
+    // its used memory is below MaxPageOccupancy, CanEvacuate returns true for it (the second
+    // argument is the size of the page's live allocations), and these
+    // allocations fit into the free space of other pages of the same type. Evacuating pages
+    // receive no new allocations and are released by ShrinkMemory() as soon as they become
+    // empty, regardless of the reserve size. New pages are only selected when the previously
+    // selected ones have been released.
+    // Returns the number of pages that are currently being evacuated.
+    size_t BeginPageEvacuation(float MaxPageOccupancy, const std::function<bool(const VulkanMemoryPage&, VkDeviceSize)>& CanEvacuate);
+
+    // Clears the evacuation flag of all pages
+    void CancelPageEvacuation();
+
 protected:
     friend class VulkanMemoryPage;
 
@@ -254,6 +285,7 @@ protected:
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
+    const VkDeviceSize m_DedicatedAllocationThreshold;
 
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
 
@@ -263,6 +295,10 @@ protected:
     std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
 
+    // Number of dedicated and evacuating pages, which are released by ShrinkMemory() regardless
+    // of the reserve size. Protected by m_PagesMtx.
+    size_t m_NumUnreservedPages = 0;
+
     // If adding new member, do not forget to update move ctor
 };
 
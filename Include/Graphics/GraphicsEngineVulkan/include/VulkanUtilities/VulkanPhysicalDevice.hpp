@@ -49,6 +49,7 @@ public:
         bool                                             Spirv15             = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
         VkPhysicalDeviceBufferDeviceAddressFeaturesKHR   BufferDeviceAddress = {};
         VkPhysicalDeviceDescriptorIndexingFeaturesEXT    DescriptorIndexing  = {};
+        bool                                             DrawIndirectCount   = false; // VK_KHR_draw_indirect_count has no feature structure
     };
 
     struct ExtensionProperties
@@ -51,6 +51,12 @@ static const INTERFACE_ID IID_BufferVk =
 DILIGENT_BEGIN_INTERFACE(IBufferVk, IBuffer)
 {
     /// Returns a vulkan buffer handle
+
+    /// \remarks When memory defragmentation is enabled (see EngineVkCreateInfo::DefragmentationBytesPerFrame),
+    ///          the handle of a default or immutable buffer that is only bound as a vertex, index or
+    ///          indirect argument buffer may change in IDeviceContext::FinishFrame(). Such handles
+    ///          must be queried again after every frame and must not be used in commands recorded
+    ///          outside of the engine across frames.
     VIRTUAL VkBuffer METHOD(GetVkBuffer)(THIS) CONST PURE;
 
     /// Sets vulkan access flags
@@ -39,6 +39,29 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextVk =
     {0x72aeb1ba, 0xc6ad, 0x42ec, {0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb}};
 
+/// Pipeline barrier statistics of a Vulkan device context.
+
+/// Image and buffer barriers requested by state transitions are not recorded immediately, but are
+/// accumulated and issued by a single vkCmdPipelineBarrier before the next command that requires them.
+struct BarrierStatsVk
+{
+    /// The number of image memory barriers requested by state transitions.
+    Uint32 NumImageBarriers    DEFAULT_INITIALIZER(0);
+
+    /// The number of buffer memory barriers requested by state transitions.
+    Uint32 NumBufferBarriers   DEFAULT_INITIALIZER(0);
+
+    /// The number of acceleration structure memory barriers (these are not batched).
+    Uint32 NumMemoryBarriers   DEFAULT_INITIALIZER(0);
+
+    /// The number of vkCmdPipelineBarrier commands actually recorded.
+    Uint32 NumPipelineBarriers DEFAULT_INITIALIZER(0);
+
+    /// The number of barriers that were merged into a pipeline barrier together with other barriers.
+    Uint32 NumMergedBarriers   DEFAULT_INITIALIZER(0);
+};
+typedef struct BarrierStatsVk BarrierStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -89,6 +112,21 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
 
     /// Unlocks the command queue that was previously locked by IDeviceContextVk::LockCommandQueue().
     VIRTUAL void METHOD(UnlockCommandQueue)(THIS) PURE;
+
+    /// Returns the pipeline barrier statistics accumulated since the context was created.
+    VIRTUAL BarrierStatsVk METHOD(GetBarrierStats)(THIS) CONST PURE;
+
+    /// Generates a mipmap chain where every texel is the maximum of the texels it covers in the previous level.
+
+    /// \param [in] pTextureView - Texture view to generate mip maps for. The view must cover at least two mip levels.
+    ///
+    /// \remarks This is the reduction required to build a hierarchical depth buffer (Hi-Z) for occlusion
+    ///          culling: the depth stored in a mip texel is never closer than any depth it covers.
+    ///          The texture must be a 2D texture or texture array with a single-channel float format
+    ///          created with MISC_TEXTURE_FLAG_GENERATE_MIPS flag. The function uses the same compute
+    ///          shader as IDeviceContext::GenerateMips() and is subject to the same state rules.
+    VIRTUAL void METHOD(GenerateMaxReductionMips)(THIS_
+                                                  ITextureView* pTextureView) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -98,10 +136,12 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
-#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
-#    define IDeviceContextVk_LockCommandQueue(This)           CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,      This)
-#    define IDeviceContextVk_UnlockCommandQueue(This)         CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,    This)
+#    define IDeviceContextVk_TransitionImageLayout(This, ...)    CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout,    This, __VA_ARGS__)
+#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)      CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,      This, __VA_ARGS__)
+#    define IDeviceContextVk_LockCommandQueue(This)              CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,         This)
+#    define IDeviceContextVk_UnlockCommandQueue(This)            CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,       This)
+#    define IDeviceContextVk_GetBarrierStats(This)               CALL_IFACE_METHOD(DeviceContextVk, GetBarrierStats,          This)
+#    define IDeviceContextVk_GenerateMaxReductionMips(This, ...) CALL_IFACE_METHOD(DeviceContextVk, GenerateMaxReductionMips, This, __VA_ARGS__)
 
 // clang-format on
 
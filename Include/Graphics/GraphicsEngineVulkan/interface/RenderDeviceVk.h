@@ -38,6 +38,28 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+/// Index of the descriptor set that holds the global bindless descriptor array.
+/// Unsized resource arrays in shaders are remapped to this set.
+static const Uint32 BINDLESS_DESCRIPTOR_SET_INDEX = 2;
+
+/// Special value returned by IRenderDeviceVk::RegisterBindlessResource() when the resource
+/// could not be added to the bindless descriptor set.
+static const Uint32 INVALID_BINDLESS_INDEX = ~0u;
+
+/// Describes a texture created by IRenderDeviceVk::CreateAliasedTextures().
+struct AliasedTextureDescVk
+{
+    /// Texture description. Usage must be USAGE_DEFAULT.
+    TextureDesc Desc;
+
+    /// Index of the first pass in the frame that accesses the texture.
+    Uint32 FirstPass DEFAULT_INITIALIZER(0);
+
+    /// Index of the last pass in the frame that accesses the texture.
+    Uint32 LastPass  DEFAULT_INITIALIZER(0);
+};
+typedef struct AliasedTextureDescVk AliasedTextureDescVk;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -150,6 +172,51 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                       const TopLevelASDesc REF   Desc,
                                                       RESOURCE_STATE             InitialState,
                                                       ITopLevelAS**              ppTLAS) PURE;
+
+    /// Adds a resource to the global bindless descriptor set
+
+    /// \param [in] pObject - Resource to register. Can be a texture view (SRV or UAV),
+    ///                       a structured or raw buffer view, or a sampler.
+    ///
+    /// \return Index of the resource in the bindless descriptor arrays, or INVALID_BINDLESS_INDEX
+    ///         if the resource could not be registered.
+    ///
+    /// \remarks Bindless descriptors must be enabled with EngineVkCreateInfo::EnableBindlessDescriptors.
+    ///          The same index is used for all descriptor arrays the resource is compatible with.
+    ///          Registering the same object twice returns the same index.
+    ///          The device keeps a strong reference to the object until it is unregistered.
+    VIRTUAL Uint32 METHOD(RegisterBindlessResource)(THIS_
+                                                    IDeviceObject* pObject) PURE;
+
+    /// Removes a resource from the global bindless descriptor set
+
+    /// \param [in] pObject - Resource previously registered with RegisterBindlessResource().
+    ///
+    /// \remarks The index is not recycled until all command buffers that may reference
+    ///          it have completed execution.
+    VIRTUAL void METHOD(UnregisterBindlessResource)(THIS_
+                                                    IDeviceObject* pObject) PURE;
+
+    /// Creates a set of textures that share device memory
+
+    /// \param [in]  NumTextures - Number of textures to create.
+    /// \param [in]  pDescs      - Array of NumTextures texture descriptions with lifetimes.
+    /// \param [out] ppTextures  - Array of NumTextures pointers to the memory locations where
+    ///                            the created textures will be written. If any texture can't be
+    ///                            created, all pointers are set to null.
+    ///
+    /// \remarks Textures whose [FirstPass, LastPass] ranges do not overlap may be placed in the same
+    ///          memory range, which reduces the memory footprint of chains of intermediate render targets.
+    ///          Contents of an aliased texture are undefined at the start of its lifetime: before the first
+    ///          access in every frame, the application must call ITexture::SetState(RESOURCE_STATE_UNDEFINED)
+    ///          and must then fully overwrite the texture, e.g. by clearing it or with ATTACHMENT_LOAD_OP_CLEAR.
+    ///          Textures created with MISC_TEXTURE_FLAG_TRANSIENT flag are aliased with each other only and
+    ///          use lazily allocated memory if the device supports it.
+    ///          Memory is released when all textures that share it have been released.
+    VIRTUAL void METHOD(CreateAliasedTextures)(THIS_
+                                               Uint32                      NumTextures,
+                                               const AliasedTextureDescVk* pDescs,
+                                               ITexture**                  ppTextures) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -169,6 +236,9 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
+#    define IRenderDeviceVk_RegisterBindlessResource(This, ...)       CALL_IFACE_METHOD(RenderDeviceVk, RegisterBindlessResource,       This, __VA_ARGS__)
+#    define IRenderDeviceVk_UnregisterBindlessResource(This, ...)     CALL_IFACE_METHOD(RenderDeviceVk, UnregisterBindlessResource,     This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateAliasedTextures(This, ...)          CALL_IFACE_METHOD(RenderDeviceVk, CreateAliasedTextures,          This, __VA_ARGS__)
 
 // clang-format on
 
@@ -39,6 +39,78 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_SwapChainVk =
     {0x22a39881, 0x5ec5, 0x4a9c, {0x83, 0x95, 0x90, 0x21, 0x5f, 0x4, 0xa5, 0xcc}};
 
+/// Vulkan presentation mode of a swap chain.
+DILIGENT_TYPED_ENUM(PRESENT_MODE_VK, Uint8)
+{
+    /// VK_PRESENT_MODE_FIFO_KHR if vertical sync is requested by ISwapChain::Present(),
+    /// and VK_PRESENT_MODE_MAILBOX_KHR otherwise.
+    PRESENT_MODE_VK_AUTO = 0,
+
+    /// Images are presented at vertical blanks. Never tears.
+    PRESENT_MODE_VK_FIFO,
+
+    /// Images are presented at vertical blanks, unless the frame missed the blank,
+    /// in which case it is presented immediately and may tear.
+    PRESENT_MODE_VK_FIFO_RELAXED,
+
+    /// The most recent image replaces the queued one and is presented at the next vertical blank. Never tears.
+    PRESENT_MODE_VK_MAILBOX,
+
+    /// Images are presented immediately. May tear, gives the lowest latency.
+    PRESENT_MODE_VK_IMMEDIATE
+};
+
+/// Frame pacing attributes of a Vulkan swap chain.
+struct FramePacingAttribsVk
+{
+    /// Presentation mode. If the mode is not supported by the surface,
+    /// the swap chain falls back to a supported one.
+    PRESENT_MODE_VK PresentMode DEFAULT_INITIALIZER(PRESENT_MODE_VK_AUTO);
+
+    /// The maximum number of frames that can be processed at the same time,
+    /// including the frame that is being recorded. 0 means that the number
+    /// is only limited by the number of swap chain images.
+
+    /// When the limit is set, ISwapChain::Present() waits until the GPU has finished the
+    /// frame that is MaxFramesInFlight frames behind before returning. This way the application
+    /// samples input for the next frame as late as possible. 1 gives the lowest input latency
+    /// at the cost of the CPU and GPU not working in parallel.
+    Uint32 MaxFramesInFlight DEFAULT_INITIALIZER(0);
+};
+typedef struct FramePacingAttribsVk FramePacingAttribsVk;
+
+/// Frame timings returned by ISwapChainVk::GetFrameTimings().
+
+/// All times are given in seconds.
+struct FrameTimingsVk
+{
+    /// The number of frames presented by the swap chain.
+    Uint64 FrameNumber DEFAULT_INITIALIZER(0);
+
+    /// CPU time between the last two ISwapChain::Present() calls.
+    Float32 FrameInterval DEFAULT_INITIALIZER(0);
+
+    /// CPU time the last ISwapChain::Present() spent waiting for the frame limit,
+    /// see FramePacingAttribsVk::MaxFramesInFlight.
+    Float32 FrameLatencyWait DEFAULT_INITIALIZER(0);
+
+    /// CPU time spent acquiring the next swap chain image.
+    Float32 AcquireTime DEFAULT_INITIALIZER(0);
+
+    /// CPU time spent in vkQueuePresentKHR.
+    Float32 PresentTime DEFAULT_INITIALIZER(0);
+
+    /// GPU time between acquiring the back buffer and presenting it for frame GPUTimeFrameNumber.
+    /// GPU time is only measured if DeviceFeatures::DurationQueries is enabled.
+    Float32 GPUTime DEFAULT_INITIALIZER(0);
+
+    /// The frame GPUTime was measured for. As the GPU lags behind the CPU, this
+    /// number is typically several frames smaller than FrameNumber.
+    /// 0 if no GPU time is available yet.
+    Uint64 GPUTimeFrameNumber DEFAULT_INITIALIZER(0);
+};
+typedef struct FrameTimingsVk FrameTimingsVk;
+
 #define DILIGENT_INTERFACE_NAME ISwapChainVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -51,6 +123,19 @@ DILIGENT_BEGIN_INTERFACE(ISwapChainVk, ISwapChain)
 {
     /// Returns a handle to the Vulkan swap chain object.
     VIRTUAL VkSwapchainKHR METHOD(GetVkSwapChain)(THIS) PURE;
+
+    /// Sets frame pacing attributes.
+
+    /// \remarks If the present mode changes, the Vulkan swap chain is recreated
+    ///          by the next ISwapChain::Present() call.
+    VIRTUAL void METHOD(SetFramePacing)(THIS_
+                                        const FramePacingAttribsVk REF Attribs) PURE;
+
+    /// Returns current frame pacing attributes.
+    VIRTUAL const FramePacingAttribsVk REF METHOD(GetFramePacing)(THIS) CONST PURE;
+
+    /// Returns the timings of the most recent frame.
+    VIRTUAL FrameTimingsVk METHOD(GetFrameTimings)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -60,7 +145,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define ISwapChainVk_GetVkSwapChain(This)  CALL_IFACE_METHOD(SwapChainVk, GetVkSwapChain, This)
+#    define ISwapChainVk_GetVkSwapChain(This)      CALL_IFACE_METHOD(SwapChainVk, GetVkSwapChain,  This)
+#    define ISwapChainVk_SetFramePacing(This, ...) CALL_IFACE_METHOD(SwapChainVk, SetFramePacing,  This, __VA_ARGS__)
+#    define ISwapChainVk_GetFramePacing(This)      CALL_IFACE_METHOD(SwapChainVk, GetFramePacing,  This)
+#    define ISwapChainVk_GetFrameTimings(This)     CALL_IFACE_METHOD(SwapChainVk, GetFrameTimings, This)
 
 // clang-format on
 
@@ -10,6 +10,12 @@
 "#define IMG_FORMAT rgba8\n"
 "#endif\n"
 "\n"
+"// When set, every texel of a mip level is the maximum of the source texels it covers\n"
+"// instead of their average. This is used to build hierarchical depth (Hi-Z) pyramids.\n"
+"#ifndef REDUCTION_MAX\n"
+"#define REDUCTION_MAX 0\n"
+"#endif\n"
+"\n"
 "layout(IMG_FORMAT) uniform writeonly image2DArray OutMip0;\n"
 "layout(IMG_FORMAT) uniform writeonly image2DArray OutMip1;\n"
 "layout(IMG_FORMAT) uniform writeonly image2DArray OutMip2;\n"
@@ -57,6 +63,20 @@
 "    return x < 0.0031308 ? 12.92 * x : 1.13005 * sqrt(abs(x - 0.00228)) - 0.13448 * x + 0.005719;\n"
 "}\n"
 "\n"
+"vec4 Reduce4(vec4 Src1, vec4 Src2, vec4 Src3, vec4 Src4)\n"
+"{\n"
+"#if REDUCTION_MAX\n"
+"    return max(max(Src1, Src2), max(Src3, Src4));\n"
+"#else\n"
+"    return 0.25 * (Src1 + Src2 + Src3 + Src4);\n"
+"#endif\n"
+"}\n"
+"\n"
+"vec4 FetchSrc(ivec2 Location, ivec2 MaxLocation, int ArraySlice)\n"
+"{\n"
+"    return texelFetch(SrcMip, ivec3(min(Location, MaxLocation), ArraySlice), 0);\n"
+"}\n"
+"\n"
 "vec4 PackColor(vec4 Linear)\n"
 "{\n"
 "#if CONVERT_TO_SRGB\n"
@@ -99,6 +119,28 @@
 "    float fSrcMipLevel = 0.0; // SrcMip is the view of the source mip level\n"
 "    if (IsValidThread)\n"
 "    {\n"
+"#if REDUCTION_MAX\n"
+"        // Filtering would average the texels, so the source texels are fetched directly.\n"
+"        // When a source dimension is odd, the last row or column of the source level is\n"
+"        // covered by two destination texels, which keeps the reduction conservative.\n"
+"        ivec2 SrcXY = ivec2(GlobalInd.xy) * 2;\n"
+"        ivec2 MaxXY = SrcMipSize.xy - ivec2(1, 1);\n"
+"        Src1 = Reduce4(FetchSrc(SrcXY,               MaxXY, ArraySlice),\n"
+"                       FetchSrc(SrcXY + ivec2(1, 0), MaxXY, ArraySlice),\n"
+"                       FetchSrc(SrcXY + ivec2(0, 1), MaxXY, ArraySlice),\n"
+"                       FetchSrc(SrcXY + ivec2(1, 1), MaxXY, ArraySlice));\n"
+"#   if NON_POWER_OF_TWO == 1 || NON_POWER_OF_TWO == 3\n"
+"        Src1 = max(Src1, max(FetchSrc(SrcXY + ivec2(2, 0), MaxXY, ArraySlice),\n"
+"                             FetchSrc(SrcXY + ivec2(2, 1), MaxXY, ArraySlice)));\n"
+"#   endif\n"
+"#   if NON_POWER_OF_TWO == 2 || NON_POWER_OF_TWO == 3\n"
+"        Src1 = max(Src1, max(FetchSrc(SrcXY + ivec2(0, 2), MaxXY, ArraySlice),\n"
+"                             FetchSrc(SrcXY + ivec2(1, 2), MaxXY, ArraySlice)));\n"
+"#   endif\n"
+"#   if NON_POWER_OF_TWO == 3\n"
+"        Src1 = max(Src1, FetchSrc(SrcXY + ivec2(2, 2), MaxXY, ArraySlice));\n"
+"#   endif\n"
+"#else\n"
 "        // One bilinear sample is insufficient when scaling down by more than 2x.\n"
 "        // You will slightly undersample in the case where the source dimension\n"
 "        // is odd.  This is why it\'s a really good idea to only generate mips on\n"
@@ -136,6 +178,7 @@
 "        Src1 += textureLod(SrcMip, vec3(UV1 + vec2(Off.x, Off.y), ArraySlice), fSrcMipLevel);\n"
 "        Src1 *= 0.25;\n"
 "#endif\n"
+"#endif // REDUCTION_MAX\n"
 "\n"
 "        imageStore(OutMip0, ivec3(GlobalInd.xy, ArraySlice), PackColor(Src1));\n"
 "    }\n"
@@ -165,7 +208,7 @@
 "            vec4 Src2 = LoadColor(LocalInd + 0x01u);\n"
 "            vec4 Src3 = LoadColor(LocalInd + 0x08u);\n"
 "            vec4 Src4 = LoadColor(LocalInd + 0x09u);\n"
-"            Src1 = 0.25 * (Src1 + Src2 + Src3 + Src4);\n"
+"            Src1 = Reduce4(Src1, Src2, Src3, Src4);\n"
 "\n"
 "            imageStore(OutMip1, ivec3(GlobalInd.xy / 2u, ArraySlice), PackColor(Src1));\n"
 "            StoreColor(LocalInd, Src1);\n"
@@ -185,7 +228,7 @@
 "            vec4 Src2 = LoadColor(LocalInd + 0x02u);\n"
 "            vec4 Src3 = LoadColor(LocalInd + 0x10u);\n"
 "            vec4 Src4 = LoadColor(LocalInd + 0x12u);\n"
-"            Src1 = 0.25 * (Src1 + Src2 + Src3 + Src4);\n"
+"            Src1 = Reduce4(Src1, Src2, Src3, Src4);\n"
 "\n"
 "            imageStore(OutMip2, ivec3(GlobalInd.xy / 4u, ArraySlice), PackColor(Src1));\n"
 "            StoreColor(LocalInd, Src1);\n"
@@ -206,7 +249,7 @@
 "            vec4 Src2 = LoadColor(LocalInd + 0x04u);\n"
 "            vec4 Src3 = LoadColor(LocalInd + 0x20u);\n"
 "            vec4 Src4 = LoadColor(LocalInd + 0x24u);\n"
-"            Src1 = 0.25 * (Src1 + Src2 + Src3 + Src4);\n"
+"            Src1 = Reduce4(Src1, Src2, Src3, Src4);\n"
 "\n"
 "            imageStore(OutMip3, ivec3(GlobalInd.xy / 8u, ArraySlice), PackColor(Src1));\n"
 "        }\n"
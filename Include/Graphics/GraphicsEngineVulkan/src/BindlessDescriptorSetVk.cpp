@@ -0,0 +1,394 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <array>
+#include <algorithm>
+
+#include "BindlessDescriptorSetVk.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "TextureViewVkImpl.hpp"
+#include "BufferViewVkImpl.hpp"
+#include "BufferVkImpl.hpp"
+#include "SamplerVkImpl.hpp"
+#include "ShaderResourceCacheVk.hpp"
+
+namespace Diligent
+{
+
+static constexpr VkDescriptorType BindlessDescriptorTypes[] =
+    {
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, // BINDING_COMBINED_IMAGE_SAMPLER
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          // BINDING_SAMPLED_IMAGE
+        VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          // BINDING_STORAGE_IMAGE
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         // BINDING_STORAGE_BUFFER
+        VK_DESCRIPTOR_TYPE_SAMPLER                 // BINDING_SAMPLER
+};
+static_assert(_countof(BindlessDescriptorTypes) == BindlessDescriptorSetVk::BINDING_COUNT, "Please update the descriptor type array");
+
+bool BindlessDescriptorSetVk::IsSupported(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& DescrIndexingFeats)
+{
+    // clang-format off
+    return DescrIndexingFeats.runtimeDescriptorArray                             != VK_FALSE &&
+           DescrIndexingFeats.descriptorBindingPartiallyBound                    != VK_FALSE &&
+           DescrIndexingFeats.descriptorBindingUpdateUnusedWhilePending          != VK_FALSE &&
+           DescrIndexingFeats.descriptorBindingSampledImageUpdateAfterBind       != VK_FALSE &&
+           DescrIndexingFeats.descriptorBindingStorageImageUpdateAfterBind       != VK_FALSE &&
+           DescrIndexingFeats.descriptorBindingStorageBufferUpdateAfterBind      != VK_FALSE &&
+           DescrIndexingFeats.shaderSampledImageArrayNonUniformIndexing          != VK_FALSE &&
+           DescrIndexingFeats.shaderStorageBufferArrayNonUniformIndexing         != VK_FALSE;
+    // clang-format on
+}
+
+Uint32 BindlessDescriptorSetVk::GetBinding(SPIRVShaderResourceAttribs::ResourceType Type)
+{
+    using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
+    switch (Type)
+    {
+        // clang-format off
+        case ResourceType::SampledImage:    return BINDING_COMBINED_IMAGE_SAMPLER;
+        case ResourceType::SeparateImage:   return BINDING_SAMPLED_IMAGE;
+        case ResourceType::StorageImage:    return BINDING_STORAGE_IMAGE;
+        case ResourceType::ROStorageBuffer: return BINDING_STORAGE_BUFFER;
+        case ResourceType::RWStorageBuffer: return BINDING_STORAGE_BUFFER;
+        case ResourceType::SeparateSampler: return BINDING_SAMPLER;
+        // clang-format on
+        default:
+            return InvalidBinding;
+    }
+}
+
+BindlessDescriptorSetVk::BindlessDescriptorSetVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 DescriptorCount) :
+    m_DeviceVkImpl{DeviceVkImpl}
+{
+    const auto& LogicalDevice = DeviceVkImpl.GetLogicalDevice();
+    const auto& Limits        = DeviceVkImpl.GetPhysicalDevice().GetExtProperties().DescriptorIndexing;
+
+    // Combined image samplers count against both sampled image and sampler limits
+    // clang-format off
+    m_DescriptorCount = std::min({DescriptorCount,
+                                  Limits.maxPerStageDescriptorUpdateAfterBindSampledImages / 2,
+                                  Limits.maxPerStageDescriptorUpdateAfterBindSamplers      / 2,
+                                  Limits.maxPerStageDescriptorUpdateAfterBindStorageImages,
+                                  Limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                                  Limits.maxUpdateAfterBindDescriptorsInAllPools / BINDING_COUNT});
+    // clang-format on
+    if (m_DescriptorCount < DescriptorCount)
+    {
+        LOG_WARNING_MESSAGE("Requested bindless descriptor count (", DescriptorCount, ") exceeds device limits. The count is clamped to ", m_DescriptorCount);
+    }
+
+    std::array<VkDescriptorSetLayoutBinding, BINDING_COUNT> Bindings     = {};
+    std::array<VkDescriptorBindingFlagsEXT, BINDING_COUNT>  BindingFlags = {};
+    std::array<VkDescriptorPoolSize, BINDING_COUNT>         PoolSizes    = {};
+    for (Uint32 b = 0; b < BINDING_COUNT; ++b)
+    {
+        Bindings[b].binding            = b;
+        Bindings[b].descriptorType     = BindlessDescriptorTypes[b];
+        Bindings[b].descriptorCount    = m_DescriptorCount;
+        Bindings[b].stageFlags         = VK_SHADER_STAGE_ALL;
+        Bindings[b].pImmutableSamplers = nullptr;
+
+        // Not every index is populated in every array, descriptors are written while the set
+        // is bound in command buffers that are being recorded or are pending execution.
+        BindingFlags[b] =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        PoolSizes[b].type            = BindlessDescriptorTypes[b];
+        PoolSizes[b].descriptorCount = m_DescriptorCount;
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+
+    BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext         = nullptr;
+    BindingFlagsCI.bindingCount  = static_cast<uint32_t>(BindingFlags.size());
+    BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo LayoutCI = {};
+
+    LayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    LayoutCI.pNext        = &BindingFlagsCI;
+    LayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    LayoutCI.bindingCount = static_cast<uint32_t>(Bindings.size());
+    LayoutCI.pBindings    = Bindings.data();
+    m_vkLayout            = LogicalDevice.CreateDescriptorSetLayout(LayoutCI, "Bindless descriptor set layout");
+
+    LayoutCI.pNext        = nullptr;
+    LayoutCI.flags        = 0;
+    LayoutCI.bindingCount = 0;
+    LayoutCI.pBindings    = nullptr;
+    m_vkEmptyLayout       = LogicalDevice.CreateDescriptorSetLayout(LayoutCI, "Empty descriptor set layout");
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+
+    PoolCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext         = nullptr;
+    PoolCI.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets       = 1;
+    PoolCI.poolSizeCount = static_cast<uint32_t>(PoolSizes.size());
+    PoolCI.pPoolSizes    = PoolSizes.data();
+    m_vkPool             = LogicalDevice.CreateDescriptorPool(PoolCI, "Bindless descriptor pool");
+
+    VkDescriptorSetAllocateInfo AllocInfo = {};
+
+    AllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    AllocInfo.pNext              = nullptr;
+    AllocInfo.descriptorPool     = m_vkPool;
+    AllocInfo.descriptorSetCount = 1;
+    AllocInfo.pSetLayouts        = &m_vkLayout;
+    m_vkSet                      = LogicalDevice.AllocateVkDescriptorSet(AllocInfo, "Bindless descriptor set");
+    if (m_vkSet == VK_NULL_HANDLE)
+        LOG_ERROR_AND_THROW("Failed to allocate bindless descriptor set");
+}
+
+BindlessDescriptorSetVk::~BindlessDescriptorSetVk()
+{
+    VERIFY(m_vkPool == VK_NULL_HANDLE, "Bindless descriptor set has not been destroyed. Did you forget to call Destroy()?");
+    VERIFY(m_NumPendingIndices == 0, m_NumPendingIndices, " bindless indices are still in the release queues. "
+                                                          "The render device must release all stale resources before the set is destroyed.");
+}
+
+void BindlessDescriptorSetVk::Destroy()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    // Registered objects are released through the regular release queues
+    m_Resources.clear();
+
+    // The set is freed together with the pool
+    m_vkSet = VK_NULL_HANDLE;
+    m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(m_vkPool), ~Uint64{0});
+    m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(m_vkLayout), ~Uint64{0});
+    m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(m_vkEmptyLayout), ~Uint64{0});
+}
+
+Uint32 BindlessDescriptorSetVk::Register(IDeviceObject* pObject)
+{
+    DEV_CHECK_ERR(pObject != nullptr, "Object must not be null");
+    if (pObject == nullptr)
+        return INVALID_BINDLESS_INDEX;
+
+    using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
+
+    // Descriptor infos are collected before the index is allocated so that incompatible
+    // objects do not consume indices
+    std::array<VkDescriptorImageInfo, BINDING_COUNT> ImageInfos    = {};
+    VkDescriptorBufferInfo                           BufferInfo    = {};
+    std::array<bool, BINDING_COUNT>                  UsedBindings  = {};
+    const char*                                      ObjectName    = pObject->GetDesc().Name;
+    RefCntAutoPtr<IDeviceObject>                     pStrongObject = pObject;
+
+    if (RefCntAutoPtr<ITextureViewVk> pTexView{pObject, IID_TextureViewVk})
+    {
+        const auto ViewType = pTexView->GetDesc().ViewType;
+        if (ViewType == TEXTURE_VIEW_SHADER_RESOURCE)
+        {
+            ShaderResourceCacheVk::Resource SepImg{ResourceType::SeparateImage};
+            SepImg.pObject                      = pStrongObject;
+            ImageInfos[BINDING_SAMPLED_IMAGE]   = SepImg.GetImageDescriptorWriteInfo(false);
+            UsedBindings[BINDING_SAMPLED_IMAGE] = true;
+
+            if (pTexView->GetSampler() != nullptr)
+            {
+                ShaderResourceCacheVk::Resource SmplImg{ResourceType::SampledImage};
+                SmplImg.pObject                              = pStrongObject;
+                ImageInfos[BINDING_COMBINED_IMAGE_SAMPLER]   = SmplImg.GetImageDescriptorWriteInfo(false);
+                UsedBindings[BINDING_COMBINED_IMAGE_SAMPLER] = true;
+            }
+        }
+        else if (ViewType == TEXTURE_VIEW_UNORDERED_ACCESS)
+        {
+            ShaderResourceCacheVk::Resource StorageImg{ResourceType::StorageImage};
+            StorageImg.pObject                  = pStrongObject;
+            ImageInfos[BINDING_STORAGE_IMAGE]   = StorageImg.GetImageDescriptorWriteInfo(false);
+            UsedBindings[BINDING_STORAGE_IMAGE] = true;
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Texture view '", ObjectName, "' can't be registered in the bindless descriptor set: only shader resource and unordered access views are allowed");
+            return INVALID_BINDLESS_INDEX;
+        }
+    }
+    else if (RefCntAutoPtr<IBufferViewVk> pBuffView{pObject, IID_BufferViewVk})
+    {
+        const auto& BuffDesc = pBuffView->GetBuffer()->GetDesc();
+        if (BuffDesc.Mode != BUFFER_MODE_STRUCTURED && BuffDesc.Mode != BUFFER_MODE_RAW)
+        {
+            LOG_ERROR_MESSAGE("Buffer view '", ObjectName, "' can't be registered in the bindless descriptor set: only structured and raw buffers are allowed");
+            return INVALID_BINDLESS_INDEX;
+        }
+        if (BuffDesc.Usage == USAGE_DYNAMIC)
+        {
+            // Dynamic buffers are suballocated from the dynamic heap and require dynamic offsets
+            LOG_ERROR_MESSAGE("Buffer view '", ObjectName, "' can't be registered in the bindless descriptor set: dynamic buffers are not allowed");
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        ShaderResourceCacheVk::Resource SB{pBuffView->GetDesc().ViewType == BUFFER_VIEW_UNORDERED_ACCESS ? ResourceType::RWStorageBuffer : ResourceType::ROStorageBuffer};
+        SB.pObject                           = pStrongObject;
+        BufferInfo                           = SB.GetStorageBufferDescriptorWriteInfo();
+        UsedBindings[BINDING_STORAGE_BUFFER] = true;
+    }
+    else if (RefCntAutoPtr<ISamplerVk> pSampler{pObject, IID_SamplerVk})
+    {
+        ShaderResourceCacheVk::Resource SepSam{ResourceType::SeparateSampler};
+        SepSam.pObject                = pStrongObject;
+        ImageInfos[BINDING_SAMPLER]   = SepSam.GetSamplerDescriptorWriteInfo();
+        UsedBindings[BINDING_SAMPLER] = true;
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Object '", ObjectName, "' can't be registered in the bindless descriptor set: only texture views, buffer views and samplers are allowed");
+        return INVALID_BINDLESS_INDEX;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Resources.find(pObject);
+    if (it != m_Resources.end())
+        return it->second.Index;
+
+    Uint32 Index = INVALID_BINDLESS_INDEX;
+    if (!m_FreeIndices.empty())
+    {
+        Index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else if (m_NextIndex < m_DescriptorCount)
+    {
+        Index = m_NextIndex++;
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Unable to register '", ObjectName, "': all ", m_DescriptorCount, " bindless descriptors are in use. Increase EngineVkCreateInfo::BindlessDescriptorCount.");
+        return INVALID_BINDLESS_INDEX;
+    }
+
+    std::array<VkWriteDescriptorSet, BINDING_COUNT> Writes = {};
+
+    Uint32 NumWrites = 0;
+    for (Uint32 b = 0; b < BINDING_COUNT; ++b)
+    {
+        if (!UsedBindings[b])
+            continue;
+
+        auto& Write = Writes[NumWrites++];
+
+        Write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        Write.pNext           = nullptr;
+        Write.dstSet          = m_vkSet;
+        Write.dstBinding      = b;
+        Write.dstArrayElement = Index;
+        Write.descriptorCount = 1;
+        Write.descriptorType  = BindlessDescriptorTypes[b];
+        if (b == BINDING_STORAGE_BUFFER)
+            Write.pBufferInfo = &BufferInfo;
+        else
+            Write.pImageInfo = &ImageInfos[b];
+    }
+    m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(NumWrites, Writes.data(), 0, nullptr);
+
+    auto& Res   = m_Resources[pObject];
+    Res.Index   = Index;
+    Res.pObject = std::move(pStrongObject);
+
+    return Index;
+}
+
+// Returns the index to the free list once the command buffers that may access it have completed.
+// The deleter keeps a raw pointer to the set, so the render device must release all stale
+// resources before it destroys the set (see ~RenderDeviceVkImpl()).
+class BindlessIndexDeleter
+{
+public:
+    // clang-format off
+    BindlessIndexDeleter(BindlessDescriptorSetVk&       _Owner,
+                         Uint32                         _Index,
+                         RefCntAutoPtr<IDeviceObject>&& _pObject) noexcept :
+        Owner   {&_Owner             },
+        Index   {_Index              },
+        pObject {std::move(_pObject) }
+    {}
+
+    BindlessIndexDeleter            (const BindlessIndexDeleter&) = delete;
+    BindlessIndexDeleter& operator= (const BindlessIndexDeleter&) = delete;
+    BindlessIndexDeleter& operator= (      BindlessIndexDeleter&&)= delete;
+
+    BindlessIndexDeleter(BindlessIndexDeleter&& rhs)noexcept :
+        Owner   {rhs.Owner              },
+        Index   {rhs.Index              },
+        pObject {std::move(rhs.pObject) }
+    {
+        rhs.Owner = nullptr;
+    }
+    // clang-format on
+
+    ~BindlessIndexDeleter()
+    {
+        if (Owner != nullptr)
+        {
+            Owner->FreeIndex(Index);
+        }
+    }
+
+private:
+    BindlessDescriptorSetVk*     Owner;
+    Uint32                       Index;
+    RefCntAutoPtr<IDeviceObject> pObject;
+};
+
+void BindlessDescriptorSetVk::Unregister(IDeviceObject* pObject)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Resources.find(pObject);
+    if (it == m_Resources.end())
+    {
+        LOG_WARNING_MESSAGE("Object is not registered in the bindless descriptor set");
+        return;
+    }
+
+    // Command buffers that are pending execution may still access the descriptor,
+    // so the index can only be reused once they complete.
+    m_DeviceVkImpl.SafeReleaseDeviceObject(BindlessIndexDeleter{*this, it->second.Index, std::move(it->second.pObject)}, ~Uint64{0});
+    m_Resources.erase(it);
+    ++m_NumPendingIndices;
+}
+
+void BindlessDescriptorSetVk::FreeIndex(Uint32 Index)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    m_FreeIndices.push_back(Index);
+    VERIFY_EXPR(m_NumPendingIndices > 0);
+    --m_NumPendingIndices;
+}
+
+} // namespace Diligent
@@ -213,6 +213,7 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                                                                     // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+        m_VkUsageFlags = VkBuffCI.usage;
 
         VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
 
@@ -264,6 +265,17 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+        // Vertex, index and indirect argument buffers are never referenced by descriptors or views,
+        // so their VkBuffer can be replaced without invalidating anything but the context state.
+        constexpr Uint32 RelocatableBindFlags = BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER | BIND_INDIRECT_DRAW_ARGS;
+        if (pRenderDeviceVk->IsDefragmentationEnabled() &&
+            (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+            (m_Desc.BindFlags & ~RelocatableBindFlags) == 0 &&
+            !m_MemoryAllocation.Page->IsDedicated())
+        {
+            m_IsRelocatable = true;
+        }
+
         bool           bInitializeBuffer = (pBuffData != nullptr && pBuffData->pData != nullptr && pBuffData->DataSize > 0);
         RESOURCE_STATE InitialState      = RESOURCE_STATE_UNDEFINED;
         if (bInitializeBuffer)
@@ -373,6 +385,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
 
         SetState(InitialState);
+
+        if (m_IsRelocatable)
+            pRenderDeviceVk->RegisterRelocatableBuffer(this);
     }
 
     VERIFY_EXPR(IsInKnownState());
@@ -403,6 +418,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
 BufferVkImpl::~BufferVkImpl()
 {
+    if (m_IsRelocatable)
+        m_pDevice->UnregisterRelocatableBuffer(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.CommandQueueMask);
@@ -26,8 +26,10 @@
  */
 
 #include "pch.h"
+#include <new>
 #include "DescriptorPoolManager.hpp"
 #include "RenderDeviceVkImpl.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -36,8 +38,8 @@ void DescriptorSetAllocation::Release()
 {
     if (Set != VK_NULL_HANDLE)
     {
-        VERIFY_EXPR(DescrSetAllocator != nullptr && Pool != VK_NULL_HANDLE);
-        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask);
+        VERIFY_EXPR(DescrSetAllocator != nullptr && pPoolNode != nullptr);
+        DescrSetAllocator->FreeDescriptorSet(Set, pPoolNode, CmdQueueMask);
 
         Reset();
     }
@@ -100,25 +102,100 @@ DescriptorPoolManager::DescriptorPoolManager(RenderDeviceVkImpl&               D
 DescriptorPoolManager::~DescriptorPoolManager()
 {
     DEV_CHECK_ERR(m_AllocatedPoolCounter == 0, "Not all allocated descriptor pools are returned to the pool manager");
-    LOG_INFO_MESSAGE(m_PoolName, " stats: allocated ", m_Pools.size(), " pool(s)");
+    LOG_INFO_MESSAGE(m_PoolName, " stats: allocated ", m_NumNodes.load(), " pool(s)");
+}
+
+DescriptorPoolNode* DescriptorPoolManager::GetNode(Uint32 Index) const
+{
+    const auto Block  = PlatformMisc::GetMSB(Index / FirstNodeBlockSize + 1);
+    const auto Offset = Index - FirstNodeBlockSize * ((1u << Block) - 1u);
+    VERIFY_EXPR(Block < MaxNodeBlocks && m_NodeBlocks[Block]);
+    return m_NodeBlocks[Block][Offset].get();
+}
+
+DescriptorPoolNode* DescriptorPoolManager::CreatePoolNode(VulkanUtilities::DescriptorPoolWrapper&& Pool) noexcept
+{
+    std::lock_guard<std::mutex> Lock{m_NodeCreationMutex};
+
+    const auto Index = m_NumNodes.load();
+    const auto Block = PlatformMisc::GetMSB(Index / FirstNodeBlockSize + 1);
+    if (Block >= MaxNodeBlocks)
+    {
+        LOG_ERROR_MESSAGE(m_PoolName, ": the number of descriptor pools exceeds the maximum allowed count");
+        return nullptr;
+    }
+
+    auto& pBlock = m_NodeBlocks[Block];
+    if (!pBlock)
+    {
+        // Existing blocks are never reallocated, so other threads may keep reading them
+        pBlock.reset(new (std::nothrow) std::unique_ptr<DescriptorPoolNode>[FirstNodeBlockSize << Block]);
+        if (!pBlock)
+        {
+            LOG_ERROR_MESSAGE(m_PoolName, ": failed to allocate descriptor pool node block");
+            return nullptr;
+        }
+    }
+
+    auto& pNode = pBlock[Index - FirstNodeBlockSize * ((1u << Block) - 1u)];
+    pNode.reset(new (std::nothrow) DescriptorPoolNode{Index});
+    if (!pNode)
+    {
+        LOG_ERROR_MESSAGE(m_PoolName, ": failed to allocate descriptor pool node");
+        return nullptr;
+    }
+    pNode->Pool = std::move(Pool);
+
+    // Node pointer is published to other threads by the release operation in PushNode()
+    m_NumNodes.store(Index + 1);
+    return pNode.get();
+}
+
+void DescriptorPoolManager::PushNode(std::atomic<Uint64>& ListHead, DescriptorPoolNode* pNode)
+{
+    VERIFY_EXPR(pNode != nullptr && pNode->Index < m_NumNodes.load(std::memory_order_relaxed));
+
+    auto   Head    = ListHead.load(std::memory_order_acquire);
+    Uint64 NewHead = 0;
+    do
+    {
+        pNode->NextFree.store(static_cast<Uint32>(Head), std::memory_order_relaxed);
+        const auto Tag = static_cast<Uint32>(Head >> 32) + 1;
+        NewHead        = (Uint64{Tag} << 32) | Uint64{pNode->Index + 1};
+    } while (!ListHead.compare_exchange_weak(Head, NewHead, std::memory_order_release, std::memory_order_acquire));
+}
+
+DescriptorPoolNode* DescriptorPoolManager::PopNode(std::atomic<Uint64>& ListHead)
+{
+    auto Head = ListHead.load(std::memory_order_acquire);
+    while (static_cast<Uint32>(Head) != 0)
+    {
+        auto* pNode = GetNode(static_cast<Uint32>(Head) - 1);
+        VERIFY_EXPR(pNode != nullptr);
+        const auto Next    = pNode->NextFree.load(std::memory_order_relaxed);
+        const auto Tag     = static_cast<Uint32>(Head >> 32) + 1;
+        const auto NewHead = (Uint64{Tag} << 32) | Uint64{Next};
+        // If another thread has modified the list since Head was read, the tag will not match
+        if (ListHead.compare_exchange_weak(Head, NewHead, std::memory_order_acquire, std::memory_order_acquire))
+            return pNode;
+    }
+    return nullptr;
 }
 
 VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::GetPool(const char* DebugName)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPoolCounter;
 #endif
-    if (m_Pools.empty())
+    auto* pNode = PopNode(m_FreeNodes);
+    if (pNode == nullptr)
         return CreateDescriptorPool(DebugName);
-    else
-    {
-        auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
-        auto  Pool          = std::move(m_Pools.front());
-        VulkanUtilities::SetDescriptorPoolName(LogicalDevice.GetVkDevice(), Pool, DebugName);
-        m_Pools.pop_front();
-        return Pool;
-    }
+
+    auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+    auto  Pool          = std::move(pNode->Pool);
+    VulkanUtilities::SetDescriptorPoolName(LogicalDevice.GetVkDevice(), Pool, DebugName);
+    PushNode(m_EmptyNodes, pNode);
+    return Pool;
 }
 
 void DescriptorPoolManager::DisposePool(VulkanUtilities::DescriptorPoolWrapper&& Pool, Uint64 QueueMask)
@@ -163,9 +240,19 @@ void DescriptorPoolManager::DisposePool(VulkanUtilities::DescriptorPoolWrapper&&
 
 void DescriptorPoolManager::FreePool(VulkanUtilities::DescriptorPoolWrapper&& Pool)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    // The pool is not referenced by anyone else at this point
     m_DeviceVkImpl.GetLogicalDevice().ResetDescriptorPool(Pool);
-    m_Pools.emplace_back(std::move(Pool));
+
+    auto* pNode = PopNode(m_EmptyNodes);
+    if (pNode != nullptr)
+        pNode->Pool = std::move(Pool);
+    else
+        pNode = CreatePoolNode(std::move(Pool));
+
+    // This method is called from the release queue and must not throw. If no node
+    // could be created, the pool is destroyed together with the deleter.
+    if (pNode != nullptr)
+        PushNode(m_FreeNodes, pNode);
 #ifdef DILIGENT_DEVELOPMENT
     --m_AllocatedPoolCounter;
 #endif
@@ -195,49 +282,75 @@ DescriptorSetAllocator::~DescriptorSetAllocator()
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
 }
 
+static Uint32 GetThreadCacheIndex(Uint32 NumThreadCaches)
+{
+    static std::atomic<Uint32> NextThreadId{0};
+    thread_local const Uint32  ThreadId = NextThreadId.fetch_add(1);
+    return ThreadId % NumThreadCaches;
+}
+
 DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
-    // Descriptor pools are externally synchronized, meaning that the application must not allocate
-    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto& Cache = m_ThreadCaches[GetThreadCacheIndex(NumThreadCaches)];
+
+    std::lock_guard<std::mutex> CacheLock{Cache.Mutex};
 
     const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
-    // Try all pools starting from the frontmost
-    for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
+    while (true)
     {
-        auto& Pool = *it;
-        auto  Set  = AllocateDescriptorSet(LogicalDevice, Pool, SetLayout, DebugName);
-        if (Set != VK_NULL_HANDLE)
+        if (auto* pNode = Cache.pNode)
         {
-            // Move the pool to the front
-            if (it != m_Pools.begin())
-            {
-                std::swap(*it, m_Pools.front());
-            }
+            // Descriptor pools are externally synchronized, meaning that the application must not allocate
+            // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+            std::lock_guard<std::mutex> PoolLock{pNode->Mutex};
+            VERIFY_EXPR(pNode->State == DescriptorPoolNode::STATE::Owned);
 
+            auto Set = AllocateDescriptorSet(LogicalDevice, pNode->Pool, SetLayout, DebugName);
+            if (Set != VK_NULL_HANDLE)
+            {
 #ifdef DILIGENT_DEVELOPMENT
-            ++m_AllocatedSetCounter;
+                ++m_AllocatedSetCounter;
 #endif
-            return {Set, Pool, CommandQueueMask, *this};
+                return {Set, pNode, CommandQueueMask, *this};
+            }
+
+            // The pool is exhausted. It will be put back to the free-pool
+            // list when one of its descriptor sets is released.
+            pNode->State = DescriptorPoolNode::STATE::Full;
+            Cache.pNode  = nullptr;
         }
+
+        auto* pFreeNode = PopNode(m_FreeNodes);
+        if (pFreeNode == nullptr)
+            break;
+
+        std::lock_guard<std::mutex> PoolLock{pFreeNode->Mutex};
+        VERIFY_EXPR(pFreeNode->State == DescriptorPoolNode::STATE::Free);
+        pFreeNode->State = DescriptorPoolNode::STATE::Owned;
+        Cache.pNode      = pFreeNode;
     }
 
     // Failed to allocate descriptor from existing pools -> create a new one
     LOG_INFO_MESSAGE("Allocated new descriptor pool");
-    m_Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+    auto* pNewNode = CreatePoolNode(CreateDescriptorPool("Descriptor pool"));
+    if (pNewNode == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate descriptor set from ", m_PoolName);
+    pNewNode->State = DescriptorPoolNode::STATE::Owned;
+    Cache.pNode     = pNewNode;
+
+    std::lock_guard<std::mutex> PoolLock{pNewNode->Mutex};
 
-    auto& NewPool = m_Pools.front();
-    auto  Set     = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
+    auto Set = AllocateDescriptorSet(LogicalDevice, pNewNode->Pool, SetLayout, DebugName);
     DEV_CHECK_ERR(Set != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedSetCounter;
 #endif
 
-    return {Set, NewPool, CommandQueueMask, *this};
+    return {Set, pNewNode, CommandQueueMask, *this};
 }
 
-void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
+void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, DescriptorPoolNode* pPoolNode, Uint64 QueueMask)
 {
     class DescriptorSetDeleter
     {
@@ -245,10 +358,10 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         // clang-format off
         DescriptorSetDeleter(DescriptorSetAllocator& _Allocator,
                              VkDescriptorSet         _Set,
-                             VkDescriptorPool        _Pool) : 
+                             DescriptorPoolNode*     _pPoolNode) : 
             Allocator {&_Allocator},
             Set       {_Set       },
-            Pool      {_Pool      }
+            pPoolNode {_pPoolNode }
         {}
 
         DescriptorSetDeleter             (const DescriptorSetDeleter&) = delete;
@@ -258,11 +371,11 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetDeleter(DescriptorSetDeleter&& rhs)noexcept : 
             Allocator {rhs.Allocator},
             Set       {rhs.Set      },
-            Pool      {rhs.Pool     }
+            pPoolNode {rhs.pPoolNode}
         {
             rhs.Allocator = nullptr;
             rhs.Set       = VK_NULL_HANDLE;
-            rhs.Pool      = VK_NULL_HANDLE;
+            rhs.pPoolNode = nullptr;
         }
         // clang-format on
 
@@ -270,8 +383,14 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
-                Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
+                std::lock_guard<std::mutex> Lock{pPoolNode->Mutex};
+                Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(pPoolNode->Pool, Set);
+                if (pPoolNode->State == DescriptorPoolNode::STATE::Full)
+                {
+                    // The pool now has space again, so make it available to all threads
+                    pPoolNode->State = DescriptorPoolNode::STATE::Free;
+                    Allocator->PushNode(Allocator->m_FreeNodes, pPoolNode);
+                }
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
 #endif
@@ -281,9 +400,9 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
     private:
         DescriptorSetAllocator* Allocator;
         VkDescriptorSet         Set;
-        VkDescriptorPool        Pool;
+        DescriptorPoolNode*     pPoolNode;
     };
-    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool}, QueueMask);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, pPoolNode}, QueueMask);
 }
 
 
@@ -30,6 +30,7 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
+#include "ShaderResourceBindingVkImpl.hpp"
 #include "TextureVkImpl.hpp"
 #include "BufferVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
@@ -143,6 +144,11 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
     {
         Flush();
     }
+    else if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE)
+    {
+        // The command buffer that is being recorded will never be submitted
+        m_pDevice->OnDeferredCmdBufferReleased();
+    }
 
     // For deferred contexts, m_SubmittedBuffersCmdQueueMask is reset to 0 after every call to FinishFrame().
     // In this case there are no resources to release, so there will be no issues.
@@ -231,7 +237,7 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
-    if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
+    if (IsRedundantPipelineState(pPipelineStateVk))
         return;
 
     if (m_State.NumCommands >= m_NumCommandsToFlush &&
@@ -272,6 +278,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 
     auto vkPipeline = pPipelineStateVk->GetVkPipeline();
 
+    VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
     switch (PSODesc.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -279,6 +286,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         {
             auto& GraphicsPipeline = pPipelineStateVk->GetGraphicsPipelineDesc();
             m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
             if (CommitStates)
             {
@@ -296,11 +304,13 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         case PIPELINE_TYPE_COMPUTE:
         {
             m_CommandBuffer.BindComputePipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
             break;
         }
         case PIPELINE_TYPE_RAY_TRACING:
         {
             m_CommandBuffer.BindRayTracingPipeline(vkPipeline);
+            BindPoint = VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR;
             break;
         }
         default:
@@ -308,6 +318,18 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     }
 
     m_DescrSetBindInfo.Reset();
+    m_pCommittedSRB.Release();
+
+    // The bindless set does not depend on shader resource bindings, so it is bound once
+    // per pipeline. Binding lower-numbered sets with the same layout later does not disturb it.
+    const auto& PipelineLayout = pPipelineStateVk->GetPipelineLayout();
+    if (PipelineLayout.IsUsingBindlessSet())
+    {
+        const auto* pBindlessSet = m_pDevice->GetBindlessDescriptorSet();
+        VERIFY_EXPR(pBindlessSet != nullptr);
+        VkDescriptorSet vkBindlessSet = pBindlessSet->GetVkDescriptorSet();
+        m_CommandBuffer.BindDescriptorSets(BindPoint, PipelineLayout.GetVkPipelineLayout(), BINDLESS_DESCRIPTOR_SET_INDEX, 1, &vkBindlessSet);
+    }
 }
 
 void DeviceContextVkImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
@@ -328,7 +350,66 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
         return;
 
+    if (pShaderResourceBinding != nullptr)
+    {
+        auto& ResourceCache = ValidatedCast<ShaderResourceBindingVkImpl>(pShaderResourceBinding)->GetResourceCache();
+        // The SRB itself must match too: the reference held by m_pCommittedSRB guarantees that a new SRB
+        // can't reuse the memory of the committed one and thus alias its resource cache address.
+        if (m_pCommittedSRB.RawPtr() == pShaderResourceBinding && m_DescrSetBindInfo.IsUpToDate(ResourceCache))
+        {
+            // Descriptor sets of this SRB are already bound and none of them has changed since,
+            // so there is no need to allocate and write a new dynamic descriptor set. Resources
+            // may have been used in other states though, so they still need to be transitioned.
+            if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            {
+                ResourceCache.TransitionResources<false>(this);
+            }
+#ifdef DILIGENT_DEVELOPMENT
+            else if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+            {
+                ResourceCache.TransitionResources<true>(this);
+            }
+#endif
+            return;
+        }
+    }
+
+    ++m_BindStats.ShaderResourcesIssued;
     m_pPipelineState->CommitAndTransitionShaderResources(pShaderResourceBinding, this, true, StateTransitionMode, &m_DescrSetBindInfo);
+    m_pCommittedSRB = pShaderResourceBinding;
+}
+
+void DeviceContextVkImpl::SetPushConstants(const void* pData, Uint32 Offset, Uint32 Size)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    if (!DvpVerifyPushConstantsArguments(pData, Offset, Size, m_pPipelineState ? m_pPipelineState->GetPipelineLayout().GetPushConstantsSize() : 0))
+        return;
+#endif
+
+    if (m_PushConstantsData.size() < Offset + Size)
+        m_PushConstantsData.resize(Offset + Size);
+    memcpy(m_PushConstantsData.data() + Offset, pData, Size);
+
+    EnsureVkCmdBuffer();
+    if (m_State.CommittedPushConstantsUpToDate)
+    {
+        const auto& Layout = m_pPipelineState->GetPipelineLayout();
+        m_CommandBuffer.PushConstants(Layout.GetVkPipelineLayout(), Layout.GetPushConstantsStages(), Offset, Size, pData);
+    }
+    else
+    {
+        // Values set before the command buffer was started are not in it yet
+        CommitPushConstants();
+    }
+}
+
+void DeviceContextVkImpl::CommitPushConstants()
+{
+    const auto& Layout    = m_pPipelineState->GetPipelineLayout();
+    const auto  BlockSize = std::min(static_cast<Uint32>(m_PushConstantsData.size()), Layout.GetPushConstantsSize());
+    if (BlockSize != 0)
+        m_CommandBuffer.PushConstants(Layout.GetVkPipelineLayout(), Layout.GetPushConstantsStages(), 0, BlockSize, m_PushConstantsData.data());
+    m_State.CommittedPushConstantsUpToDate = true;
 }
 
 void DeviceContextVkImpl::SetStencilRef(Uint32 StencilRef)
@@ -450,6 +531,9 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 
     EnsureVkCmdBuffer();
 
+    if (!m_State.CommittedPushConstantsUpToDate && !m_PushConstantsData.empty())
+        CommitPushConstants();
+
     if (!m_State.CommittedVBsUpToDate && m_pPipelineState->GetNumBufferSlotsUsed() > 0)
     {
         CommitVkVertexBuffers();
@@ -472,9 +556,11 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     {
         // First time we must always bind descriptor sets with dynamic offsets.
         // If there are no dynamic buffers bound in the resource cache, for all subsequent
-        // cals we do not need to bind the sets again.
+        // cals we do not need to bind the sets again, unless uniform buffer dynamic offsets
+        // have been changed through shader variables.
         if (!m_DescrSetBindInfo.DynamicDescriptorsBound ||
-            (m_DescrSetBindInfo.DynamicBuffersPresent && (Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT) == 0))
+            (m_DescrSetBindInfo.DynamicBuffersPresent && (Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT) == 0) ||
+            m_DescrSetBindInfo.DynamicOffsetsRevision != m_DescrSetBindInfo.pResourceCache->GetDynamicOffsetsRevision())
         {
             m_pPipelineState->BindDescriptorSetsWithDynamicOffsets(GetCommandBuffer(), m_ContextId, this, m_DescrSetBindInfo);
         }
@@ -587,6 +673,24 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     ++m_State.NumCommands;
 }
 
+void DeviceContextVkImpl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    if (!DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer))
+        return;
+
+    // Both buffers are read by the indirect command processor, so the count buffer
+    // requires the same state as the indirect draw arguments buffer
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCountBufferVk         = PrepareIndirectDrawAttribsBuffer(pCountBuffer, Attribs.CountBufferStateTransitionMode);
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    m_CommandBuffer.DrawIndexedIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset,
+                                             pCountBufferVk->GetVkBuffer(), pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset,
+                                             Attribs.MaxDrawCount, Attribs.IndirectDrawArgsStride);
+    ++m_State.NumCommands;
+}
+
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     if (!DvpVerifyDrawMeshArguments(Attribs))
@@ -617,13 +721,17 @@ void DeviceContextVkImpl::PrepareForDispatchCompute()
 {
     EnsureVkCmdBuffer();
 
+    if (!m_State.CommittedPushConstantsUpToDate && !m_PushConstantsData.empty())
+        CommitPushConstants();
+
     // Dispatch commands must be executed outside of render pass
     if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
         m_CommandBuffer.EndRenderPass();
 
     if (m_DescrSetBindInfo.DynamicOffsetCount != 0)
     {
-        if (!m_DescrSetBindInfo.DynamicDescriptorsBound || m_DescrSetBindInfo.DynamicBuffersPresent)
+        if (!m_DescrSetBindInfo.DynamicDescriptorsBound || m_DescrSetBindInfo.DynamicBuffersPresent ||
+            m_DescrSetBindInfo.DynamicOffsetsRevision != m_DescrSetBindInfo.pResourceCache->GetDynamicOffsetsRevision())
         {
             m_pPipelineState->BindDescriptorSetsWithDynamicOffsets(GetCommandBuffer(), m_ContextId, this, m_DescrSetBindInfo);
         }
@@ -643,9 +751,13 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 {
     EnsureVkCmdBuffer();
 
+    if (!m_State.CommittedPushConstantsUpToDate && !m_PushConstantsData.empty())
+        CommitPushConstants();
+
     if (m_DescrSetBindInfo.DynamicOffsetCount != 0)
     {
-        if (!m_DescrSetBindInfo.DynamicDescriptorsBound || m_DescrSetBindInfo.DynamicBuffersPresent)
+        if (!m_DescrSetBindInfo.DynamicDescriptorsBound || m_DescrSetBindInfo.DynamicBuffersPresent ||
+            m_DescrSetBindInfo.DynamicOffsetsRevision != m_DescrSetBindInfo.pResourceCache->GetDynamicOffsetsRevision())
         {
             m_pPipelineState->BindDescriptorSetsWithDynamicOffsets(GetCommandBuffer(), m_ContextId, this, m_DescrSetBindInfo);
         }
@@ -937,6 +1049,15 @@ void DeviceContextVkImpl::FinishFrame()
 
     VERIFY_EXPR(m_bIsDeferred || m_SubmittedBuffersCmdQueueMask == (Uint64{1} << m_CommandQueueId));
 
+    // Incrementally compact device-local memory. DefragmentMemory() does nothing while any deferred
+    // context is recording or any command list has not been executed, since their commands may
+    // reference the buffer handles that are replaced.
+    if (!m_bIsDeferred && m_pDevice->IsDefragmentationEnabled())
+    {
+        if (m_pDevice->DefragmentMemory(*this) != 0)
+            Flush();
+    }
+
     // Release resources used by the context during this frame.
 
     // Upload heap returns all allocated pages to the global memory manager.
@@ -989,7 +1110,8 @@ void DeviceContextVkImpl::Flush()
             m_State.NumCommands += m_QueryMgr->ResetStaleQueries(m_CommandBuffer);
         }
 
-        if (m_State.NumCommands != 0)
+        // Deferred barriers are not counted as commands, but must not be lost
+        if (m_State.NumCommands != 0 || m_CommandBuffer.HasPendingBarriers())
         {
             if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
             {
@@ -1032,6 +1154,7 @@ void DeviceContextVkImpl::Flush()
 
     m_State = ContextState{};
     m_DescrSetBindInfo.Reset();
+    m_pCommittedSRB.Release();
     m_CommandBuffer.Reset();
     m_pPipelineState    = nullptr;
     m_pActiveRenderPass = nullptr;
@@ -1045,7 +1168,12 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    // Buffers that are already bound still need to be transitioned, but
+    // the vertex buffers committed to the command buffer remain valid
+    const bool StreamsChanged = !IsRedundantVertexBufferBinding(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags);
+    if (StreamsChanged)
+        TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
@@ -1055,7 +1183,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                           "Setting vertex buffers (DeviceContextVkImpl::SetVertexBuffers)");
         }
     }
-    m_State.CommittedVBsUpToDate = false;
+
+    if (StreamsChanged)
+        m_State.CommittedVBsUpToDate = false;
 }
 
 void DeviceContextVkImpl::InvalidateState()
@@ -1068,18 +1198,24 @@ void DeviceContextVkImpl::InvalidateState()
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
     m_DescrSetBindInfo.Reset();
+    m_pCommittedSRB.Release();
     VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
     m_CommandBuffer.Reset();
 }
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = !IsRedundantIndexBufferBinding(pIndexBuffer, ByteOffset);
+    if (IndexBufferChanged)
+        TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
     if (m_pIndexBuffer)
     {
         TransitionOrVerifyBufferState(*m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, VK_ACCESS_INDEX_READ_BIT, "Binding buffer as index buffer  (DeviceContextVkImpl::SetIndexBuffer)");
     }
-    m_State.CommittedIBUpToDate = false;
+
+    if (IndexBufferChanged)
+        m_State.CommittedIBUpToDate = false;
 }
 
 
@@ -1811,6 +1947,19 @@ void DeviceContextVkImpl::GenerateMips(ITextureView* pTexView)
     m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsSRB);
 }
 
+void DeviceContextVkImpl::GenerateMaxReductionMips(ITextureView* pTexView)
+{
+    TDeviceContextBase::GenerateMips(pTexView);
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(pTexView->GetDesc().Format);
+        DEV_CHECK_ERR(FmtAttribs.NumComponents == 1 && FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT,
+                      "Max-reduction mips can only be generated for single-channel float textures");
+    }
+#endif
+    m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsSRB, true);
+}
+
 static VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
                                                 Uint32             BufferRowStrideInTexels,
                                                 const TextureDesc& TexDesc,
@@ -2082,6 +2231,8 @@ void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
         m_CommandBuffer.EndRenderPass();
     }
 
+    m_CommandBuffer.FlushBarriers();
+
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     auto err       = vkEndCommandBuffer(vkCmdBuff);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
@@ -2093,6 +2244,7 @@ void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
     m_CommandBuffer.Reset();
     m_State = ContextState{};
     m_DescrSetBindInfo.Reset();
+    m_pCommittedSRB.Release();
     m_pPipelineState = nullptr;
 
     InvalidateState();
@@ -2117,6 +2269,8 @@ void DeviceContextVkImpl::ExecuteCommandList(class ICommandList* pCommandList)
     pCmdListVk->Close(vkCmdBuff, pDeferredCtx);
     VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
     VERIFY_EXPR(pDeferredCtx);
+    // The command buffer is submitted below, before any buffer can be relocated
+    m_pDevice->OnDeferredCmdBufferReleased();
     VkSubmitInfo SubmitInfo = {};
 
     SubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -2346,9 +2500,20 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
     auto OldStages = ResourceStateFlagsToVkPipelineStageFlags(OldState, m_CommandBuffer.GetEnabledShaderStages());
     auto NewStages = ResourceStateFlagsToVkPipelineStageFlags(NewState, m_CommandBuffer.GetEnabledShaderStages());
 
-    if (((OldState & NewState) != NewState) || OldLayout != NewLayout || AfterWrite)
+    VkAccessFlags ExtraSrcAccess = 0;
+    if (OldState == RESOURCE_STATE_UNDEFINED && TextureVk.IsAliased())
+    {
+        // The memory may have been used by another aliased texture that started its lifetime
+        // earlier in the frame. All accesses to it must complete and all writes must be made
+        // available before the memory is reused. The access mask derived from the undefined
+        // layout is empty, so it has to be given explicitly.
+        OldStages      = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        ExtraSrcAccess = VK_ACCESS_MEMORY_WRITE_BIT;
+    }
+
+    if (((OldState & NewState) != NewState) || OldLayout != NewLayout || AfterWrite || ExtraSrcAccess != 0)
     {
-        m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange, OldStages, NewStages);
+        m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange, ExtraSrcAccess, OldStages, NewStages);
         if (UpdateTextureState)
         {
             TextureVk.SetState(NewState);
@@ -2455,6 +2620,96 @@ void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE
     }
 }
 
+VkDeviceSize DeviceContextVkImpl::RelocateBuffer(BufferVkImpl& BufferVk)
+{
+    VERIFY(!m_bIsDeferred, "Buffers can only be relocated by the immediate context");
+    VERIFY_EXPR(BufferVk.m_IsRelocatable && BufferVk.m_VulkanBuffer != VK_NULL_HANDLE);
+
+    // Barriers for the copy depend on the current buffer state
+    if (!BufferVk.IsInKnownState())
+        return 0;
+
+    const auto& LogicalDevice  = m_pDevice->GetLogicalDevice();
+    const auto& PhysicalDevice = m_pDevice->GetPhysicalDevice();
+    const auto& BuffDesc       = BufferVk.GetDesc();
+
+    VkBufferCreateInfo VkBuffCI    = {};
+    VkBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext                 = nullptr;
+    VkBuffCI.flags                 = 0;
+    VkBuffCI.size                  = BuffDesc.uiSizeInBytes;
+    VkBuffCI.usage                 = BufferVk.m_VkUsageFlags;
+    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffCI.queueFamilyIndexCount = 0;
+    VkBuffCI.pQueueFamilyIndices   = nullptr;
+
+    auto NewVkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, BuffDesc.Name);
+
+    auto MemReqs         = LogicalDevice.GetBufferMemoryRequirements(NewVkBuffer);
+    auto MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (MemoryTypeIndex == VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        LOG_ERROR_AND_THROW("Failed to find suitable memory type for buffer '", BuffDesc.Name, '\'');
+
+    auto NewAllocation = m_pDevice->AllocateMemory(MemReqs.size, MemReqs.alignment, MemoryTypeIndex);
+    VERIFY(!NewAllocation.Page->IsEvacuating(), "New allocation must not be placed into an evacuating page");
+
+    const auto AlignedOffset = Align(VkDeviceSize{NewAllocation.UnalignedOffset}, MemReqs.alignment);
+    auto       err           = LogicalDevice.BindBufferMemory(NewVkBuffer, NewAllocation.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+
+    // Contents of a buffer in undefined state do not need to be preserved
+    const auto State = BufferVk.GetState();
+    if (State != RESOURCE_STATE_UNDEFINED)
+    {
+        EnsureVkCmdBuffer();
+        const auto AccessFlags = ResourceStateFlagsToVkAccessFlags(State);
+        m_CommandBuffer.BufferMemoryBarrier(BufferVk.m_VulkanBuffer, AccessFlags, VK_ACCESS_TRANSFER_READ_BIT);
+        m_CommandBuffer.BufferMemoryBarrier(NewVkBuffer, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        VkBufferCopy CopyRegion = {};
+        CopyRegion.srcOffset    = 0;
+        CopyRegion.dstOffset    = 0;
+        CopyRegion.size         = BuffDesc.uiSizeInBytes;
+        m_CommandBuffer.CopyBuffer(BufferVk.m_VulkanBuffer, NewVkBuffer, 1, &CopyRegion);
+
+        if (AccessFlags != 0)
+        {
+            // Make the new buffer available in the same state the old one was in
+            m_CommandBuffer.BufferMemoryBarrier(NewVkBuffer, VK_ACCESS_TRANSFER_WRITE_BIT, AccessFlags);
+        }
+        else
+        {
+            BufferVk.SetState(RESOURCE_STATE_COPY_DEST);
+        }
+        ++m_State.NumCommands;
+    }
+
+    m_pDevice->SafeReleaseDeviceObject(std::move(BufferVk.m_VulkanBuffer), BuffDesc.CommandQueueMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(BufferVk.m_MemoryAllocation), BuffDesc.CommandQueueMask);
+    BufferVk.m_VulkanBuffer              = std::move(NewVkBuffer);
+    BufferVk.m_MemoryAllocation          = std::move(NewAllocation);
+    BufferVk.m_BufferMemoryAlignedOffset = AlignedOffset;
+
+    // Vertex and index buffers must be rebound with the new handle
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+
+    return BuffDesc.uiSizeInBytes;
+}
+
+BarrierStatsVk DeviceContextVkImpl::GetBarrierStats() const
+{
+    const auto& Counters = m_CommandBuffer.GetBarrierCounters();
+
+    BarrierStatsVk Stats;
+    Stats.NumImageBarriers    = Counters.NumImageBarriers;
+    Stats.NumBufferBarriers   = Counters.NumBufferBarriers;
+    Stats.NumMemoryBarriers   = Counters.NumMemoryBarriers;
+    Stats.NumPipelineBarriers = Counters.NumPipelineBarriers;
+    Stats.NumMergedBarriers   = Counters.NumMergedBarriers;
+    return Stats;
+}
+
 void DeviceContextVkImpl::TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                         RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                         RESOURCE_STATE                 RequiredState,
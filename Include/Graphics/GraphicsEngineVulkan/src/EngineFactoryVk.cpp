@@ -231,6 +231,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         ENABLE_FEATURE(vertexPipelineStoresAndAtomics,    EngineCI.Features.VertexPipelineUAVWritesAndAtomics, "Vertex pipeline UAV writes and atomics are");
         ENABLE_FEATURE(fragmentStoresAndAtomics,          EngineCI.Features.PixelUAVWritesAndAtomics,          "Pixel UAV writes and atomics are");
         ENABLE_FEATURE(shaderStorageImageExtendedFormats, EngineCI.Features.TextureUAVExtendedFormats,         "Texture UAV extended formats are");
+        ENABLE_FEATURE(drawIndirectFirstInstance,         EngineCI.Features.DrawIndirectFirstInstance,         "Indirect draw first instance is");
         // clang-format on
 #undef ENABLE_FEATURE
 
@@ -279,6 +280,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // clang-format on
 
         ENABLE_FEATURE(DeviceExtFeatures.AccelStruct.accelerationStructure != VK_FALSE && DeviceExtFeatures.RayTracingPipeline.rayTracingPipeline != VK_FALSE, RayTracing, "Ray tracing is");
+        ENABLE_FEATURE(DeviceExtFeatures.DrawIndirectCount, DrawIndirectCount, "Indirect draw count is");
 #undef FeatureSupport
 
 
@@ -401,6 +403,37 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 DeviceExtensions.push_back(VK_KHR_STORAGE_BUFFER_STORAGE_CLASS_EXTENSION_NAME);
             }
 
+            if (EngineCI.Features.DrawIndirectCount != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME),
+                       "VK_KHR_draw_indirect_count must be supported as it has already been checked by VulkanPhysicalDevice");
+                DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+                EnabledExtFeats.DrawIndirectCount = true;
+            }
+
+
+            // Bindless descriptors
+            bool DescriptorIndexingEnabled = false;
+            if (EngineCI.EnableBindlessDescriptors)
+            {
+                if (BindlessDescriptorSetVk::IsSupported(DeviceExtFeatures.DescriptorIndexing))
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);        // required for VK_EXT_descriptor_indexing
+                    DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME); // required for bindless descriptors
+
+                    EnabledExtFeats.DescriptorIndexing = DeviceExtFeatures.DescriptorIndexing;
+
+                    *NextExt = &EnabledExtFeats.DescriptorIndexing;
+                    NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
+
+                    DescriptorIndexingEnabled = true;
+                }
+                else
+                {
+                    LOG_WARNING_MESSAGE("Bindless descriptors are requested, but the device does not support required descriptor indexing features");
+                }
+            }
 
             // Ray tracing
             if (EngineCI.Features.RayTracing != DEVICE_FEATURE_STATE_DISABLED)
@@ -414,8 +447,11 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                     VERIFY_EXPR(DeviceExtFeatures.Spirv14);
                 }
 
-                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);             // required for VK_EXT_descriptor_indexing
-                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);      // required for VK_KHR_acceleration_structure
+                if (!DescriptorIndexingEnabled)
+                {
+                    DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);        // required for VK_EXT_descriptor_indexing
+                    DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME); // required for VK_KHR_acceleration_structure
+                }
                 DeviceExtensions.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);    // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME); // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);   // required for ray tracing
@@ -424,7 +460,6 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 EnabledExtFeats.AccelStruct         = DeviceExtFeatures.AccelStruct;
                 EnabledExtFeats.RayTracingPipeline  = DeviceExtFeatures.RayTracingPipeline;
                 EnabledExtFeats.BufferDeviceAddress = DeviceExtFeatures.BufferDeviceAddress;
-                EnabledExtFeats.DescriptorIndexing  = DeviceExtFeatures.DescriptorIndexing;
 
                 // disable unused features
                 EnabledExtFeats.AccelStruct.accelerationStructureCaptureReplay                    = false;
@@ -441,8 +476,13 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 NextExt  = &EnabledExtFeats.AccelStruct.pNext;
                 *NextExt = &EnabledExtFeats.RayTracingPipeline;
                 NextExt  = &EnabledExtFeats.RayTracingPipeline.pNext;
-                *NextExt = &EnabledExtFeats.DescriptorIndexing;
-                NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
+                if (!DescriptorIndexingEnabled)
+                {
+                    EnabledExtFeats.DescriptorIndexing = DeviceExtFeatures.DescriptorIndexing;
+
+                    *NextExt = &EnabledExtFeats.DescriptorIndexing;
+                    NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
+                }
                 *NextExt = &EnabledExtFeats.BufferDeviceAddress;
                 NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
             }
@@ -452,7 +492,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         }
 
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 34, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
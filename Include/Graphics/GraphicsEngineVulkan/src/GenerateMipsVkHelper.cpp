@@ -110,7 +110,7 @@ void GenerateMipsVkHelper::GetGlImageFormat(const TextureFormatAttribs& FmtAttri
     GlFmt[pos] = 0;
 }
 
-std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TEXTURE_FORMAT Fmt)
+std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TEXTURE_FORMAT Fmt, bool ReductionMax)
 {
     std::array<RefCntAutoPtr<IPipelineState>, 4> PSOs;
 
@@ -123,7 +123,7 @@ std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TE
     CSCreateInfo.Desc.ShaderType = SHADER_TYPE_COMPUTE;
 
     const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
-    bool        IsGamma    = FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+    bool        IsGamma    = FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB && !ReductionMax;
 
     std::array<char, 16> GlFmt;
     GetGlImageFormat(FmtAttribs, GlFmt);
@@ -134,6 +134,7 @@ std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TE
         Macros.AddShaderMacro("NON_POWER_OF_TWO", NonPowOfTwo);
         Macros.AddShaderMacro("CONVERT_TO_SRGB", IsGamma);
         Macros.AddShaderMacro("IMG_FORMAT", GlFmt.data());
+        Macros.AddShaderMacro("REDUCTION_MAX", ReductionMax);
 
         Macros.Finalize();
         CSCreateInfo.Macros = Macros;
@@ -148,6 +149,8 @@ std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TE
             case 3: name_ss << " odd XY"; break;
             default: UNEXPECTED("Unexpected value");
         }
+        if (ReductionMax)
+            name_ss << " max";
         auto name              = name_ss.str();
         CSCreateInfo.Desc.Name = name.c_str();
         RefCntAutoPtr<IShader> pCS;
@@ -204,13 +207,15 @@ void GenerateMipsVkHelper::CreateSRB(IShaderResourceBinding** ppSRB)
 #endif
 }
 
-std::array<RefCntAutoPtr<IPipelineState>, 4>& GenerateMipsVkHelper::FindPSOs(TEXTURE_FORMAT Fmt)
+std::array<RefCntAutoPtr<IPipelineState>, 4>& GenerateMipsVkHelper::FindPSOs(TEXTURE_FORMAT Fmt, bool ReductionMax)
 {
     std::lock_guard<std::mutex> Lock{m_PSOMutex};
 
-    auto it = m_PSOHash.find(Fmt);
-    if (it == m_PSOHash.end())
-        it = m_PSOHash.emplace(Fmt, CreatePSOs(Fmt)).first;
+    auto& PSOHash = ReductionMax ? m_MaxReductionPSOHash : m_PSOHash;
+
+    auto it = PSOHash.find(Fmt);
+    if (it == PSOHash.end())
+        it = PSOHash.emplace(Fmt, CreatePSOs(Fmt, ReductionMax)).first;
     return it->second;
 }
 
@@ -219,7 +224,7 @@ void GenerateMipsVkHelper::WarmUpCache(TEXTURE_FORMAT Fmt)
     FindPSOs(Fmt);
 }
 
-void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB)
+void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB, bool ReductionMax)
 {
     auto* pTexVk = TexView.GetTexture<TextureVkImpl>();
     if (!pTexVk->IsInKnownState())
@@ -264,10 +269,18 @@ void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContex
     if (TexView.HasMipLevelViews())
     {
         VERIFY_EXPR(pSRB != nullptr);
-        AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *pSRB, SubresRange);
+        AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *pSRB, SubresRange, ReductionMax);
     }
     else
 #endif
+    if (ReductionMax)
+    {
+        // Blit filters always average the texels
+        LOG_ERROR_MESSAGE("Unable to generate max-reduction mips for texture '", TexDesc.Name,
+                          "': the texture must be created with MISC_TEXTURE_FLAG_GENERATE_MIPS flag and the engine must be built with glslang");
+        return;
+    }
+    else
     {
         AffectedMipLevelLayout = GenerateMipsBlit(TexView, Ctx, SubresRange);
     }
@@ -296,7 +309,7 @@ void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContex
     }
 }
 
-VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange)
+VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange, bool ReductionMax)
 {
     auto*       pTexVk  = TexView.GetTexture<TextureVkImpl>();
     const auto& TexDesc = pTexVk->GetDesc();
@@ -315,7 +328,7 @@ VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, D
             SRB.GetVariableByName(SHADER_TYPE_COMPUTE, "OutMip3") //
         };
 
-    auto& PSOs = FindPSOs(ViewDesc.Format);
+    auto& PSOs = FindPSOs(ViewDesc.Format, ReductionMax);
 
     const auto OriginalState  = pTexVk->GetState();
     const auto OriginalLayout = pTexVk->GetLayout();
@@ -232,7 +232,7 @@ size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash(
     return Hash;
 }
 
-void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessDescriptorSetVk* pBindlessSet)
 {
     size_t TotalBindings = 0;
     for (const auto& Layout : m_DescriptorSetLayouts)
@@ -242,7 +242,7 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
 
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    std::array<VkDescriptorSetLayout, BINDLESS_DESCRIPTOR_SET_INDEX + 1> ActiveDescrSetLayouts = {};
     for (auto& Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -260,15 +260,33 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
                 m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
     // clang-format on
 
+    Uint32 SetLayoutCount = m_ActiveSets;
+    if (m_UseBindlessSet)
+    {
+        VERIFY(pBindlessSet != nullptr, "Pipeline layout uses bindless descriptor set, but bindless descriptors are not enabled");
+        // All elements of pSetLayouts must be valid descriptor set layouts (13.2.2), so
+        // sets between the last active set and the bindless set use the empty layout
+        for (Uint32 s = m_ActiveSets; s < BINDLESS_DESCRIPTOR_SET_INDEX; ++s)
+            ActiveDescrSetLayouts[s] = pBindlessSet->GetEmptyVkLayout();
+        ActiveDescrSetLayouts[BINDLESS_DESCRIPTOR_SET_INDEX] = pBindlessSet->GetVkLayout();
+        SetLayoutCount                                       = BINDLESS_DESCRIPTOR_SET_INDEX + 1;
+    }
+
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
 
     PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     PipelineLayoutCI.pNext                  = nullptr;
     PipelineLayoutCI.flags                  = 0; // reserved for future use
-    PipelineLayoutCI.setLayoutCount         = m_ActiveSets;
+    PipelineLayoutCI.setLayoutCount         = SetLayoutCount;
     PipelineLayoutCI.pSetLayouts            = PipelineLayoutCI.setLayoutCount != 0 ? ActiveDescrSetLayouts.data() : nullptr;
-    PipelineLayoutCI.pushConstantRangeCount = 0;
-    PipelineLayoutCI.pPushConstantRanges    = nullptr;
+
+    VkPushConstantRange PushConstantRange = {};
+    PushConstantRange.stageFlags          = m_PushConstantsStages;
+    PushConstantRange.offset              = 0;
+    PushConstantRange.size                = m_PushConstantsSize;
+
+    PipelineLayoutCI.pushConstantRangeCount = m_PushConstantsSize != 0 ? 1 : 0;
+    PipelineLayoutCI.pPushConstantRanges    = m_PushConstantsSize != 0 ? &PushConstantRange : nullptr;
     m_VkPipelineLayout                      = LogicalDevice.CreatePipelineLayout(PipelineLayoutCI);
 
     VERIFY_EXPR(BindingOffset == TotalBindings);
@@ -293,7 +311,10 @@ bool PipelineLayout::DescriptorSetLayoutManager::operator==(const DescriptorSetL
     // defined descriptor set layouts for sets zero through N, and if they were created with identical push
     // constant ranges (13.2.2)
 
-    if (m_ActiveSets != rhs.m_ActiveSets)
+    if (m_ActiveSets != rhs.m_ActiveSets || m_UseBindlessSet != rhs.m_UseBindlessSet)
+        return false;
+
+    if (m_PushConstantsSize != rhs.m_PushConstantsSize || m_PushConstantsStages != rhs.m_PushConstantsStages)
         return false;
 
     for (size_t i = 0; i < m_DescriptorSetLayouts.size(); ++i)
@@ -308,10 +329,21 @@ size_t PipelineLayout::DescriptorSetLayoutManager::GetHash() const
     size_t Hash = 0;
     for (const auto& SetLayout : m_DescriptorSetLayouts)
         HashCombine(Hash, SetLayout.GetHash());
+    HashCombine(Hash, m_UseBindlessSet);
+    HashCombine(Hash, m_PushConstantsSize, m_PushConstantsStages);
 
     return Hash;
 }
 
+void PipelineLayout::DescriptorSetLayoutManager::AddPushConstants(SHADER_TYPE ShaderType, Uint32 Size)
+{
+    VERIFY(m_VkPipelineLayout == VK_NULL_HANDLE, "Push constants must be added before the layout is finalized");
+    // Any member of pPushConstantRanges must not contain a stage that is also in another range (13.2.2),
+    // so a single range is used for all stages.
+    m_PushConstantsSize = std::max(m_PushConstantsSize, Size);
+    m_PushConstantsStages |= ShaderTypeToVkShaderStageFlagBit(ShaderType);
+}
+
 void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
                                                                       SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                                                       VkSampler                         vkImmutableSampler,
@@ -379,9 +411,9 @@ void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResA
     m_LayoutMgr.AllocateResourceSlot(ResAttribs, VariableType, vkImmutableSampler, ShaderType, DescriptorSet, Binding, OffsetInCache);
 }
 
-void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessDescriptorSetVk* pBindlessSet)
 {
-    m_LayoutMgr.Finalize(LogicalDevice);
+    m_LayoutMgr.Finalize(LogicalDevice, pBindlessSet);
 }
 
 std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) const
@@ -486,6 +518,10 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
 #endif
     BindInfo.DynamicBuffersPresent = ResourceCache.GetNumDynamicBuffers() > 0;
 
+    VERIFY_EXPR(ResourceCache.GetNumDescriptorSets() <= BindInfo.SetRevisions.size());
+    for (Uint32 set = 0; set < ResourceCache.GetNumDescriptorSets(); ++set)
+        BindInfo.SetRevisions[set] = ResourceCache.GetDescriptorSet(set).GetRevision();
+
     if (TotalDynamicDescriptors == 0)
     {
         // There are no dynamic descriptors, so we can bind descriptor sets right now
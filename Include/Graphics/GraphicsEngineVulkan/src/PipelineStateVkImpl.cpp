@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <array>
+#include <cstring>
+#include <unordered_map>
 #include "PipelineStateVkImpl.hpp"
 #include "ShaderVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
@@ -47,7 +49,7 @@ namespace Diligent
 namespace
 {
 
-bool StripReflection(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, std::vector<uint32_t>& SPIRV)
+bool StripReflection(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, std::vector<uint32_t>& SPIRV, bool StripDebugInfo)
 {
 #if DILIGENT_NO_HLSL
     return true;
@@ -65,6 +67,9 @@ bool StripReflection(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
     // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
     // removed by strip-reflect-info pass. SPIRV offsets become INVALID after this operation.
     SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
+    // Debug names have been consumed by the shader reflection and specialization constant lookup
+    if (StripDebugInfo)
+        SpirvOptimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
     if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &StrippedSPIRV))
     {
         SPIRV = std::move(StrippedSPIRV);
@@ -75,8 +80,93 @@ bool StripReflection(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
 #endif
 }
 
+// Finds the specialization constant with the given name in the SPIR-V module and returns
+// its SpecId and the size of its value in bytes.
+bool FindSpecializationConstant(const std::vector<uint32_t>& SPIRV, const char* Name, uint32_t& SpecId, Uint32& Size)
+{
+    // See SPIR-V specification, section 2.3 "Physical Layout of a SPIR-V Module and Instruction"
+    static constexpr size_t HeaderSize = 5;
+
+    // clang-format off
+    static constexpr uint32_t OpName              = 5;
+    static constexpr uint32_t OpTypeBool          = 20;
+    static constexpr uint32_t OpTypeInt           = 21;
+    static constexpr uint32_t OpTypeFloat         = 22;
+    static constexpr uint32_t OpSpecConstantTrue  = 48;
+    static constexpr uint32_t OpSpecConstantFalse = 49;
+    static constexpr uint32_t OpSpecConstant      = 50;
+    static constexpr uint32_t OpDecorate          = 71;
+    static constexpr uint32_t DecorationSpecId    = 1;
+    // clang-format on
+
+    std::vector<uint32_t>                  NamedIds;
+    std::unordered_map<uint32_t, uint32_t> SpecIds;       // Constant id -> SpecId
+    std::unordered_map<uint32_t, uint32_t> ConstantTypes; // Constant id -> type id
+    std::unordered_map<uint32_t, Uint32>   TypeSizes;     // Type id -> size in bytes
+
+    for (size_t i = HeaderSize; i < SPIRV.size();)
+    {
+        const auto OpCode    = SPIRV[i] & 0xFFFFu;
+        const auto WordCount = SPIRV[i] >> 16u;
+        if (WordCount == 0 || i + WordCount > SPIRV.size())
+            return false;
+
+        const auto* Operands = &SPIRV[i + 1];
+        switch (OpCode)
+        {
+            case OpName:
+                // The name is a nul-terminated string packed into the remaining words
+                if (WordCount > 2 && strncmp(reinterpret_cast<const char*>(Operands + 1), Name, (WordCount - 2) * sizeof(uint32_t)) == 0)
+                    NamedIds.push_back(Operands[0]);
+                break;
+
+            case OpDecorate:
+                if (WordCount >= 4 && Operands[1] == DecorationSpecId)
+                    SpecIds[Operands[0]] = Operands[2];
+                break;
+
+            case OpTypeBool:
+                TypeSizes[Operands[0]] = sizeof(VkBool32);
+                break;
+
+            case OpTypeInt:
+            case OpTypeFloat:
+                if (WordCount >= 3)
+                    TypeSizes[Operands[0]] = Operands[1] / 8;
+                break;
+
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            case OpSpecConstant:
+                if (WordCount >= 3)
+                    ConstantTypes[Operands[1]] = Operands[0];
+                break;
+        }
+        i += WordCount;
+    }
+
+    for (auto Id : NamedIds)
+    {
+        auto spec_id_it = SpecIds.find(Id);
+        auto type_it    = ConstantTypes.find(Id);
+        if (spec_id_it == SpecIds.end() || type_it == ConstantTypes.end())
+            continue;
+
+        auto size_it = TypeSizes.find(type_it->second);
+        if (size_it == TypeSizes.end())
+            continue;
+
+        SpecId = spec_id_it->second;
+        Size   = size_it->second;
+        return true;
+    }
+
+    return false;
+}
+
 void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
                               ShaderResourceLayoutVk::TShaderStages&             ShaderStages,
+                              bool                                               StripDebugInfo,
                               std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
                               std::vector<VkPipelineShaderStageCreateInfo>&      Stages)
 {
@@ -109,7 +199,7 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
             // We have to strip reflection instructions to fix the follownig validation error:
             //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
             // Optimizer also performs validation and may catch problems with the byte code.
-            if (!StripReflection(LogicalDevice, SPIRV))
+            if (!StripReflection(LogicalDevice, SPIRV, StripDebugInfo))
                 LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
 
             ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
@@ -614,7 +704,7 @@ void PipelineStateVkImpl::InitResourceLayouts(const PipelineStateCreateInfo& Cre
                                        m_Desc.ResourceLayout, m_PipelineLayout,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_VARIABLES) == 0,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS) == 0);
-    m_PipelineLayout.Finalize(LogicalDevice);
+    m_PipelineLayout.Finalize(LogicalDevice, pDeviceVk->GetBindlessDescriptorSet());
 
     if (m_Desc.SRBAllocationGranularity > 1)
     {
@@ -650,11 +740,86 @@ void PipelineStateVkImpl::InitResourceLayouts(const PipelineStateCreateInfo& Cre
     m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
 }
 
+void PipelineStateVkImpl::InitSpecializationInfo(const PipelineStateCreateInfo& CreateInfo,
+                                                 const TShaderStages&           ShaderStages,
+                                                 TShaderSpecializations&        Specializations) const
+{
+    const auto NumConstants = CreateInfo.NumSpecializationConstants;
+    if (NumConstants == 0)
+        return;
+
+    DEV_CHECK_ERR(CreateInfo.pSpecializationConstants != nullptr, "pSpecializationConstants must not be null when NumSpecializationConstants is not zero");
+
+    size_t NumShaderModules = 0;
+    for (const auto& Stage : ShaderStages)
+        NumShaderModules += Stage.Shaders.size();
+    // The stage create infos keep pointers to the specialization info, so the array must not be resized after this point
+    Specializations.resize(NumShaderModules);
+
+    std::vector<bool> ConstantFound(NumConstants, false);
+
+    // Shader modules are initialized in the same order by InitPipelineShaderStages().
+    size_t ModuleIdx = 0;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (size_t i = 0; i < Stage.Shaders.size(); ++i, ++ModuleIdx)
+        {
+            auto& Spec = Specializations[ModuleIdx];
+            for (Uint32 c = 0; c < NumConstants; ++c)
+            {
+                const auto& Const = CreateInfo.pSpecializationConstants[c];
+                if ((Const.ShaderStages & Stage.Type) == 0)
+                    continue;
+
+                if (Const.Name == nullptr || Const.pData == nullptr)
+                    LOG_ERROR_AND_THROW("Name and data of specialization constant ", c, " in PSO '", m_Desc.Name, "' must not be null");
+
+                uint32_t SpecId = 0;
+                Uint32   Size   = 0;
+                if (!FindSpecializationConstant(Stage.SPIRVs[i], Const.Name, SpecId, Size))
+                    continue;
+
+                if (Const.Size != Size)
+                {
+                    LOG_ERROR_AND_THROW("The size (", Const.Size, ") of specialization constant '", Const.Name, "' in PSO '", m_Desc.Name,
+                                        "' does not match the size of the constant type (", Size, ") in shader '", Stage.Shaders[i]->GetDesc().Name, "'");
+                }
+
+                VkSpecializationMapEntry MapEntry{};
+                MapEntry.constantID = SpecId;
+                MapEntry.offset     = static_cast<uint32_t>(Spec.Data.size());
+                MapEntry.size       = Size;
+                Spec.MapEntries.push_back(MapEntry);
+
+                const auto* pData = static_cast<const Uint8*>(Const.pData);
+                Spec.Data.insert(Spec.Data.end(), pData, pData + Size);
+
+                ConstantFound[c] = true;
+            }
+
+            Spec.Info.mapEntryCount = static_cast<uint32_t>(Spec.MapEntries.size());
+            Spec.Info.pMapEntries   = Spec.MapEntries.data();
+            Spec.Info.dataSize      = Spec.Data.size();
+            Spec.Info.pData         = Spec.Data.data();
+        }
+    }
+
+    for (Uint32 c = 0; c < NumConstants; ++c)
+    {
+        if (!ConstantFound[c])
+        {
+            LOG_WARNING_MESSAGE("Specialization constant '", CreateInfo.pSpecializationConstants[c].Name,
+                                "' is not found in any of the designated shader stages of PSO '", m_Desc.Name, "'");
+        }
+    }
+}
+
 template <typename PSOCreateInfoType>
 PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
     const PSOCreateInfoType&                           CreateInfo,
     std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules)
+    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
+    TShaderSpecializations&                            Specializations)
 {
     m_ResourceLayoutIndex.fill(-1);
 
@@ -696,8 +861,19 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
 
     InitResourceLayouts(CreateInfo, ShaderStages);
 
+    // Specialization constants are looked up by name, so this must be done before debug names are stripped
+    InitSpecializationInfo(CreateInfo, ShaderStages, Specializations);
+
     // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+    const auto StripDebugInfo = (GetDevice()->GetSPIRVOptimizationFlags() & SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO) != 0;
+    InitPipelineShaderStages(LogicalDevice, ShaderStages, StripDebugInfo, ShaderModules, vkShaderStages);
+
+    VERIFY_EXPR(Specializations.empty() || Specializations.size() == vkShaderStages.size());
+    for (size_t i = 0; i < Specializations.size(); ++i)
+    {
+        if (!Specializations[i].MapEntries.empty())
+            vkShaderStages[i].pSpecializationInfo = &Specializations[i].Info;
+    }
 
     return ShaderStages;
 }
@@ -713,8 +889,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*
     {
         std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
         std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        TShaderSpecializations                            Specializations;
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
 
         CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, m_pRenderPass);
     }
@@ -736,8 +913,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*                   p
     {
         std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
         std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        TShaderSpecializations                            Specializations;
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
 
         CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline);
     }
@@ -760,8 +938,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*
 
         std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
         std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        TShaderSpecializations                            Specializations;
 
-        const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
 
         const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
 
@@ -26,6 +26,9 @@
  */
 
 #include "pch.h"
+
+#include <algorithm>
+
 #include "RenderDeviceVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
 #include "ShaderVkImpl.hpp"
@@ -150,7 +153,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryPageSize,
         EngineCI.HostVisibleMemoryPageSize,
         EngineCI.DeviceLocalMemoryReserveSize,
-        EngineCI.HostVisibleMemoryReserveSize
+        EngineCI.HostVisibleMemoryReserveSize,
+        EngineCI.DedicatedAllocationThreshold
     },
     m_DynamicMemoryManager
     {
@@ -249,7 +253,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     Features.DurationQueries               = DEVICE_FEATURE_STATE_ENABLED;
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
+    static_assert(sizeof(DeviceFeatures) == 34, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
 #endif
 
     const auto& vkDeviceLimits    = m_PhysicalDevice->GetProperties().limits;
@@ -274,6 +278,41 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     SamCaps.BorderSamplingModeSupported   = True;
     SamCaps.AnisotropicFilteringSupported = vkEnabledFeatures.samplerAnisotropy;
     SamCaps.LODBiasSupported              = True;
+
+    if (EngineCI.EnableBindlessDescriptors)
+    {
+        if (BindlessDescriptorSetVk::IsSupported(m_LogicalVkDevice->GetEnabledExtFeatures().DescriptorIndexing))
+            m_pBindlessDescriptorSet.reset(new BindlessDescriptorSetVk{*this, EngineCI.BindlessDescriptorCount});
+        else
+            LOG_WARNING_MESSAGE("Bindless descriptors are requested, but required descriptor indexing features are not enabled by the device");
+    }
+
+    if (EngineCI.pShaderCacheDirectory != nullptr)
+    {
+        try
+        {
+            m_pShaderCache.reset(new SPIRVShaderCache{EngineCI.pShaderCacheDirectory});
+        }
+        catch (...)
+        {
+            LOG_WARNING_MESSAGE("Failed to initialize the shader cache in '", EngineCI.pShaderCacheDirectory, "'. Shaders will always be compiled from source.");
+        }
+    }
+
+    m_SPIRVOptimizationFlags = EngineCI.SPIRVOptimizationFlags;
+    if (m_SPIRVOptimizationFlags & SPIRV_OPTIMIZATION_FLAG_DEFAULT)
+    {
+#ifdef DILIGENT_DEBUG
+        m_SPIRVOptimizationFlags = SPIRV_OPTIMIZATION_FLAG_NONE;
+#else
+        m_SPIRVOptimizationFlags = SPIRV_OPTIMIZATION_FLAG_PERFORMANCE | SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO;
+#endif
+    }
+#if DILIGENT_NO_HLSL
+    if ((EngineCI.SPIRVOptimizationFlags & SPIRV_OPTIMIZATION_FLAG_DEFAULT) == 0 && m_SPIRVOptimizationFlags != SPIRV_OPTIMIZATION_FLAG_NONE)
+        LOG_WARNING_MESSAGE("SPIR-V optimization is not available because the engine is built without SPIRV-Tools");
+    m_SPIRVOptimizationFlags = SPIRV_OPTIMIZATION_FLAG_NONE;
+#endif
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -285,9 +324,15 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // Explicitly destroy render pass cache
     m_ImplicitRenderPassCache.Destroy();
 
+    // Move bindless descriptor set objects and registered resources into release queues
+    if (m_pBindlessDescriptorSet)
+        m_pBindlessDescriptorSet->Destroy();
+
     // Wait for the GPU to complete all its operations
     IdleGPU();
 
+    // Unregistered bindless indices are returned to m_pBindlessDescriptorSet by the release queues,
+    // so all stale resources must be released while the set is still alive.
     ReleaseStaleResources(true);
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
@@ -803,6 +848,304 @@ void RenderDeviceVkImpl::CreateTLASFromVulkanResource(VkAccelerationStructureKHR
     );
 }
 
+Uint32 RenderDeviceVkImpl::RegisterBindlessResource(IDeviceObject* pObject)
+{
+    if (!m_pBindlessDescriptorSet)
+    {
+        LOG_ERROR_MESSAGE("Bindless descriptors are not enabled. Set EngineVkCreateInfo::EnableBindlessDescriptors to true.");
+        return INVALID_BINDLESS_INDEX;
+    }
+    return m_pBindlessDescriptorSet->Register(pObject);
+}
+
+void RenderDeviceVkImpl::UnregisterBindlessResource(IDeviceObject* pObject)
+{
+    if (!m_pBindlessDescriptorSet)
+    {
+        LOG_ERROR_MESSAGE("Bindless descriptors are not enabled. Set EngineVkCreateInfo::EnableBindlessDescriptors to true.");
+        return;
+    }
+    m_pBindlessDescriptorSet->Unregister(pObject);
+}
+
+VkMemoryPropertyFlags RenderDeviceVkImpl::GetTransientAttachmentMemoryProperties(uint32_t MemoryTypeBits) const
+{
+    // Lazily allocated memory is only committed when the implementation actually needs it, which on
+    // tile-based GPUs is typically never, as attachment contents stay in on-chip tile memory.
+    constexpr VkMemoryPropertyFlags LazyMemoryProps = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    if (m_PhysicalDevice->GetMemoryTypeIndex(MemoryTypeBits, LazyMemoryProps) != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        return LazyMemoryProps;
+    else
+        return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+}
+
+namespace
+{
+
+struct AliasedTextureInfo
+{
+    VkDeviceSize Size           = 0;
+    VkDeviceSize Alignment      = 0;
+    uint32_t     MemoryTypeBits = 0;
+    Uint32       FirstPass      = 0;
+    Uint32       LastPass       = 0;
+    bool         IsTransient    = false;
+
+    // Offset from the start of the memory block shared by the group
+    VkDeviceSize Offset = 0;
+};
+
+// Returns the lowest offset at which the texture does not overlap any already placed
+// texture whose lifetime intersects with the lifetime of this texture.
+VkDeviceSize FindAliasedTextureOffset(const AliasedTextureInfo& Tex, const std::vector<const AliasedTextureInfo*>& PlacedTextures)
+{
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> BusyRanges;
+    for (const auto* pPlaced : PlacedTextures)
+    {
+        if (pPlaced->FirstPass <= Tex.LastPass && Tex.FirstPass <= pPlaced->LastPass)
+            BusyRanges.emplace_back(pPlaced->Offset, pPlaced->Offset + pPlaced->Size);
+    }
+    std::sort(BusyRanges.begin(), BusyRanges.end());
+
+    VkDeviceSize Offset = 0;
+    for (const auto& Range : BusyRanges)
+    {
+        if (Offset + Tex.Size <= Range.first)
+            break;
+        Offset = std::max(Offset, Align(Range.second, Tex.Alignment));
+    }
+    return Offset;
+}
+
+} // namespace
+
+void RenderDeviceVkImpl::CreateAliasedTextures(Uint32 NumTextures, const AliasedTextureDescVk* pDescs, ITexture** ppTextures)
+{
+    DEV_CHECK_ERR(NumTextures == 0 || (pDescs != nullptr && ppTextures != nullptr), "pDescs and ppTextures must not be null");
+    for (Uint32 i = 0; i < NumTextures; ++i)
+        ppTextures[i] = nullptr;
+
+    const auto& LogicalDevice = GetLogicalDevice();
+
+    std::vector<RefCntAutoPtr<TextureVkImpl>> Textures(NumTextures);
+    std::vector<AliasedTextureInfo>           TexInfos(NumTextures);
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        const auto& AliasedDesc = pDescs[i];
+        const auto* Name        = AliasedDesc.Desc.Name != nullptr ? AliasedDesc.Desc.Name : "";
+        if (AliasedDesc.Desc.Usage != USAGE_DEFAULT)
+        {
+            LOG_ERROR_MESSAGE("Failed to create aliased texture '", Name, "': only USAGE_DEFAULT textures can be aliased");
+            return;
+        }
+        if (AliasedDesc.FirstPass > AliasedDesc.LastPass)
+        {
+            LOG_ERROR_MESSAGE("Failed to create aliased texture '", Name, "': first pass (", AliasedDesc.FirstPass,
+                              ") is greater than the last pass (", AliasedDesc.LastPass, ")");
+            return;
+        }
+
+        TextureVkImpl* pTextureVk = nullptr;
+        CreateDeviceObject(
+            "texture", AliasedDesc.Desc, &pTextureVk,
+            [&]() //
+            {
+                TextureVkImpl* pNewTextureVk = NEW_RC_OBJ(m_TexObjAllocator, "TextureVkImpl instance", TextureVkImpl)(m_TexViewObjAllocator, this, AliasedDesc.Desc, nullptr, true);
+                pNewTextureVk->QueryInterface(IID_TextureVk, reinterpret_cast<IObject**>(&pTextureVk));
+                OnCreateDeviceObject(pNewTextureVk);
+            } //
+        );
+        if (pTextureVk == nullptr)
+            return;
+        Textures[i].Attach(pTextureVk);
+
+        const auto MemReqs = LogicalDevice.GetImageMemoryRequirements(pTextureVk->GetVkImage());
+        VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+
+        auto& TexInfo          = TexInfos[i];
+        TexInfo.Size           = MemReqs.size;
+        TexInfo.Alignment      = MemReqs.alignment;
+        TexInfo.MemoryTypeBits = MemReqs.memoryTypeBits;
+        TexInfo.FirstPass      = AliasedDesc.FirstPass;
+        TexInfo.LastPass       = AliasedDesc.LastPass;
+        TexInfo.IsTransient    = (AliasedDesc.Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT) != 0;
+    }
+
+    // Textures can only share memory if they have a common memory type. Transient attachments
+    // are kept separate as they may be placed in lazily allocated memory.
+    struct AliasingGroup
+    {
+        uint32_t            MemoryTypeBits = 0;
+        bool                IsTransient    = false;
+        std::vector<Uint32> Textures;
+    };
+    std::vector<AliasingGroup> Groups;
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        const auto& TexInfo  = TexInfos[i];
+        auto        group_it = std::find_if(Groups.begin(), Groups.end(),
+                                     [&TexInfo](const AliasingGroup& Group) //
+                                     {
+                                         return Group.IsTransient == TexInfo.IsTransient && (Group.MemoryTypeBits & TexInfo.MemoryTypeBits) != 0;
+                                     });
+        if (group_it == Groups.end())
+        {
+            Groups.emplace_back();
+            group_it                 = std::prev(Groups.end());
+            group_it->IsTransient    = TexInfo.IsTransient;
+            group_it->MemoryTypeBits = TexInfo.MemoryTypeBits;
+        }
+        else
+        {
+            group_it->MemoryTypeBits &= TexInfo.MemoryTypeBits;
+        }
+        group_it->Textures.push_back(i);
+    }
+
+    try
+    {
+        for (auto& Group : Groups)
+        {
+            // Placing larger textures first leaves fewer gaps in the shared block
+            std::sort(Group.Textures.begin(), Group.Textures.end(),
+                      [&TexInfos](Uint32 Idx0, Uint32 Idx1) //
+                      {
+                          return TexInfos[Idx0].Size > TexInfos[Idx1].Size;
+                      });
+
+            VkMemoryRequirements BlockMemReqs = {};
+            BlockMemReqs.alignment            = 1;
+            BlockMemReqs.memoryTypeBits       = Group.MemoryTypeBits;
+
+            std::vector<const AliasedTextureInfo*> PlacedTextures;
+            for (auto TexIdx : Group.Textures)
+            {
+                auto& TexInfo  = TexInfos[TexIdx];
+                TexInfo.Offset = FindAliasedTextureOffset(TexInfo, PlacedTextures);
+                PlacedTextures.push_back(&TexInfo);
+
+                BlockMemReqs.size      = std::max(BlockMemReqs.size, TexInfo.Offset + TexInfo.Size);
+                BlockMemReqs.alignment = std::max(BlockMemReqs.alignment, TexInfo.Alignment);
+            }
+
+            const auto MemoryProps = Group.IsTransient ?
+                GetTransientAttachmentMemoryProperties(Group.MemoryTypeBits) :
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+            auto pMemory = std::make_shared<VulkanUtilities::VulkanMemoryAllocation>(AllocateMemory(BlockMemReqs, MemoryProps));
+            // All offsets within the block are aligned by their own alignment, which does not exceed the block alignment
+            const auto BlockOffset = Align(pMemory->UnalignedOffset, BlockMemReqs.alignment);
+            VERIFY_EXPR(pMemory->Size >= BlockMemReqs.size + (BlockOffset - pMemory->UnalignedOffset));
+            for (auto TexIdx : Group.Textures)
+                Textures[TexIdx]->BindAliasedMemory(pMemory, BlockOffset + TexInfos[TexIdx].Offset);
+        }
+
+        // Image views can only be created once the image is bound to memory
+        for (auto& pTexture : Textures)
+            pTexture->CreateDefaultViews();
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR_MESSAGE("Failed to create aliased textures");
+        return;
+    }
+
+    for (Uint32 i = 0; i < NumTextures; ++i)
+        Textures[i]->QueryInterface(IID_Texture, reinterpret_cast<IObject**>(ppTextures + i));
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableBuffer(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    m_RelocatableBuffers.insert(pBuffer);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableBuffer(BufferVkImpl* pBuffer)
+{
+    // The buffer may be in the middle of relocation in DefragmentMemory(), which
+    // holds the lock, so the destructor must wait until it completes
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    m_RelocatableBuffers.erase(pBuffer);
+}
+
+void RenderDeviceVkImpl::OnDeferredCmdBufferStarted()
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    ++m_NumPendingDeferredCmdBuffers;
+}
+
+void RenderDeviceVkImpl::OnDeferredCmdBufferReleased()
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    VERIFY_EXPR(m_NumPendingDeferredCmdBuffers > 0);
+    --m_NumPendingDeferredCmdBuffers;
+}
+
+VkDeviceSize RenderDeviceVkImpl::DefragmentMemory(DeviceContextVkImpl& ImmediateCtx)
+{
+    VERIFY(!ImmediateCtx.IsDeferred(), "Memory can only be defragmented by the immediate context");
+
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    if (m_RelocatableBuffers.empty())
+        return 0;
+
+    // Commands recorded by deferred contexts reference current buffer handles. Evacuating pages are
+    // kept as they are, so defragmentation resumes once all command lists have been executed.
+    if (m_NumPendingDeferredCmdBuffers != 0)
+        return 0;
+
+    // Only pages that exclusively contain relocatable buffers can be evacuated.
+    // The map is only built when the memory manager looks for new pages to evacuate.
+    std::unordered_map<const VulkanUtilities::VulkanMemoryPage*, VkDeviceSize> RelocatableSizes;
+    auto CanEvacuate = [&](const VulkanUtilities::VulkanMemoryPage& Page, VkDeviceSize UsedSize) //
+    {
+        if (RelocatableSizes.empty())
+        {
+            for (const auto* pBuffer : m_RelocatableBuffers)
+            {
+                const auto& Allocation = pBuffer->GetMemoryAllocation();
+                RelocatableSizes[Allocation.Page] += Allocation.Size;
+            }
+        }
+        auto it = RelocatableSizes.find(&Page);
+        return it != RelocatableSizes.end() && it->second == UsedSize;
+    };
+    if (m_MemoryMgr.BeginPageEvacuation(m_EngineAttribs.DefragmentationPageOccupancy, CanEvacuate) == 0)
+        return 0;
+
+    VkDeviceSize MovedSize         = 0;
+    bool         HasPendingBuffers = false;
+    for (auto* pBuffer : m_RelocatableBuffers)
+    {
+        if (MovedSize >= m_EngineAttribs.DefragmentationBytesPerFrame)
+            break;
+
+        if (!pBuffer->GetMemoryAllocation().Page->IsEvacuating())
+            continue;
+
+        HasPendingBuffers = true;
+        try
+        {
+            MovedSize += ImmediateCtx.RelocateBuffer(*pBuffer);
+        }
+        catch (const std::runtime_error&)
+        {
+            LOG_WARNING_MESSAGE("Failed to relocate buffer '", pBuffer->GetDesc().Name, "'. Memory defragmentation is cancelled.");
+            m_MemoryMgr.CancelPageEvacuation();
+            return MovedSize;
+        }
+    }
+
+    if (HasPendingBuffers && MovedSize == 0)
+    {
+        // None of the buffers in the evacuating pages can currently be moved (e.g. their state is unknown).
+        // Cancel evacuation so that the pages do not stay unusable forever.
+        m_MemoryMgr.CancelPageEvacuation();
+    }
+
+    return MovedSize;
+}
+
 void RenderDeviceVkImpl::CreateTLAS(const TopLevelASDesc& Desc,
                                     ITopLevelAS**         ppTLAS)
 {
@@ -379,8 +379,8 @@ VkDescriptorBufferInfo ShaderResourceCacheVk::Resource::GetUniformBufferDescript
     DescrBuffInfo.buffer = pBuffVk->GetVkBuffer();
     // If descriptorType is VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER or VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, the offset member
     // of each element of pBufferInfo must be a multiple of VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment (13.2.4)
-    DescrBuffInfo.offset = 0;
-    DescrBuffInfo.range  = pBuffVk->GetDesc().uiSizeInBytes;
+    DescrBuffInfo.offset = BufferRangeOffset;
+    DescrBuffInfo.range  = BufferRangeSize != 0 ? BufferRangeSize : pBuffVk->GetDesc().uiSizeInBytes - BufferRangeOffset;
     return DescrBuffInfo;
 }
 
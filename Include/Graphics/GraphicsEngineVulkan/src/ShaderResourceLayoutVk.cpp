@@ -180,6 +180,10 @@ StringPool ShaderResourceLayoutVk::AllocateMemory(const std::vector<const Shader
         Resources.ProcessResources(
             [&](const SPIRVShaderResourceAttribs& ResAttribs, Uint32) //
             {
+                // Runtime arrays are not part of the layout and are accessed through the bindless descriptor set
+                if (ResAttribs.IsRuntimeArray())
+                    return;
+
                 auto VarType = FindShaderVariableType(m_ShaderType, ResAttribs, ResourceLayoutDesc, CombinedSamplerSuffix);
                 if (IsAllowedType(VarType, AllowedTypeBits))
                 {
@@ -339,6 +343,9 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(const std::vector<co
         Resources.ProcessResources(
             [&](const SPIRVShaderResourceAttribs& Attribs, Uint32) //
             {
+                if (Attribs.IsRuntimeArray())
+                    return;
+
                 auto VarType = FindShaderVariableType(m_ShaderType, Attribs, ResourceLayoutDesc, CombinedSamplerSuffix);
                 if (!IsAllowedType(VarType, AllowedTypeBits))
                     return;
@@ -592,6 +599,28 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
                            const SPIRVShaderResourceAttribs& Attribs,
                            std::vector<uint32_t>&            SPIRV) //
     {
+        if (Attribs.IsRuntimeArray())
+        {
+            // Unsized arrays are always remapped to the global bindless descriptor set
+            if (ValidatedCast<RenderDeviceVkImpl>(pRenderDevice)->GetBindlessDescriptorSet() == nullptr)
+            {
+                LOG_ERROR_AND_THROW("Resource '", Attribs.Name, "' is a runtime array. Runtime arrays require bindless descriptors to be enabled (EngineVkCreateInfo::EnableBindlessDescriptors).");
+            }
+
+            const auto BindlessBinding = BindlessDescriptorSetVk::GetBinding(Attribs.Type);
+            if (BindlessBinding == BindlessDescriptorSetVk::InvalidBinding)
+            {
+                LOG_ERROR_AND_THROW("Resource '", Attribs.Name, "' is a runtime array of type ",
+                                    GetShaderResourceTypeLiteralName(SPIRVShaderResourceAttribs::GetShaderResourceType(Attribs.Type)),
+                                    ", which can't be accessed through the bindless descriptor set");
+            }
+
+            SPIRV[Attribs.BindingDecorationOffset]       = BindlessBinding;
+            SPIRV[Attribs.DescriptorSetDecorationOffset] = BINDLESS_DESCRIPTOR_SET_INDEX;
+            PipelineLayout.UseBindlessSet();
+            return;
+        }
+
         auto& ResourceNameToIndex = ResourceNameToIndexArray[ShaderStageInd];
 
         auto ResIter = ResourceNameToIndex.find(HashMapStringKey{Attribs.Name});
@@ -682,6 +711,27 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
         SPIRV[Attribs.DescriptorSetDecorationOffset] = pResource->DescriptorSet;
     };
 
+    // Push constants do not use descriptors. The range is shared by all stages of the pipeline.
+    {
+        const auto MaxPushConstantsSize = ValidatedCast<RenderDeviceVkImpl>(pRenderDevice)->GetPhysicalDevice().GetProperties().limits.maxPushConstantsSize;
+        for (size_t s = 0; s < ShaderStages.size(); ++s)
+        {
+            for (const auto* pShader : ShaderStages[s].Shaders)
+            {
+                const auto& Resources = *pShader->GetShaderResources();
+                if (!Resources.HasPushConstants())
+                    continue;
+
+                if (Resources.GetPushConstantBlockSize() > MaxPushConstantsSize)
+                {
+                    LOG_ERROR_AND_THROW("Push constant block '", Resources.GetPushConstantBlockName(), "' in shader '", Resources.GetShaderName(), "' is ",
+                                        Resources.GetPushConstantBlockSize(), " bytes, which exceeds the device limit (", MaxPushConstantsSize, " bytes).");
+                }
+                PipelineLayout.AddPushConstants(Resources.GetShaderType(), Resources.GetPushConstantBlockSize());
+            }
+        }
+    }
+
     // First process uniform buffers for ALL shader stages to make sure all UBs go first in every descriptor set
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
@@ -847,14 +897,31 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
                                                             ShaderResourceCacheVk::Resource& DstRes,
                                                             VkDescriptorSet                  vkDescrSet,
                                                             Uint32                           ArrayInd,
-                                                            Uint16&                          DynamicBuffersCounter) const
+                                                            Uint16&                          DynamicBuffersCounter,
+                                                            Uint32                           RangeOffset,
+                                                            Uint32                           RangeSize) const
 {
     VERIFY(Type == SPIRVShaderResourceAttribs::ResourceType::UniformBuffer, "Uniform buffer resource is expected");
     RefCntAutoPtr<BufferVkImpl> pBufferVk{pBuffer, IID_BufferVk};
 #ifdef DILIGENT_DEVELOPMENT
     VerifyConstantBufferBinding(*this, GetVariableType(), ArrayInd, pBuffer, pBufferVk.RawPtr(), DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
 
-    if (pBufferVk->GetDesc().uiSizeInBytes < BufferStaticSize)
+    if (pBufferVk && (RangeOffset != 0 || RangeSize != 0))
+    {
+        const auto& BuffDesc = pBufferVk->GetDesc();
+        if (RangeOffset % pBufferVk->GetDynamicOffsetAlignment() != 0)
+        {
+            LOG_ERROR_MESSAGE("Error binding uniform buffer '", BuffDesc.Name, "' to shader variable '", Name, "' in shader '", ParentResLayout.GetShaderName(),
+                              "': range offset (", RangeOffset, ") is not a multiple of the minimum uniform buffer offset alignment (", pBufferVk->GetDynamicOffsetAlignment(), ").");
+        }
+        if (Uint64{RangeOffset} + RangeSize > BuffDesc.uiSizeInBytes)
+        {
+            LOG_ERROR_MESSAGE("Error binding uniform buffer '", BuffDesc.Name, "' to shader variable '", Name, "' in shader '", ParentResLayout.GetShaderName(),
+                              "': range [", RangeOffset, ", ", Uint64{RangeOffset} + RangeSize, ") is out of the buffer bounds (", BuffDesc.uiSizeInBytes, ").");
+        }
+    }
+
+    if (pBufferVk && (RangeSize != 0 ? RangeSize : pBufferVk->GetDesc().uiSizeInBytes - RangeOffset) < BufferStaticSize)
     {
         // It is OK if robustBufferAccess feature is enabled, otherwise access outside of buffer range may lead to crash or undefined behavior.
         LOG_WARNING_MESSAGE("Error binding uniform buffer '", pBufferVk->GetDesc().Name, "' to shader variable '",
@@ -874,6 +941,10 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
     };
     if (UpdateCachedResource(DstRes, std::move(pBufferVk), UpdateDynamicBuffersCounter))
     {
+        DstRes.BufferRangeOffset   = RangeOffset;
+        DstRes.BufferRangeSize     = RangeSize;
+        DstRes.BufferDynamicOffset = 0;
+
         // VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER or VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor type require
         // buffer to be created with VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
 
@@ -1170,7 +1241,11 @@ void ShaderResourceLayoutVk::VkResource::CacheAccelerationStructure(IDeviceObjec
     }
 }
 
-void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint32 ArrayIndex, ShaderResourceCacheVk& ResourceCache) const
+void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject*         pObj,
+                                                      Uint32                 ArrayIndex,
+                                                      ShaderResourceCacheVk& ResourceCache,
+                                                      Uint32                 RangeOffset,
+                                                      Uint32                 RangeSize) const
 {
     VERIFY_EXPR(ArrayIndex < ArraySize);
 
@@ -1203,8 +1278,14 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
         switch (Type)
         {
             case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
-                CacheUniformBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
-                break;
+            {
+                const auto PrevDynamicOffset = DstRes.BufferDynamicOffset;
+                CacheUniformBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter(), RangeOffset, RangeSize);
+                // Binding a new buffer resets the dynamic offset
+                if (DstRes.BufferDynamicOffset != PrevDynamicOffset)
+                    ResourceCache.OnDynamicOffsetChanged();
+            }
+            break;
 
             case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
             case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
@@ -1269,6 +1350,62 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
 
         DstRes.pObject.Release();
     }
+
+    DstDescrSet.MarkDirty();
+}
+
+void ShaderResourceLayoutVk::VkResource::SetDynamicOffset(Uint32 ArrayIndex, Uint32 Offset, ShaderResourceCacheVk& ResourceCache) const
+{
+    VERIFY_EXPR(ArrayIndex < ArraySize);
+
+    if (Type != SPIRVShaderResourceAttribs::ResourceType::UniformBuffer)
+    {
+        LOG_ERROR_MESSAGE("Unable to set dynamic offset for shader variable '", GetPrintName(ArrayIndex), "' in shader '",
+                          ParentResLayout.GetShaderName(), "': the variable is not a uniform buffer.");
+        return;
+    }
+    if (GetVariableType() == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+    {
+        // Static resources are copied to every SRB when it is initialized, so the offset would have no effect
+        LOG_ERROR_MESSAGE("Unable to set dynamic offset for static shader variable '", GetPrintName(ArrayIndex), "' in shader '",
+                          ParentResLayout.GetShaderName(), "'. Use mutable or dynamic variables.");
+        return;
+    }
+
+    auto& DstRes = ResourceCache.GetDescriptorSet(DescriptorSet).GetResource(CacheOffset + ArrayIndex);
+    VERIFY(DstRes.Type == Type, "Inconsistent types");
+
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto* pBufferVk = DstRes.pObject.RawPtr<const BufferVkImpl>();
+        if (pBufferVk == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Unable to set dynamic offset for shader variable '", GetPrintName(ArrayIndex), "' in shader '",
+                              ParentResLayout.GetShaderName(), "': no buffer is bound to the variable.");
+            return;
+        }
+
+        const auto& BuffDesc = pBufferVk->GetDesc();
+        if (Offset % pBufferVk->GetDynamicOffsetAlignment() != 0)
+        {
+            LOG_ERROR_MESSAGE("Dynamic offset (", Offset, ") of shader variable '", GetPrintName(ArrayIndex), "' in shader '", ParentResLayout.GetShaderName(),
+                              "' is not a multiple of the minimum uniform buffer offset alignment (", pBufferVk->GetDynamicOffsetAlignment(), ").");
+        }
+
+        const Uint64 RangeSize = DstRes.BufferRangeSize != 0 ? DstRes.BufferRangeSize : BuffDesc.uiSizeInBytes - DstRes.BufferRangeOffset;
+        if (DstRes.BufferRangeOffset + Uint64{Offset} + RangeSize > BuffDesc.uiSizeInBytes)
+        {
+            LOG_ERROR_MESSAGE("Dynamic offset (", Offset, ") of shader variable '", GetPrintName(ArrayIndex), "' in shader '", ParentResLayout.GetShaderName(),
+                              "' moves the bound range of buffer '", BuffDesc.Name, "' out of the buffer bounds. Bind a smaller range with SetBufferRange().");
+        }
+    }
+#endif
+
+    if (DstRes.BufferDynamicOffset != Offset)
+    {
+        DstRes.BufferDynamicOffset = Offset;
+        ResourceCache.OnDynamicOffsetChanged();
+    }
 }
 
 bool ShaderResourceLayoutVk::VkResource::IsBound(Uint32 ArrayIndex, const ShaderResourceCacheVk& ResourceCache) const
@@ -1328,7 +1465,7 @@ void ShaderResourceLayoutVk::InitializeStaticResources(const ShaderResourceLayou
             if (pCachedResource != pObject)
             {
                 VERIFY(pCachedResource == nullptr, "Static resource has already been initialized, and the resource to be assigned from the shader does not match previously assigned resource");
-                DstRes.BindResource(pObject, ArrInd, DstResourceCache);
+                DstRes.BindResource(pObject, ArrInd, DstResourceCache, SrcCachedRes.BufferRangeOffset, SrcCachedRes.BufferRangeSize);
             }
         }
     }
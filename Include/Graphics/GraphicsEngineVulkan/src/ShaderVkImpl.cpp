@@ -40,9 +40,42 @@
 #    include "GLSLangUtils.hpp"
 #endif
 
+#if !DILIGENT_NO_HLSL
+#    include "spirv-tools/optimizer.hpp"
+#endif
+
 namespace Diligent
 {
 
+namespace
+{
+
+// Runs the performance passes of the SPIR-V optimizer on DXC output. glslang output is already
+// optimized by GLSLangUtils. The module must be optimized before the resources are reflected
+// as the pipeline patches bindings at the reflected offsets.
+void OptimizeSPIRV(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, std::vector<uint32_t>& SPIRV, const char* ShaderName)
+{
+#if !DILIGENT_NO_HLSL
+    spv_target_env Target   = SPV_ENV_VULKAN_1_0;
+    const auto&    ExtFeats = LogicalDevice.GetEnabledExtFeatures();
+    if (ExtFeats.Spirv15)
+        Target = SPV_ENV_VULKAN_1_2;
+    else if (ExtFeats.Spirv14)
+        Target = SPV_ENV_VULKAN_1_1_SPIRV_1_4;
+
+    spvtools::Optimizer SpirvOptimizer(Target);
+    SpirvOptimizer.RegisterPerformancePasses();
+
+    std::vector<uint32_t> OptimizedSPIRV;
+    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
+        SPIRV = std::move(OptimizedSPIRV);
+    else
+        LOG_WARNING_MESSAGE("Failed to optimize SPIR-V bytecode of shader '", ShaderName, "'. Unoptimized bytecode will be used.");
+#endif
+}
+
+} // namespace
+
 ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceVkImpl*     pRenderDeviceVk,
                            const ShaderCreateInfo& ShaderCI) :
@@ -55,16 +88,18 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    // Reflection data loaded from the shader cache
+    std::vector<Uint8> CachedReflection;
+
+    auto*                 pShaderCache = pRenderDeviceVk->GetShaderCache();
+    SPIRVShaderCache::Key CacheKey;
+    bool                  StoreInCache = false;
+
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
         DEV_CHECK_ERR(ShaderCI.ByteCodeSize == 0, "'ByteCodeSize' must be 0 when shader is created from source code or a file");
 
-        static constexpr char VulkanDefine[] =
-            "#ifndef VULKAN\n"
-            "#   define VULKAN 1\n"
-            "#endif\n";
-
         auto ShaderCompiler = ShaderCI.ShaderCompiler;
         if (ShaderCompiler == SHADER_COMPILER_DXC)
         {
@@ -76,76 +111,131 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
             }
         }
 
-        switch (ShaderCompiler)
+#if !DILIGENT_NO_GLSLANG
+        GLSLangUtils::SpirvVersion SpvVersion = GLSLangUtils::SpirvVersion::Vk100;
+        {
+            const auto& ExtFeats = pRenderDeviceVk->GetLogicalDevice().GetEnabledExtFeatures();
+            if (ExtFeats.Spirv15)
+                SpvVersion = GLSLangUtils::SpirvVersion::Vk120;
+            else if (ExtFeats.Spirv14)
+                SpvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
+        }
+#endif
+
+        // GLSLangUtils runs the performance passes on everything glslang produces, so only
+        // DXC output needs to be optimized
+        const auto OptimizeBytecode =
+            ShaderCompiler == SHADER_COMPILER_DXC &&
+            (pRenderDeviceVk->GetSPIRVOptimizationFlags() & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE) != 0;
+
+        // Look up the bytecode in the persistent cache. The compiler info string must capture
+        // everything that affects the generated SPIR-V and is not part of the create info.
+        if (pShaderCache != nullptr)
         {
-            case SHADER_COMPILER_DXC:
+            std::string CompilerInfo = VulkanDefine;
+            if (ShaderCompiler == SHADER_COMPILER_DXC)
             {
-                auto* pDXComiler = pRenderDeviceVk->GetDxCompiler();
-                VERIFY_EXPR(pDXComiler != nullptr && pDXComiler->IsLoaded());
-                pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
+                auto*      pDXComiler = pRenderDeviceVk->GetDxCompiler();
+                const auto MaxSM      = pDXComiler->GetMaxShaderModel();
+                CompilerInfo += "dxc " + pDXComiler->GetVersionString();
+                CompilerInfo += " sm" + std::to_string(MaxSM.Major) + '.' + std::to_string(MaxSM.Minor);
             }
-            break;
+            else
+            {
+                CompilerInfo += "glslang";
+#if !DILIGENT_NO_GLSLANG
+                CompilerInfo += ' ' + GLSLangUtils::GetVersionString();
+                CompilerInfo += " spv" + std::to_string(static_cast<int>(SpvVersion));
+#endif
+                // GLSL source is wrapped by BuildGLSLSourceString(), which depends on the device
+                if (ShaderCI.SourceLanguage != SHADER_SOURCE_LANGUAGE_HLSL && ShaderCI.SourceLanguage != SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                    CompilerInfo += ' ' + GetGLSLSourceStringCapsInfo(pRenderDeviceVk->GetDeviceCaps());
+            }
+            if (OptimizeBytecode)
+            {
+                CompilerInfo += " opt";
+#if !DILIGENT_NO_HLSL
+                CompilerInfo += ' ';
+                CompilerInfo += spvSoftwareVersionDetailsString();
+#endif
+            }
+
+            CacheKey = pShaderCache->ComputeKey(ShaderCI, CompilerInfo.c_str());
+            pShaderCache->Load(CacheKey, m_SPIRV, &CachedReflection);
+        }
 
-            case SHADER_COMPILER_DEFAULT:
-            case SHADER_COMPILER_GLSLANG:
+        if (m_SPIRV.empty())
+        {
+            switch (ShaderCompiler)
             {
-#if DILIGENT_NO_GLSLANG
-                LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
-#else
-                if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+                case SHADER_COMPILER_DXC:
                 {
-                    m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
+                    auto* pDXComiler = pRenderDeviceVk->GetDxCompiler();
+                    VERIFY_EXPR(pDXComiler != nullptr && pDXComiler->IsLoaded());
+                    pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
                 }
-                else
-                {
-                    std::string              GLSLSourceString;
-                    RefCntAutoPtr<IDataBlob> pSourceFileData;
+                break;
 
-                    const char*        ShaderSource = nullptr;
-                    size_t             SourceLength = 0;
-                    const ShaderMacro* Macros       = nullptr;
-                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                case SHADER_COMPILER_DEFAULT:
+                case SHADER_COMPILER_GLSLANG:
+                {
+#if DILIGENT_NO_GLSLANG
+                    LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
+#else
+                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
                     {
-                        // Read the source file directly and use it as is
-                        ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
-
-                        // Add user macros.
-                        // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
-                        Macros = ShaderCI.Macros;
+                        m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, SpvVersion, ShaderCI.ppCompilerOutput);
                     }
                     else
                     {
-                        // Build the full source code string that will contain GLSL version declaration,
-                        // platform definitions, user-provided shader macros, etc.
-                        GLSLSourceString = BuildGLSLSourceString(ShaderCI, pRenderDeviceVk->GetDeviceCaps(), TargetGLSLCompiler::glslang, VulkanDefine);
-                        ShaderSource     = GLSLSourceString.c_str();
-                        SourceLength     = GLSLSourceString.length();
-                    }
+                        std::string              GLSLSourceString;
+                        RefCntAutoPtr<IDataBlob> pSourceFileData;
 
-                    GLSLangUtils::SpirvVersion spvVersion = GLSLangUtils::SpirvVersion::Vk100;
-                    const auto&                ExtFeats   = GetDevice()->GetLogicalDevice().GetEnabledExtFeatures();
-                    if (ExtFeats.Spirv15)
-                        spvVersion = GLSLangUtils::SpirvVersion::Vk120;
-                    else if (ExtFeats.Spirv14)
-                        spvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
-
-                    m_SPIRV = GLSLangUtils::GLSLtoSPIRV(m_Desc.ShaderType, ShaderSource,
-                                                        static_cast<int>(SourceLength), Macros,
-                                                        ShaderCI.pShaderSourceStreamFactory,
-                                                        spvVersion,
-                                                        ShaderCI.ppCompilerOutput);
-                }
+                        const char*        ShaderSource = nullptr;
+                        size_t             SourceLength = 0;
+                        const ShaderMacro* Macros       = nullptr;
+                        if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                        {
+                            // Read the source file directly and use it as is
+                            ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+
+                            // Add user macros.
+                            // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
+                            Macros = ShaderCI.Macros;
+                        }
+                        else
+                        {
+                            // Build the full source code string that will contain GLSL version declaration,
+                            // platform definitions, user-provided shader macros, etc.
+                            GLSLSourceString = BuildGLSLSourceString(ShaderCI, pRenderDeviceVk->GetDeviceCaps(), TargetGLSLCompiler::glslang, VulkanDefine);
+                            ShaderSource     = GLSLSourceString.c_str();
+                            SourceLength     = GLSLSourceString.length();
+                        }
+
+                        m_SPIRV = GLSLangUtils::GLSLtoSPIRV(m_Desc.ShaderType, ShaderSource,
+                                                            static_cast<int>(SourceLength), Macros,
+                                                            ShaderCI.pShaderSourceStreamFactory,
+                                                            SpvVersion,
+                                                            ShaderCI.ppCompilerOutput);
+                    }
 #endif
-                break;
+                    break;
+                }
+
+                default:
+                    LOG_ERROR_AND_THROW("Unsupported shader compiler");
             }
 
-            default:
-                LOG_ERROR_AND_THROW("Unsupported shader compiler");
-        }
+            if (m_SPIRV.empty())
+            {
+                LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, '\'');
+            }
 
-        if (m_SPIRV.empty())
-        {
-            LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, '\'');
+            if (OptimizeBytecode)
+                OptimizeSPIRV(pRenderDeviceVk->GetLogicalDevice(), m_SPIRV, m_Desc.Name);
+
+            // The bytecode is stored together with the reflection data once the resources are loaded
+            StoreInCache = pShaderCache != nullptr;
         }
     }
     else if (ShaderCI.ByteCode != nullptr)
@@ -167,18 +257,44 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     auto& Allocator        = GetRawAllocator();
     auto* pRawMem          = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
     auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources       = new (pRawMem) SPIRVShaderResources //
+
+    SPIRVShaderResources* pResources = nullptr;
+    if (!CachedReflection.empty())
+    {
+        // Cached reflection data is only relocated, which is much faster than running SPIRV-Cross
+        try
+        {
+            pResources = new (pRawMem) SPIRVShaderResources{Allocator, CachedReflection.data(), CachedReflection.size(), m_Desc, m_EntryPoint};
+        }
+        catch (...)
         {
-            Allocator,
-            pRenderDeviceVk,
-            m_SPIRV,
-            m_Desc,
-            ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
-            LoadShaderInputs,
-            m_EntryPoint //
-        };
+            LOG_WARNING_MESSAGE("Failed to load cached reflection data of shader '", m_Desc.Name, "'. The byte code will be reflected.");
+            m_EntryPoint.clear();
+        }
+    }
+
+    if (pResources == nullptr)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                pRenderDeviceVk,
+                m_SPIRV,
+                m_Desc,
+                ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
+                LoadShaderInputs,
+                m_EntryPoint //
+            };
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
+    if (StoreInCache)
+    {
+        std::vector<Uint8> Reflection;
+        m_pShaderResources->Serialize(m_EntryPoint, Reflection);
+        pShaderCache->Store(CacheKey, m_SPIRV, &Reflection);
+    }
+
     if (LoadShaderInputs && m_pShaderResources->IsHLSLSource())
     {
         MapHLSLVertexShaderInputs();
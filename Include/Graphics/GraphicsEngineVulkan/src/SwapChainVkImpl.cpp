@@ -36,6 +36,33 @@
 namespace Diligent
 {
 
+namespace
+{
+
+const char* GetVkPresentModeName(VkPresentModeKHR PresentMode)
+{
+#define PRESENT_MODE_CASE(Mode) \
+    case Mode: return #Mode;
+    switch (PresentMode)
+    {
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_IMMEDIATE_KHR)
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_MAILBOX_KHR)
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_FIFO_KHR)
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_SHARED_DEMAND_REFRESH_KHR)
+        PRESENT_MODE_CASE(VK_PRESENT_MODE_SHARED_CONTINUOUS_REFRESH_KHR)
+        default: return "<UNKNOWN>";
+    }
+#undef PRESENT_MODE_CASE
+}
+
+Float32 GetSecondsSince(std::chrono::high_resolution_clock::time_point Start)
+{
+    return std::chrono::duration_cast<std::chrono::duration<Float32>>(std::chrono::high_resolution_clock::now() - Start).count();
+}
+
+} // namespace
+
 SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
                                  const SwapChainDesc& SCDesc,
                                  RenderDeviceVkImpl*  pRenderDeviceVk,
@@ -54,6 +81,29 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     CreateSurface();
     CreateVulkanSwapChain();
     InitBuffersAndViews();
+
+    {
+        FenceDesc FrameFenceDesc;
+        FrameFenceDesc.Name = "Swap chain frame complete fence";
+        pRenderDeviceVk->CreateFence(FrameFenceDesc, &m_pFrameCompleteFence);
+    }
+
+    if (pRenderDeviceVk->GetDeviceCaps().Features.DurationQueries != DEVICE_FEATURE_STATE_DISABLED)
+    {
+        // Acquire fences do not let the CPU get more than BufferCount frames ahead of the GPU,
+        // so a query is never reused before its frame has completed.
+        m_GPUTimeQueries.resize(m_SwapChainDesc.BufferCount + 1);
+        m_GPUTimeQueryFrames.resize(m_GPUTimeQueries.size());
+
+        QueryDesc GPUTimeQueryDesc;
+        GPUTimeQueryDesc.Name = "Swap chain GPU frame time query";
+        GPUTimeQueryDesc.Type = QUERY_TYPE_DURATION;
+        for (auto& pQuery : m_GPUTimeQueries)
+            pRenderDeviceVk->CreateQuery(GPUTimeQueryDesc, &pQuery);
+    }
+
+    m_LastPresentTime = std::chrono::high_resolution_clock::now();
+
     auto res = AcquireNextImage(pDeviceContextVk);
     DEV_CHECK_ERR(res == VK_SUCCESS, "Failed to acquire next image for the newly created swap chain");
     (void)res;
@@ -331,34 +381,39 @@ void SwapChainVkImpl::CreateVulkanSwapChain()
     m_SwapChainDesc.Width  = swapchainExtent.width;
     m_SwapChainDesc.Height = swapchainExtent.height;
 
-    // Mailbox is the lowest latency non-tearing presentation mode.
-    VkPresentModeKHR swapchainPresentMode = m_VSyncEnabled ? VK_PRESENT_MODE_FIFO_KHR : VK_PRESENT_MODE_MAILBOX_KHR;
+    auto IsPresentModeSupported = [&presentModes](VkPresentModeKHR PresentMode) //
+    {
+        return std::find(presentModes.begin(), presentModes.end(), PresentMode) != presentModes.end();
+    };
 
-    bool PresentModeSupported = std::find(presentModes.begin(), presentModes.end(), swapchainPresentMode) != presentModes.end();
-    if (!PresentModeSupported)
+    VkPresentModeKHR swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    switch (m_FramePacing.PresentMode)
+    {
+        // clang-format off
+        // Mailbox is the lowest latency non-tearing presentation mode.
+        case PRESENT_MODE_VK_AUTO:         swapchainPresentMode = m_VSyncEnabled ? VK_PRESENT_MODE_FIFO_KHR : VK_PRESENT_MODE_MAILBOX_KHR; break;
+        case PRESENT_MODE_VK_FIFO:         swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;         break;
+        case PRESENT_MODE_VK_FIFO_RELAXED: swapchainPresentMode = VK_PRESENT_MODE_FIFO_RELAXED_KHR; break;
+        case PRESENT_MODE_VK_MAILBOX:      swapchainPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;      break;
+        case PRESENT_MODE_VK_IMMEDIATE:    swapchainPresentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;    break;
+        // clang-format on
+        default: UNEXPECTED("Unexpected present mode");
+    }
+
+    if (!IsPresentModeSupported(swapchainPresentMode))
     {
         VERIFY(swapchainPresentMode != VK_PRESENT_MODE_FIFO_KHR, "The FIFO present mode is guaranteed by the spec to be supported");
 
-        const char* PresentModeName = nullptr;
+        // Mailbox is the closest non-tearing substitute for the immediate mode
+        auto FallbackPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+        if (swapchainPresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR && IsPresentModeSupported(VK_PRESENT_MODE_MAILBOX_KHR))
+            FallbackPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
 
-#define PRESENT_MODE_CASE(Mode) \
-    case Mode: PresentModeName = #Mode; break;
-        switch (swapchainPresentMode)
-        {
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_IMMEDIATE_KHR)
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_MAILBOX_KHR)
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_FIFO_KHR)
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_FIFO_RELAXED_KHR)
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_SHARED_DEMAND_REFRESH_KHR)
-            PRESENT_MODE_CASE(VK_PRESENT_MODE_SHARED_CONTINUOUS_REFRESH_KHR)
-            default: PresentModeName = "<UNKNOWN>";
-        }
-#undef PRESENT_MODE_CASE
-        LOG_WARNING_MESSAGE(PresentModeName, " is not supported. Defaulting to VK_PRESENT_MODE_FIFO_KHR");
+        LOG_WARNING_MESSAGE(GetVkPresentModeName(swapchainPresentMode), " is not supported. Defaulting to ", GetVkPresentModeName(FallbackPresentMode));
 
-        swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+        swapchainPresentMode = FallbackPresentMode;
         // The FIFO present mode is guaranteed by the spec to be supported
-        VERIFY(std::find(presentModes.begin(), presentModes.end(), swapchainPresentMode) != presentModes.end(), "FIFO present mode must be supported");
+        VERIFY(IsPresentModeSupported(swapchainPresentMode), "FIFO present mode must be supported");
     }
 
     // Determine the number of VkImage's to use in the swap chain.
@@ -656,6 +711,16 @@ VkResult SwapChainVkImpl::AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk)
             m_SwapChainImagesInitialized[m_BackBufferIndex] = true;
         }
         pDeviceCtxVk->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        if (!m_GPUTimeQueries.empty() && !m_GPUTimeQueryActive)
+        {
+            // The query is ended by the Present() call that completes the frame
+            const auto Frame    = m_FrameTimings.FrameNumber + 1;
+            const auto QueryIdx = static_cast<size_t>(Frame % m_GPUTimeQueries.size());
+            pDeviceCtxVk->BeginQuery(m_GPUTimeQueries[QueryIdx]);
+            m_GPUTimeQueryFrames[QueryIdx] = Frame;
+            m_GPUTimeQueryActive           = true;
+        }
     }
 
     return res;
@@ -676,6 +741,12 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
     auto* pImmediateCtxVk = pDeviceContext.RawPtr<DeviceContextVkImpl>();
     auto* pDeviceVk       = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>();
 
+    {
+        const auto CurrTime          = std::chrono::high_resolution_clock::now();
+        m_FrameTimings.FrameInterval = std::chrono::duration_cast<std::chrono::duration<Float32>>(CurrTime - m_LastPresentTime).count();
+        m_LastPresentTime            = CurrTime;
+    }
+
     auto* pBackBuffer = GetCurrentBackBufferRTV()->GetTexture();
     pImmediateCtxVk->UnbindTextureFromFramebuffer(ValidatedCast<TextureVkImpl>(pBackBuffer), false);
 
@@ -688,6 +759,16 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         pImmediateCtxVk->AddSignalSemaphore(m_DrawCompleteSemaphores[m_SemaphoreIndex]);
     }
 
+    if (m_GPUTimeQueryActive)
+    {
+        const auto QueryIdx = static_cast<size_t>((m_FrameTimings.FrameNumber + 1) % m_GPUTimeQueries.size());
+        pImmediateCtxVk->EndQuery(m_GPUTimeQueries[QueryIdx]);
+        m_GPUTimeQueryActive = false;
+    }
+
+    ++m_FrameTimings.FrameNumber;
+    pImmediateCtxVk->SignalFence(m_pFrameCompleteFence, m_FrameTimings.FrameNumber);
+
     pImmediateCtxVk->Flush();
 
     if (!m_IsMinimized)
@@ -705,6 +786,8 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         PresentInfo.pImageIndices   = &m_BackBufferIndex;
         VkResult Result             = VK_SUCCESS;
         PresentInfo.pResults        = &Result;
+
+        const auto PresentStartTime = std::chrono::high_resolution_clock::now();
         pDeviceVk->LockCmdQueueAndRun(
             0,
             [&PresentInfo](ICommandQueueVk* pCmdQueueVk) //
@@ -712,6 +795,7 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
                 pCmdQueueVk->Present(PresentInfo);
             } //
         );
+        m_FrameTimings.PresentTime = GetSecondsSince(PresentStartTime);
 
         if (Result == VK_SUBOPTIMAL_KHR || Result == VK_ERROR_OUT_OF_DATE_KHR)
         {
@@ -730,6 +814,12 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         pDeviceVk->ReleaseStaleResources();
     }
 
+    if (!m_GPUTimeQueries.empty())
+        UpdateGPUFrameTime();
+
+    // Block before the application starts the next frame and samples input for it
+    WaitForFrameLatency(pImmediateCtxVk);
+
     if (!m_IsMinimized)
     {
         ++m_SemaphoreIndex;
@@ -737,17 +827,76 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
             m_SemaphoreIndex = 0;
 
         bool EnableVSync = SyncInterval != 0;
+        // VSync setting only affects the automatically selected present mode
+        bool RecreateSwapChain = m_PresentModeChanged || (m_FramePacing.PresentMode == PRESENT_MODE_VK_AUTO && m_VSyncEnabled != EnableVSync);
+
+        const auto AcquireStartTime = std::chrono::high_resolution_clock::now();
 
-        auto res = (m_VSyncEnabled == EnableVSync) ? AcquireNextImage(pImmediateCtxVk) : VK_ERROR_OUT_OF_DATE_KHR;
+        auto res = !RecreateSwapChain ? AcquireNextImage(pImmediateCtxVk) : VK_ERROR_OUT_OF_DATE_KHR;
         if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR)
         {
-            m_VSyncEnabled = EnableVSync;
+            m_VSyncEnabled       = EnableVSync;
+            m_PresentModeChanged = false;
             RecreateVulkanSwapchain(pImmediateCtxVk);
             m_SemaphoreIndex = m_SwapChainDesc.BufferCount - 1; // To start with 0 index when acquire next image
 
             res = AcquireNextImage(pImmediateCtxVk);
         }
         DEV_CHECK_ERR(res == VK_SUCCESS, "Failed to acquire next swap chain image");
+
+        m_FrameTimings.AcquireTime = GetSecondsSince(AcquireStartTime);
+    }
+}
+
+void SwapChainVkImpl::SetFramePacing(const FramePacingAttribsVk& Attribs)
+{
+    if (Attribs.PresentMode != m_FramePacing.PresentMode)
+        m_PresentModeChanged = true;
+
+    m_FramePacing = Attribs;
+}
+
+void SwapChainVkImpl::WaitForFrameLatency(DeviceContextVkImpl* pImmediateCtxVk)
+{
+    m_FrameTimings.FrameLatencyWait = 0;
+
+    const Uint64 MaxFramesInFlight = m_FramePacing.MaxFramesInFlight;
+    if (MaxFramesInFlight == 0 || m_FrameTimings.FrameNumber < MaxFramesInFlight)
+        return;
+
+    // Frame N+1 is recorded next. To keep no more than MaxFramesInFlight frames in flight
+    // once its recording starts, frame N+1-MaxFramesInFlight must have completed.
+    const auto FrameToWait = m_FrameTimings.FrameNumber + 1 - MaxFramesInFlight;
+    if (m_pFrameCompleteFence->GetCompletedValue() >= FrameToWait)
+        return;
+
+    const auto WaitStartTime = std::chrono::high_resolution_clock::now();
+    pImmediateCtxVk->WaitForFence(m_pFrameCompleteFence, FrameToWait, false);
+    m_FrameTimings.FrameLatencyWait = GetSecondsSince(WaitStartTime);
+}
+
+void SwapChainVkImpl::UpdateGPUFrameTime()
+{
+    // Report the most recent frame whose GPU time is available. Queries of older
+    // frames that have not been read are simply reused.
+    const auto NumQueries = static_cast<Uint64>(m_GPUTimeQueries.size());
+    for (Uint64 i = 0; i < NumQueries && i < m_FrameTimings.FrameNumber; ++i)
+    {
+        const auto Frame = m_FrameTimings.FrameNumber - i;
+        if (Frame <= m_FrameTimings.GPUTimeFrameNumber)
+            break;
+
+        const auto QueryIdx = static_cast<size_t>(Frame % NumQueries);
+        if (m_GPUTimeQueryFrames[QueryIdx] != Frame)
+            continue; // The frame was not measured, e.g. the window was minimized
+
+        QueryDataDuration QueryData;
+        if (m_GPUTimeQueries[QueryIdx]->GetData(&QueryData, sizeof(QueryData), true) && QueryData.Frequency != 0)
+        {
+            m_FrameTimings.GPUTime            = static_cast<Float32>(static_cast<double>(QueryData.Duration) / static_cast<double>(QueryData.Frequency));
+            m_FrameTimings.GPUTimeFrameNumber = Frame;
+            break;
+        }
     }
 }
 
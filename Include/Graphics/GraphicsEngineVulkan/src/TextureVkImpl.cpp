@@ -43,7 +43,8 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                              FixedBlockMemoryAllocator& TexViewObjAllocator,
                              RenderDeviceVkImpl*        pRenderDeviceVk,
                              const TextureDesc&         TexDesc,
-                             const TextureData*         pInitData /*= nullptr*/) :
+                             const TextureData*         pInitData /*= nullptr*/,
+                             bool                       bDeferMemoryBinding /*= false*/) :
     // clang-format off
     TTextureBase
     {
@@ -168,6 +169,18 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             }
         }
 
+        const bool bIsTransient = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT) != 0;
+        if (bIsTransient)
+        {
+            if (bInitializeTexture)
+                LOG_ERROR_AND_THROW("Transient textures can't be initialized with data");
+
+            // If usage includes VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT, then bits other than VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+            // VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, and VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT must not be set (11.3)
+            ImageCI.usage &= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+            ImageCI.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+
         ImageCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
         ImageCI.queueFamilyIndexCount = 0;
         ImageCI.pQueueFamilyIndices   = nullptr;
@@ -181,11 +194,24 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
+        if (bDeferMemoryBinding)
+        {
+            // Memory is shared with other textures and will be bound by BindAliasedMemory().
+            // The contents of an aliased texture are undefined at the start of every lifetime,
+            // so there is nothing to initialize.
+            if (bInitializeTexture)
+                LOG_ERROR_AND_THROW("Aliased textures can't be initialized with data");
+            SetState(RESOURCE_STATE_UNDEFINED);
+            return;
+        }
+
         VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
 
         VkMemoryPropertyFlags ImageMemoryFlags = 0;
         if (m_Desc.Usage == USAGE_STAGING)
             ImageMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        else if (bIsTransient)
+            ImageMemoryFlags = pRenderDeviceVk->GetTransientAttachmentMemoryProperties(MemReqs.memoryTypeBits);
         else
             ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
@@ -197,6 +223,13 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         auto err    = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
 
+        if (bIsTransient)
+        {
+            // Transient attachments can't be used in transfer commands. Their contents are
+            // defined by the load operation of the render pass that uses them.
+            SetState(RESOURCE_STATE_UNDEFINED);
+            return;
+        }
 
         // Vulkan validation layers do not like uninitialized memory, so if no initial data
         // is provided, we will clear the memory
@@ -597,6 +630,21 @@ TextureVkImpl::~TextureVkImpl()
     if (m_StagingBuffer)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_StagingBuffer), m_Desc.CommandQueueMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
+    if (m_pAliasedMemory)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_pAliasedMemory), m_Desc.CommandQueueMask);
+}
+
+void TextureVkImpl::BindAliasedMemory(std::shared_ptr<VulkanUtilities::VulkanMemoryAllocation> pMemory, VkDeviceSize Offset)
+{
+    VERIFY(m_MemoryAllocation.Page == nullptr && !m_pAliasedMemory, "Memory has already been bound to texture '", m_Desc.Name, "'");
+    VERIFY_EXPR(pMemory && pMemory->Page != nullptr);
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    auto err = LogicalDevice.BindImageMemory(m_VulkanImage, pMemory->Page->GetVkMemory(), Offset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind aliased image memory");
+
+    m_pAliasedMemory = std::move(pMemory);
 }
 
 VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc& ViewDesc)
@@ -249,17 +249,14 @@ static VkPipelineStageFlags AccessMaskFromImageLayout(VkImageLayout Layout,
     return AccessMask;
 }
 
-void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
-                                                VkImage                        Image,
-                                                VkImageLayout                  OldLayout,
-                                                VkImageLayout                  NewLayout,
-                                                const VkImageSubresourceRange& SubresRange,
-                                                VkPipelineStageFlags           EnabledShaderStages,
-                                                VkPipelineStageFlags           SrcStages,
-                                                VkPipelineStageFlags           DestStages)
+static VkImageMemoryBarrier InitImageBarrier(VkImage                        Image,
+                                             VkImageLayout                  OldLayout,
+                                             VkImageLayout                  NewLayout,
+                                             const VkImageSubresourceRange& SubresRange,
+                                             VkPipelineStageFlags           EnabledShaderStages,
+                                             VkPipelineStageFlags&          SrcStages,
+                                             VkPipelineStageFlags&          DestStages)
 {
-    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
-
     VkImageMemoryBarrier ImgBarrier = {};
     ImgBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     ImgBarrier.pNext                = nullptr;
@@ -312,6 +309,81 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
         }
     }
 
+    return ImgBarrier;
+}
+
+static VkBufferMemoryBarrier InitBufferBarrier(VkBuffer              Buffer,
+                                               VkAccessFlags         srcAccessMask,
+                                               VkAccessFlags         dstAccessMask,
+                                               VkPipelineStageFlags  EnabledShaderStages,
+                                               VkPipelineStageFlags& SrcStages,
+                                               VkPipelineStageFlags& DestStages)
+{
+    VkBufferMemoryBarrier BuffBarrier = {};
+    BuffBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    BuffBarrier.pNext                 = nullptr;
+    BuffBarrier.srcAccessMask         = srcAccessMask;
+    BuffBarrier.dstAccessMask         = dstAccessMask;
+    BuffBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.buffer                = Buffer;
+    BuffBarrier.offset                = 0;
+    BuffBarrier.size                  = VK_WHOLE_SIZE;
+    if (SrcStages == 0)
+    {
+        if (BuffBarrier.srcAccessMask != 0)
+            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledShaderStages);
+        else
+        {
+            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage
+            // mask will effectively not wait for any prior commands to complete. (6.1.2)
+            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+    }
+
+    if (DestStages == 0)
+    {
+        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
+        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledShaderStages);
+    }
+
+    return BuffBarrier;
+}
+
+static bool SubresourceRangesOverlap(const VkImageSubresourceRange& Range0, const VkImageSubresourceRange& Range1)
+{
+    if ((Range0.aspectMask & Range1.aspectMask) == 0)
+        return false;
+
+    // VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS are ~0u, so the end below saturates to the max value
+    auto RangeEnd = [](uint32_t Start, uint32_t Count) {
+        return Count > ~Start ? ~0u : Start + Count;
+    };
+
+    if (Range0.baseMipLevel >= RangeEnd(Range1.baseMipLevel, Range1.levelCount) ||
+        Range1.baseMipLevel >= RangeEnd(Range0.baseMipLevel, Range0.levelCount))
+        return false;
+
+    if (Range0.baseArrayLayer >= RangeEnd(Range1.baseArrayLayer, Range1.layerCount) ||
+        Range1.baseArrayLayer >= RangeEnd(Range0.baseArrayLayer, Range0.layerCount))
+        return false;
+
+    return true;
+}
+
+void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
+                                                VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           EnabledShaderStages,
+                                                VkPipelineStageFlags           SrcStages,
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    auto ImgBarrier = InitImageBarrier(Image, OldLayout, NewLayout, SubresRange, EnabledShaderStages, SrcStages, DestStages);
+
     // Including a particular pipeline stage in the first synchronization scope of a command implicitly
     // includes logically earlier pipeline stages in the synchronization scope. Similarly, the second
     // synchronization scope includes logically later pipeline stages.
@@ -336,6 +408,32 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
     // of the pipeline stages in dstStageMask (6.6)
 }
 
+void VulkanCommandBuffer::EnqueueImageBarrier(VkImage                        Image,
+                                              VkImageLayout                  OldLayout,
+                                              VkImageLayout                  NewLayout,
+                                              const VkImageSubresourceRange& SubresRange,
+                                              VkAccessFlags                  ExtraSrcAccessMask,
+                                              VkPipelineStageFlags           SrcStages,
+                                              VkPipelineStageFlags           DestStages)
+{
+    // Barriers recorded by a single vkCmdPipelineBarrier are not ordered with respect to each other,
+    // so a second transition of the same subresource must wait until the pending one has been issued.
+    for (const auto& PendingBarrier : m_ImageBarriers)
+    {
+        if (PendingBarrier.image == Image && SubresourceRangesOverlap(PendingBarrier.subresourceRange, SubresRange))
+        {
+            IssuePendingBarriers();
+            break;
+        }
+    }
+
+    m_ImageBarriers.emplace_back(InitImageBarrier(Image, OldLayout, NewLayout, SubresRange, m_EnabledShaderStages, SrcStages, DestStages));
+    m_ImageBarriers.back().srcAccessMask |= ExtraSrcAccessMask;
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+    ++m_BarrierCounters.NumImageBarriers;
+}
+
 
 void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkBuffer             Buffer,
@@ -345,33 +443,7 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkPipelineStageFlags SrcStages,
                                               VkPipelineStageFlags DestStages)
 {
-    VkBufferMemoryBarrier BuffBarrier = {};
-    BuffBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    BuffBarrier.pNext                 = nullptr;
-    BuffBarrier.srcAccessMask         = srcAccessMask;
-    BuffBarrier.dstAccessMask         = dstAccessMask;
-    BuffBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.buffer                = Buffer;
-    BuffBarrier.offset                = 0;
-    BuffBarrier.size                  = VK_WHOLE_SIZE;
-    if (SrcStages == 0)
-    {
-        if (BuffBarrier.srcAccessMask != 0)
-            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledShaderStages);
-        else
-        {
-            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage
-            // mask will effectively not wait for any prior commands to complete. (6.1.2)
-            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        }
-    }
-
-    if (DestStages == 0)
-    {
-        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
-        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledShaderStages);
-    }
+    auto BuffBarrier = InitBufferBarrier(Buffer, srcAccessMask, dstAccessMask, EnabledShaderStages, SrcStages, DestStages);
 
     vkCmdPipelineBarrier(CmdBuffer,
                          SrcStages,    // must not be 0
@@ -385,6 +457,28 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                          nullptr);
 }
 
+void VulkanCommandBuffer::EnqueueBufferBarrier(VkBuffer             Buffer,
+                                               VkAccessFlags        srcAccessMask,
+                                               VkAccessFlags        dstAccessMask,
+                                               VkPipelineStageFlags SrcStages,
+                                               VkPipelineStageFlags DestStages)
+{
+    // Buffer barriers always cover the whole buffer, so any pending barrier for the same buffer conflicts
+    for (const auto& PendingBarrier : m_BufferBarriers)
+    {
+        if (PendingBarrier.buffer == Buffer)
+        {
+            IssuePendingBarriers();
+            break;
+        }
+    }
+
+    m_BufferBarriers.emplace_back(InitBufferBarrier(Buffer, srcAccessMask, dstAccessMask, m_EnabledShaderStages, SrcStages, DestStages));
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+    ++m_BarrierCounters.NumBufferBarriers;
+}
+
 void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                           VkAccessFlags        srcAccessMask,
                                           VkAccessFlags        dstAccessMask,
@@ -434,8 +528,35 @@ void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
                          nullptr);
 }
 
-void VulkanCommandBuffer::FlushBarriers()
+void VulkanCommandBuffer::IssuePendingBarriers()
 {
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pipeline barriers must not be issued inside a render pass");
+
+    const auto NumBarriers = m_ImageBarriers.size() + m_BufferBarriers.size();
+    if (NumBarriers == 0)
+        return;
+
+    // Stage masks of all pending barriers are combined. This may introduce extra execution dependencies
+    // between unrelated resources, but is still far cheaper than a separate pipeline barrier per resource.
+    vkCmdPipelineBarrier(m_VkCmdBuffer,
+                         m_PendingSrcStages, // must not be 0
+                         m_PendingDstStages, // must not be 0
+                         0,                  // a bitmask specifying how execution and memory dependencies are formed
+                         0,                  // memoryBarrierCount
+                         nullptr,            // pMemoryBarriers
+                         static_cast<uint32_t>(m_BufferBarriers.size()),
+                         m_BufferBarriers.empty() ? nullptr : m_BufferBarriers.data(),
+                         static_cast<uint32_t>(m_ImageBarriers.size()),
+                         m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+
+    ++m_BarrierCounters.NumPipelineBarriers;
+    m_BarrierCounters.NumMergedBarriers += static_cast<uint32_t>(NumBarriers - 1);
+
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+    m_PendingSrcStages = 0;
+    m_PendingDstStages = 0;
 }
 
 } // namespace VulkanUtilities
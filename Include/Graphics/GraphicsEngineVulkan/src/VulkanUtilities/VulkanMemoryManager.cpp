@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -44,10 +46,12 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
                                    VkDeviceSize          PageSize,
                                    uint32_t              MemoryTypeIndex,
                                    bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) noexcept :
+                                   VkMemoryAllocateFlags AllocateFlags,
+                                   bool                  IsDedicated) noexcept :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_IsDedicated    {IsDedicated}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
@@ -70,7 +74,8 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
         MemFlagInfo.flags = AllocateFlags;
     }
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(IsDedicated ? "Dedicated device memory. Size: " : "Device memory page. Size: ",
+                                             Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -172,16 +177,40 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
 
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    // Large resources get their own memory object: suballocating them from shared pages would
+    // either waste most of a page or require a page that is only partially used afterwards.
+    const bool IsDedicated = m_DedicatedAllocationThreshold != 0 && Size >= m_DedicatedAllocationThreshold;
+
+    if (!IsDedicated)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        auto range = m_Pages.equal_range(PageIdx);
+        for (auto page_it = range.first; page_it != range.second; ++page_it)
+        {
+            auto& Page = page_it->second;
+            if (Page.IsDedicated() || Page.IsEvacuating())
+                continue;
+
+            Allocation = Page.Allocate(Size, Alignment);
+            if (Allocation.Page != nullptr)
+                break;
+        }
     }
 
     size_t stat_ind = HostVisible ? 1 : 0;
-    if (Allocation.Page == nullptr)
+    if (IsDedicated)
+    {
+        // Offset 0 of a memory object satisfies any alignment requirement, so the page size
+        // does not need to be padded.
+        m_CurrAllocatedSize[stat_ind] += Size;
+        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+
+        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, Size, MemoryTypeIndex, HostVisible, AllocateFlags, true});
+        ++m_NumUnreservedPages;
+        OnNewPageCreated(it->second);
+        Allocation = it->second.Allocate(Size, 1);
+        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate dedicated memory");
+    }
+    else if (Allocation.Page == nullptr)
     {
         auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
         while (PageSize < Size)
@@ -213,7 +242,7 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
 void VulkanMemoryManager::ShrinkMemory()
 {
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize && m_NumUnreservedPages == 0)
         return;
 
     auto it = m_Pages.begin();
@@ -221,23 +250,118 @@ void VulkanMemoryManager::ShrinkMemory()
     {
         auto curr_it = it;
         ++it;
-        auto& Page          = curr_it->second;
-        bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto& Page = curr_it->second;
+        if (!Page.IsEmpty())
+            continue;
+
+        bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+        auto ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+        // Dedicated and evacuated pages are never kept in reserve
+        if (Page.IsDedicated() || Page.IsEvacuating() || m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
         {
+            if (Page.IsDedicated() || Page.IsEvacuating())
+            {
+                VERIFY_EXPR(m_NumUnreservedPages > 0);
+                --m_NumUnreservedPages;
+            }
             auto PageSize = Page.GetPageSize();
             m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
-                             " page (", Diligent::FormatMemorySize(PageSize, 2),
-                             "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+            if (!Page.IsDedicated())
+            {
+                LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (Page.IsEvacuating() ? "evacuated " : ""),
+                                 (IsHostVisible ? "host-visible" : "device-local"), " page (", Diligent::FormatMemorySize(PageSize, 2),
+                                 "). Current allocated size: ",
+                                 Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+            }
             OnPageDestroy(Page);
             m_Pages.erase(curr_it);
         }
     }
 }
 
+size_t VulkanMemoryManager::BeginPageEvacuation(float MaxPageOccupancy, const std::function<bool(const VulkanMemoryPage&, VkDeviceSize)>& CanEvacuate)
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    size_t NumEvacuatingPages = 0;
+    for (const auto& it : m_Pages)
+    {
+        if (it.second.IsEvacuating())
+            ++NumEvacuatingPages;
+    }
+    if (NumEvacuatingPages != 0)
+        return NumEvacuatingPages;
+
+    struct PageInfo
+    {
+        VulkanMemoryPage* pPage;
+        VkDeviceSize      UsedSize;
+    };
+
+    auto range_start = m_Pages.begin();
+    while (range_start != m_Pages.end())
+    {
+        auto range = m_Pages.equal_range(range_start->first);
+        range_start = range.second;
+        if (range.first->first.IsHostVisible)
+            continue;
+
+        std::vector<PageInfo> Candidates;
+        VkDeviceSize          FreeSpace = 0;
+        for (auto page_it = range.first; page_it != range.second; ++page_it)
+        {
+            auto& Page = page_it->second;
+            if (Page.IsDedicated())
+                continue;
+
+            VkDeviceSize UsedSize = 0;
+            {
+                std::lock_guard<std::mutex> PageLock{Page.m_Mutex};
+                UsedSize = Page.GetUsedSize();
+            }
+            const auto PageSize = Page.GetPageSize();
+            if (UsedSize != 0 && static_cast<float>(UsedSize) < MaxPageOccupancy * static_cast<float>(PageSize) && CanEvacuate(Page, UsedSize))
+                Candidates.push_back({&Page, UsedSize});
+            else
+                FreeSpace += PageSize - UsedSize;
+        }
+
+        // Evacuate the sparsest pages first, as long as their contents fit into the remaining pages.
+        // Otherwise the live allocations would just be moved into a newly created page.
+        std::sort(Candidates.begin(), Candidates.end(), [](const PageInfo& lhs, const PageInfo& rhs) { return lhs.UsedSize < rhs.UsedSize; });
+        for (const auto& Candidate : Candidates)
+        {
+            if (Candidate.UsedSize > FreeSpace)
+                break;
+            FreeSpace -= Candidate.UsedSize;
+            Candidate.pPage->m_IsEvacuating.store(true);
+            ++m_NumUnreservedPages;
+            ++NumEvacuatingPages;
+        }
+    }
+
+    if (NumEvacuatingPages != 0)
+    {
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': evacuating ", NumEvacuatingPages,
+                         (NumEvacuatingPages == 1 ? " sparse device-local page" : " sparse device-local pages"));
+    }
+
+    return NumEvacuatingPages;
+}
+
+void VulkanMemoryManager::CancelPageEvacuation()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (auto& it : m_Pages)
+    {
+        if (it.second.m_IsEvacuating.exchange(false))
+        {
+            VERIFY_EXPR(m_NumUnreservedPages > 0);
+            --m_NumUnreservedPages;
+        }
+    }
+}
+
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
 {
     m_CurrUsedSize[IsHostVisble ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
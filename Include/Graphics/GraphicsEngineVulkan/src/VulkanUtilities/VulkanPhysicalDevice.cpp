@@ -173,6 +173,9 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
         if (IsExtensionSupported(VK_KHR_SPIRV_1_4_EXTENSION_NAME))
             m_ExtFeatures.Spirv14 = true;
 
+        if (IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+            m_ExtFeatures.DrawIndirectCount = true;
+
         // Some features requires SPIRV 1.4 or 1.5 that added to Vulkan 1.2 core.
         if (Instance.GetVkVersion() >= VK_API_VERSION_1_2)
         {
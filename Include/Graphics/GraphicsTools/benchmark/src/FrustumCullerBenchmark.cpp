@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Frustum culling benchmark.
+//
+// Usage:
+//
+//     Diligent-FrustumCullerBenchmark [<max threads> [<instances> [<views>]]]
+//
+// Generates <instances> (1M by default) random boxes in a cube and culls them against <views> (1 by default)
+// frustums that see about a sixth of the cube. Culling is run with 1, 2, 4, ... up to <max threads>
+// (the number of hardware threads by default) worker threads of a persistent thread pool, and the
+// time of a single Cull() call is compared with the target of 1M instances in 1 ms. The visible
+// lists of every run are checked against the single-threaded result.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "FrustumCuller.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Minimal persistent thread pool. Threads are not created per Cull() call, as that
+// alone would take a noticeable part of the 1 ms budget.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(Uint32 NumThreads)
+    {
+        // The calling thread is one of the workers
+        for (Uint32 i = 1; i < NumThreads; ++i)
+            m_Threads.emplace_back([this]() { WorkerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        for (auto& Thread : m_Threads)
+            Thread.join();
+    }
+
+    void ParallelFor(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task)
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_pTask     = &Task;
+            m_NumTasks  = NumTasks;
+            m_NextTask  = 0;
+            m_Remaining = NumTasks;
+            ++m_Generation;
+        }
+        m_CV.notify_all();
+
+        RunTasks();
+
+        // Wait until the tasks picked up by other workers are complete
+        while (m_Remaining.load() != 0)
+            std::this_thread::yield();
+    }
+
+private:
+    void RunTasks()
+    {
+        for (Uint32 TaskId = m_NextTask++; TaskId < m_NumTasks; TaskId = m_NextTask++)
+        {
+            (*m_pTask)(TaskId);
+            --m_Remaining;
+        }
+    }
+
+    void WorkerLoop()
+    {
+        Uint64 Generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> Lock{m_Mtx};
+                m_CV.wait(Lock, [&]() { return m_Stop || m_Generation != Generation; });
+                if (m_Stop)
+                    return;
+                Generation = m_Generation;
+            }
+            RunTasks();
+        }
+    }
+
+    std::vector<std::thread> m_Threads;
+
+    std::mutex              m_Mtx;
+    std::condition_variable m_CV;
+    bool                    m_Stop       = false;
+    Uint64                  m_Generation = 0;
+
+    const std::function<void(Uint32 TaskId)>* m_pTask    = nullptr;
+    Uint32                                    m_NumTasks = 0;
+    std::atomic<Uint32>                       m_NextTask{0};
+    std::atomic<Uint32>                       m_Remaining{0};
+};
+
+// Frustum of a view looking along +Z from Origin with a 90-degree field of view
+ViewFrustum MakeFrustum(const float3& Origin, float FarDist)
+{
+    ViewFrustum Frustum;
+
+    // clang-format off
+    Frustum.LeftPlane.Normal   = float3{ 1,  0,  1};
+    Frustum.RightPlane.Normal  = float3{-1,  0,  1};
+    Frustum.BottomPlane.Normal = float3{ 0,  1,  1};
+    Frustum.TopPlane.Normal    = float3{ 0, -1,  1};
+    Frustum.NearPlane.Normal   = float3{ 0,  0,  1};
+    Frustum.FarPlane.Normal    = float3{ 0,  0, -1};
+    // clang-format on
+
+    // Planes are defined as dot(Normal, Point) + Distance >= 0 for points inside the frustum
+    Frustum.LeftPlane.Distance   = -dot(Frustum.LeftPlane.Normal, Origin);
+    Frustum.RightPlane.Distance  = -dot(Frustum.RightPlane.Normal, Origin);
+    Frustum.BottomPlane.Distance = -dot(Frustum.BottomPlane.Normal, Origin);
+    Frustum.TopPlane.Distance    = -dot(Frustum.TopPlane.Normal, Origin);
+    Frustum.NearPlane.Distance   = -dot(Frustum.NearPlane.Normal, Origin) - 0.1f;
+    Frustum.FarPlane.Distance    = dot(Frustum.NearPlane.Normal, Origin) + FarDist;
+
+    return Frustum;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Uint32 MaxThreads   = argc > 1 ? static_cast<Uint32>(std::max(std::atoi(argv[1]), 1)) : std::max(std::thread::hardware_concurrency(), 1u);
+    const Uint32 NumInstances = argc > 2 ? static_cast<Uint32>(std::max(std::atoi(argv[2]), 1)) : 1000000;
+    const Uint32 NumViews     = argc > 3 ? static_cast<Uint32>(std::max(std::atoi(argv[3]), 1)) : 1;
+
+    static constexpr float  SceneSize     = 1000;
+    static constexpr Uint32 NumIterations = 50;
+
+    std::vector<BoundBox> Boxes(NumInstances);
+    {
+        std::mt19937                          Rng{1};
+        std::uniform_real_distribution<float> Pos{-SceneSize / 2, SceneSize / 2};
+        std::uniform_real_distribution<float> Size{0.5f, 5.f};
+        for (auto& Box : Boxes)
+        {
+            const float3 Center{Pos(Rng), Pos(Rng), Pos(Rng)};
+            const float3 HalfSize{Size(Rng), Size(Rng), Size(Rng)};
+            Box.Min = Center - HalfSize;
+            Box.Max = Center + HalfSize;
+        }
+    }
+
+    std::vector<ViewFrustum> Frustums(NumViews);
+    for (Uint32 v = 0; v < NumViews; ++v)
+        Frustums[v] = MakeFrustum(float3{static_cast<float>(v) * 10.f, 0, 0}, SceneSize / 2);
+
+    std::vector<std::vector<Uint32>> Reference(NumViews);
+    std::vector<std::vector<Uint32>> VisibleLists(NumViews);
+
+    std::cout << "SIMD width: " << FrustumCuller::GetSIMDWidth() << ", instances: " << NumInstances
+              << ", views: " << NumViews << '\n';
+
+    double SingleThreadTime = 0;
+    for (Uint32 NumThreads = 1;; NumThreads = std::min(NumThreads * 2, MaxThreads))
+    {
+        ThreadPool Pool{NumThreads};
+
+        FrustumCuller::CreateInfo CI;
+        if (NumThreads > 1)
+        {
+            CI.ParallelFor = [&Pool](Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) {
+                Pool.ParallelFor(NumTasks, Task);
+            };
+        }
+
+        FrustumCuller Culler{CI};
+        Culler.SetNumInstances(NumInstances);
+        for (Uint32 i = 0; i < NumInstances; ++i)
+            Culler.SetBounds(i, Boxes[i]);
+
+        // Warm-up
+        Culler.Cull(Frustums.data(), NumViews, VisibleLists.data());
+
+        auto BestTime = 1e+10;
+        for (Uint32 it = 0; it < NumIterations; ++it)
+        {
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            Culler.Cull(Frustums.data(), NumViews, VisibleLists.data());
+            const auto Time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - StartTime).count();
+            BestTime        = std::min(BestTime, Time);
+        }
+
+        if (NumThreads == 1)
+        {
+            SingleThreadTime = BestTime;
+            Reference        = VisibleLists;
+        }
+        else if (VisibleLists != Reference)
+        {
+            std::cerr << NumThreads << " thread(s): visible lists do not match the single-threaded result\n";
+            return EXIT_FAILURE;
+        }
+
+        // Time the target of 1M instances in 1 ms is scaled to
+        const auto TargetTime = 1e-3 * NumInstances / 1e+6;
+        std::cout << NumThreads << " thread(s): " << BestTime * 1000.0 << " ms per cull, "
+                  << NumInstances * NumViews / BestTime / 1e+9 << " G instance-views/s, scaling "
+                  << SingleThreadTime / BestTime << "x, visible " << VisibleLists[0].size() << ", "
+                  << (BestTime <= TargetTime ? "meets" : "misses") << " the 1M/ms target\n";
+
+        if (NumThreads == MaxThreads)
+            break;
+    }
+
+    return EXIT_SUCCESS;
+}
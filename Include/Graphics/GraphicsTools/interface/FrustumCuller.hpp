@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a FrustumCuller class
+
+#include <vector>
+#include <functional>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// CPU frustum culler that tests bounding volumes of many instances against one or more views.
+
+/// The culler keeps instance bounds in structure-of-arrays form: a bounding sphere and an
+/// axis-aligned bounding box (stored as center and half-extents) per instance. The test is
+/// performed for 8 instances at a time with AVX, 4 instances with SSE, or one instance
+/// when neither is available at compile time. An instance is visible in a view when both its
+/// sphere and its box intersect the view frustum: the cheap sphere test rejects most of the
+/// instances and the box test removes the false positives of loose spheres.
+///
+/// Instances are split into partitions that are culled in parallel through the optional
+/// ParallelFor callback (e.g. backed by an enkiTS task set), and every partition is tested
+/// against all views while its bounds are in cache.
+class FrustumCuller
+{
+public:
+    /// Runs NumTasks invocations of Task, possibly in parallel, and returns when all of them have completed.
+    using ParallelForType = std::function<void(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task)>;
+
+    struct CreateInfo
+    {
+        /// Optional parallel-for implementation (e.g. backed by a task scheduler).
+        /// When not provided, culling runs on the calling thread.
+        ParallelForType ParallelFor;
+
+        /// Number of instances in a single partition. Rounded up to a multiple of 8.
+        Uint32 InstancesPerPartition = 16384;
+    };
+
+    explicit FrustumCuller(const CreateInfo& CI);
+
+    // clang-format off
+    FrustumCuller           (const FrustumCuller&)  = delete;
+    FrustumCuller& operator=(const FrustumCuller&)  = delete;
+    FrustumCuller           (      FrustumCuller&&) = delete;
+    FrustumCuller& operator=(      FrustumCuller&&) = delete;
+    // clang-format on
+
+
+    /// Sets the number of instances. Bounds of new instances are empty boxes at the origin.
+    void SetNumInstances(Uint32 NumInstances);
+
+
+    /// Sets the bounds of an instance. The bounding sphere is the sphere circumscribed around the box.
+    void SetBounds(Uint32 Index, const BoundBox& Box);
+
+
+    /// Sets the bounds of an instance.
+
+    /// \param[in] Index        - Instance index.
+    /// \param[in] Box          - World-space bounding box.
+    /// \param[in] SphereCenter - World-space center of the bounding sphere.
+    /// \param[in] SphereRadius - Radius of the bounding sphere.
+    void SetBounds(Uint32 Index, const BoundBox& Box, const float3& SphereCenter, float SphereRadius);
+
+
+    /// Culls all instances against the views.
+
+    /// \param[in]  pFrustums     - Array of NumViews view frustums. The planes do not need to be normalized.
+    /// \param[in]  NumViews      - Number of views.
+    /// \param[out] pVisibleLists - Array of NumViews lists that receive indices of visible instances
+    ///                             in ascending order.
+    void Cull(const ViewFrustum* pFrustums, Uint32 NumViews, std::vector<Uint32>* pVisibleLists);
+
+
+    /// Returns the number of instances.
+    Uint32 GetNumInstances() const
+    {
+        return m_NumInstances;
+    }
+
+
+    /// Returns the number of instances the SIMD path processes at a time (8, 4 or 1).
+    static Uint32 GetSIMDWidth();
+
+private:
+    void RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const;
+
+    const CreateInfo m_CI;
+    const Uint32     m_PartitionSize;
+
+    Uint32 m_NumInstances = 0;
+
+    // Arrays are padded to a multiple of 8 elements, so that SIMD loads never read out of bounds
+    std::vector<float> m_SphereX;
+    std::vector<float> m_SphereY;
+    std::vector<float> m_SphereZ;
+    std::vector<float> m_SphereR;
+    std::vector<float> m_BoxCenterX;
+    std::vector<float> m_BoxCenterY;
+    std::vector<float> m_BoxCenterZ;
+    std::vector<float> m_BoxExtentX;
+    std::vector<float> m_BoxExtentY;
+    std::vector<float> m_BoxExtentZ;
+
+    std::vector<Uint32> m_PartitionCounts;
+    std::vector<Uint32> m_Scratch;
+};
+
+} // namespace Diligent
@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a GPUInstanceCuller class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "HiZPyramid.hpp"
+
+namespace Diligent
+{
+
+/// Scene instance as it is laid out in the instance buffer of the GPU instance culler.
+struct GPUCullInstanceData
+{
+    /// Object-to-world transform rows (row-vector convention, i.e. the memory layout of float4x4).
+    float4 Transform[4];
+
+    /// Object-space bounding sphere: xyz - center, w - radius.
+    float4 BoundingSphere;
+
+    /// Index of the mesh in the mesh buffer.
+    Uint32 MeshId = 0;
+
+    Uint32 Padding[3] = {};
+};
+static_assert(sizeof(GPUCullInstanceData) % 16 == 0, "Instance data size must be a multiple of 16 bytes");
+
+
+/// Mesh draw arguments as they are laid out in the mesh buffer of the GPU instance culler.
+struct GPUCullMeshData
+{
+    /// Number of indices of the mesh.
+    Uint32 NumIndices = 0;
+
+    /// Location of the first index of the mesh in the index buffer.
+    Uint32 FirstIndexLocation = 0;
+
+    /// Value added to every index before reading the vertex.
+    Int32 BaseVertex = 0;
+
+    Uint32 Padding = 0;
+};
+static_assert(sizeof(GPUCullMeshData) == 16, "Mesh data size must be 16 bytes");
+
+
+/// GPU instance culler create info.
+struct GPUInstanceCullerCreateInfo
+{
+    /// Render device. Must support compute shaders, indirect draw count and non-zero first
+    /// instance in indirect draw commands (DeviceFeatures::DrawIndirectFirstInstance).
+    IRenderDevice* pDevice = nullptr;
+
+    /// Maximum number of instances in the scene.
+    Uint32 MaxInstances = 0;
+
+    /// Maximum number of meshes in the scene.
+    Uint32 MaxMeshes = 0;
+
+    /// Compute shader thread group size.
+    Uint32 ThreadGroupSize = 64;
+
+    /// Whether to create the pipeline that additionally tests instances against a Hi-Z pyramid.
+    bool EnableOcclusionCulling = false;
+};
+
+
+/// Occlusion culling attributes of the GPU instance culler.
+struct GPUCullOcclusionAttribs
+{
+    /// Hi-Z pyramid built from the depth buffer of a previously rendered frame.
+    HiZPyramid* pHiZ = nullptr;
+
+    /// View-projection matrix the depth buffer of the Hi-Z pyramid was rendered with.
+    float4x4 HiZViewProj;
+};
+
+
+/// Culls scene instances on the GPU and draws the visible ones with a single indirect draw call.
+
+/// The culler keeps all scene instances in a structured buffer. Every frame, a compute shader
+/// tests the bounding sphere of every instance against the view frustum and, optionally, against
+/// the Hi-Z pyramid of the previous frame, and appends a
+/// DrawIndexed command for every visible instance to the indirect arguments buffer. The number
+/// of commands is written to the count buffer, and the commands are submitted with
+/// IDeviceContext::DrawIndexedIndirectCount(), so the CPU never touches individual objects.
+///
+/// FirstInstanceLocation of the command written for slot i is i, and element i of the visible
+/// instance buffer contains the index of the instance in the scene. An application binds the
+/// visible instance buffer as a per-instance vertex stream with VT_UINT32 format to fetch the
+/// instance index in the vertex shader, which works the same way on all backends.
+class GPUInstanceCuller
+{
+public:
+    explicit GPUInstanceCuller(const GPUInstanceCullerCreateInfo& CI);
+
+    // clang-format off
+    GPUInstanceCuller           (const GPUInstanceCuller&)  = delete;
+    GPUInstanceCuller& operator=(const GPUInstanceCuller&)  = delete;
+    GPUInstanceCuller           (      GPUInstanceCuller&&) = delete;
+    GPUInstanceCuller& operator=(      GPUInstanceCuller&&) = delete;
+    // clang-format on
+
+
+    /// Uploads scene instances to the instance buffer.
+
+    /// \param[in] pContext      - Device context.
+    /// \param[in] FirstInstance - Index of the first instance to update.
+    /// \param[in] NumInstances  - Number of instances to update.
+    /// \param[in] pInstances    - Instance data.
+    void UpdateInstances(IDeviceContext* pContext, Uint32 FirstInstance, Uint32 NumInstances, const GPUCullInstanceData* pInstances);
+
+
+    /// Uploads mesh draw arguments to the mesh buffer.
+    void UpdateMeshes(IDeviceContext* pContext, Uint32 FirstMesh, Uint32 NumMeshes, const GPUCullMeshData* pMeshes);
+
+
+    /// Sets the number of instances in the scene.
+    void SetNumInstances(Uint32 NumInstances);
+
+
+    /// Runs the culling compute shader.
+
+    /// \param[in] pContext   - Device context. Must not be inside a render pass.
+    /// \param[in] ViewProj   - View-projection matrix of the camera.
+    /// \param[in] pOcclusion - Optional occlusion culling attributes. The culler must be created
+    ///                          with EnableOcclusionCulling flag to use them.
+    ///
+    /// \remarks    Instances are tested against the depth of the frame that produced the Hi-Z pyramid,
+    ///             so objects that were hidden in that frame but become visible in the current one
+    ///             appear one frame late.
+    void Cull(IDeviceContext* pContext, const float4x4& ViewProj, const GPUCullOcclusionAttribs* pOcclusion = nullptr);
+
+
+    /// Draws the instances that passed the culling test.
+
+    /// \param[in] pContext  - Device context. The pipeline state, shader resources, vertex buffers
+    ///                        and the index buffer must be set by the application.
+    /// \param[in] IndexType - Index type.
+    void Draw(IDeviceContext* pContext, VALUE_TYPE IndexType);
+
+
+    /// Returns the scene instance buffer.
+    IBuffer* GetInstanceBuffer() { return m_pInstanceBuffer; }
+
+    /// Returns the buffer that contains indices of visible instances.
+    IBuffer* GetVisibleInstanceBuffer() { return m_pVisibleInstanceBuffer; }
+
+    /// Returns the indirect draw arguments buffer.
+    IBuffer* GetDrawArgsBuffer() { return m_pDrawArgsBuffer; }
+
+    /// Returns the draw count buffer.
+    IBuffer* GetDrawCountBuffer() { return m_pDrawCountBuffer; }
+
+private:
+    RefCntAutoPtr<IPipelineState> CreateCullPSO(bool OcclusionCulling);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_MaxInstances;
+    const Uint32 m_MaxMeshes;
+    const Uint32 m_ThreadGroupSize;
+    Uint32       m_NumInstances = 0;
+
+    RefCntAutoPtr<IBuffer> m_pInstanceBuffer;
+    RefCntAutoPtr<IBuffer> m_pMeshBuffer;
+    RefCntAutoPtr<IBuffer> m_pVisibleInstanceBuffer;
+    RefCntAutoPtr<IBuffer> m_pDrawArgsBuffer;
+    RefCntAutoPtr<IBuffer> m_pDrawCountBuffer;
+    RefCntAutoPtr<IBuffer> m_pCullAttribsCB;
+
+    RefCntAutoPtr<IBufferView> m_pDrawArgsUAV;
+    RefCntAutoPtr<IBufferView> m_pVisibleInstanceUAV;
+    RefCntAutoPtr<IBufferView> m_pDrawCountUAV;
+
+    RefCntAutoPtr<IPipelineState>         m_pCullPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pCullSRB;
+    RefCntAutoPtr<IPipelineState>         m_pOcclusionCullPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pOcclusionCullSRB;
+};
+
+} // namespace Diligent
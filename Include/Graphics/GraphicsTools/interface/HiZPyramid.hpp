@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a HiZPyramid class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Hi-Z pyramid create info.
+struct HiZPyramidCreateInfo
+{
+    /// Render device.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Width of the depth buffer the pyramid is built from.
+    Uint32 Width = 0;
+
+    /// Height of the depth buffer the pyramid is built from.
+    Uint32 Height = 0;
+};
+
+
+/// Hierarchical depth buffer used for occlusion culling.
+
+/// The pyramid is an R32_FLOAT texture with a full mip chain. The most detailed level is a copy
+/// of the depth buffer, and every texel of the following levels is the maximum (i.e. the farthest)
+/// depth of the texels it covers, so an object whose nearest depth is farther than the pyramid
+/// value over its screen-space bounds is guaranteed to be occluded.
+///
+/// On Vulkan, the mip chain is built by IDeviceContextVk::GenerateMaxReductionMips(), which
+/// reduces up to four levels per dispatch. Other backends use a single-level reduction shader.
+class HiZPyramid
+{
+public:
+    explicit HiZPyramid(const HiZPyramidCreateInfo& CI);
+
+    // clang-format off
+    HiZPyramid           (const HiZPyramid&)  = delete;
+    HiZPyramid& operator=(const HiZPyramid&)  = delete;
+    HiZPyramid           (      HiZPyramid&&) = delete;
+    HiZPyramid& operator=(      HiZPyramid&&) = delete;
+    // clang-format on
+
+
+    /// Builds the pyramid from the depth buffer.
+
+    /// \param[in] pContext  - Device context. Must not be inside a render pass.
+    /// \param[in] pDepthSRV - Shader resource view of a non-multisampled depth buffer
+    ///                        with the dimensions given at creation.
+    ///
+    /// \remarks    When the pyramid is built at the end of a frame, it is used to cull the
+    ///             next frame with the view-projection matrix of the frame that produced it.
+    ///             After the method returns, the pyramid is in RESOURCE_STATE_SHADER_RESOURCE state.
+    void Build(IDeviceContext* pContext, ITextureView* pDepthSRV);
+
+
+    /// Returns the shader resource view of the whole mip chain.
+    ITextureView* GetSRV() { return m_pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE); }
+
+    /// Returns the pyramid texture.
+    ITexture* GetTexture() { return m_pTexture; }
+
+    /// Returns the width of the most detailed level.
+    Uint32 GetWidth() const { return m_Width; }
+
+    /// Returns the height of the most detailed level.
+    Uint32 GetHeight() const { return m_Height; }
+
+    /// Returns the number of mip levels.
+    Uint32 GetNumMipLevels() const { return m_NumMips; }
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_Width;
+    const Uint32 m_Height;
+    Uint32       m_NumMips = 0;
+
+    RefCntAutoPtr<ITexture>               m_pTexture;
+    RefCntAutoPtr<IBuffer>                m_pAttribsCB;
+    RefCntAutoPtr<IPipelineState>         m_pCopyPSO;
+    RefCntAutoPtr<IPipelineState>         m_pReducePSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pCopySRB;
+    RefCntAutoPtr<IShaderResourceBinding> m_pReduceSRB;
+
+    // Single-level views used by the portable reduction path
+    std::vector<RefCntAutoPtr<ITextureView>> m_MipUAVs;
+};
+
+} // namespace Diligent
@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of an InstanceBatcher class
+
+#include <vector>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/HashUtils.hpp"
+#include "StreamingBuffer.hpp"
+
+namespace Diligent
+{
+
+/// Describes a mesh draw whose instances may be merged by the instance batcher.
+
+/// \remarks Two draws are merged if all members of the structure are equal.
+///          NumInstances and FirstInstanceLocation members of the indexed draw
+///          attributes are ignored.
+struct InstancedDrawDesc
+{
+    /// Maximum number of per-vertex buffers a draw may use.
+    static constexpr Uint32 MaxVertexBuffers = 4;
+
+    /// Pipeline state to draw with. The pipeline must read per-instance data
+    /// from the vertex buffer slot set by InstanceBatcherCreateInfo::InstanceBufferSlot.
+    IPipelineState* pPSO = nullptr;
+
+    /// Shader resource binding to commit. May be null if the pipeline has no resources.
+    IShaderResourceBinding* pSRB = nullptr;
+
+    /// Per-vertex buffers bound to slots [0, NumVertexBuffers).
+    IBuffer* pVertexBuffers[MaxVertexBuffers] = {};
+
+    /// Offsets of the per-vertex buffers, in bytes.
+    Uint32 VertexOffsets[MaxVertexBuffers] = {};
+
+    /// Number of per-vertex buffers.
+    Uint32 NumVertexBuffers = 0;
+
+    /// Index buffer.
+    IBuffer* pIndexBuffer = nullptr;
+
+    /// Offset of the index data, in bytes.
+    Uint32 IndexOffset = 0;
+
+    /// Indexed draw attributes.
+    DrawIndexedAttribs Attribs;
+
+    bool operator==(const InstancedDrawDesc& rhs) const;
+
+    struct Hasher
+    {
+        size_t operator()(const InstancedDrawDesc& Desc) const;
+    };
+};
+
+
+struct InstanceBatcherCreateInfo
+{
+    /// Render device.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Size of the data of a single instance, in bytes (e.g. 64 for a float4x4 transform).
+    Uint32 InstanceDataSize = 0;
+
+    /// Initial size of the instance stream buffer, in bytes. The buffer grows as necessary.
+    Uint32 InitialBufferSize = 64 << 10;
+
+    /// Vertex buffer slot the instance stream is bound to. Must not be less than
+    /// the number of per-vertex buffers used by any draw.
+    Uint32 InstanceBufferSlot = 1;
+
+    /// Number of contexts that flush the batcher.
+    Uint32 NumContexts = 1;
+
+    /// State transition mode used when vertex, index buffers and shader resources are bound.
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    /// Instance stream buffer name.
+    const char* Name = "Instance stream";
+};
+
+
+/// Merges draws of the same mesh and material into instanced draw calls.
+
+/// The batcher groups instances of draws that share the pipeline state, shader resource binding,
+/// vertex and index buffers and draw attributes. When the batcher is flushed, per-instance data of all
+/// batches is written to a streaming vertex buffer with a single map operation, and every batch is drawn
+/// with one DrawIndexed() call.
+///
+/// \remarks The batcher does not keep references to the objects in the draw descriptions.
+///          An application must keep them alive until the batcher is flushed.
+///          Different contexts must not add draws to the same batcher simultaneously.
+class InstanceBatcher
+{
+public:
+    explicit InstanceBatcher(const InstanceBatcherCreateInfo& CI);
+
+    // clang-format off
+    InstanceBatcher           (const InstanceBatcher&)  = delete;
+    InstanceBatcher& operator=(const InstanceBatcher&)  = delete;
+    InstanceBatcher           (      InstanceBatcher&&) = delete;
+    InstanceBatcher& operator=(      InstanceBatcher&&) = delete;
+    // clang-format on
+
+
+    /// Adds instances of the draw to the batcher.
+
+    /// \param[in] Draw          - Draw description.
+    /// \param[in] pInstanceData - Per-instance data, NumInstances * InstanceDataSize bytes.
+    /// \param[in] NumInstances  - Number of instances to add.
+    void AddInstances(const InstancedDrawDesc& Draw, const void* pInstanceData, Uint32 NumInstances = 1);
+
+
+    /// Uploads per-instance data and issues one instanced draw call per batch.
+
+    /// \param[in] pContext - Device context to record commands to.
+    /// \param[in] CtxNum   - Index of the context, must be less than InstanceBatcherCreateInfo::NumContexts.
+    ///
+    /// \remarks Batches are drawn in the order their first instance was added.
+    ///          All batches are removed after the method returns.
+    void Flush(IDeviceContext* pContext, size_t CtxNum = 0);
+
+
+    /// Removes all batches without drawing them.
+    void Clear();
+
+
+    /// Returns the number of batches, i.e. the number of draw calls the next Flush() will issue.
+    Uint32 GetNumBatches() const
+    {
+        return m_NumBatches;
+    }
+
+
+    /// Returns the number of instances in all batches.
+    Uint32 GetNumInstances() const
+    {
+        return m_NumInstances;
+    }
+
+
+    /// Returns the instance stream buffer.
+    IBuffer* GetInstanceBuffer() const
+    {
+        return m_InstanceStream.GetBuffer();
+    }
+
+private:
+    struct Batch
+    {
+        InstancedDrawDesc  Draw;
+        std::vector<Uint8> InstanceData;
+        Uint32             NumInstances = 0;
+    };
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32                         m_InstanceDataSize;
+    const Uint32                         m_InstanceBufferSlot;
+    const RESOURCE_STATE_TRANSITION_MODE m_StateTransitionMode;
+
+    StreamingBuffer m_InstanceStream;
+
+    // Batch storage is reused between flushes to avoid reallocating instance data arrays
+    std::vector<Batch> m_Batches;
+    Uint32             m_NumBatches   = 0;
+    Uint32             m_NumInstances = 0;
+
+    std::unordered_map<InstancedDrawDesc, Uint32, InstancedDrawDesc::Hasher> m_BatchIndices;
+};
+
+} // namespace Diligent
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a PipelineArchive class
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Creates pipeline states from an archive of precompiled shaders and pipeline descriptions.
+
+/// Archives are produced offline by the Diligent-PipelineBaker tool from a JSON manifest.
+/// Shaders are stored as SPIR-V bytecode, so pipelines are created without compiling any
+/// source code at run time, and the archive can only be used with a Vulkan device.
+/// Shaders shared by several pipelines are stored and created once.
+class PipelineArchive
+{
+public:
+    struct ShaderData
+    {
+        std::string         Name;
+        SHADER_TYPE         ShaderType = SHADER_TYPE_UNKNOWN;
+        std::string         EntryPoint;
+        std::vector<Uint32> SPIRV;
+
+        bool        UseCombinedTextureSamplers = false;
+        std::string CombinedSamplerSuffix      = "_sampler";
+    };
+
+    struct StageShader
+    {
+        SHADER_TYPE Stage       = SHADER_TYPE_UNKNOWN;
+        Uint32      ShaderIndex = 0;
+    };
+
+    struct LayoutElementData
+    {
+        std::string HLSLSemantic;
+
+        /// Layout element; HLSLSemantic member is ignored.
+        LayoutElement Element;
+    };
+
+    struct VariableData
+    {
+        SHADER_TYPE                   ShaderStages = SHADER_TYPE_UNKNOWN;
+        std::string                   Name;
+        SHADER_RESOURCE_VARIABLE_TYPE Type = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    };
+
+    struct ImmutableSamplerData
+    {
+        SHADER_TYPE ShaderStages = SHADER_TYPE_UNKNOWN;
+        std::string SamplerOrTextureName;
+
+        /// Sampler description; Name member is ignored.
+        SamplerDesc Desc;
+    };
+
+    struct PipelineData
+    {
+        std::string   Name;
+        PIPELINE_TYPE PipelineType = PIPELINE_TYPE_GRAPHICS;
+
+        /// Shader of every stage, as an index in the archive shader list.
+        std::vector<StageShader> Shaders;
+
+        /// Graphics pipeline description; input layout and render pass members are ignored.
+        GraphicsPipelineDesc GraphicsPipeline;
+
+        std::vector<LayoutElementData> InputLayout;
+
+        SHADER_RESOURCE_VARIABLE_TYPE     DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        std::vector<VariableData>         Variables;
+        std::vector<ImmutableSamplerData> ImmutableSamplers;
+    };
+
+    /// Writes the archive with the given shaders and pipelines to Data.
+    static void Serialize(const std::vector<ShaderData>&   Shaders,
+                          const std::vector<PipelineData>& Pipelines,
+                          std::vector<Uint8>&              Data);
+
+
+    /// Loads the archive produced by Serialize(). The data is copied and may be released after
+    /// the archive is created. Throws an exception if the data is invalid or the device is not Vulkan.
+    PipelineArchive(IRenderDevice* pDevice, const void* pData, size_t DataSize) noexcept(false);
+
+    // clang-format off
+    PipelineArchive           (const PipelineArchive&)  = delete;
+    PipelineArchive& operator=(const PipelineArchive&)  = delete;
+    PipelineArchive           (      PipelineArchive&&) = delete;
+    PipelineArchive& operator=(      PipelineArchive&&) = delete;
+    // clang-format on
+
+
+    Uint32 GetPipelineCount() const { return static_cast<Uint32>(m_Pipelines.size()); }
+
+    const PipelineData& GetPipelineData(Uint32 Index) const
+    {
+        VERIFY_EXPR(Index < m_Pipelines.size());
+        return m_Pipelines[Index];
+    }
+
+    /// Returns the index of the pipeline with the given name, or -1 if there is no such pipeline.
+    Int32 FindPipeline(const Char* Name) const;
+
+
+    /// Creates the pipeline state with the given index. Shaders are created on first use and
+    /// are shared by all pipelines that use them. Returns null if the pipeline could not be created.
+    RefCntAutoPtr<IPipelineState> CreatePipeline(Uint32 Index);
+
+    /// Creates the pipeline state with the given name.
+    RefCntAutoPtr<IPipelineState> CreatePipeline(const Char* Name);
+
+private:
+    IShader* GetShader(Uint32 ShaderIndex);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    std::vector<ShaderData>             m_ShaderData;
+    std::vector<RefCntAutoPtr<IShader>> m_Shaders;
+
+    std::vector<PipelineData>               m_Pipelines;
+    std::unordered_map<std::string, Uint32> m_PipelineIndices;
+};
+
+} // namespace Diligent
@@ -0,0 +1,354 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a RenderGraph class
+
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+class RenderGraph;
+
+/// Identifies a resource registered in a render graph.
+using RenderGraphResourceId = Uint32;
+
+/// Invalid render graph resource identifier.
+static constexpr RenderGraphResourceId InvalidRenderGraphResourceId = ~0u;
+
+
+/// Arguments passed to the render graph pass execute callback.
+struct RenderGraphPassContext
+{
+    /// Context to record the pass commands to. This is either the immediate context
+    /// or one of the deferred contexts of the graph.
+    IDeviceContext* pContext = nullptr;
+
+    /// The graph that executes the pass. Use it to get the resources declared by the pass.
+    const RenderGraph* pGraph = nullptr;
+};
+
+
+/// Render graph statistics, see RenderGraph::GetStats().
+struct RenderGraphStats
+{
+    /// The number of passes added to the graph.
+    Uint32 NumPasses = 0;
+
+    /// The number of passes whose results are not used and that were removed from the graph.
+    Uint32 NumCulledPasses = 0;
+
+    /// The number of dependency levels. Passes of the same level are independent of each other.
+    Uint32 NumLevels = 0;
+
+    /// The number of transient textures declared by the passes.
+    Uint32 NumTransientTextures = 0;
+
+    /// The number of textures that back the transient textures.
+    Uint32 NumPhysicalTextures = 0;
+
+    /// The number of state transitions the graph issues.
+    Uint32 NumBarriers = 0;
+
+    /// The number of IDeviceContext::TransitionResourceStates() calls the barriers are grouped into.
+    Uint32 NumBarrierBatches = 0;
+};
+
+
+/// Render graph.
+
+/// Passes declare the resources they read and write. Every frame the application adds the passes,
+/// compiles the graph and executes it:
+///
+///     Graph.Reset();
+///     auto BackBuffer = Graph.ImportTexture(pSwapChain->GetCurrentBackBufferRTV()->GetTexture(), RESOURCE_STATE_PRESENT);
+///     auto GBuffer    = Graph.CreateTexture(GBufferDesc);
+///     Graph.AddPass("GBuffer", [&](const RenderGraphPassContext& Ctx){ ... })
+///         .Write(GBuffer, RESOURCE_STATE_RENDER_TARGET);
+///     Graph.AddPass("Lighting", [&](const RenderGraphPassContext& Ctx){ ... })
+///         .Read(GBuffer, RESOURCE_STATE_SHADER_RESOURCE)
+///         .Write(BackBuffer, RESOURCE_STATE_RENDER_TARGET);
+///     Graph.Compile();
+///     Graph.Execute(pImmediateContext);
+///
+/// When the graph is compiled, it
+/// - removes passes that neither write imported resources nor have side effects, and whose
+///   results are not read by other passes;
+/// - sorts the passes into dependency levels. Passes of the same level do not depend on each other;
+/// - assigns textures to the transient resources. On Vulkan, every transient resource gets its own texture
+///   created by IRenderDeviceVk::CreateAliasedTextures(), so that textures whose lifetimes do not overlap
+///   share device memory. The textures are kept while the transient resources and their dependency levels
+///   stay the same between frames. On other backends, transient textures whose lifetimes do not overlap
+///   and whose descriptions are equal share the same texture. Textures are kept in a pool between frames;
+/// - computes the state transitions required by every level and groups them into a single
+///   IDeviceContext::TransitionResourceStates() call. Transitions to the state the resource
+///   is already in are skipped.
+///
+/// Since all transitions are performed by the graph, passes must use RESOURCE_STATE_TRANSITION_MODE_NONE
+/// for the resources they declare, which removes the state tracking overhead from the device context.
+/// When deferred contexts are provided, the passes of the same level are recorded in parallel.
+class RenderGraph
+{
+public:
+    /// Runs NumTasks invocations of Task, possibly in parallel, and returns when all of them have completed.
+    using ParallelForType = std::function<void(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task)>;
+
+    /// Pass execute callback.
+    using ExecuteCallbackType = std::function<void(const RenderGraphPassContext& Context)>;
+
+    struct CreateInfo
+    {
+        /// Render device used to create transient textures.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Optional deferred contexts used to record independent passes in parallel.
+        IDeviceContext** ppDeferredContexts = nullptr;
+
+        /// The number of deferred contexts in ppDeferredContexts.
+        Uint32 NumDeferredContexts = 0;
+
+        /// Optional parallel-for implementation (e.g. backed by a task scheduler).
+        /// When not provided, the passes are recorded on the calling thread.
+        ParallelForType ParallelFor;
+
+        /// The number of frames after which a pooled texture that was not used is released.
+        Uint32 MaxIdleFrames = 8;
+    };
+
+
+    /// Declares the resources accessed by a pass.
+    class PassBuilder
+    {
+    public:
+        /// Declares that the pass reads the resource in the given state.
+        PassBuilder& Read(RenderGraphResourceId Id, RESOURCE_STATE State);
+
+        /// Declares that the pass writes the resource in the given state.
+        /// The previous content of the resource is not used by the pass.
+        PassBuilder& Write(RenderGraphResourceId Id, RESOURCE_STATE State);
+
+        /// Declares that the pass reads and modifies the resource in the given state.
+        PassBuilder& ReadWrite(RenderGraphResourceId Id, RESOURCE_STATE State);
+
+        /// Marks the pass as having side effects not visible to the graph (e.g. readback
+        /// to a staging resource), so that the pass is never culled.
+        PassBuilder& SetSideEffects();
+
+    private:
+        friend RenderGraph;
+        PassBuilder(RenderGraph& Graph, Uint32 PassIndex) :
+            m_Graph{Graph},
+            m_PassIndex{PassIndex}
+        {}
+
+        PassBuilder& AddAccess(RenderGraphResourceId Id, RESOURCE_STATE State, bool IsRead, bool IsWrite);
+
+        RenderGraph& m_Graph;
+        const Uint32 m_PassIndex;
+    };
+
+
+    explicit RenderGraph(const CreateInfo& CI);
+
+    // clang-format off
+    RenderGraph           (const RenderGraph&)  = delete;
+    RenderGraph& operator=(const RenderGraph&)  = delete;
+    RenderGraph           (      RenderGraph&&) = delete;
+    RenderGraph& operator=(      RenderGraph&&) = delete;
+    // clang-format on
+
+
+    /// Removes all passes and resources. Pooled transient textures are kept.
+    void Reset();
+
+
+    /// Registers an external texture.
+
+    /// \param[in] pTexture   - Texture to import.
+    /// \param[in] FinalState - State the texture is transitioned to after the graph is executed
+    ///                         (e.g. RESOURCE_STATE_PRESENT for a swap chain back buffer).
+    ///                         If RESOURCE_STATE_UNKNOWN, the texture is left in the last state it was used in.
+    ///
+    /// \remarks    The state of the texture must be known to the engine (see ITexture::GetState()).
+    ///             Writes to imported resources are considered to be the outputs of the graph.
+    RenderGraphResourceId ImportTexture(ITexture* pTexture, RESOURCE_STATE FinalState = RESOURCE_STATE_UNKNOWN);
+
+
+    /// Registers an external buffer, see ImportTexture().
+    RenderGraphResourceId ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE FinalState = RESOURCE_STATE_UNKNOWN);
+
+
+    /// Declares a transient texture that only lives while the graph is executed.
+    /// The content of the texture is undefined when it is first written by a pass.
+    RenderGraphResourceId CreateTexture(const TextureDesc& Desc);
+
+
+    /// Adds a pass. Passes must be added in the order they would execute on a single queue.
+    PassBuilder AddPass(const char* Name, ExecuteCallbackType Execute);
+
+
+    /// Culls unused passes, allocates transient textures and computes the state transitions.
+    void Compile();
+
+
+    /// Executes the compiled graph.
+
+    /// \param[in] pContext - Immediate device context.
+    ///
+    /// \remarks    If deferred contexts are used, the method calls IDeviceContext::FinishFrame()
+    ///             for every deferred context after its command lists have been executed.
+    void Execute(IDeviceContext* pContext);
+
+
+    /// Returns the texture of a texture resource. For transient textures, the texture is only
+    /// available after the graph is compiled.
+    ITexture* GetTexture(RenderGraphResourceId Id) const;
+
+    /// Returns the buffer of a buffer resource.
+    IBuffer* GetBuffer(RenderGraphResourceId Id) const;
+
+    /// Returns the statistics of the last compiled graph.
+    const RenderGraphStats& GetStats() const
+    {
+        return m_Stats;
+    }
+
+private:
+    struct ResourceAccess
+    {
+        RenderGraphResourceId Id;
+        RESOURCE_STATE        State;
+        bool                  IsRead;
+        bool                  IsWrite;
+    };
+
+    struct Pass
+    {
+        std::string                 Name;
+        ExecuteCallbackType         Execute;
+        std::vector<ResourceAccess> Accesses;
+        bool                        HasSideEffects = false;
+        bool                        IsLive         = false;
+        Uint32                      Level          = 0;
+    };
+
+    struct Resource
+    {
+        // Strong reference to an imported resource. Transient textures are kept alive by the pool.
+        RefCntAutoPtr<IDeviceObject> pObject;
+
+        ITexture* pTexture = nullptr;
+        IBuffer*  pBuffer  = nullptr;
+
+        // Description of a transient texture
+        TextureDesc Desc;
+        std::string Name;
+
+        bool           IsImported = false;
+        RESOURCE_STATE FinalState = RESOURCE_STATE_UNKNOWN;
+
+        // Index of the pooled texture that backs a transient texture.
+        // Transient textures that are backed by aliased textures are not pooled.
+        Uint32 PoolIndex = ~0u;
+
+        // Dependency levels of the first and the last live pass that use the resource
+        Uint32 FirstLevel = ~0u;
+        Uint32 LastLevel  = 0;
+    };
+
+    struct PooledTexture
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        Uint64                  LastUsedFrame = 0;
+    };
+
+    // Transient texture backed by an aliased texture, see AllocateAliasedTextures()
+    struct AliasedTextureLayout
+    {
+        TextureDesc Desc;
+        Uint32      FirstLevel = 0;
+        Uint32      LastLevel  = 0;
+
+        bool operator==(const AliasedTextureLayout& RHS) const
+        {
+            return Desc == RHS.Desc && FirstLevel == RHS.FirstLevel && LastLevel == RHS.LastLevel;
+        }
+    };
+
+    struct Level
+    {
+        // Barriers issued before the passes of the level are executed
+        std::vector<StateTransitionDesc> Barriers;
+
+        // Indices of the passes of the level
+        std::vector<Uint32> Passes;
+    };
+
+    void CullPasses();
+    void ComputeLevels();
+    void AllocateTransientTextures();
+    void AllocateAliasedTextures(const std::vector<Uint32>& Transients);
+    void ComputeBarriers();
+    void RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const;
+
+    const CreateInfo m_CI;
+
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_DeferredContexts;
+    std::vector<RefCntAutoPtr<ICommandList>>   m_CommandLists;
+
+    std::vector<Pass>     m_Passes;
+    std::vector<Resource> m_Resources;
+    std::vector<Level>    m_Levels;
+
+    // Transitions performed after all passes are executed
+    std::vector<StateTransitionDesc> m_FinalBarriers;
+
+    std::vector<PooledTexture> m_TexturePool;
+
+    // True if the device can create textures that share memory (Vulkan only)
+    bool m_UseAliasedTextures = false;
+
+    std::vector<AliasedTextureLayout>    m_AliasedLayout;
+    std::vector<RefCntAutoPtr<ITexture>> m_AliasedTextures;
+
+    RenderGraphStats m_Stats;
+    Uint64           m_FrameNumber = 0;
+    bool             m_IsCompiled  = false;
+};
+
+} // namespace Diligent
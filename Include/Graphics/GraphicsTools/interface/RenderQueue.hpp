@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a RenderQueue class
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+
+namespace Diligent
+{
+
+/// Describes a single draw command submitted to the render queue.
+
+/// \remarks The render queue does not keep references to the objects in the packet.
+///          An application must keep them alive until the queue is executed.
+struct DrawPacket
+{
+    /// Maximum number of vertex buffers a packet may use.
+    static constexpr Uint32 MaxVertexBuffers = 4;
+
+    /// Pipeline state to draw with.
+    IPipelineState* pPSO = nullptr;
+
+    /// Shader resource binding to commit. May be null if the pipeline has no resources.
+    IShaderResourceBinding* pSRB = nullptr;
+
+    /// Vertex buffers bound to slots [0, NumVertexBuffers).
+    IBuffer* pVertexBuffers[MaxVertexBuffers] = {};
+
+    /// Offsets of the vertex buffers, in bytes.
+    Uint32 VertexOffsets[MaxVertexBuffers] = {};
+
+    /// Number of vertex buffers.
+    Uint32 NumVertexBuffers = 0;
+
+    /// Index buffer. When not null, the packet is drawn with IDeviceContext::DrawIndexed()
+    /// using IndexedAttribs. Otherwise it is drawn with IDeviceContext::Draw() using Attribs.
+    IBuffer* pIndexBuffer = nullptr;
+
+    /// Offset of the index data, in bytes.
+    Uint32 IndexOffset = 0;
+
+    /// Non-indexed draw attributes.
+    DrawAttribs Attribs;
+
+    /// Indexed draw attributes.
+    DrawIndexedAttribs IndexedAttribs;
+
+    /// Render pass index. Packets of lower passes are drawn first. Must be less than RenderQueue::MaxPasses.
+    Uint8 Pass = 0;
+
+    /// Transparent packets are drawn after opaque packets of the same pass, back to front.
+    bool IsTransparent = false;
+
+    /// Material identifier. If zero, the queue derives the identifier from the SRB.
+    Uint16 MaterialId = 0;
+
+    /// Non-negative view-space depth used to order packets. Opaque packets are
+    /// drawn front to back after state sorting, transparent ones back to front.
+    float Depth = 0;
+};
+
+
+/// Sort-key based render queue.
+
+/// The queue collects draw packets, assigns every packet a 64-bit sort key, sorts the keys
+/// with a stable LSD radix sort and replays the packets into a device context. Sorting groups
+/// packets that use the same pipeline state and material, which minimizes PSO and
+/// descriptor switches, while keeping opaque geometry roughly front to back.
+///
+/// Sort key layout, from the most significant bit:
+///
+///     Opaque:      | Pass (4) | 0 | PSO id (16) | Material id (16) | Depth (27)          |
+///     Transparent: | Pass (4) | 1 | Inverted depth (27)          | PSO id (16) | Material id (16) |
+///
+/// Sorted packets can be split into ranges that are recorded by different deferred contexts.
+class RenderQueue
+{
+public:
+    /// Maximum number of render passes encoded in the sort key.
+    static constexpr Uint32 MaxPasses = 16;
+
+    /// Runs NumTasks invocations of Task, possibly in parallel, and returns when all of them have completed.
+    using ParallelForType = std::function<void(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task)>;
+
+    struct CreateInfo
+    {
+        /// Optional parallel-for implementation (e.g. backed by a task scheduler).
+        /// When not provided, sorting runs on the calling thread.
+        ParallelForType ParallelFor;
+
+        /// Minimum number of packets processed by a single sorting task.
+        Uint32 MinPacketsPerTask = 4096;
+
+        /// Maximum number of sorting tasks.
+        Uint32 MaxTasks = 16;
+
+        /// State transition mode used when vertex, index buffers and shader resources are bound.
+        /// Packets are typically replayed inside a render pass where transitions are not allowed.
+        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+    };
+
+    explicit RenderQueue(const CreateInfo& CI);
+
+    // clang-format off
+    RenderQueue           (const RenderQueue&)  = delete;
+    RenderQueue& operator=(const RenderQueue&)  = delete;
+    RenderQueue           (      RenderQueue&&) = delete;
+    RenderQueue& operator=(      RenderQueue&&) = delete;
+    // clang-format on
+
+
+    /// Adds a draw packet to the queue and computes its sort key.
+    void Submit(const DrawPacket& Packet);
+
+
+    /// Sorts the submitted packets by their sort keys. The sort is stable,
+    /// so packets with equal keys are drawn in submission order.
+    void Sort();
+
+
+    /// Replays the sorted packets into the device context.
+
+    /// \param[in] pContext    - Device context to record commands to. This may be a deferred context.
+    /// \param[in] FirstPacket - Index of the first sorted packet to replay.
+    /// \param[in] NumPackets  - Number of packets to replay.
+    ///
+    /// \remarks    The method keeps track of the state it sets and skips redundant pipeline state,
+    ///             shader resource and buffer bindings. It assumes no state is bound when it starts,
+    ///             so different ranges may be replayed into different deferred contexts.
+    void Execute(IDeviceContext* pContext, Uint32 FirstPacket = 0, Uint32 NumPackets = ~0u) const;
+
+
+    /// Removes all packets from the queue.
+    void Clear();
+
+
+    /// Returns the number of packets in the queue.
+    Uint32 GetNumPackets() const
+    {
+        return static_cast<Uint32>(m_Packets.size());
+    }
+
+
+    /// Returns the sort key of the sorted packet with the given index.
+    Uint64 GetSortKey(Uint32 Index) const
+    {
+        return m_Items[Index].Key;
+    }
+
+
+    /// Builds the sort key from its components.
+    static Uint64 MakeSortKey(Uint32 Pass, bool IsTransparent, Uint32 PSOId, Uint32 MaterialId, float Depth);
+
+private:
+    struct SortItem
+    {
+        Uint64 Key;
+        Uint32 PacketIndex;
+    };
+
+    template <typename ObjectType>
+    static Uint32 GetObjectId(std::unordered_map<const ObjectType*, Uint32>& Ids, const ObjectType* pObject);
+
+    void RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const;
+
+    const CreateInfo m_CI;
+
+    std::vector<DrawPacket> m_Packets;
+    std::vector<SortItem>   m_Items;
+    std::vector<SortItem>   m_SortBuffer;
+    std::vector<Uint32>     m_Histograms;
+
+    // Compact identifiers assigned to objects in the order they are first submitted
+    std::unordered_map<const IPipelineState*, Uint32>         m_PSOIds;
+    std::unordered_map<const IShaderResourceBinding*, Uint32> m_SRBIds;
+};
+
+} // namespace Diligent
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a ShaderBatchCompiler class
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Creates many shaders concurrently.
+
+/// Every shader is created through IRenderDevice::CreateShader(), which is free-threaded on devices
+/// that support multithreaded resource creation, so shaders are compiled on the workers provided by
+/// the ParallelFor callback (e.g. backed by an enkiTS task set). Other devices (OpenGL) compile the
+/// shaders on the calling thread. glslang keeps its parser state in thread-local pools, so every worker
+/// uses its own compiler state after the process-wide initialization done by the engine. When the
+/// persistent SPIR-V cache is enabled (see EngineVkCreateInfo::pShaderCacheDirectory), already
+/// compiled permutations are loaded from the cache.
+class ShaderBatchCompiler
+{
+public:
+    /// Runs NumTasks invocations of Task, possibly in parallel, and returns when all of them have completed.
+    using ParallelForType = std::function<void(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task)>;
+
+    struct CreateInfo
+    {
+        /// Render device that creates the shaders.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Optional parallel-for implementation (e.g. backed by a task scheduler).
+        /// When not provided, or when the device does not support multithreaded
+        /// resource creation, shaders are compiled on the calling thread.
+        ParallelForType ParallelFor;
+    };
+
+    /// Result of a single shader compilation.
+    struct Result
+    {
+        /// Created shader, or null if compilation failed.
+        RefCntAutoPtr<IShader> pShader;
+
+        /// Compiler messages. Non-empty when compilation failed, and may contain warnings otherwise.
+        std::string Log;
+    };
+
+    explicit ShaderBatchCompiler(const CreateInfo& CI);
+
+    // clang-format off
+    ShaderBatchCompiler           (const ShaderBatchCompiler&)  = delete;
+    ShaderBatchCompiler& operator=(const ShaderBatchCompiler&)  = delete;
+    ShaderBatchCompiler           (      ShaderBatchCompiler&&) = delete;
+    ShaderBatchCompiler& operator=(      ShaderBatchCompiler&&) = delete;
+    // clang-format on
+
+
+    /// Compiles the shaders.
+
+    /// \param[in] pShaderCIs - Array of NumShaders shader create infos. ppCompilerOutput members are ignored.
+    /// \param[in] NumShaders - Number of shaders.
+    ///
+    /// \return    Array of NumShaders results in the same order as the create infos.
+    std::vector<Result> Compile(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders) const;
+
+
+    /// Compiles the shaders, see Compile().
+    std::vector<Result> Compile(const std::vector<ShaderCreateInfo>& ShaderCIs) const
+    {
+        return Compile(ShaderCIs.data(), static_cast<Uint32>(ShaderCIs.size()));
+    }
+
+private:
+    const CreateInfo m_CI;
+};
+
+} // namespace Diligent
@@ -0,0 +1,218 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ShaderHotReloader class
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Recompiles shaders and rebuilds pipeline states when shader source files change.
+
+/// Pipelines are registered with the shaders they are built from and a callback that creates
+/// the pipeline state from compiled shaders. The reloader tracks the source file of every shader
+/// and all files it includes. When some of these files change, only the affected shaders are
+/// recompiled, and only the pipelines that use them are rebuilt; other shaders are reused.
+///
+/// Recompilation runs on a background thread, so frames are never stalled. If the device does not
+/// support multithreaded resource creation (e.g. OpenGL), changes are still detected in the background,
+/// but the shaders are compiled and the pipelines are rebuilt by Update() on the render thread.
+/// New pipeline states are published by Update(), which the application calls once per frame on the
+/// render thread, so every frame uses a consistent set of pipelines. Draw packets submitted to the render queue
+/// should take the pipeline from GetPipeline() every frame. If compilation fails, the error is
+/// logged and the previous pipeline remains in use.
+///
+/// On Linux, the watch directories and all their subdirectories are monitored with inotify.
+/// On other platforms, changes must be reported with NotifyFileChanged().
+class ShaderHotReloader
+{
+public:
+    /// Called by Update() when the pipeline has been rebuilt, e.g. to recreate the shader resource bindings.
+    using PipelineReloadedCallbackType = std::function<void(Uint32 PipelineId, IPipelineState* pPSO)>;
+
+    /// Creates the pipeline state from shaders passed in the same order as PipelineDesc::Shaders.
+    /// Called on the background thread for rebuilt pipelines, or by Update() if the device does not
+    /// support multithreaded resource creation.
+    using CreatePipelineCallbackType = std::function<RefCntAutoPtr<IPipelineState>(IShader* const* ppShaders, Uint32 NumShaders)>;
+
+    struct CreateInfo
+    {
+        /// Render device that creates the shaders.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Semicolon-separated list of directories to watch, typically the same directories
+        /// the shader source stream factory searches.
+        const Char* WatchDirectories = nullptr;
+
+        /// Time to wait after the last change before recompiling, in milliseconds.
+        /// Editors often write a file in several steps, and this delay merges them into a single reload.
+        Uint32 ReloadDelayMs = 100;
+
+        /// Optional callback invoked by Update() for every rebuilt pipeline.
+        PipelineReloadedCallbackType OnPipelineReloaded;
+    };
+
+    struct PipelineDesc
+    {
+        /// Shaders of the pipeline. Shader source files must be resolvable through the
+        /// shader source stream factory. All strings and objects referenced by the create
+        /// infos must stay valid while the reloader is alive.
+        std::vector<ShaderCreateInfo> Shaders;
+
+        /// Creates the pipeline state from the compiled shaders. Must be thread-safe.
+        CreatePipelineCallbackType CreatePipeline;
+    };
+
+    explicit ShaderHotReloader(const CreateInfo& CI);
+    ~ShaderHotReloader();
+
+    // clang-format off
+    ShaderHotReloader           (const ShaderHotReloader&)  = delete;
+    ShaderHotReloader& operator=(const ShaderHotReloader&)  = delete;
+    ShaderHotReloader           (      ShaderHotReloader&&) = delete;
+    ShaderHotReloader& operator=(      ShaderHotReloader&&) = delete;
+    // clang-format on
+
+
+    /// Compiles the shaders, creates the pipeline and returns its identifier.
+
+    /// The pipeline is registered even if the initial compilation fails, in which case
+    /// GetPipeline() returns null until the source files are fixed.
+    Uint32 AddPipeline(const PipelineDesc& Desc);
+
+
+    /// Returns the current pipeline state. Must be called on the thread that calls Update().
+    IPipelineState* GetPipeline(Uint32 PipelineId) const
+    {
+        VERIFY(PipelineId < m_Pipelines.size(), "Pipeline id (", PipelineId, ") is out of range");
+        return m_Pipelines[PipelineId]->pPSO;
+    }
+
+
+    /// Publishes the pipelines rebuilt since the last call and returns their number.
+    /// If the device does not support multithreaded resource creation, also recompiles
+    /// the shaders affected by the changes detected since the last call.
+    Uint32 Update();
+
+
+    /// Reports that the file has changed. The path may be absolute or relative to a watch directory.
+    void NotifyFileChanged(const Char* Path);
+
+
+    /// Returns true if file changes are detected automatically.
+    bool IsWatching() const { return m_WatchFd >= 0; }
+
+private:
+    struct ShaderInfo
+    {
+        RefCntAutoPtr<IShader> pShader;
+
+        // Files the shader is compiled from: the source file and all its includes, as
+        // they are resolved by the shader source stream factory.
+        std::vector<std::string> Dependencies;
+    };
+
+    struct PipelineInfo
+    {
+        PipelineDesc Desc;
+
+        // Only accessed by the thread that reloads the pipelines after the pipeline is registered.
+        // Updated under m_PipelinesMtx.
+        std::vector<ShaderInfo> Shaders;
+
+        // Only accessed by the render thread
+        RefCntAutoPtr<IPipelineState> pPSO;
+    };
+
+    RefCntAutoPtr<IShader> CompileShader(const ShaderCreateInfo& ShaderCI) const;
+
+    void WatchDirectory(const std::string& Dir, const std::string& RelativePath);
+
+    void WorkerThread();
+
+    void ReloadChangedFiles(const std::unordered_set<std::string>& ChangedFiles);
+
+    const CreateInfo m_CI;
+
+    // Registered pipelines. Entries are never removed and their addresses are stable.
+    std::vector<std::unique_ptr<PipelineInfo>> m_Pipelines;
+    std::mutex                                 m_PipelinesMtx;
+
+    // Pipelines rebuilt by the worker thread that are not yet published by Update()
+    std::unordered_map<Uint32, RefCntAutoPtr<IPipelineState>> m_PendingPipelines;
+    std::mutex                                                m_PendingPipelinesMtx;
+
+    // If the device does not support multithreaded resource creation, the worker thread
+    // only detects the changes, and the shaders are compiled by Update() on the render thread
+    const bool m_ReloadInUpdate;
+
+    // Changes detected by the worker thread that are not yet reloaded by Update()
+    std::unordered_set<std::string> m_ChangesToReload;
+    std::mutex                      m_ChangesToReloadMtx;
+
+    // Changes reported through NotifyFileChanged()
+    std::vector<std::string> m_NotifiedFiles;
+    std::mutex               m_NotifiedFilesMtx;
+    std::condition_variable  m_NotifiedFilesCV;
+
+    struct WatchedDir
+    {
+        std::string Path;
+
+        // Path relative to the watch directory it belongs to, with the trailing slash
+        std::string RelativePath;
+    };
+
+    // inotify file descriptor and the directory of every watch descriptor.
+    // Only accessed by the worker thread once it is started.
+    int                                 m_WatchFd = -1;
+    std::unordered_map<int, WatchedDir> m_WatchedDirs;
+
+    std::atomic_bool m_StopWorker{false};
+    std::thread      m_WorkerThread;
+};
+
+} // namespace Diligent
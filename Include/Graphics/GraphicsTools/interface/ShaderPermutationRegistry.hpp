@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ShaderPermutationRegistry class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "ShaderBatchCompiler.hpp"
+
+namespace Diligent
+{
+
+class ShaderMacroHelper;
+
+/// Manages the permutations of a single shader.
+
+/// A shader declares a set of feature axes, each taking values in [0, NumValues). A permutation
+/// is identified by a 64-bit key that packs the value of every axis into its own bit range, so
+/// the key is built with a few bit operations and the shader is found by a single hash lookup.
+/// Only the permutations that are actually requested are ever compiled: they can either be
+/// declared upfront with DeclareUsed() and compiled in parallel by CompileUsed(), or created
+/// on first use by GetShader().
+///
+/// Macro axes are passed to the shader as preprocessor macros with the axis name, so every
+/// combination of their values is a separate shader. Specialization constant axes do not
+/// create new shaders: all their values share one compiled shader and the value is provided
+/// to the pipeline through PipelineStateCreateInfo::pSpecializationConstants (see
+/// GetSpecializationConstants()). Specialization constants are only supported in Vulkan; on other
+/// backends such axes are treated as macro axes, so the shader should declare the constant under
+/// `#ifndef <Name>` to work with both.
+class ShaderPermutationRegistry
+{
+public:
+    using KeyType = Uint64;
+
+    /// Feature axis description.
+    struct AxisDesc
+    {
+        /// Macro or specialization constant name.
+        const Char* Name = nullptr;
+
+        /// The number of values the axis can take.
+        Uint32 NumValues = 2;
+
+        /// Whether the axis is provided as a specialization constant rather than a macro.
+        bool UseSpecializationConstant = false;
+    };
+
+    struct CreateInfo
+    {
+        /// Render device that creates the shaders.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Shader create info that all permutations are created from. Axis macros are
+        /// appended to ShaderCI.Macros. All strings and objects referenced by the create
+        /// info must stay valid while the registry is alive.
+        ShaderCreateInfo ShaderCI;
+
+        /// The number of axes in pAxes array.
+        Uint32 NumAxes = 0;
+
+        /// Feature axes. The total number of bits required to store all axis values must not exceed 64.
+        const AxisDesc* pAxes = nullptr;
+    };
+
+    explicit ShaderPermutationRegistry(const CreateInfo& CI);
+
+    // clang-format off
+    ShaderPermutationRegistry           (const ShaderPermutationRegistry&)  = delete;
+    ShaderPermutationRegistry& operator=(const ShaderPermutationRegistry&)  = delete;
+    ShaderPermutationRegistry           (      ShaderPermutationRegistry&&) = delete;
+    ShaderPermutationRegistry& operator=(      ShaderPermutationRegistry&&) = delete;
+    // clang-format on
+
+
+    /// Returns the key with the value of the given axis replaced with Value.
+    KeyType SetAxisValue(KeyType Key, Uint32 Axis, Uint32 Value) const
+    {
+        VERIFY(Axis < m_Axes.size(), "Axis index (", Axis, ") is out of range");
+        const auto& AxisInfo = m_Axes[Axis];
+        VERIFY(Value < AxisInfo.NumValues, "Value (", Value, ") of axis '", AxisInfo.Name, "' is out of range");
+        const auto Mask = AxisInfo.GetMask();
+        return (Key & ~Mask) | ((KeyType{Value} << AxisInfo.Shift) & Mask);
+    }
+
+    /// Returns the value of the given axis in the key.
+    Uint32 GetAxisValue(KeyType Key, Uint32 Axis) const
+    {
+        VERIFY(Axis < m_Axes.size(), "Axis index (", Axis, ") is out of range");
+        const auto& AxisInfo = m_Axes[Axis];
+        return static_cast<Uint32>((Key & AxisInfo.GetMask()) >> AxisInfo.Shift);
+    }
+
+    Uint32 GetNumAxes() const { return static_cast<Uint32>(m_Axes.size()); }
+
+
+    /// Declares that the permutation is used by the application.
+    void DeclareUsed(KeyType Key);
+
+    /// Returns all permutations declared with DeclareUsed().
+    std::vector<KeyType> GetUsedPermutations() const;
+
+    /// Compiles all declared permutations that have not been created yet.
+
+    /// \param[in] Compiler - Batch compiler used to create the shaders in parallel.
+    ///
+    /// \return    The number of permutations that failed to compile.
+    Uint32 CompileUsed(const ShaderBatchCompiler& Compiler);
+
+
+    /// Returns the shader for the permutation, creating it if necessary.
+
+    /// The shader is created on the calling thread on the first request. Permutations that
+    /// failed to compile are not retried and return null.
+    IShader* GetShader(KeyType Key);
+
+
+    /// Appends the specialization constants of the permutation to Constants.
+
+    /// The constant data is owned by the registry. The method does nothing if the registry
+    /// has no specialization constant axes.
+    void GetSpecializationConstants(KeyType Key, std::vector<SpecializationConstant>& Constants) const;
+
+private:
+    struct AxisInfo
+    {
+        std::string Name;
+        Uint32      NumValues                = 0;
+        Uint32      Shift                    = 0;
+        Uint32      NumBits                  = 0;
+        bool        IsSpecializationConstant = false;
+
+        // Specialization constant values referenced by SpecializationConstant::pData
+        std::vector<Uint32> Values;
+
+        KeyType GetMask() const
+        {
+            return NumBits < 64 ? ((KeyType{1} << NumBits) - 1) << Shift : ~KeyType{0};
+        }
+    };
+
+    // Clears the values of specialization constant axes that do not affect the compiled shader
+    KeyType GetShaderKey(KeyType Key) const
+    {
+        return Key & ~m_SpecializationConstantMask;
+    }
+
+    std::string GetPermutationName(KeyType ShaderKey) const;
+
+    void InitMacros(KeyType ShaderKey, ShaderMacroHelper& Macros) const;
+
+    void LogCompilationError(KeyType ShaderKey, const std::string& Log) const;
+
+    IRenderDevice* const   m_pDevice;
+    const ShaderCreateInfo m_ShaderCI;
+
+    std::vector<AxisInfo> m_Axes;
+    KeyType               m_SpecializationConstantMask = 0;
+
+    mutable std::mutex                                  m_Mtx;
+    std::unordered_map<KeyType, RefCntAutoPtr<IShader>> m_Shaders;
+    std::unordered_set<KeyType>                         m_UsedKeys;
+};
+
+} // namespace Diligent
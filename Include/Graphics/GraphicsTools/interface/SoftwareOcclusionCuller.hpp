@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a SoftwareOcclusionCuller class
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Software occlusion culler create info.
+struct SoftwareOcclusionCullerCreateInfo
+{
+    /// Width of the occlusion depth buffer.
+    Uint32 Width = 256;
+
+    /// Height of the occlusion depth buffer.
+    Uint32 Height = 128;
+
+    /// Whether clip-space depth is in [-1, 1] range (OpenGL) rather than [0, 1].
+    bool NDCDepthMinusOneToOne = false;
+};
+
+
+/// CPU implementation of hierarchical depth buffer occlusion culling.
+
+/// The culler rasterizes occluder triangles into a small depth buffer, builds a max-reduced
+/// mip pyramid from it and tests bounding boxes against the pyramid the same way the GPU
+/// instance culler tests instances against a Hi-Z pyramid. It does not need a GPU, so it
+/// may be used on servers, in tools and to validate occlusion culling results.
+///
+/// Matrices use the row-vector convention of BasicMath (clip = float4(pos, 1) * Matrix).
+class SoftwareOcclusionCuller
+{
+public:
+    explicit SoftwareOcclusionCuller(const SoftwareOcclusionCullerCreateInfo& CI);
+
+    // clang-format off
+    SoftwareOcclusionCuller           (const SoftwareOcclusionCuller&)  = delete;
+    SoftwareOcclusionCuller& operator=(const SoftwareOcclusionCuller&)  = delete;
+    SoftwareOcclusionCuller           (      SoftwareOcclusionCuller&&) = delete;
+    SoftwareOcclusionCuller& operator=(      SoftwareOcclusionCuller&&) = delete;
+    // clang-format on
+
+
+    /// Clears the depth buffer to the far plane.
+    void Clear();
+
+
+    /// Rasterizes an indexed triangle list into the depth buffer.
+
+    /// \param[in] pPositions    - Object-space vertex positions.
+    /// \param[in] NumVertices   - Number of vertices.
+    /// \param[in] pIndices      - Triangle list indices.
+    /// \param[in] NumIndices    - Number of indices, must be a multiple of 3.
+    /// \param[in] WorldViewProj - Object-to-clip space transform.
+    ///
+    /// \remarks    Both triangle windings are rasterized. Triangles that cross the near plane are
+    ///             skipped, which can only make culling less aggressive.
+    void RasterizeOccluder(const float3*   pPositions,
+                           Uint32          NumVertices,
+                           const Uint32*   pIndices,
+                           Uint32          NumIndices,
+                           const float4x4& WorldViewProj);
+
+
+    /// Builds the depth pyramid. Must be called after all occluders are rasterized and before testing.
+    void BuildHiZ();
+
+
+    /// Returns true if the world-space box is hidden behind the rasterized occluders.
+    bool IsOccluded(const BoundBox& Box, const float4x4& ViewProj) const;
+
+
+    /// Filters a list of instances, keeping the ones that are not occluded.
+
+    /// \param[in]  pBoxes     - World-space bounding boxes of all instances.
+    /// \param[in]  pIndices   - Indices of the instances to test (e.g. the output of the frustum culler).
+    /// \param[in]  NumIndices - Number of indices.
+    /// \param[in]  ViewProj   - View-projection matrix.
+    /// \param[out] Visible    - Indices of the instances that are not occluded.
+    void Cull(const BoundBox*      pBoxes,
+              const Uint32*        pIndices,
+              Uint32               NumIndices,
+              const float4x4&      ViewProj,
+              std::vector<Uint32>& Visible) const;
+
+
+    /// Returns the depth of the texel of the given mip level.
+    float GetDepth(Uint32 x, Uint32 y, Uint32 Mip = 0) const;
+
+    /// Returns the number of mip levels of the depth pyramid.
+    Uint32 GetNumMipLevels() const
+    {
+        return static_cast<Uint32>(m_Mips.size());
+    }
+
+private:
+    struct MipLevel
+    {
+        Uint32             Width  = 0;
+        Uint32             Height = 0;
+        std::vector<float> Depth;
+    };
+
+    const SoftwareOcclusionCullerCreateInfo m_CI;
+
+    // Level 0 is the depth buffer occluders are rasterized into
+    std::vector<MipLevel> m_Mips;
+};
+
+} // namespace Diligent
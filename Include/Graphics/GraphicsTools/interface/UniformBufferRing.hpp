@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of a UniformBufferRing class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/ShaderResourceVariable.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "MapHelper.hpp"
+
+namespace Diligent
+{
+
+/// Uniform buffer ring create info.
+struct UniformBufferRingCreateInfo
+{
+    /// Render device. Must be a Vulkan device.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Ring buffer name.
+    const char* Name = "Uniform buffer ring";
+
+    /// The total size of the allocations made in one frame, in bytes.
+    Uint32 FrameSize = 1 << 20;
+
+    /// The maximum size of a single allocation, in bytes. This is the size of the
+    /// buffer range that is bound to shader variables.
+    Uint32 MaxBlockSize = 1024;
+
+    /// The number of frames the GPU may lag behind the CPU.
+    Uint32 NumFramesInFlight = 3;
+};
+
+
+/// Uniform buffer that is suballocated for every draw call.
+
+/// Instead of mapping a separate buffer for every draw, the ring hands out aligned blocks of a
+/// single large buffer that stays mapped for the whole frame. Every shader variable that reads from
+/// the ring is bound once with Bind(), and only the block offset is changed per draw with
+/// IShaderResourceVariable::SetBufferOffset(). The offset is applied when the draw command binds the
+/// descriptor sets as a Vulkan dynamic offset, so the shader resource binding does not need to be
+/// committed again.
+///
+/// When the device has unified memory, the buffer is created with USAGE_UNIFIED and is mapped once.
+/// It is split into NumFramesInFlight segments, and a fence prevents the CPU from overwriting a segment
+/// the GPU is still reading. Otherwise, the buffer is a USAGE_DYNAMIC buffer that is mapped with
+/// MAP_FLAG_DISCARD at the beginning of every frame, and the engine dynamic heap keeps the previous
+/// frames alive. In this case, the dynamic heap page must be large enough to hold FrameSize bytes.
+///
+/// Typical usage:
+///
+///     Ring.BeginFrame(pContext);
+///     Ring.Bind(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbObjectAttribs"));
+///     pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+///     for (...)
+///     {
+///         auto Block = Ring.Allocate(sizeof(ObjectAttribs));
+///         memcpy(Block.pData, &Attribs, sizeof(ObjectAttribs));
+///         pVar->SetBufferOffset(Block.Offset);
+///         pContext->DrawIndexed(DrawAttrs);
+///     }
+///     Ring.EndFrame(pContext);
+///
+/// Shader variables must be mutable or dynamic.
+class UniformBufferRing
+{
+public:
+    /// Alignment of the allocations. This is the maximum value of minUniformBufferOffsetAlignment
+    /// allowed by the Vulkan specification.
+    static constexpr Uint32 BlockAlignment = 256;
+
+    struct Block
+    {
+        /// CPU address of the block, or null if the allocation failed.
+        void* pData = nullptr;
+
+        /// Offset of the block that should be passed to IShaderResourceVariable::SetBufferOffset().
+        Uint32 Offset = 0;
+    };
+
+    explicit UniformBufferRing(const UniformBufferRingCreateInfo& CI);
+
+    // clang-format off
+    UniformBufferRing           (const UniformBufferRing&)  = delete;
+    UniformBufferRing& operator=(const UniformBufferRing&)  = delete;
+    UniformBufferRing           (      UniformBufferRing&&) = delete;
+    UniformBufferRing& operator=(      UniformBufferRing&&) = delete;
+    // clang-format on
+
+
+    /// Maps the frame segment of the buffer.
+
+    /// \param[in] pContext - Immediate device context. The same context must be used for all frames.
+    ///
+    /// \remarks    The method blocks if the GPU is still reading the segment from NumFramesInFlight frames ago.
+    void BeginFrame(IDeviceContext* pContext);
+
+
+    /// Allocates a block of the given size.
+
+    /// \param[in] Size - Block size, in bytes. Must not exceed MaxBlockSize.
+    ///
+    /// \return     The block. If the frame segment is exhausted, pData is null.
+    Block Allocate(Uint32 Size);
+
+
+    /// Binds the ring buffer to the shader variable.
+
+    /// \remarks    The variable references MaxBlockSize bytes starting at the offset set
+    ///             with IShaderResourceVariable::SetBufferOffset().
+    void Bind(IShaderResourceVariable* pVar);
+
+
+    /// Finishes the frame.
+
+    /// \param[in] pContext - The context that was passed to BeginFrame().
+    void EndFrame(IDeviceContext* pContext);
+
+
+    /// Returns the ring buffer.
+    IBuffer* GetBuffer() { return m_pBuffer; }
+
+    /// Returns the number of bytes allocated in the current frame.
+    Uint32 GetFrameUsage() const { return m_CurrOffset - m_SegmentStart; }
+
+private:
+    const Uint32 m_FrameSize;
+    const Uint32 m_MaxBlockSize;
+    const Uint32 m_NumFramesInFlight;
+    const bool   m_PersistentMap;
+
+    RefCntAutoPtr<IBuffer> m_pBuffer;
+    RefCntAutoPtr<IFence>  m_pFence;
+
+    MapHelper<Uint8> m_MappedData;
+
+    Uint64 m_FrameNumber  = 0;
+    Uint32 m_SegmentStart = 0;
+    Uint32 m_CurrOffset   = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,345 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "FrustumCuller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#    include <immintrin.h>
+#    define FRUSTUM_CULLER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define FRUSTUM_CULLER_SSE 1
+#endif
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 MaxSIMDWidth = 8;
+
+// Plane with the absolute values of the normal components precomputed for the box test
+struct CullPlane
+{
+    float Nx, Ny, Nz, D;
+    float AbsNx, AbsNy, AbsNz;
+};
+
+struct CullFrustum
+{
+    CullPlane Planes[6];
+};
+
+struct InstanceStreams
+{
+    const float* SphereX;
+    const float* SphereY;
+    const float* SphereZ;
+    const float* SphereR;
+    const float* BoxCenterX;
+    const float* BoxCenterY;
+    const float* BoxCenterZ;
+    const float* BoxExtentX;
+    const float* BoxExtentY;
+    const float* BoxExtentZ;
+};
+
+// Each SIMD flavor exposes the same set of operations, so that the culling kernel is written once.
+
+#if FRUSTUM_CULLER_AVX
+struct SIMDOps
+{
+    using Vec                    = __m256;
+    static constexpr Uint32 Width = 8;
+
+    // clang-format off
+    static Vec    Load (const float* p)  { return _mm256_loadu_ps(p); }
+    static Vec    Set1 (float f)         { return _mm256_set1_ps(f); }
+    static Vec    Add  (Vec a, Vec b)    { return _mm256_add_ps(a, b); }
+    static Vec    Mul  (Vec a, Vec b)    { return _mm256_mul_ps(a, b); }
+    static Vec    CmpGE(Vec a, Vec b)    { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Vec    And  (Vec a, Vec b)    { return _mm256_and_ps(a, b); }
+    static Vec    True ()                { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Uint32 Mask (Vec a)           { return static_cast<Uint32>(_mm256_movemask_ps(a)); }
+    // clang-format on
+};
+#elif FRUSTUM_CULLER_SSE
+struct SIMDOps
+{
+    using Vec                    = __m128;
+    static constexpr Uint32 Width = 4;
+
+    // clang-format off
+    static Vec    Load (const float* p)  { return _mm_loadu_ps(p); }
+    static Vec    Set1 (float f)         { return _mm_set1_ps(f); }
+    static Vec    Add  (Vec a, Vec b)    { return _mm_add_ps(a, b); }
+    static Vec    Mul  (Vec a, Vec b)    { return _mm_mul_ps(a, b); }
+    static Vec    CmpGE(Vec a, Vec b)    { return _mm_cmpge_ps(a, b); }
+    static Vec    And  (Vec a, Vec b)    { return _mm_and_ps(a, b); }
+    static Vec    True ()                { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Uint32 Mask (Vec a)           { return static_cast<Uint32>(_mm_movemask_ps(a)); }
+    // clang-format on
+};
+#else
+struct SIMDOps
+{
+    using Vec                    = float;
+    static constexpr Uint32 Width = 1;
+
+    // clang-format off
+    static Vec    Load (const float* p)  { return *p; }
+    static Vec    Set1 (float f)         { return f; }
+    static Vec    Add  (Vec a, Vec b)    { return a + b; }
+    static Vec    Mul  (Vec a, Vec b)    { return a * b; }
+    static Vec    CmpGE(Vec a, Vec b)    { return a >= b ? 1.f : 0.f; }
+    static Vec    And  (Vec a, Vec b)    { return a * b; }
+    static Vec    True ()                { return 1.f; }
+    static Uint32 Mask (Vec a)           { return a != 0.f ? 1u : 0u; }
+    // clang-format on
+};
+#endif
+static_assert(MaxSIMDWidth % SIMDOps::Width == 0, "Arrays are padded to a multiple of MaxSIMDWidth");
+
+// Writes indices of the instances in [Begin, End) that intersect the frustum to pOut and returns their number
+Uint32 CullRange(const InstanceStreams& Streams, const CullFrustum& Frustum, Uint32 Begin, Uint32 End, Uint32* pOut)
+{
+    using Ops = SIMDOps;
+    using Vec = Ops::Vec;
+
+    const Vec Zero = Ops::Set1(0.f);
+
+    Uint32 NumVisible = 0;
+    for (Uint32 i = Begin; i < End; i += Ops::Width)
+    {
+        const Vec Sx = Ops::Load(Streams.SphereX + i);
+        const Vec Sy = Ops::Load(Streams.SphereY + i);
+        const Vec Sz = Ops::Load(Streams.SphereZ + i);
+        // Sphere radius is compared with the signed distance, so it is negated once
+        const Vec NegSr = Ops::Mul(Ops::Load(Streams.SphereR + i), Ops::Set1(-1.f));
+
+        // Sphere is outside if its center is farther than the radius behind any plane.
+        // Most instances are rejected by this test, so box streams are not even loaded for them.
+        Vec Visible = Ops::True();
+        for (const auto& Plane : Frustum.Planes)
+        {
+            const Vec Dist = Ops::Add(Ops::Add(Ops::Mul(Ops::Set1(Plane.Nx), Sx), Ops::Mul(Ops::Set1(Plane.Ny), Sy)),
+                                      Ops::Add(Ops::Mul(Ops::Set1(Plane.Nz), Sz), Ops::Set1(Plane.D)));
+            Visible        = Ops::And(Visible, Ops::CmpGE(Dist, NegSr));
+        }
+        if (Ops::Mask(Visible) == 0)
+            continue;
+
+        // clang-format off
+        const Vec Cx = Ops::Load(Streams.BoxCenterX + i);
+        const Vec Cy = Ops::Load(Streams.BoxCenterY + i);
+        const Vec Cz = Ops::Load(Streams.BoxCenterZ + i);
+        const Vec Ex = Ops::Load(Streams.BoxExtentX + i);
+        const Vec Ey = Ops::Load(Streams.BoxExtentY + i);
+        const Vec Ez = Ops::Load(Streams.BoxExtentZ + i);
+        // clang-format on
+
+        // Box is outside if its vertex farthest along the normal is behind any plane
+        for (const auto& Plane : Frustum.Planes)
+        {
+            const Vec CenterDist = Ops::Add(Ops::Add(Ops::Mul(Ops::Set1(Plane.Nx), Cx), Ops::Mul(Ops::Set1(Plane.Ny), Cy)),
+                                            Ops::Add(Ops::Mul(Ops::Set1(Plane.Nz), Cz), Ops::Set1(Plane.D)));
+            const Vec Projection = Ops::Add(Ops::Add(Ops::Mul(Ops::Set1(Plane.AbsNx), Ex), Ops::Mul(Ops::Set1(Plane.AbsNy), Ey)),
+                                            Ops::Mul(Ops::Set1(Plane.AbsNz), Ez));
+            Visible              = Ops::And(Visible, Ops::CmpGE(Ops::Add(CenterDist, Projection), Zero));
+        }
+
+        auto Mask = Ops::Mask(Visible);
+        // Drop the padding elements past the end of the range
+        if (End - i < Ops::Width)
+            Mask &= (1u << (End - i)) - 1u;
+
+        while (Mask != 0)
+        {
+            const auto Lane = PlatformMisc::GetLSB(Mask);
+            pOut[NumVisible++] = i + Lane;
+            Mask &= Mask - 1u;
+        }
+    }
+    return NumVisible;
+}
+
+CullFrustum PrepareFrustum(const ViewFrustum& Frustum)
+{
+    const Plane3D* Planes[] = {&Frustum.LeftPlane, &Frustum.RightPlane, &Frustum.BottomPlane, &Frustum.TopPlane, &Frustum.NearPlane, &Frustum.FarPlane};
+
+    CullFrustum Res;
+    for (size_t p = 0; p < _countof(Planes); ++p)
+    {
+        // Planes must be normalized for the distance to be compared with the sphere radius
+        const auto Len   = std::max(length(Planes[p]->Normal), 1e-12f);
+        const auto N     = Planes[p]->Normal / Len;
+        auto&      Plane = Res.Planes[p];
+
+        Plane.Nx    = N.x;
+        Plane.Ny    = N.y;
+        Plane.Nz    = N.z;
+        Plane.D     = Planes[p]->Distance / Len;
+        Plane.AbsNx = std::abs(N.x);
+        Plane.AbsNy = std::abs(N.y);
+        Plane.AbsNz = std::abs(N.z);
+    }
+    return Res;
+}
+
+} // namespace
+
+FrustumCuller::FrustumCuller(const CreateInfo& CI) :
+    m_CI{CI},
+    // Partitions must start at SIMD boundaries
+    m_PartitionSize{std::max((CI.InstancesPerPartition + MaxSIMDWidth - 1) / MaxSIMDWidth * MaxSIMDWidth, MaxSIMDWidth)}
+{
+}
+
+Uint32 FrustumCuller::GetSIMDWidth()
+{
+    return SIMDOps::Width;
+}
+
+void FrustumCuller::SetNumInstances(Uint32 NumInstances)
+{
+    m_NumInstances = NumInstances;
+
+    const size_t PaddedSize = (size_t{NumInstances} + MaxSIMDWidth - 1) / MaxSIMDWidth * MaxSIMDWidth;
+    for (auto* pStream : {&m_SphereX, &m_SphereY, &m_SphereZ, &m_SphereR,
+                          &m_BoxCenterX, &m_BoxCenterY, &m_BoxCenterZ,
+                          &m_BoxExtentX, &m_BoxExtentY, &m_BoxExtentZ})
+    {
+        pStream->resize(PaddedSize, 0.f);
+    }
+}
+
+void FrustumCuller::SetBounds(Uint32 Index, const BoundBox& Box)
+{
+    const auto Center = (Box.Min + Box.Max) * 0.5f;
+    SetBounds(Index, Box, Center, length(Box.Max - Center));
+}
+
+void FrustumCuller::SetBounds(Uint32 Index, const BoundBox& Box, const float3& SphereCenter, float SphereRadius)
+{
+    DEV_CHECK_ERR(Index < m_NumInstances, "Instance index (", Index, ") is out of range");
+    VERIFY(Box.Min.x <= Box.Max.x && Box.Min.y <= Box.Max.y && Box.Min.z <= Box.Max.z, "Invalid bounding box");
+
+    const auto Center = (Box.Min + Box.Max) * 0.5f;
+    const auto Extent = (Box.Max - Box.Min) * 0.5f;
+
+    // clang-format off
+    m_SphereX   [Index] = SphereCenter.x;
+    m_SphereY   [Index] = SphereCenter.y;
+    m_SphereZ   [Index] = SphereCenter.z;
+    m_SphereR   [Index] = SphereRadius;
+    m_BoxCenterX[Index] = Center.x;
+    m_BoxCenterY[Index] = Center.y;
+    m_BoxCenterZ[Index] = Center.z;
+    m_BoxExtentX[Index] = Extent.x;
+    m_BoxExtentY[Index] = Extent.y;
+    m_BoxExtentZ[Index] = Extent.z;
+    // clang-format on
+}
+
+void FrustumCuller::RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const
+{
+    if (NumTasks > 1 && m_CI.ParallelFor)
+    {
+        m_CI.ParallelFor(NumTasks, Task);
+    }
+    else
+    {
+        for (Uint32 t = 0; t < NumTasks; ++t)
+            Task(t);
+    }
+}
+
+void FrustumCuller::Cull(const ViewFrustum* pFrustums, Uint32 NumViews, std::vector<Uint32>* pVisibleLists)
+{
+    DEV_CHECK_ERR(NumViews == 0 || (pFrustums != nullptr && pVisibleLists != nullptr), "Frustums and visible lists must not be null");
+
+    if (NumViews == 0)
+        return;
+
+    std::vector<CullFrustum> Frustums(NumViews);
+    for (Uint32 v = 0; v < NumViews; ++v)
+        Frustums[v] = PrepareFrustum(pFrustums[v]);
+
+    // Every partition writes its visible instances to the scratch buffer at the partition
+    // start, and the results are gathered into the visible lists afterwards
+    if (m_Scratch.size() < size_t{m_NumInstances} * NumViews)
+        m_Scratch.resize(size_t{m_NumInstances} * NumViews);
+
+    InstanceStreams Streams;
+    Streams.SphereX    = m_SphereX.data();
+    Streams.SphereY    = m_SphereY.data();
+    Streams.SphereZ    = m_SphereZ.data();
+    Streams.SphereR    = m_SphereR.data();
+    Streams.BoxCenterX = m_BoxCenterX.data();
+    Streams.BoxCenterY = m_BoxCenterY.data();
+    Streams.BoxCenterZ = m_BoxCenterZ.data();
+    Streams.BoxExtentX = m_BoxExtentX.data();
+    Streams.BoxExtentY = m_BoxExtentY.data();
+    Streams.BoxExtentZ = m_BoxExtentZ.data();
+
+    const auto PartitionSize = m_PartitionSize;
+    const auto NumPartitions = (m_NumInstances + PartitionSize - 1) / PartitionSize;
+    m_PartitionCounts.resize(size_t{NumPartitions} * NumViews);
+
+    RunTasks(NumPartitions, [&](Uint32 Partition) {
+        const auto Begin = Partition * PartitionSize;
+        const auto End   = std::min(Begin + PartitionSize, m_NumInstances);
+        for (Uint32 v = 0; v < NumViews; ++v)
+        {
+            auto* pOut = m_Scratch.data() + size_t{v} * m_NumInstances + Begin;
+
+            m_PartitionCounts[size_t{v} * NumPartitions + Partition] = CullRange(Streams, Frustums[v], Begin, End, pOut);
+        }
+    });
+
+    for (Uint32 v = 0; v < NumViews; ++v)
+    {
+        auto& List = pVisibleLists[v];
+        List.clear();
+        for (Uint32 Partition = 0; Partition < NumPartitions; ++Partition)
+        {
+            const auto  Count = m_PartitionCounts[size_t{v} * NumPartitions + Partition];
+            const auto* pSrc  = m_Scratch.data() + size_t{v} * m_NumInstances + Partition * PartitionSize;
+            List.insert(List.end(), pSrc, pSrc + Count);
+        }
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,431 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUInstanceCuller.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+constexpr Uint32 DrawArgsStride = 5; // NumIndices, NumInstances, FirstIndexLocation, BaseVertex, FirstInstanceLocation
+
+const char* g_CullInstancesCS = R"(
+struct InstanceData
+{
+    float4 Transform[4];
+    float4 BoundingSphere;
+    uint   MeshId;
+    uint3  Padding;
+};
+
+struct MeshData
+{
+    uint NumIndices;
+    uint FirstIndexLocation;
+    int  BaseVertex;
+    uint Padding;
+};
+
+cbuffer cbCullAttribs
+{
+    float4 g_FrustumPlanes[6];
+    float4 g_HiZViewProj[4]; // Rows of the view-projection matrix of the frame that produced the Hi-Z pyramid
+    float2 g_HiZSize;
+    uint   g_HiZNumMips;
+    uint   g_NumInstances;
+}
+
+StructuredBuffer<InstanceData> g_Instances;
+StructuredBuffer<MeshData>     g_Meshes;
+
+RWBuffer<uint /*format = r32ui*/> g_DrawArgs;
+RWBuffer<uint /*format = r32ui*/> g_VisibleInstances;
+RWBuffer<uint /*format = r32ui*/> g_DrawCount;
+
+#if OCCLUSION_CULLING
+Texture2D<float> g_HiZ;
+
+float LoadHiZ(int2 Location, uint Mip)
+{
+    return g_HiZ.Load(int3(Location, int(Mip)));
+}
+
+bool IsOccluded(float3 Center, float Radius)
+{
+    // Project the corners of the cube enclosing the sphere to the screen of the Hi-Z frame
+    float2 MinUV    = float2(1.0, 1.0);
+    float2 MaxUV    = float2(0.0, 0.0);
+    float  MinDepth = 1.0;
+    for (uint i = 0u; i < 8u; ++i)
+    {
+        float3 Corner = Center + Radius * float3((i & 1u) != 0u ? 1.0 : -1.0,
+                                                 (i & 2u) != 0u ? 1.0 : -1.0,
+                                                 (i & 4u) != 0u ? 1.0 : -1.0);
+        float4 ClipPos = Corner.x * g_HiZViewProj[0] + Corner.y * g_HiZViewProj[1] + Corner.z * g_HiZViewProj[2] + g_HiZViewProj[3];
+
+        // Bounds that cross the camera plane can't be projected
+        if (ClipPos.w <= 0.0)
+            return false;
+
+        float3 NDC = ClipPos.xyz / ClipPos.w;
+#if NDC_DEPTH_MINUS_ONE_TO_ONE
+        float2 UV    = float2(0.5 + 0.5 * NDC.x, 0.5 + 0.5 * NDC.y);
+        float  Depth = 0.5 + 0.5 * NDC.z;
+#else
+        float2 UV    = float2(0.5 + 0.5 * NDC.x, 0.5 - 0.5 * NDC.y);
+        float  Depth = NDC.z;
+#endif
+        MinUV    = min(MinUV, UV);
+        MaxUV    = max(MaxUV, UV);
+        MinDepth = min(MinDepth, Depth);
+    }
+    MinUV = saturate(MinUV);
+    MaxUV = saturate(MaxUV);
+
+    // Select the level where the rectangle spans at most 2x2 texels
+    float2 RectSize = (MaxUV - MinUV) * g_HiZSize;
+    uint   Mip      = min(uint(ceil(log2(max(max(RectSize.x, RectSize.y), 1.0)))), g_HiZNumMips - 1u);
+    int2   MipSize  = max(int2(g_HiZSize) >> int(Mip), int2(1, 1));
+    int2   MinTexel = min(int2(MinUV * float2(MipSize)), MipSize - int2(1, 1));
+    int2   MaxTexel = min(int2(MaxUV * float2(MipSize)), MipSize - int2(1, 1));
+
+    float MaxDepth = max(max(LoadHiZ(MinTexel, Mip),                     LoadHiZ(int2(MaxTexel.x, MinTexel.y), Mip)),
+                         max(LoadHiZ(int2(MinTexel.x, MaxTexel.y), Mip), LoadHiZ(MaxTexel, Mip)));
+
+    // The object is hidden if it is entirely behind the farthest occluder depth
+    return MinDepth > MaxDepth;
+}
+#endif
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    uint InstId = DTid.x;
+    if (InstId >= g_NumInstances)
+        return;
+
+    InstanceData Inst = g_Instances[InstId];
+
+    // Row-vector convention: world = local.x * r0 + local.y * r1 + local.z * r2 + r3
+    float3 Center = Inst.BoundingSphere.x * Inst.Transform[0].xyz +
+                    Inst.BoundingSphere.y * Inst.Transform[1].xyz +
+                    Inst.BoundingSphere.z * Inst.Transform[2].xyz +
+                    Inst.Transform[3].xyz;
+    float MaxScale = max(max(length(Inst.Transform[0].xyz), length(Inst.Transform[1].xyz)), length(Inst.Transform[2].xyz));
+    float Radius   = Inst.BoundingSphere.w * MaxScale;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(g_FrustumPlanes[i].xyz, Center) + g_FrustumPlanes[i].w < -Radius)
+            return;
+    }
+
+#if OCCLUSION_CULLING
+    if (IsOccluded(Center, Radius))
+        return;
+#endif
+
+    uint Slot;
+    InterlockedAdd(g_DrawCount[0], 1u, Slot);
+
+    MeshData Mesh = g_Meshes[Inst.MeshId];
+    g_DrawArgs[Slot * 5u + 0u] = Mesh.NumIndices;
+    g_DrawArgs[Slot * 5u + 1u] = 1u;
+    g_DrawArgs[Slot * 5u + 2u] = Mesh.FirstIndexLocation;
+    g_DrawArgs[Slot * 5u + 3u] = asuint(Mesh.BaseVertex);
+    g_DrawArgs[Slot * 5u + 4u] = Slot;
+    g_VisibleInstances[Slot]   = InstId;
+}
+)";
+// clang-format on
+
+struct CullAttribs
+{
+    float4 FrustumPlanes[6];
+    float4 HiZViewProj[4];
+    float2 HiZSize;
+    Uint32 HiZNumMips;
+    Uint32 NumInstances;
+};
+
+RefCntAutoPtr<IBuffer> CreateBuffer(IRenderDevice* pDevice, const char* Name, Uint32 Size, BIND_FLAGS BindFlags, BUFFER_MODE Mode, Uint32 Stride)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = Name;
+    BuffDesc.uiSizeInBytes     = Size;
+    BuffDesc.BindFlags         = BindFlags;
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.Mode              = Mode;
+    BuffDesc.ElementByteStride = Stride;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    if (!pBuffer)
+        LOG_ERROR_AND_THROW("Failed to create buffer '", Name, "'");
+    return pBuffer;
+}
+
+RefCntAutoPtr<IBufferView> CreateUintUAV(IBuffer* pBuffer)
+{
+    BufferViewDesc ViewDesc;
+    ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+
+    RefCntAutoPtr<IBufferView> pUAV;
+    pBuffer->CreateView(ViewDesc, &pUAV);
+    return pUAV;
+}
+
+} // namespace
+
+GPUInstanceCuller::GPUInstanceCuller(const GPUInstanceCullerCreateInfo& CI) :
+    // clang-format off
+    m_pDevice        {CI.pDevice        },
+    m_MaxInstances   {CI.MaxInstances   },
+    m_MaxMeshes      {CI.MaxMeshes      },
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+// clang-format on
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_MaxInstances > 0 && m_MaxMeshes > 0, "The maximum number of instances and meshes must not be zero");
+    DEV_CHECK_ERR(m_ThreadGroupSize > 0, "Thread group size must not be zero");
+
+    const auto& Features = m_pDevice->GetDeviceCaps().Features;
+    if (!Features.ComputeShaders || !Features.DrawIndirectCount)
+        LOG_ERROR_AND_THROW("GPU instance culling requires compute shaders and indirect draw count");
+    // Every command references its visible instance through FirstInstanceLocation
+    if (!Features.DrawIndirectFirstInstance)
+        LOG_ERROR_AND_THROW("GPU instance culling requires non-zero first instance in indirect draw commands");
+
+    // clang-format off
+    m_pInstanceBuffer        = CreateBuffer(m_pDevice, "GPU culler instances",         m_MaxInstances * sizeof(GPUCullInstanceData),     BIND_SHADER_RESOURCE,                            BUFFER_MODE_STRUCTURED, sizeof(GPUCullInstanceData));
+    m_pMeshBuffer            = CreateBuffer(m_pDevice, "GPU culler meshes",            m_MaxMeshes    * sizeof(GPUCullMeshData),         BIND_SHADER_RESOURCE,                            BUFFER_MODE_STRUCTURED, sizeof(GPUCullMeshData));
+    m_pVisibleInstanceBuffer = CreateBuffer(m_pDevice, "GPU culler visible instances", m_MaxInstances * sizeof(Uint32),                  BIND_VERTEX_BUFFER      | BIND_UNORDERED_ACCESS, BUFFER_MODE_FORMATTED,  sizeof(Uint32));
+    m_pDrawArgsBuffer        = CreateBuffer(m_pDevice, "GPU culler draw args",         m_MaxInstances * sizeof(Uint32) * DrawArgsStride, BIND_INDIRECT_DRAW_ARGS | BIND_UNORDERED_ACCESS, BUFFER_MODE_FORMATTED,  sizeof(Uint32));
+    m_pDrawCountBuffer       = CreateBuffer(m_pDevice, "GPU culler draw count",                         sizeof(Uint32),                  BIND_INDIRECT_DRAW_ARGS | BIND_UNORDERED_ACCESS, BUFFER_MODE_FORMATTED,  sizeof(Uint32));
+    // clang-format on
+
+    m_pDrawArgsUAV        = CreateUintUAV(m_pDrawArgsBuffer);
+    m_pVisibleInstanceUAV = CreateUintUAV(m_pVisibleInstanceBuffer);
+    m_pDrawCountUAV       = CreateUintUAV(m_pDrawCountBuffer);
+
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name           = "GPU culler attribs CB";
+        CBDesc.uiSizeInBytes  = sizeof(CullAttribs);
+        CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        CBDesc.Usage          = USAGE_DYNAMIC;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pCullAttribsCB);
+    }
+
+    m_pCullPSO = CreateCullPSO(false);
+    m_pCullPSO->CreateShaderResourceBinding(&m_pCullSRB, true);
+
+    if (CI.EnableOcclusionCulling)
+    {
+        m_pOcclusionCullPSO = CreateCullPSO(true);
+        m_pOcclusionCullPSO->CreateShaderResourceBinding(&m_pOcclusionCullSRB, true);
+    }
+}
+
+RefCntAutoPtr<IPipelineState> GPUInstanceCuller::CreateCullPSO(bool OcclusionCulling)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", static_cast<Int32>(m_ThreadGroupSize));
+    Macros.AddShaderMacro("OCCLUSION_CULLING", OcclusionCulling);
+    // OpenGL clip space depth range is [-1, 1], and the texture origin is in the bottom-left corner
+    Macros.AddShaderMacro("NDC_DEPTH_MINUS_ONE_TO_ONE", m_pDevice->GetDeviceCaps().IsGLDevice());
+    Macros.Finalize();
+
+    ShaderCreateInfo CSCreateInfo;
+    CSCreateInfo.Source                     = g_CullInstancesCS;
+    CSCreateInfo.EntryPoint                 = "main";
+    CSCreateInfo.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    CSCreateInfo.UseCombinedTextureSamplers = true;
+    CSCreateInfo.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    CSCreateInfo.Desc.Name                  = OcclusionCulling ? "Cull instances with Hi-Z CS" : "Cull instances CS";
+    CSCreateInfo.Macros                     = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(CSCreateInfo, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create instance culling shader");
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
+
+    PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSODesc.Name         = OcclusionCulling ? "Cull instances with Hi-Z PSO" : "Cull instances PSO";
+    PSOCreateInfo.pCS    = pCS;
+
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    // The Hi-Z pyramid may be recreated when the depth buffer is resized
+    ShaderResourceVariableDesc HiZVarDesc{SHADER_TYPE_COMPUTE, "g_HiZ", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+    if (OcclusionCulling)
+    {
+        PSODesc.ResourceLayout.Variables    = &HiZVarDesc;
+        PSODesc.ResourceLayout.NumVariables = 1;
+    }
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+        LOG_ERROR_AND_THROW("Failed to create instance culling pipeline state");
+
+    // clang-format off
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbCullAttribs"     )->Set(m_pCullAttribsCB);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Instances"       )->Set(m_pInstanceBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Meshes"          )->Set(m_pMeshBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_DrawArgs"        )->Set(m_pDrawArgsUAV);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_VisibleInstances")->Set(m_pVisibleInstanceUAV);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_DrawCount"       )->Set(m_pDrawCountUAV);
+    // clang-format on
+
+    return pPSO;
+}
+
+void GPUInstanceCuller::UpdateInstances(IDeviceContext* pContext, Uint32 FirstInstance, Uint32 NumInstances, const GPUCullInstanceData* pInstances)
+{
+    DEV_CHECK_ERR(FirstInstance + NumInstances <= m_MaxInstances, "Instance range [", FirstInstance, ", ", FirstInstance + NumInstances,
+                  ") exceeds the maximum number of instances (", m_MaxInstances, ")");
+    if (NumInstances == 0)
+        return;
+
+    pContext->UpdateBuffer(m_pInstanceBuffer, FirstInstance * sizeof(GPUCullInstanceData), NumInstances * sizeof(GPUCullInstanceData),
+                           pInstances, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void GPUInstanceCuller::UpdateMeshes(IDeviceContext* pContext, Uint32 FirstMesh, Uint32 NumMeshes, const GPUCullMeshData* pMeshes)
+{
+    DEV_CHECK_ERR(FirstMesh + NumMeshes <= m_MaxMeshes, "Mesh range [", FirstMesh, ", ", FirstMesh + NumMeshes,
+                  ") exceeds the maximum number of meshes (", m_MaxMeshes, ")");
+    if (NumMeshes == 0)
+        return;
+
+    pContext->UpdateBuffer(m_pMeshBuffer, FirstMesh * sizeof(GPUCullMeshData), NumMeshes * sizeof(GPUCullMeshData),
+                           pMeshes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void GPUInstanceCuller::SetNumInstances(Uint32 NumInstances)
+{
+    DEV_CHECK_ERR(NumInstances <= m_MaxInstances, "The number of instances (", NumInstances, ") exceeds the maximum (", m_MaxInstances, ")");
+    m_NumInstances = std::min(NumInstances, m_MaxInstances);
+}
+
+void GPUInstanceCuller::Cull(IDeviceContext* pContext, const float4x4& ViewProj, const GPUCullOcclusionAttribs* pOcclusion)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pOcclusion == nullptr || (pOcclusion->pHiZ != nullptr && m_pOcclusionCullPSO),
+                  "Occlusion culling requires a Hi-Z pyramid and the culler created with EnableOcclusionCulling flag");
+
+    const bool UseOcclusion = pOcclusion != nullptr && pOcclusion->pHiZ != nullptr && m_pOcclusionCullPSO;
+
+    {
+        ViewFrustum Frustum;
+        ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, !m_pDevice->GetDeviceCaps().IsGLDevice());
+
+        const Plane3D* Planes[] = {&Frustum.LeftPlane, &Frustum.RightPlane, &Frustum.BottomPlane, &Frustum.TopPlane, &Frustum.NearPlane, &Frustum.FarPlane};
+
+        MapHelper<CullAttribs> Attribs{pContext, m_pCullAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+        for (size_t i = 0; i < _countof(Planes); ++i)
+        {
+            // Planes must be normalized for the distance to be compared with the radius
+            const auto Len            = std::max(length(Planes[i]->Normal), 1e-12f);
+            Attribs->FrustumPlanes[i] = float4{Planes[i]->Normal / Len, Planes[i]->Distance / Len};
+        }
+        Attribs->NumInstances = m_NumInstances;
+
+        if (UseOcclusion)
+        {
+            const auto& M    = pOcclusion->HiZViewProj;
+            auto*       pHiZ = pOcclusion->pHiZ;
+            for (Uint32 r = 0; r < 4; ++r)
+                Attribs->HiZViewProj[r] = float4{M.m[r][0], M.m[r][1], M.m[r][2], M.m[r][3]};
+            Attribs->HiZSize    = float2{static_cast<float>(pHiZ->GetWidth()), static_cast<float>(pHiZ->GetHeight())};
+            Attribs->HiZNumMips = pHiZ->GetNumMipLevels();
+        }
+    }
+
+    const Uint32 Zero = 0;
+    pContext->UpdateBuffer(m_pDrawCountBuffer, 0, sizeof(Zero), &Zero, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // Dispatching zero thread groups is invalid in some backends. The count is still
+    // reset, so that the draw count buffer can be used when the scene is empty.
+    if (m_NumInstances != 0)
+    {
+        if (UseOcclusion)
+        {
+            m_pOcclusionCullSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_HiZ")->Set(pOcclusion->pHiZ->GetSRV());
+            pContext->SetPipelineState(m_pOcclusionCullPSO);
+            pContext->CommitShaderResources(m_pOcclusionCullSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        else
+        {
+            pContext->SetPipelineState(m_pCullPSO);
+            pContext->CommitShaderResources(m_pCullSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        pContext->DispatchCompute(DispatchComputeAttribs{(m_NumInstances + m_ThreadGroupSize - 1) / m_ThreadGroupSize, 1, 1});
+    }
+
+    // Transition the buffers now, as the draw is typically recorded inside a render pass
+    // clang-format off
+    StateTransitionDesc Barriers[] =
+    {
+        {m_pDrawArgsBuffer,        RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDIRECT_ARGUMENT, true},
+        {m_pDrawCountBuffer,       RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDIRECT_ARGUMENT, true},
+        {m_pVisibleInstanceBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER,     true}
+    };
+    // clang-format on
+    pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+}
+
+void GPUInstanceCuller::Draw(IDeviceContext* pContext, VALUE_TYPE IndexType)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (m_NumInstances == 0)
+        return;
+
+    DrawIndexedIndirectCountAttribs Attribs{IndexType, DRAW_FLAG_VERIFY_ALL, m_NumInstances,
+                                            RESOURCE_STATE_TRANSITION_MODE_VERIFY, RESOURCE_STATE_TRANSITION_MODE_VERIFY};
+    pContext->DrawIndexedIndirectCount(Attribs, m_pDrawArgsBuffer, m_pDrawCountBuffer);
+}
+
+} // namespace Diligent
@@ -0,0 +1,267 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "HiZPyramid.hpp"
+
+#include <algorithm>
+
+#if VULKAN_SUPPORTED
+#    include "../../GraphicsEngineVulkan/interface/DeviceContextVk.h"
+#endif
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+const char* g_HiZReduceCS = R"(
+cbuffer cbHiZAttribs
+{
+    uint2 g_SrcSize;
+    uint2 g_DstSize;
+}
+
+#if COPY_DEPTH
+Texture2D<float> g_Src;
+#else
+RWTexture2D<float /*format = r32f*/> g_Src;
+#endif
+RWTexture2D<float /*format = r32f*/> g_Dst;
+
+float LoadSrc(int2 Location)
+{
+    Location = min(Location, int2(g_SrcSize) - int2(1, 1));
+#if COPY_DEPTH
+    return g_Src.Load(int3(Location, 0));
+#else
+    return g_Src[Location];
+#endif
+}
+
+[numthreads(8, 8, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x >= g_DstSize.x || DTid.y >= g_DstSize.y)
+        return;
+
+#if COPY_DEPTH
+    g_Dst[DTid.xy] = LoadSrc(int2(DTid.xy));
+#else
+    int2  SrcXY = int2(DTid.xy) * 2;
+    float Depth = max(max(LoadSrc(SrcXY),              LoadSrc(SrcXY + int2(1, 0))),
+                      max(LoadSrc(SrcXY + int2(0, 1)), LoadSrc(SrcXY + int2(1, 1))));
+
+    // When a source dimension is odd, the last destination texel also covers the last source row or column
+    bool LastX = (g_SrcSize.x & 1u) != 0u && DTid.x == g_DstSize.x - 1u;
+    bool LastY = (g_SrcSize.y & 1u) != 0u && DTid.y == g_DstSize.y - 1u;
+    if (LastX)
+        Depth = max(Depth, max(LoadSrc(SrcXY + int2(2, 0)), LoadSrc(SrcXY + int2(2, 1))));
+    if (LastY)
+        Depth = max(Depth, max(LoadSrc(SrcXY + int2(0, 2)), LoadSrc(SrcXY + int2(1, 2))));
+    if (LastX && LastY)
+        Depth = max(Depth, LoadSrc(SrcXY + int2(2, 2)));
+
+    g_Dst[DTid.xy] = Depth;
+#endif
+}
+)";
+// clang-format on
+
+struct HiZAttribs
+{
+    Uint32 SrcSize[2];
+    Uint32 DstSize[2];
+};
+
+RefCntAutoPtr<IPipelineState> CreateReducePSO(IRenderDevice* pDevice, IBuffer* pAttribsCB, bool CopyDepth)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("COPY_DEPTH", CopyDepth);
+    Macros.Finalize();
+
+    ShaderCreateInfo CSCreateInfo;
+    CSCreateInfo.Source                     = g_HiZReduceCS;
+    CSCreateInfo.EntryPoint                 = "main";
+    CSCreateInfo.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    CSCreateInfo.UseCombinedTextureSamplers = true;
+    CSCreateInfo.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    CSCreateInfo.Desc.Name                  = CopyDepth ? "Hi-Z copy depth CS" : "Hi-Z reduce CS";
+    CSCreateInfo.Macros                     = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(CSCreateInfo, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create Hi-Z shader");
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
+
+    PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSODesc.Name         = CopyDepth ? "Hi-Z copy depth PSO" : "Hi-Z reduce PSO";
+    PSOCreateInfo.pCS    = pCS;
+
+    // Source and destination views change with every dispatch
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    ShaderResourceVariableDesc VarDesc{SHADER_TYPE_COMPUTE, "cbHiZAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC};
+    PSODesc.ResourceLayout.Variables    = &VarDesc;
+    PSODesc.ResourceLayout.NumVariables = 1;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+        LOG_ERROR_AND_THROW("Failed to create Hi-Z pipeline state");
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbHiZAttribs")->Set(pAttribsCB);
+    return pPSO;
+}
+
+} // namespace
+
+HiZPyramid::HiZPyramid(const HiZPyramidCreateInfo& CI) :
+    // clang-format off
+    m_pDevice{CI.pDevice},
+    m_Width  {CI.Width  },
+    m_Height {CI.Height }
+// clang-format on
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_Width > 0 && m_Height > 0, "Hi-Z pyramid dimensions must not be zero");
+
+    const bool IsVulkan = m_pDevice->GetDeviceCaps().IsVulkanDevice();
+
+    m_NumMips = ComputeMipLevelsCount(m_Width, m_Height);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Hi-Z pyramid";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = m_Width;
+    TexDesc.Height    = m_Height;
+    TexDesc.MipLevels = m_NumMips;
+    TexDesc.Format    = TEX_FORMAT_R32_FLOAT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    // Vulkan compute mip generation requires per-mip views created by the engine
+    if (IsVulkan)
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+    m_pDevice->CreateTexture(TexDesc, nullptr, &m_pTexture);
+    if (!m_pTexture)
+        LOG_ERROR_AND_THROW("Failed to create Hi-Z pyramid texture");
+
+    BufferDesc CBDesc;
+    CBDesc.Name           = "Hi-Z attribs CB";
+    CBDesc.uiSizeInBytes  = sizeof(HiZAttribs);
+    CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CBDesc.Usage          = USAGE_DYNAMIC;
+    CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pAttribsCB);
+
+    m_pCopyPSO = CreateReducePSO(m_pDevice, m_pAttribsCB, true);
+    m_pCopyPSO->CreateShaderResourceBinding(&m_pCopySRB, true);
+
+    m_MipUAVs.resize(m_NumMips);
+    for (Uint32 Mip = 0; Mip < m_NumMips; ++Mip)
+    {
+        TextureViewDesc ViewDesc;
+        ViewDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+        ViewDesc.MostDetailedMip = Mip;
+        ViewDesc.NumMipLevels    = 1;
+        m_pTexture->CreateView(ViewDesc, &m_MipUAVs[Mip]);
+    }
+
+#if VULKAN_SUPPORTED
+    if (IsVulkan)
+        return;
+#endif
+
+    m_pReducePSO = CreateReducePSO(m_pDevice, m_pAttribsCB, false);
+    m_pReducePSO->CreateShaderResourceBinding(&m_pReduceSRB, true);
+}
+
+void HiZPyramid::Build(IDeviceContext* pContext, ITextureView* pDepthSRV)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pDepthSRV != nullptr, "Depth buffer view must not be null");
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto& DepthDesc = pDepthSRV->GetTexture()->GetDesc();
+        DEV_CHECK_ERR(DepthDesc.Width == m_Width && DepthDesc.Height == m_Height,
+                      "Depth buffer dimensions (", DepthDesc.Width, "x", DepthDesc.Height,
+                      ") do not match the Hi-Z pyramid dimensions (", m_Width, "x", m_Height, ")");
+        DEV_CHECK_ERR(DepthDesc.SampleCount == 1, "Multisampled depth buffers are not supported");
+    }
+#endif
+
+    auto Dispatch = [&](IPipelineState* pPSO, IShaderResourceBinding* pSRB, Uint32 SrcW, Uint32 SrcH, Uint32 DstW, Uint32 DstH) {
+        {
+            MapHelper<HiZAttribs> Attribs{pContext, m_pAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+            *Attribs = HiZAttribs{{SrcW, SrcH}, {DstW, DstH}};
+        }
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{(DstW + 7) / 8, (DstH + 7) / 8, 1});
+    };
+
+    m_pCopySRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Src")->Set(pDepthSRV);
+    m_pCopySRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Dst")->Set(m_MipUAVs[0]);
+    Dispatch(m_pCopyPSO, m_pCopySRB, m_Width, m_Height, m_Width, m_Height);
+
+    if (m_NumMips > 1)
+    {
+#if VULKAN_SUPPORTED
+        RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+        if (pContextVk)
+        {
+            pContextVk->GenerateMaxReductionMips(GetSRV());
+        }
+        else
+#endif
+        {
+            // Different mip levels of the same texture are bound as source and destination UAVs,
+            // so the whole texture stays in the unordered access state until the chain is built.
+            for (Uint32 Mip = 1; Mip < m_NumMips; ++Mip)
+            {
+                const auto SrcW = std::max(m_Width >> (Mip - 1), 1u);
+                const auto SrcH = std::max(m_Height >> (Mip - 1), 1u);
+                m_pReduceSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Src")->Set(m_MipUAVs[Mip - 1]);
+                m_pReduceSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Dst")->Set(m_MipUAVs[Mip]);
+                Dispatch(m_pReducePSO, m_pReduceSRB, SrcW, SrcH, std::max(SrcW >> 1, 1u), std::max(SrcH >> 1, 1u));
+            }
+        }
+    }
+
+    StateTransitionDesc Barrier{m_pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true};
+    pContext->TransitionResourceStates(1, &Barrier);
+}
+
+} // namespace Diligent
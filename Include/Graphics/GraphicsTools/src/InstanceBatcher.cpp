@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "InstanceBatcher.hpp"
+
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+bool InstancedDrawDesc::operator==(const InstancedDrawDesc& rhs) const
+{
+    // clang-format off
+    if (pPSO                       != rhs.pPSO                       ||
+        pSRB                       != rhs.pSRB                       ||
+        NumVertexBuffers           != rhs.NumVertexBuffers           ||
+        pIndexBuffer               != rhs.pIndexBuffer               ||
+        IndexOffset                != rhs.IndexOffset                ||
+        Attribs.NumIndices         != rhs.Attribs.NumIndices         ||
+        Attribs.IndexType          != rhs.Attribs.IndexType          ||
+        Attribs.Flags              != rhs.Attribs.Flags              ||
+        Attribs.FirstIndexLocation != rhs.Attribs.FirstIndexLocation ||
+        Attribs.BaseVertex         != rhs.Attribs.BaseVertex)
+        return false;
+    // clang-format on
+
+    for (Uint32 vb = 0; vb < NumVertexBuffers; ++vb)
+    {
+        if (pVertexBuffers[vb] != rhs.pVertexBuffers[vb] || VertexOffsets[vb] != rhs.VertexOffsets[vb])
+            return false;
+    }
+    return true;
+}
+
+size_t InstancedDrawDesc::Hasher::operator()(const InstancedDrawDesc& Desc) const
+{
+    auto Hash = ComputeHash(Desc.pPSO, Desc.pSRB, Desc.NumVertexBuffers, Desc.pIndexBuffer, Desc.IndexOffset,
+                            Desc.Attribs.NumIndices, Desc.Attribs.IndexType, Desc.Attribs.Flags,
+                            Desc.Attribs.FirstIndexLocation, Desc.Attribs.BaseVertex);
+    for (Uint32 vb = 0; vb < Desc.NumVertexBuffers; ++vb)
+        HashCombine(Hash, Desc.pVertexBuffers[vb], Desc.VertexOffsets[vb]);
+    return Hash;
+}
+
+
+static StreamingBufferCreateInfo GetInstanceStreamCreateInfo(const InstanceBatcherCreateInfo& CI)
+{
+    StreamingBufferCreateInfo StreamCI;
+    StreamCI.pDevice                 = CI.pDevice;
+    StreamCI.BuffDesc.Name           = CI.Name;
+    StreamCI.BuffDesc.uiSizeInBytes  = CI.InitialBufferSize;
+    StreamCI.BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+    StreamCI.BuffDesc.Usage          = USAGE_DYNAMIC;
+    StreamCI.BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    StreamCI.NumContexts             = CI.NumContexts;
+    // The buffer is mapped once per flush, so there is no benefit in keeping it mapped
+    StreamCI.AllowPersistentMapping = false;
+    return StreamCI;
+}
+
+InstanceBatcher::InstanceBatcher(const InstanceBatcherCreateInfo& CI) :
+    // clang-format off
+    m_pDevice            {CI.pDevice                      },
+    m_InstanceDataSize   {CI.InstanceDataSize             },
+    m_InstanceBufferSlot {CI.InstanceBufferSlot           },
+    m_StateTransitionMode{CI.StateTransitionMode          },
+    m_InstanceStream     {GetInstanceStreamCreateInfo(CI)}
+// clang-format on
+{
+    DEV_CHECK_ERR(m_InstanceDataSize > 0, "Instance data size must not be zero");
+    DEV_CHECK_ERR(m_InstanceBufferSlot < MAX_BUFFER_SLOTS, "Instance buffer slot (", m_InstanceBufferSlot, ") is out of range");
+}
+
+void InstanceBatcher::AddInstances(const InstancedDrawDesc& Draw, const void* pInstanceData, Uint32 NumInstances)
+{
+    DEV_CHECK_ERR(Draw.pPSO != nullptr, "Draw must have a pipeline state");
+    DEV_CHECK_ERR(Draw.pIndexBuffer != nullptr, "Draw must have an index buffer");
+    DEV_CHECK_ERR(Draw.NumVertexBuffers <= m_InstanceBufferSlot,
+                  "Per-vertex buffers (", Draw.NumVertexBuffers, ") overlap the instance buffer slot (", m_InstanceBufferSlot, ")");
+    VERIFY_EXPR(pInstanceData != nullptr || NumInstances == 0);
+
+    if (NumInstances == 0)
+        return;
+
+    auto it = m_BatchIndices.find(Draw);
+    if (it == m_BatchIndices.end())
+    {
+        if (m_NumBatches == m_Batches.size())
+            m_Batches.emplace_back();
+
+        auto& NewBatch = m_Batches[m_NumBatches];
+        NewBatch.Draw  = Draw;
+        VERIFY_EXPR(NewBatch.InstanceData.empty() && NewBatch.NumInstances == 0);
+
+        it = m_BatchIndices.emplace(Draw, m_NumBatches++).first;
+    }
+
+    auto&       CurrBatch = m_Batches[it->second];
+    const auto  DataSize  = size_t{NumInstances} * m_InstanceDataSize;
+    const auto* pSrc      = static_cast<const Uint8*>(pInstanceData);
+    CurrBatch.InstanceData.insert(CurrBatch.InstanceData.end(), pSrc, pSrc + DataSize);
+    CurrBatch.NumInstances += NumInstances;
+    m_NumInstances += NumInstances;
+}
+
+void InstanceBatcher::Flush(IDeviceContext* pContext, size_t CtxNum)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (m_NumInstances == 0)
+        return;
+
+    // Write instance data of all batches with a single map operation
+    const auto DataSize   = m_NumInstances * m_InstanceDataSize;
+    const auto BaseOffset = m_InstanceStream.Map(pContext, m_pDevice, DataSize, CtxNum);
+    {
+        auto* pDst = static_cast<Uint8*>(m_InstanceStream.GetMappedCPUAddress(CtxNum)) + BaseOffset;
+        for (Uint32 b = 0; b < m_NumBatches; ++b)
+        {
+            const auto& SrcData = m_Batches[b].InstanceData;
+            memcpy(pDst, SrcData.data(), SrcData.size());
+            pDst += SrcData.size();
+        }
+    }
+    m_InstanceStream.Unmap(CtxNum);
+
+    // The buffer may have been recreated by Map()
+    IBuffer* pInstanceBuffer = m_InstanceStream.GetBuffer();
+
+    IPipelineState*         pCurrPSO     = nullptr;
+    IShaderResourceBinding* pCurrSRB     = nullptr;
+    IBuffer*                pCurrIB      = nullptr;
+    Uint32                  CurrIBOffset = 0;
+
+    IBuffer* pVBs[MAX_BUFFER_SLOTS]      = {};
+    Uint32   VBOffsets[MAX_BUFFER_SLOTS] = {};
+
+    auto InstanceOffset = BaseOffset;
+    for (Uint32 b = 0; b < m_NumBatches; ++b)
+    {
+        const auto& CurrBatch = m_Batches[b];
+        const auto& Draw      = CurrBatch.Draw;
+
+        if (Draw.pPSO != pCurrPSO)
+        {
+            pContext->SetPipelineState(Draw.pPSO);
+            pCurrPSO = Draw.pPSO;
+            pCurrSRB = nullptr;
+        }
+
+        if (Draw.pSRB != nullptr && Draw.pSRB != pCurrSRB)
+        {
+            pContext->CommitShaderResources(Draw.pSRB, m_StateTransitionMode);
+            pCurrSRB = Draw.pSRB;
+        }
+
+        // Every batch reads its own region of the instance stream, so vertex buffers are always set
+        for (Uint32 vb = 0; vb < m_InstanceBufferSlot; ++vb)
+        {
+            pVBs[vb]      = vb < Draw.NumVertexBuffers ? Draw.pVertexBuffers[vb] : nullptr;
+            VBOffsets[vb] = vb < Draw.NumVertexBuffers ? Draw.VertexOffsets[vb] : 0;
+        }
+        pVBs[m_InstanceBufferSlot]      = pInstanceBuffer;
+        VBOffsets[m_InstanceBufferSlot] = InstanceOffset;
+        pContext->SetVertexBuffers(0, m_InstanceBufferSlot + 1, pVBs, VBOffsets, m_StateTransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        if (Draw.pIndexBuffer != pCurrIB || Draw.IndexOffset != CurrIBOffset)
+        {
+            pContext->SetIndexBuffer(Draw.pIndexBuffer, Draw.IndexOffset, m_StateTransitionMode);
+            pCurrIB      = Draw.pIndexBuffer;
+            CurrIBOffset = Draw.IndexOffset;
+        }
+
+        DrawIndexedAttribs Attribs    = Draw.Attribs;
+        Attribs.NumInstances          = CurrBatch.NumInstances;
+        Attribs.FirstInstanceLocation = 0;
+        pContext->DrawIndexed(Attribs);
+
+        InstanceOffset += CurrBatch.NumInstances * m_InstanceDataSize;
+    }
+
+    // Dynamic buffers must be mapped with MAP_FLAG_DISCARD first in every frame,
+    // so start from the beginning of the buffer the next time the batcher is flushed
+    m_InstanceStream.Flush(CtxNum);
+
+    Clear();
+}
+
+void InstanceBatcher::Clear()
+{
+    for (Uint32 b = 0; b < m_NumBatches; ++b)
+    {
+        m_Batches[b].InstanceData.clear();
+        m_Batches[b].NumInstances = 0;
+    }
+    m_NumBatches   = 0;
+    m_NumInstances = 0;
+    m_BatchIndices.clear();
+}
+
+} // namespace Diligent
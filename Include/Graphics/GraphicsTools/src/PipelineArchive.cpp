@@ -0,0 +1,497 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PipelineArchive.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 ArchiveMagic   = 0x41535044; // 'DPSA'
+constexpr Uint32 ArchiveVersion = 1;
+
+// Archive data is a sequence of little-endian values. Enums are stored as their underlying type,
+// booleans as single bytes, strings and arrays are prefixed with the number of elements.
+class ArchiveWriter
+{
+public:
+    explicit ArchiveWriter(std::vector<Uint8>& Data) :
+        m_Data{Data}
+    {}
+
+    template <typename T>
+    void operator()(const T& Val)
+    {
+        WriteValue(Val, std::is_enum<T>{});
+    }
+
+    void operator()(const bool& Val)
+    {
+        (*this)(Uint8{Val ? Uint8{1} : Uint8{0}});
+    }
+
+    void operator()(const std::string& Str)
+    {
+        (*this)(static_cast<Uint32>(Str.length()));
+        Write(Str.data(), Str.length());
+    }
+
+    void operator()(const std::vector<Uint32>& Words)
+    {
+        (*this)(static_cast<Uint32>(Words.size()));
+        Write(Words.data(), Words.size() * sizeof(Uint32));
+    }
+
+    template <typename T, typename HandlerType>
+    void operator()(const std::vector<T>& Elements, HandlerType Handler)
+    {
+        (*this)(static_cast<Uint32>(Elements.size()));
+        for (const auto& Elem : Elements)
+            Handler(Elem);
+    }
+
+private:
+    template <typename T>
+    void WriteValue(const T& Val, std::true_type /*IsEnum*/)
+    {
+        (*this)(static_cast<typename std::underlying_type<T>::type>(Val));
+    }
+
+    template <typename T>
+    void WriteValue(const T& Val, std::false_type /*IsEnum*/)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be written");
+        Write(&Val, sizeof(Val));
+    }
+
+    void Write(const void* pData, size_t Size)
+    {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+    }
+
+    std::vector<Uint8>& m_Data;
+};
+
+class ArchiveReader
+{
+public:
+    ArchiveReader(const void* pData, size_t Size) :
+        m_pCurr{static_cast<const Uint8*>(pData)},
+        m_pEnd{m_pCurr + Size}
+    {}
+
+    template <typename T>
+    void operator()(T& Val)
+    {
+        ReadValue(Val, std::is_enum<T>{});
+    }
+
+    void operator()(bool& Val)
+    {
+        Uint8 Byte = 0;
+        (*this)(Byte);
+        Val = Byte != 0;
+    }
+
+    void operator()(std::string& Str)
+    {
+        const auto Length = ReadCount(1);
+        Str.assign(reinterpret_cast<const char*>(m_pCurr), Length);
+        m_pCurr += Length;
+    }
+
+    void operator()(std::vector<Uint32>& Words)
+    {
+        Words.resize(ReadCount(sizeof(Uint32)));
+        Read(Words.data(), Words.size() * sizeof(Uint32));
+    }
+
+    template <typename T, typename HandlerType>
+    void operator()(std::vector<T>& Elements, HandlerType Handler)
+    {
+        // Every element takes at least one byte
+        Elements.resize(ReadCount(1));
+        for (auto& Elem : Elements)
+            Handler(Elem);
+    }
+
+    bool IsEnd() const { return m_pCurr == m_pEnd; }
+
+private:
+    template <typename T>
+    void ReadValue(T& Val, std::true_type /*IsEnum*/)
+    {
+        typename std::underlying_type<T>::type RawVal{};
+        (*this)(RawVal);
+        Val = static_cast<T>(RawVal);
+    }
+
+    template <typename T>
+    void ReadValue(T& Val, std::false_type /*IsEnum*/)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be read");
+        Read(&Val, sizeof(Val));
+    }
+
+    // Reads the number of elements and checks that the data is large enough to hold them,
+    // so that corrupted data never results in huge allocations
+    Uint32 ReadCount(size_t MinElementSize)
+    {
+        Uint32 Count = 0;
+        (*this)(Count);
+        if (Count > static_cast<size_t>(m_pEnd - m_pCurr) / MinElementSize)
+            LOG_ERROR_AND_THROW("Pipeline archive data is truncated");
+        return Count;
+    }
+
+    void Read(void* pData, size_t Size)
+    {
+        if (Size > static_cast<size_t>(m_pEnd - m_pCurr))
+            LOG_ERROR_AND_THROW("Pipeline archive data is truncated");
+        memcpy(pData, m_pCurr, Size);
+        m_pCurr += Size;
+    }
+
+    const Uint8*       m_pCurr;
+    const Uint8* const m_pEnd;
+};
+
+// The same function both writes and reads the data, so the layout is defined in one place
+template <typename ArchiveType, typename StencilOpDescType>
+void SerializeStencilOp(ArchiveType& Ar, StencilOpDescType& Desc)
+{
+    Ar(Desc.StencilFailOp);
+    Ar(Desc.StencilDepthFailOp);
+    Ar(Desc.StencilPassOp);
+    Ar(Desc.StencilFunc);
+}
+
+template <typename ArchiveType, typename ShaderListType, typename PipelineListType>
+void SerializeArchive(ArchiveType& Ar, ShaderListType& Shaders, PipelineListType& Pipelines)
+{
+    Ar(Shaders, [&Ar](auto& Shader) {
+        Ar(Shader.Name);
+        Ar(Shader.ShaderType);
+        Ar(Shader.EntryPoint);
+        Ar(Shader.SPIRV);
+        Ar(Shader.UseCombinedTextureSamplers);
+        Ar(Shader.CombinedSamplerSuffix);
+    });
+
+    Ar(Pipelines, [&Ar](auto& Pipeline) {
+        Ar(Pipeline.Name);
+        Ar(Pipeline.PipelineType);
+        Ar(Pipeline.Shaders, [&Ar](auto& Shader) {
+            Ar(Shader.Stage);
+            Ar(Shader.ShaderIndex);
+        });
+
+        auto& GraphicsPipeline = Pipeline.GraphicsPipeline;
+
+        auto& BlendDesc = GraphicsPipeline.BlendDesc;
+        Ar(BlendDesc.AlphaToCoverageEnable);
+        Ar(BlendDesc.IndependentBlendEnable);
+        for (auto& RT : BlendDesc.RenderTargets)
+        {
+            Ar(RT.BlendEnable);
+            Ar(RT.LogicOperationEnable);
+            Ar(RT.SrcBlend);
+            Ar(RT.DestBlend);
+            Ar(RT.BlendOp);
+            Ar(RT.SrcBlendAlpha);
+            Ar(RT.DestBlendAlpha);
+            Ar(RT.BlendOpAlpha);
+            Ar(RT.LogicOp);
+            Ar(RT.RenderTargetWriteMask);
+        }
+        Ar(GraphicsPipeline.SampleMask);
+
+        auto& RasterizerDesc = GraphicsPipeline.RasterizerDesc;
+        Ar(RasterizerDesc.FillMode);
+        Ar(RasterizerDesc.CullMode);
+        Ar(RasterizerDesc.FrontCounterClockwise);
+        Ar(RasterizerDesc.DepthClipEnable);
+        Ar(RasterizerDesc.ScissorEnable);
+        Ar(RasterizerDesc.AntialiasedLineEnable);
+        Ar(RasterizerDesc.DepthBias);
+        Ar(RasterizerDesc.DepthBiasClamp);
+        Ar(RasterizerDesc.SlopeScaledDepthBias);
+
+        auto& DepthStencilDesc = GraphicsPipeline.DepthStencilDesc;
+        Ar(DepthStencilDesc.DepthEnable);
+        Ar(DepthStencilDesc.DepthWriteEnable);
+        Ar(DepthStencilDesc.DepthFunc);
+        Ar(DepthStencilDesc.StencilEnable);
+        Ar(DepthStencilDesc.StencilReadMask);
+        Ar(DepthStencilDesc.StencilWriteMask);
+        SerializeStencilOp(Ar, DepthStencilDesc.FrontFace);
+        SerializeStencilOp(Ar, DepthStencilDesc.BackFace);
+
+        Ar(GraphicsPipeline.PrimitiveTopology);
+        Ar(GraphicsPipeline.NumViewports);
+        Ar(GraphicsPipeline.NumRenderTargets);
+        Ar(GraphicsPipeline.SubpassIndex);
+        for (auto& Fmt : GraphicsPipeline.RTVFormats)
+            Ar(Fmt);
+        Ar(GraphicsPipeline.DSVFormat);
+        Ar(GraphicsPipeline.SmplDesc.Count);
+        Ar(GraphicsPipeline.SmplDesc.Quality);
+        Ar(GraphicsPipeline.NodeMask);
+
+        Ar(Pipeline.InputLayout, [&Ar](auto& Elem) {
+            Ar(Elem.HLSLSemantic);
+            Ar(Elem.Element.InputIndex);
+            Ar(Elem.Element.BufferSlot);
+            Ar(Elem.Element.NumComponents);
+            Ar(Elem.Element.ValueType);
+            Ar(Elem.Element.IsNormalized);
+            Ar(Elem.Element.RelativeOffset);
+            Ar(Elem.Element.Stride);
+            Ar(Elem.Element.Frequency);
+            Ar(Elem.Element.InstanceDataStepRate);
+        });
+
+        Ar(Pipeline.DefaultVariableType);
+        Ar(Pipeline.Variables, [&Ar](auto& Var) {
+            Ar(Var.ShaderStages);
+            Ar(Var.Name);
+            Ar(Var.Type);
+        });
+        Ar(Pipeline.ImmutableSamplers, [&Ar](auto& Sampler) {
+            Ar(Sampler.ShaderStages);
+            Ar(Sampler.SamplerOrTextureName);
+            Ar(Sampler.Desc.MinFilter);
+            Ar(Sampler.Desc.MagFilter);
+            Ar(Sampler.Desc.MipFilter);
+            Ar(Sampler.Desc.AddressU);
+            Ar(Sampler.Desc.AddressV);
+            Ar(Sampler.Desc.AddressW);
+            Ar(Sampler.Desc.MipLODBias);
+            Ar(Sampler.Desc.MaxAnisotropy);
+            Ar(Sampler.Desc.ComparisonFunc);
+            for (auto& Color : Sampler.Desc.BorderColor)
+                Ar(Color);
+            Ar(Sampler.Desc.MinLOD);
+            Ar(Sampler.Desc.MaxLOD);
+        });
+    });
+}
+
+} // namespace
+
+void PipelineArchive::Serialize(const std::vector<ShaderData>&   Shaders,
+                                const std::vector<PipelineData>& Pipelines,
+                                std::vector<Uint8>&              Data)
+{
+    ArchiveWriter Ar{Data};
+    Ar(ArchiveMagic);
+    Ar(ArchiveVersion);
+    SerializeArchive(Ar, Shaders, Pipelines);
+}
+
+PipelineArchive::PipelineArchive(IRenderDevice* pDevice, const void* pData, size_t DataSize) :
+    m_pDevice{pDevice}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (!m_pDevice->GetDeviceCaps().IsVulkanDevice())
+        LOG_ERROR_AND_THROW("Pipeline archives contain SPIR-V bytecode and can only be used with a Vulkan device");
+    if (pData == nullptr)
+        LOG_ERROR_AND_THROW("Pipeline archive data must not be null");
+
+    ArchiveReader Ar{pData, DataSize};
+
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+    Ar(Magic);
+    Ar(Version);
+    if (Magic != ArchiveMagic)
+        LOG_ERROR_AND_THROW("The data is not a pipeline archive");
+    if (Version != ArchiveVersion)
+        LOG_ERROR_AND_THROW("Pipeline archive version (", Version, ") is not supported. Expected version: ", ArchiveVersion, ". Rebuild the archive.");
+
+    SerializeArchive(Ar, m_ShaderData, m_Pipelines);
+    if (!Ar.IsEnd())
+        LOG_ERROR_AND_THROW("Unexpected data at the end of the pipeline archive");
+
+    for (Uint32 p = 0; p < m_Pipelines.size(); ++p)
+    {
+        const auto& Pipeline = m_Pipelines[p];
+        if (Pipeline.PipelineType != PIPELINE_TYPE_GRAPHICS && Pipeline.PipelineType != PIPELINE_TYPE_MESH && Pipeline.PipelineType != PIPELINE_TYPE_COMPUTE)
+            LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' has unsupported type");
+
+        for (const auto& Shader : Pipeline.Shaders)
+        {
+            if (Shader.ShaderIndex >= m_ShaderData.size() || m_ShaderData[Shader.ShaderIndex].ShaderType != Shader.Stage)
+                LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' references invalid shader");
+        }
+
+        if (!m_PipelineIndices.emplace(Pipeline.Name, p).second)
+            LOG_ERROR_AND_THROW("Pipeline archive contains more than one pipeline named '", Pipeline.Name, "'");
+    }
+
+    m_Shaders.resize(m_ShaderData.size());
+}
+
+Int32 PipelineArchive::FindPipeline(const Char* Name) const
+{
+    auto it = m_PipelineIndices.find(Name);
+    return it != m_PipelineIndices.end() ? static_cast<Int32>(it->second) : -1;
+}
+
+IShader* PipelineArchive::GetShader(Uint32 ShaderIndex)
+{
+    auto& pShader = m_Shaders[ShaderIndex];
+    if (!pShader)
+    {
+        const auto& Data = m_ShaderData[ShaderIndex];
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc.Name                  = Data.Name.c_str();
+        ShaderCI.Desc.ShaderType            = Data.ShaderType;
+        ShaderCI.EntryPoint                 = Data.EntryPoint.c_str();
+        ShaderCI.ByteCode                   = Data.SPIRV.data();
+        ShaderCI.ByteCodeSize               = Data.SPIRV.size() * sizeof(Data.SPIRV[0]);
+        ShaderCI.UseCombinedTextureSamplers = Data.UseCombinedTextureSamplers;
+        ShaderCI.CombinedSamplerSuffix      = Data.CombinedSamplerSuffix.c_str();
+        m_pDevice->CreateShader(ShaderCI, &pShader);
+    }
+    return pShader;
+}
+
+RefCntAutoPtr<IPipelineState> PipelineArchive::CreatePipeline(Uint32 Index)
+{
+    DEV_CHECK_ERR(Index < m_Pipelines.size(), "Pipeline index (", Index, ") is out of range");
+
+    const auto& Pipeline = m_Pipelines[Index];
+
+    std::vector<LayoutElement> LayoutElements(Pipeline.InputLayout.size());
+    for (size_t i = 0; i < LayoutElements.size(); ++i)
+    {
+        LayoutElements[i]              = Pipeline.InputLayout[i].Element;
+        LayoutElements[i].HLSLSemantic = Pipeline.InputLayout[i].HLSLSemantic.c_str();
+    }
+
+    std::vector<ShaderResourceVariableDesc> Variables;
+    Variables.reserve(Pipeline.Variables.size());
+    for (const auto& Var : Pipeline.Variables)
+        Variables.emplace_back(Var.ShaderStages, Var.Name.c_str(), Var.Type);
+
+    std::vector<ImmutableSamplerDesc> ImmutableSamplers;
+    ImmutableSamplers.reserve(Pipeline.ImmutableSamplers.size());
+    for (const auto& Sampler : Pipeline.ImmutableSamplers)
+        ImmutableSamplers.emplace_back(Sampler.ShaderStages, Sampler.SamplerOrTextureName.c_str(), Sampler.Desc);
+
+    auto InitCommonDesc = [&](PipelineStateCreateInfo& PSOCreateInfo) {
+        auto& PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.Name         = Pipeline.Name.c_str();
+        PSODesc.PipelineType = Pipeline.PipelineType;
+
+        auto& ResourceLayout                = PSODesc.ResourceLayout;
+        ResourceLayout.DefaultVariableType  = Pipeline.DefaultVariableType;
+        ResourceLayout.NumVariables         = static_cast<Uint32>(Variables.size());
+        ResourceLayout.Variables            = Variables.data();
+        ResourceLayout.NumImmutableSamplers = static_cast<Uint32>(ImmutableSamplers.size());
+        ResourceLayout.ImmutableSamplers    = ImmutableSamplers.data();
+    };
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    if (Pipeline.PipelineType == PIPELINE_TYPE_COMPUTE)
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        InitCommonDesc(PSOCreateInfo);
+        for (const auto& Shader : Pipeline.Shaders)
+        {
+            if (Shader.Stage == SHADER_TYPE_COMPUTE)
+                PSOCreateInfo.pCS = GetShader(Shader.ShaderIndex);
+        }
+        if (PSOCreateInfo.pCS != nullptr)
+            m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    }
+    else
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        InitCommonDesc(PSOCreateInfo);
+
+        auto& GraphicsPipeline                      = PSOCreateInfo.GraphicsPipeline;
+        GraphicsPipeline                            = Pipeline.GraphicsPipeline;
+        GraphicsPipeline.InputLayout.NumElements    = static_cast<Uint32>(LayoutElements.size());
+        GraphicsPipeline.InputLayout.LayoutElements = LayoutElements.data();
+        GraphicsPipeline.pRenderPass                = nullptr;
+
+        bool AllShadersCreated = true;
+        for (const auto& Shader : Pipeline.Shaders)
+        {
+            auto* pShader     = GetShader(Shader.ShaderIndex);
+            AllShadersCreated = AllShadersCreated && pShader != nullptr;
+            switch (Shader.Stage)
+            {
+                // clang-format off
+                case SHADER_TYPE_VERTEX:        PSOCreateInfo.pVS = pShader; break;
+                case SHADER_TYPE_PIXEL:         PSOCreateInfo.pPS = pShader; break;
+                case SHADER_TYPE_GEOMETRY:      PSOCreateInfo.pGS = pShader; break;
+                case SHADER_TYPE_HULL:          PSOCreateInfo.pHS = pShader; break;
+                case SHADER_TYPE_DOMAIN:        PSOCreateInfo.pDS = pShader; break;
+                case SHADER_TYPE_AMPLIFICATION: PSOCreateInfo.pAS = pShader; break;
+                case SHADER_TYPE_MESH:          PSOCreateInfo.pMS = pShader; break;
+                // clang-format on
+                default:
+                    LOG_ERROR_MESSAGE("Shader stage ", GetShaderTypeLiteralName(Shader.Stage), " is not supported in graphics pipeline '", Pipeline.Name, "'");
+                    AllShadersCreated = false;
+            }
+        }
+        if (AllShadersCreated)
+            m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    }
+
+    if (!pPSO)
+        LOG_ERROR_MESSAGE("Failed to create pipeline '", Pipeline.Name, "' from the archive");
+
+    return pPSO;
+}
+
+RefCntAutoPtr<IPipelineState> PipelineArchive::CreatePipeline(const Char* Name)
+{
+    const auto Index = FindPipeline(Name);
+    if (Index < 0)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", Name, "' is not found in the archive");
+        return {};
+    }
+    return CreatePipeline(static_cast<Uint32>(Index));
+}
+
+} // namespace Diligent
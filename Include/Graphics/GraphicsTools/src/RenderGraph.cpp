@@ -0,0 +1,638 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#if VULKAN_SUPPORTED
+#    include "../../GraphicsEngineVulkan/interface/RenderDeviceVk.h"
+#endif
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RenderGraphResourceId Id, RESOURCE_STATE State)
+{
+    return AddAccess(Id, State, true, false);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RenderGraphResourceId Id, RESOURCE_STATE State)
+{
+    return AddAccess(Id, State, false, true);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::ReadWrite(RenderGraphResourceId Id, RESOURCE_STATE State)
+{
+    return AddAccess(Id, State, true, true);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SetSideEffects()
+{
+    m_Graph.m_Passes[m_PassIndex].HasSideEffects = true;
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::AddAccess(RenderGraphResourceId Id, RESOURCE_STATE State, bool IsRead, bool IsWrite)
+{
+    auto& Pass = m_Graph.m_Passes[m_PassIndex];
+    DEV_CHECK_ERR(Id < m_Graph.m_Resources.size(), "Pass '", Pass.Name, "' references invalid resource ", Id);
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN && State != RESOURCE_STATE_UNDEFINED, "Pass '", Pass.Name, "' must specify a valid resource state");
+
+    for (auto& Access : Pass.Accesses)
+    {
+        if (Access.Id == Id)
+        {
+            // A resource can only be transitioned to one state before the pass is executed
+            DEV_CHECK_ERR(Access.State == State, "Pass '", Pass.Name, "' accesses resource ", Id, " in different states");
+            Access.IsRead  = Access.IsRead || IsRead;
+            Access.IsWrite = Access.IsWrite || IsWrite;
+            return *this;
+        }
+    }
+
+    Pass.Accesses.push_back(ResourceAccess{Id, State, IsRead, IsWrite});
+    return *this;
+}
+
+
+RenderGraph::RenderGraph(const CreateInfo& CI) :
+    m_CI{CI}
+{
+    DEV_CHECK_ERR(m_CI.pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_CI.NumDeferredContexts == 0 || m_CI.ppDeferredContexts != nullptr, "Deferred contexts must not be null");
+
+    m_DeferredContexts.resize(m_CI.NumDeferredContexts);
+    for (Uint32 i = 0; i < m_CI.NumDeferredContexts; ++i)
+        m_DeferredContexts[i] = m_CI.ppDeferredContexts[i];
+    m_CommandLists.reserve(m_CI.NumDeferredContexts);
+
+#if VULKAN_SUPPORTED
+    m_UseAliasedTextures = RefCntAutoPtr<IRenderDeviceVk>{m_CI.pDevice, IID_RenderDeviceVk} != nullptr;
+#endif
+}
+
+void RenderGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Levels.clear();
+    m_FinalBarriers.clear();
+    m_IsCompiled = false;
+}
+
+RenderGraphResourceId RenderGraph::ImportTexture(ITexture* pTexture, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pTexture != nullptr, "Imported texture must not be null");
+    DEV_CHECK_ERR(pTexture->GetState() != RESOURCE_STATE_UNKNOWN, "The state of an imported texture must be known");
+#ifdef DILIGENT_DEVELOPMENT
+    for (const auto& Res : m_Resources)
+        DEV_CHECK_ERR(Res.pTexture != pTexture, "The texture has already been imported");
+#endif
+
+    m_Resources.emplace_back();
+    auto& Res      = m_Resources.back();
+    Res.pObject    = pTexture;
+    Res.pTexture   = pTexture;
+    Res.IsImported = true;
+    Res.FinalState = FinalState;
+
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraphResourceId RenderGraph::ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pBuffer != nullptr, "Imported buffer must not be null");
+    DEV_CHECK_ERR(pBuffer->GetState() != RESOURCE_STATE_UNKNOWN, "The state of an imported buffer must be known");
+#ifdef DILIGENT_DEVELOPMENT
+    for (const auto& Res : m_Resources)
+        DEV_CHECK_ERR(Res.pBuffer != pBuffer, "The buffer has already been imported");
+#endif
+
+    m_Resources.emplace_back();
+    auto& Res      = m_Resources.back();
+    Res.pObject    = pBuffer;
+    Res.pBuffer    = pBuffer;
+    Res.IsImported = true;
+    Res.FinalState = FinalState;
+
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraphResourceId RenderGraph::CreateTexture(const TextureDesc& Desc)
+{
+    DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT, "Transient textures must use USAGE_DEFAULT");
+
+    m_Resources.emplace_back();
+    auto& Res     = m_Resources.back();
+    Res.Desc      = Desc;
+    Res.Name      = Desc.Name != nullptr ? Desc.Name : "Render graph transient texture";
+    Res.Desc.Name = nullptr;
+
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const char* Name, ExecuteCallbackType Execute)
+{
+    m_Passes.emplace_back();
+    auto& Pass   = m_Passes.back();
+    Pass.Name    = Name != nullptr ? Name : "";
+    Pass.Execute = std::move(Execute);
+
+    m_IsCompiled = false;
+    return PassBuilder{*this, static_cast<Uint32>(m_Passes.size() - 1)};
+}
+
+void RenderGraph::CullPasses()
+{
+    // Walk the passes backwards and keep the ones whose results are consumed
+    std::vector<bool> IsNeeded(m_Resources.size(), false);
+    for (size_t p = m_Passes.size(); p-- > 0;)
+    {
+        auto& Pass  = m_Passes[p];
+        Pass.IsLive = Pass.HasSideEffects;
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite && (m_Resources[Access.Id].IsImported || IsNeeded[Access.Id]))
+                Pass.IsLive = true;
+        }
+        if (!Pass.IsLive)
+            continue;
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsRead)
+                IsNeeded[Access.Id] = true;
+            else if (Access.IsWrite)
+                IsNeeded[Access.Id] = false; // Previous content is overwritten
+        }
+    }
+}
+
+void RenderGraph::ComputeLevels()
+{
+    struct ResourceTracking
+    {
+        // First level after the last write
+        Uint32 WriteEnd = 0;
+        // First level after the last read since the last write
+        Uint32 ReadEnd = 0;
+        // State of the reads since the last write
+        RESOURCE_STATE ReadState = RESOURCE_STATE_UNKNOWN;
+    };
+    std::vector<ResourceTracking> Tracking(m_Resources.size());
+
+    Uint32 NumLevels = 0;
+    for (auto& Pass : m_Passes)
+    {
+        if (!Pass.IsLive)
+        {
+            ++m_Stats.NumCulledPasses;
+            continue;
+        }
+
+        // A pass goes after the passes that wrote the resources it accesses and after the
+        // passes that read the resources it writes. Reads of the same resource in different
+        // states are placed in different levels, so that every level needs one transition per resource.
+        Uint32 Level = 0;
+        for (const auto& Access : Pass.Accesses)
+        {
+            const auto& T = Tracking[Access.Id];
+            Level         = std::max(Level, T.WriteEnd);
+            if (Access.IsWrite || (T.ReadState != RESOURCE_STATE_UNKNOWN && T.ReadState != Access.State))
+                Level = std::max(Level, T.ReadEnd);
+        }
+        Pass.Level = Level;
+        NumLevels  = std::max(NumLevels, Level + 1);
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            auto& T = Tracking[Access.Id];
+            if (Access.IsWrite)
+            {
+                T.WriteEnd  = Level + 1;
+                T.ReadEnd   = Level + 1;
+                T.ReadState = RESOURCE_STATE_UNKNOWN;
+            }
+            else
+            {
+                T.ReadEnd   = std::max(T.ReadEnd, Level + 1);
+                T.ReadState = Access.State;
+            }
+
+            auto& Res      = m_Resources[Access.Id];
+            Res.FirstLevel = std::min(Res.FirstLevel, Level);
+            Res.LastLevel  = std::max(Res.LastLevel, Level);
+        }
+    }
+
+    m_Levels.resize(NumLevels);
+    for (Uint32 p = 0; p < m_Passes.size(); ++p)
+    {
+        if (m_Passes[p].IsLive)
+            m_Levels[m_Passes[p].Level].Passes.push_back(p);
+    }
+    m_Stats.NumLevels = NumLevels;
+}
+
+void RenderGraph::AllocateTransientTextures()
+{
+    // Release textures that have not been used for a while
+    m_TexturePool.erase(std::remove_if(m_TexturePool.begin(), m_TexturePool.end(),
+                                       [this](const PooledTexture& Tex) {
+                                           return Tex.LastUsedFrame + m_CI.MaxIdleFrames < m_FrameNumber;
+                                       }),
+                        m_TexturePool.end());
+
+    std::vector<Uint32> Transients;
+    for (Uint32 r = 0; r < m_Resources.size(); ++r)
+    {
+        const auto& Res = m_Resources[r];
+        if (Res.IsImported)
+            continue;
+        ++m_Stats.NumTransientTextures;
+        // Transient textures only used by culled passes are not allocated
+        if (Res.FirstLevel != ~0u)
+            Transients.push_back(r);
+    }
+    std::stable_sort(Transients.begin(), Transients.end(), [this](Uint32 r0, Uint32 r1) {
+        return m_Resources[r0].FirstLevel < m_Resources[r1].FirstLevel;
+    });
+
+    if (m_UseAliasedTextures)
+    {
+        AllocateAliasedTextures(Transients);
+        return;
+    }
+
+    // Last level at which the pooled texture is used in this frame
+    std::vector<Uint32> BusyUntil(m_TexturePool.size(), ~0u);
+    for (auto r : Transients)
+    {
+        auto& Res = m_Resources[r];
+
+        // Reuse a texture with the same description whose previous user is done with it
+        Uint32 PoolIndex = ~0u;
+        for (Uint32 i = 0; i < m_TexturePool.size(); ++i)
+        {
+            if ((BusyUntil[i] == ~0u || BusyUntil[i] < Res.FirstLevel) && m_TexturePool[i].pTexture->GetDesc() == Res.Desc)
+            {
+                PoolIndex = i;
+                break;
+            }
+        }
+
+        if (PoolIndex == ~0u)
+        {
+            auto Desc = Res.Desc;
+            Desc.Name = Res.Name.c_str();
+
+            RefCntAutoPtr<ITexture> pTexture;
+            m_CI.pDevice->CreateTexture(Desc, nullptr, &pTexture);
+            if (!pTexture)
+                LOG_ERROR_AND_THROW("Failed to create transient texture '", Res.Name, "'");
+
+            PoolIndex = static_cast<Uint32>(m_TexturePool.size());
+            m_TexturePool.emplace_back();
+            m_TexturePool.back().pTexture = std::move(pTexture);
+            BusyUntil.push_back(~0u);
+        }
+
+        auto& Pooled         = m_TexturePool[PoolIndex];
+        Pooled.LastUsedFrame = m_FrameNumber;
+        BusyUntil[PoolIndex] = Res.LastLevel;
+
+        Res.PoolIndex = PoolIndex;
+        Res.pTexture  = Pooled.pTexture;
+    }
+
+    for (auto Busy : BusyUntil)
+    {
+        if (Busy != ~0u)
+            ++m_Stats.NumPhysicalTextures;
+    }
+}
+
+void RenderGraph::AllocateAliasedTextures(const std::vector<Uint32>& Transients)
+{
+#if VULKAN_SUPPORTED
+    std::vector<AliasedTextureLayout> Layout(Transients.size());
+    for (size_t i = 0; i < Transients.size(); ++i)
+    {
+        const auto& Res      = m_Resources[Transients[i]];
+        Layout[i].Desc       = Res.Desc;
+        Layout[i].FirstLevel = Res.FirstLevel;
+        Layout[i].LastLevel  = Res.LastLevel;
+    }
+
+    // The memory placement of aliased textures depends on their lifetimes, so the textures
+    // are only reused while the transient resources and their levels are the same.
+    // Released textures are kept alive by the engine until the GPU is done with them.
+    if (Layout != m_AliasedLayout)
+    {
+        m_AliasedTextures.clear();
+        m_AliasedLayout.clear();
+
+        if (!Layout.empty())
+        {
+            std::vector<AliasedTextureDescVk> Descs(Transients.size());
+            for (size_t i = 0; i < Transients.size(); ++i)
+            {
+                const auto& Res    = m_Resources[Transients[i]];
+                Descs[i].Desc      = Res.Desc;
+                Descs[i].Desc.Name = Res.Name.c_str();
+                Descs[i].FirstPass = Res.FirstLevel;
+                Descs[i].LastPass  = Res.LastLevel;
+            }
+
+            RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{m_CI.pDevice, IID_RenderDeviceVk};
+            VERIFY_EXPR(pDeviceVk);
+
+            std::vector<ITexture*> Textures(Transients.size());
+            pDeviceVk->CreateAliasedTextures(static_cast<Uint32>(Descs.size()), Descs.data(), Textures.data());
+            if (Textures[0] == nullptr)
+                LOG_ERROR_AND_THROW("Failed to create aliased transient textures");
+
+            m_AliasedTextures.resize(Textures.size());
+            for (size_t i = 0; i < Textures.size(); ++i)
+                m_AliasedTextures[i].Attach(Textures[i]);
+        }
+        m_AliasedLayout = std::move(Layout);
+    }
+
+    for (size_t i = 0; i < Transients.size(); ++i)
+        m_Resources[Transients[i]].pTexture = m_AliasedTextures[i];
+
+    m_Stats.NumPhysicalTextures = static_cast<Uint32>(m_AliasedTextures.size());
+#else
+    (void)Transients;
+    UNEXPECTED("Aliased textures are only supported in Vulkan");
+#endif
+}
+
+void RenderGraph::ComputeBarriers()
+{
+    // Imported resources and pooled textures are tracked separately,
+    // so that transient textures that share a texture share its state.
+    struct ObjectState
+    {
+        RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+        // True if the object was written or read as a UAV and no barrier has been issued since then
+        bool HasPendingUAVWrite = false;
+        bool HasPendingUAVRead  = false;
+        // Graph resource that accessed the object last. Differs from the accessed
+        // resource when a pooled texture is reused by another transient texture.
+        Uint32 LastUser = ~0u;
+    };
+
+    const auto               NumResources = m_Resources.size();
+    std::vector<ObjectState> States(NumResources + m_TexturePool.size());
+    for (size_t r = 0; r < NumResources; ++r)
+    {
+        const auto& Res = m_Resources[r];
+        if (Res.IsImported)
+            States[r].State = Res.pTexture != nullptr ? Res.pTexture->GetState() : Res.pBuffer->GetState();
+        else if (Res.pTexture != nullptr && Res.PoolIndex == ~0u)
+            States[r].State = RESOURCE_STATE_UNDEFINED; // Aliased texture, its memory may have been used by another one
+    }
+    // Pooled textures are shared by transient resources, all other resources have their own state
+    auto GetObjectState = [&](Uint32 r) -> ObjectState& {
+        const auto PoolIndex = m_Resources[r].PoolIndex;
+        return States[PoolIndex != ~0u ? NumResources + PoolIndex : r];
+    };
+    for (size_t i = 0; i < m_TexturePool.size(); ++i)
+    {
+        const auto State               = m_TexturePool[i].pTexture->GetState();
+        States[NumResources + i].State = State != RESOURCE_STATE_UNKNOWN ? State : RESOURCE_STATE_UNDEFINED;
+    }
+
+    auto AddBarrier = [](std::vector<StateTransitionDesc>& Barriers, const Resource& Res, RESOURCE_STATE OldState, RESOURCE_STATE NewState) {
+        StateTransitionDesc Barrier;
+        Barrier.pResource = Res.pTexture != nullptr ? static_cast<IDeviceObject*>(Res.pTexture) : static_cast<IDeviceObject*>(Res.pBuffer);
+        Barrier.OldState  = OldState;
+        Barrier.NewState  = NewState;
+        // Keep the engine state in sync, so that the resources can be used outside of the graph
+        Barrier.UpdateResourceState = true;
+        Barriers.push_back(Barrier);
+    };
+
+    for (auto& Level : m_Levels)
+    {
+        Level.Barriers.clear();
+        for (auto p : Level.Passes)
+        {
+            for (const auto& Access : m_Passes[p].Accesses)
+            {
+                const auto& Res = m_Resources[Access.Id];
+                auto&       Obj = GetObjectState(Access.Id);
+
+                const bool IsAliased = Obj.LastUser != ~0u && Obj.LastUser != Access.Id;
+                Obj.LastUser         = Access.Id;
+
+                if (Obj.State != Access.State)
+                {
+                    AddBarrier(Level.Barriers, Res, Obj.State, Access.State);
+                    Obj.State              = Access.State;
+                    Obj.HasPendingUAVWrite = false;
+                    Obj.HasPendingUAVRead  = false;
+                }
+                else if (Access.State == RESOURCE_STATE_UNORDERED_ACCESS &&
+                         (Obj.HasPendingUAVWrite || (Access.IsWrite && Obj.HasPendingUAVRead) || IsAliased))
+                {
+                    // UAV writes of the previous levels must complete before the resource is accessed again,
+                    // and UAV reads must complete before it is overwritten. A texture that is reused by
+                    // another transient texture in the same state is overwritten as well.
+                    AddBarrier(Level.Barriers, Res, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS);
+                    Obj.HasPendingUAVWrite = false;
+                    Obj.HasPendingUAVRead  = false;
+                }
+            }
+        }
+
+        // Mark UAV accesses once all barriers of the level are known. Passes of
+        // the same level never access a resource another one writes.
+        for (auto p : Level.Passes)
+        {
+            for (const auto& Access : m_Passes[p].Accesses)
+            {
+                if (Access.State == RESOURCE_STATE_UNORDERED_ACCESS)
+                {
+                    auto& Obj = GetObjectState(Access.Id);
+                    if (Access.IsWrite)
+                        Obj.HasPendingUAVWrite = true;
+                    else
+                        Obj.HasPendingUAVRead = true;
+                }
+            }
+        }
+
+        m_Stats.NumBarriers += static_cast<Uint32>(Level.Barriers.size());
+        if (!Level.Barriers.empty())
+            ++m_Stats.NumBarrierBatches;
+    }
+
+    m_FinalBarriers.clear();
+    for (size_t r = 0; r < NumResources; ++r)
+    {
+        const auto& Res = m_Resources[r];
+        if (Res.IsImported && Res.FinalState != RESOURCE_STATE_UNKNOWN && States[r].State != Res.FinalState)
+            AddBarrier(m_FinalBarriers, Res, States[r].State, Res.FinalState);
+    }
+    m_Stats.NumBarriers += static_cast<Uint32>(m_FinalBarriers.size());
+    if (!m_FinalBarriers.empty())
+        ++m_Stats.NumBarrierBatches;
+}
+
+void RenderGraph::Compile()
+{
+    m_Stats           = {};
+    m_Stats.NumPasses = static_cast<Uint32>(m_Passes.size());
+
+    m_Levels.clear();
+    for (auto& Res : m_Resources)
+    {
+        Res.FirstLevel = ~0u;
+        Res.LastLevel  = 0;
+        if (!Res.IsImported)
+        {
+            Res.pTexture  = nullptr;
+            Res.PoolIndex = ~0u;
+        }
+    }
+
+    CullPasses();
+    ComputeLevels();
+    AllocateTransientTextures();
+    ComputeBarriers();
+
+    m_IsCompiled = true;
+}
+
+void RenderGraph::RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const
+{
+    if (NumTasks > 1 && m_CI.ParallelFor)
+    {
+        m_CI.ParallelFor(NumTasks, Task);
+    }
+    else
+    {
+        for (Uint32 t = 0; t < NumTasks; ++t)
+            Task(t);
+    }
+}
+
+void RenderGraph::Execute(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(m_IsCompiled, "The graph must be compiled before it is executed");
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    // Contents of aliased textures are undefined at the start of every frame, see IRenderDeviceVk::CreateAliasedTextures()
+    for (auto& pTexture : m_AliasedTextures)
+        pTexture->SetState(RESOURCE_STATE_UNDEFINED);
+
+    const auto NumDeferredContexts  = static_cast<Uint32>(m_DeferredContexts.size());
+    bool       UsedDeferredContexts = false;
+    for (auto& Level : m_Levels)
+    {
+        if (!Level.Barriers.empty())
+            pContext->TransitionResourceStates(static_cast<Uint32>(Level.Barriers.size()), Level.Barriers.data());
+
+        const auto NumPasses = static_cast<Uint32>(Level.Passes.size());
+        if (NumPasses > 1 && NumDeferredContexts > 0)
+        {
+            // Passes of the level are independent and their barriers have already been issued,
+            // so they can be recorded in any order.
+            const Uint32 PassesPerTask = (NumPasses + NumDeferredContexts - 1) / NumDeferredContexts;
+            const Uint32 NumTasks      = (NumPasses + PassesPerTask - 1) / PassesPerTask;
+
+            m_CommandLists.resize(NumTasks);
+            RunTasks(NumTasks, [&](Uint32 Task) {
+                auto* pDeferredCtx = m_DeferredContexts[Task].RawPtr();
+
+                RenderGraphPassContext PassCtx;
+                PassCtx.pContext = pDeferredCtx;
+                PassCtx.pGraph   = this;
+
+                const auto End = std::min(NumPasses, (Task + 1) * PassesPerTask);
+                for (Uint32 i = Task * PassesPerTask; i < End; ++i)
+                    m_Passes[Level.Passes[i]].Execute(PassCtx);
+
+                pDeferredCtx->FinishCommandList(&m_CommandLists[Task]);
+            });
+
+            for (auto& pCmdList : m_CommandLists)
+            {
+                pContext->ExecuteCommandList(pCmdList);
+                pCmdList.Release();
+            }
+            UsedDeferredContexts = true;
+        }
+        else
+        {
+            RenderGraphPassContext PassCtx;
+            PassCtx.pContext = pContext;
+            PassCtx.pGraph   = this;
+            for (auto p : Level.Passes)
+                m_Passes[p].Execute(PassCtx);
+        }
+    }
+
+    if (!m_FinalBarriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_FinalBarriers.size()), m_FinalBarriers.data());
+
+    if (UsedDeferredContexts)
+    {
+        for (auto& pDeferredCtx : m_DeferredContexts)
+            pDeferredCtx->FinishFrame();
+    }
+
+    // The barriers were computed for the resource states at the time the graph was compiled
+    m_IsCompiled = false;
+    ++m_FrameNumber;
+}
+
+ITexture* RenderGraph::GetTexture(RenderGraphResourceId Id) const
+{
+    DEV_CHECK_ERR(Id < m_Resources.size(), "Invalid resource ", Id);
+    DEV_CHECK_ERR(m_Resources[Id].pBuffer == nullptr, "Resource ", Id, " is not a texture");
+    return m_Resources[Id].pTexture;
+}
+
+IBuffer* RenderGraph::GetBuffer(RenderGraphResourceId Id) const
+{
+    DEV_CHECK_ERR(Id < m_Resources.size(), "Invalid resource ", Id);
+    DEV_CHECK_ERR(m_Resources[Id].pBuffer != nullptr, "Resource ", Id, " is not a buffer");
+    return m_Resources[Id].pBuffer;
+}
+
+} // namespace Diligent
@@ -0,0 +1,294 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+constexpr Uint32 PassBits     = 4;
+constexpr Uint32 PSOIdBits    = 16;
+constexpr Uint32 MaterialBits = 16;
+constexpr Uint32 DepthBits    = 27;
+
+constexpr Uint32 RadixBits    = 8;
+constexpr Uint32 RadixSize    = 1u << RadixBits;
+// clang-format on
+
+static_assert(PassBits + 1 + PSOIdBits + MaterialBits + DepthBits == 64, "Sort key fields must fill all 64 bits");
+static_assert((1u << PassBits) == RenderQueue::MaxPasses, "Pass bits are inconsistent with the maximum number of passes");
+
+// Non-negative IEEE floats compare the same way as their bit patterns interpreted
+// as unsigned integers, so the depth is quantized by dropping the least significant
+// mantissa bits.
+Uint32 QuantizeDepth(float Depth)
+{
+    if (!(Depth > 0.f))
+        return 0;
+
+    Uint32 Bits = 0;
+    std::memcpy(&Bits, &Depth, sizeof(Bits));
+    return Bits >> (32 - DepthBits);
+}
+
+} // namespace
+
+RenderQueue::RenderQueue(const CreateInfo& CI) :
+    m_CI{CI}
+{
+    VERIFY_EXPR(m_CI.MinPacketsPerTask > 0 && m_CI.MaxTasks > 0);
+}
+
+Uint64 RenderQueue::MakeSortKey(Uint32 Pass, bool IsTransparent, Uint32 PSOId, Uint32 MaterialId, float Depth)
+{
+    DEV_CHECK_ERR(Pass < MaxPasses, "Pass index (", Pass, ") exceeds the maximum number of passes (", MaxPasses, ")");
+
+    // Identifiers that do not fit into their fields wrap around. This only makes
+    // sorting less efficient, but does not affect correctness.
+    const Uint64 PSOKey      = PSOId & ((1u << PSOIdBits) - 1u);
+    const Uint64 MaterialKey = MaterialId & ((1u << MaterialBits) - 1u);
+    const Uint64 DepthKey    = QuantizeDepth(Depth);
+
+    Uint64 Key = Uint64{Pass & (MaxPasses - 1u)} << (64 - PassBits);
+    if (!IsTransparent)
+    {
+        // Minimize state changes first, then draw front to back
+        Key |= PSOKey << (MaterialBits + DepthBits);
+        Key |= MaterialKey << DepthBits;
+        Key |= DepthKey;
+    }
+    else
+    {
+        // Transparent geometry must be drawn back to front regardless of the state
+        constexpr Uint64 MaxDepthKey = (Uint64{1} << DepthBits) - 1u;
+
+        Key |= Uint64{1} << (63 - PassBits);
+        Key |= (MaxDepthKey - DepthKey) << (PSOIdBits + MaterialBits);
+        Key |= PSOKey << MaterialBits;
+        Key |= MaterialKey;
+    }
+    return Key;
+}
+
+template <typename ObjectType>
+Uint32 RenderQueue::GetObjectId(std::unordered_map<const ObjectType*, Uint32>& Ids, const ObjectType* pObject)
+{
+    if (pObject == nullptr)
+        return 0;
+
+    // Zero is reserved for null objects
+    auto it = Ids.emplace(pObject, static_cast<Uint32>(Ids.size() + 1)).first;
+    return it->second;
+}
+
+void RenderQueue::Submit(const DrawPacket& Packet)
+{
+    DEV_CHECK_ERR(Packet.pPSO != nullptr, "Draw packet must have a pipeline state");
+    DEV_CHECK_ERR(Packet.NumVertexBuffers <= DrawPacket::MaxVertexBuffers, "Too many vertex buffers");
+
+    const Uint32 PSOId      = GetObjectId(m_PSOIds, Packet.pPSO);
+    const Uint32 MaterialId = Packet.MaterialId != 0 ? Packet.MaterialId : GetObjectId(m_SRBIds, Packet.pSRB);
+
+    m_Items.emplace_back(SortItem{MakeSortKey(Packet.Pass, Packet.IsTransparent, PSOId, MaterialId, Packet.Depth), GetNumPackets()});
+    m_Packets.emplace_back(Packet);
+}
+
+void RenderQueue::RunTasks(Uint32 NumTasks, const std::function<void(Uint32 TaskId)>& Task) const
+{
+    if (NumTasks > 1 && m_CI.ParallelFor)
+    {
+        m_CI.ParallelFor(NumTasks, Task);
+    }
+    else
+    {
+        for (Uint32 t = 0; t < NumTasks; ++t)
+            Task(t);
+    }
+}
+
+void RenderQueue::Sort()
+{
+    const auto NumItems = static_cast<Uint32>(m_Items.size());
+    if (NumItems < 2)
+        return;
+
+    Uint32 NumTasks = 1;
+    if (m_CI.ParallelFor)
+        NumTasks = std::max(std::min(NumItems / m_CI.MinPacketsPerTask, m_CI.MaxTasks), 1u);
+    const Uint32 ItemsPerTask = (NumItems + NumTasks - 1) / NumTasks;
+    NumTasks                  = (NumItems + ItemsPerTask - 1) / ItemsPerTask;
+
+    m_SortBuffer.resize(NumItems);
+    m_Histograms.resize(size_t{NumTasks} * RadixSize);
+
+    SortItem* pSrc = m_Items.data();
+    SortItem* pDst = m_SortBuffer.data();
+    for (Uint32 Shift = 0; Shift < 64; Shift += RadixBits)
+    {
+        // Every task builds a histogram of the digits in its range of items
+        RunTasks(NumTasks, [&](Uint32 Task) {
+            auto* Histogram = &m_Histograms[size_t{Task} * RadixSize];
+            std::fill(Histogram, Histogram + RadixSize, 0u);
+
+            const auto End = std::min(NumItems, (Task + 1) * ItemsPerTask);
+            for (Uint32 i = Task * ItemsPerTask; i < End; ++i)
+                ++Histogram[(pSrc[i].Key >> Shift) & (RadixSize - 1)];
+        });
+
+        // Compute scatter offsets. Within a digit, items of lower tasks go first,
+        // which keeps the sort stable.
+        Uint32 Offset      = 0;
+        bool   IsSkippable = false;
+        for (Uint32 Digit = 0; Digit < RadixSize && !IsSkippable; ++Digit)
+        {
+            const auto DigitStart = Offset;
+            for (Uint32 Task = 0; Task < NumTasks; ++Task)
+            {
+                auto&      Count     = m_Histograms[size_t{Task} * RadixSize + Digit];
+                const auto TaskCount = Count;
+                Count                = Offset;
+                Offset += TaskCount;
+            }
+            // All keys share the same digit (e.g. the pass bits are usually
+            // the same for all packets), so the pass would not move anything.
+            IsSkippable = Offset - DigitStart == NumItems;
+        }
+        if (IsSkippable)
+            continue;
+
+        RunTasks(NumTasks, [&](Uint32 Task) {
+            auto* Offsets = &m_Histograms[size_t{Task} * RadixSize];
+
+            const auto End = std::min(NumItems, (Task + 1) * ItemsPerTask);
+            for (Uint32 i = Task * ItemsPerTask; i < End; ++i)
+                pDst[Offsets[(pSrc[i].Key >> Shift) & (RadixSize - 1)]++] = pSrc[i];
+        });
+
+        std::swap(pSrc, pDst);
+    }
+
+    // Swapping the vectors does not move their storage, so pSrc remains valid
+    if (pSrc != m_Items.data())
+        std::swap(m_Items, m_SortBuffer);
+
+#ifdef DILIGENT_DEBUG
+    for (Uint32 i = 1; i < NumItems; ++i)
+        VERIFY(m_Items[i - 1].Key <= m_Items[i].Key, "Packets are not sorted");
+#endif
+}
+
+void RenderQueue::Execute(IDeviceContext* pContext, Uint32 FirstPacket, Uint32 NumPackets) const
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    const auto TotalPackets = GetNumPackets();
+    if (FirstPacket >= TotalPackets)
+        return;
+    NumPackets = std::min(NumPackets, TotalPackets - FirstPacket);
+
+    IPipelineState*         pCurrPSO       = nullptr;
+    IShaderResourceBinding* pCurrSRB       = nullptr;
+    IBuffer*                pCurrIB        = nullptr;
+    Uint32                  CurrIBOffset   = 0;
+    Uint32                  NumCurrVBs     = 0;
+    bool                    VBsInitialized = false;
+
+    IBuffer* pCurrVBs[DrawPacket::MaxVertexBuffers]      = {};
+    Uint32   CurrVBOffsets[DrawPacket::MaxVertexBuffers] = {};
+
+    const auto Mode = m_CI.StateTransitionMode;
+    for (Uint32 i = FirstPacket; i < FirstPacket + NumPackets; ++i)
+    {
+        const auto& Packet = m_Packets[m_Items[i].PacketIndex];
+
+        if (Packet.pPSO != pCurrPSO)
+        {
+            pContext->SetPipelineState(Packet.pPSO);
+            pCurrPSO = Packet.pPSO;
+            // Shader resources must be committed again after the pipeline state changes
+            pCurrSRB = nullptr;
+        }
+
+        if (Packet.pSRB != pCurrSRB)
+        {
+            if (Packet.pSRB != nullptr)
+                pContext->CommitShaderResources(Packet.pSRB, Mode);
+            pCurrSRB = Packet.pSRB;
+        }
+
+        bool VBsChanged = !VBsInitialized || Packet.NumVertexBuffers != NumCurrVBs;
+        for (Uint32 vb = 0; vb < Packet.NumVertexBuffers && !VBsChanged; ++vb)
+            VBsChanged = Packet.pVertexBuffers[vb] != pCurrVBs[vb] || Packet.VertexOffsets[vb] != CurrVBOffsets[vb];
+        if (VBsChanged)
+        {
+            NumCurrVBs = Packet.NumVertexBuffers;
+            for (Uint32 vb = 0; vb < NumCurrVBs; ++vb)
+            {
+                pCurrVBs[vb]      = Packet.pVertexBuffers[vb];
+                CurrVBOffsets[vb] = Packet.VertexOffsets[vb];
+            }
+            pContext->SetVertexBuffers(0, NumCurrVBs, pCurrVBs, CurrVBOffsets, Mode, SET_VERTEX_BUFFERS_FLAG_RESET);
+            VBsInitialized = true;
+        }
+
+        if (Packet.pIndexBuffer != nullptr)
+        {
+            if (Packet.pIndexBuffer != pCurrIB || Packet.IndexOffset != CurrIBOffset)
+            {
+                pContext->SetIndexBuffer(Packet.pIndexBuffer, Packet.IndexOffset, Mode);
+                pCurrIB      = Packet.pIndexBuffer;
+                CurrIBOffset = Packet.IndexOffset;
+            }
+            pContext->DrawIndexed(Packet.IndexedAttribs);
+        }
+        else
+        {
+            pContext->Draw(Packet.Attribs);
+        }
+    }
+}
+
+void RenderQueue::Clear()
+{
+    // Object identifiers are reassigned every frame, so that the maps do not
+    // grow indefinitely and do not keep stale pointers of released objects
+    m_Packets.clear();
+    m_Items.clear();
+    m_PSOIds.clear();
+    m_SRBIds.clear();
+}
+
+} // namespace Diligent
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderBatchCompiler.hpp"
+
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+ShaderBatchCompiler::ShaderBatchCompiler(const CreateInfo& CI) :
+    m_CI{CI}
+{
+    if (m_CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+}
+
+std::vector<ShaderBatchCompiler::Result> ShaderBatchCompiler::Compile(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders) const
+{
+    DEV_CHECK_ERR(NumShaders == 0 || pShaderCIs != nullptr, "Shader create infos must not be null");
+
+    std::vector<Result> Results(NumShaders);
+
+    // Shaders take vastly different time to compile, so every shader is a separate task and
+    // idle workers pick up the remaining ones instead of waiting for a fixed partition.
+    auto CompileShader = [&](Uint32 s) {
+        auto ShaderCI = pShaderCIs[s];
+
+        RefCntAutoPtr<IDataBlob> pCompilerOutput;
+        ShaderCI.ppCompilerOutput = &pCompilerOutput;
+
+        auto& Res = Results[s];
+        m_CI.pDevice->CreateShader(ShaderCI, &Res.pShader);
+
+        if (pCompilerOutput)
+        {
+            // The blob contains the compiler message followed by the full source; keep the message only
+            const auto* Msg = static_cast<const char*>(pCompilerOutput->GetConstDataPtr());
+            Res.Log.assign(Msg, strnlen(Msg, pCompilerOutput->GetSize()));
+        }
+        if (!Res.pShader && Res.Log.empty())
+            Res.Log = "Failed to create shader";
+    };
+
+    // Devices that do not support multithreaded resource creation (e.g. OpenGL) must only create
+    // shaders on the thread that owns the device
+    const auto MultithreadedCreation = m_CI.pDevice->GetDeviceCaps().Features.MultithreadedResourceCreation == DEVICE_FEATURE_STATE_ENABLED;
+    if (NumShaders > 1 && m_CI.ParallelFor && MultithreadedCreation)
+    {
+        m_CI.ParallelFor(NumShaders, CompileShader);
+    }
+    else
+    {
+        for (Uint32 s = 0; s < NumShaders; ++s)
+            CompileShader(s);
+    }
+
+    return Results;
+}
+
+} // namespace Diligent
@@ -0,0 +1,550 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderHotReloader.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#if PLATFORM_LINUX
+#    include <dirent.h>
+#    include <poll.h>
+#    include <sys/inotify.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "../../../Primitives/interface/FileStream.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+std::string NormalizePath(const Char* Path)
+{
+    std::string Normalized{Path};
+    for (auto& c : Normalized)
+    {
+        if (c == '\\')
+            c = '/';
+    }
+    while (Normalized.compare(0, 2, "./") == 0)
+        Normalized.erase(0, 2);
+    return Normalized;
+}
+
+// Returns true if one path is the other path with leading directories. Watch directories and shader
+// search directories do not need to match, so the relative paths are compared by their common tail.
+bool PathsMatch(const std::string& Path1, const std::string& Path2)
+{
+    const auto& Longer  = Path1.length() >= Path2.length() ? Path1 : Path2;
+    const auto& Shorter = Path1.length() >= Path2.length() ? Path2 : Path1;
+    if (Shorter.empty() || Longer.compare(Longer.length() - Shorter.length(), Shorter.length(), Shorter) != 0)
+        return false;
+    return Longer.length() == Shorter.length() || Longer[Longer.length() - Shorter.length() - 1] == '/';
+}
+
+bool ReadSource(IShaderSourceInputStreamFactory* pFactory, const std::string& Name, std::vector<char>& Source)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream2(Name.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    if (!pStream)
+        return false;
+
+    Source.resize(pStream->GetSize());
+    return Source.empty() || pStream->Read(Source.data(), Source.size());
+}
+
+// Adds the names of all files included by the source to the list. Only the #include directive
+// is recognized, which is enough to find the files the shader depends on; conditional
+// compilation is ignored, so some files may be reported that the compiler never reads.
+void FindIncludes(const char* pSource, size_t Length, std::vector<std::string>& Includes)
+{
+    const auto* const pEnd = pSource + Length;
+    const auto*       c    = pSource;
+    while (c < pEnd)
+    {
+        if (*c == '/' && c + 1 < pEnd && c[1] == '/')
+        {
+            while (c < pEnd && *c != '\n')
+                ++c;
+        }
+        else if (*c == '/' && c + 1 < pEnd && c[1] == '*')
+        {
+            c += 2;
+            while (c + 1 < pEnd && !(c[0] == '*' && c[1] == '/'))
+                ++c;
+            c += 2;
+        }
+        else if (*c == '#')
+        {
+            ++c;
+            while (c < pEnd && (*c == ' ' || *c == '\t'))
+                ++c;
+
+            static constexpr char   IncludeStr[] = "include";
+            static constexpr size_t IncludeLen   = sizeof(IncludeStr) - 1;
+            if (static_cast<size_t>(pEnd - c) > IncludeLen && strncmp(c, IncludeStr, IncludeLen) == 0)
+            {
+                c += IncludeLen;
+                while (c < pEnd && (*c == ' ' || *c == '\t'))
+                    ++c;
+                if (c < pEnd && (*c == '"' || *c == '<'))
+                {
+                    const auto  Terminator = *c == '"' ? '"' : '>';
+                    const auto* pNameStart = ++c;
+                    while (c < pEnd && *c != Terminator && *c != '\n')
+                        ++c;
+                    if (c < pEnd && *c == Terminator && c > pNameStart)
+                        Includes.emplace_back(pNameStart, c);
+                }
+            }
+        }
+        else
+        {
+            ++c;
+        }
+    }
+}
+
+// Returns the source file of the shader and all files it includes, directly or indirectly
+std::vector<std::string> FindDependencies(const ShaderCreateInfo& ShaderCI)
+{
+    std::vector<std::string>        Dependencies;
+    std::unordered_set<std::string> Visited;
+    std::vector<std::string>        Includes;
+
+    if (ShaderCI.FilePath != nullptr)
+    {
+        Includes.emplace_back(ShaderCI.FilePath);
+    }
+    else if (ShaderCI.Source != nullptr)
+    {
+        FindIncludes(ShaderCI.Source, strlen(ShaderCI.Source), Includes);
+    }
+
+    if (ShaderCI.pShaderSourceStreamFactory == nullptr)
+        return Dependencies;
+
+    std::vector<char> Source;
+    while (!Includes.empty())
+    {
+        auto Name = std::move(Includes.back());
+        Includes.pop_back();
+        if (!Visited.insert(Name).second)
+            continue;
+
+        Dependencies.emplace_back(NormalizePath(Name.c_str()));
+        // Files that cannot be read are still tracked, so that the shader is recompiled once they appear
+        if (ReadSource(ShaderCI.pShaderSourceStreamFactory, Name, Source))
+            FindIncludes(Source.data(), Source.size(), Includes);
+    }
+
+    return Dependencies;
+}
+
+} // namespace
+
+ShaderHotReloader::ShaderHotReloader(const CreateInfo& CI) :
+    // clang-format off
+    m_CI            {CI},
+    m_ReloadInUpdate{CI.pDevice != nullptr && CI.pDevice->GetDeviceCaps().Features.MultithreadedResourceCreation != DEVICE_FEATURE_STATE_ENABLED}
+// clang-format on
+{
+    if (m_CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+#if PLATFORM_LINUX
+    if (m_CI.WatchDirectories != nullptr && *m_CI.WatchDirectories != '\0')
+    {
+        m_WatchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_WatchFd < 0)
+        {
+            LOG_WARNING_MESSAGE("Failed to initialize inotify (", strerror(errno), "). Shader source files will not be watched.");
+        }
+        else
+        {
+            const auto* Dir = m_CI.WatchDirectories;
+            while (*Dir != '\0')
+            {
+                const auto* DirEnd = strchr(Dir, ';');
+                if (DirEnd == nullptr)
+                    DirEnd = Dir + strlen(Dir);
+                if (DirEnd > Dir)
+                    WatchDirectory(std::string{Dir, DirEnd}, "");
+                Dir = *DirEnd == ';' ? DirEnd + 1 : DirEnd;
+            }
+        }
+    }
+#else
+    if (m_CI.WatchDirectories != nullptr && *m_CI.WatchDirectories != '\0')
+        LOG_WARNING_MESSAGE("Watching shader source files is not supported on this platform. Use ShaderHotReloader::NotifyFileChanged() to report changes.");
+#endif
+
+    m_WorkerThread = std::thread{&ShaderHotReloader::WorkerThread, this};
+}
+
+ShaderHotReloader::~ShaderHotReloader()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_NotifiedFilesMtx};
+        m_StopWorker.store(true);
+    }
+    m_NotifiedFilesCV.notify_one();
+    m_WorkerThread.join();
+
+#if PLATFORM_LINUX
+    if (m_WatchFd >= 0)
+        close(m_WatchFd);
+#endif
+}
+
+void ShaderHotReloader::WatchDirectory(const std::string& Dir, const std::string& RelativePath)
+{
+#if PLATFORM_LINUX
+    // Editors commonly save files by writing a temporary file and renaming it over the original,
+    // so moves are tracked along with writes
+    const auto wd = inotify_add_watch(m_WatchFd, Dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to watch directory '", Dir, "': ", strerror(errno));
+        return;
+    }
+    m_WatchedDirs[wd] = WatchedDir{Dir, RelativePath};
+
+    if (auto* pDir = opendir(Dir.c_str()))
+    {
+        while (const auto* pEntry = readdir(pDir))
+        {
+            if (strcmp(pEntry->d_name, ".") == 0 || strcmp(pEntry->d_name, "..") == 0)
+                continue;
+
+            const auto Path = Dir + '/' + pEntry->d_name;
+
+            // Some file systems (e.g. XFS with ftype=0, some network file systems) do not report
+            // the entry type, in which case it has to be queried
+            auto IsDir = pEntry->d_type == DT_DIR;
+            if (pEntry->d_type == DT_UNKNOWN)
+            {
+                struct stat Stat;
+                IsDir = stat(Path.c_str(), &Stat) == 0 && S_ISDIR(Stat.st_mode);
+            }
+
+            if (IsDir)
+                WatchDirectory(Path, RelativePath + pEntry->d_name + '/');
+        }
+        closedir(pDir);
+    }
+#endif
+}
+
+RefCntAutoPtr<IShader> ShaderHotReloader::CompileShader(const ShaderCreateInfo& ShaderCI) const
+{
+    auto CI = ShaderCI;
+
+    RefCntAutoPtr<IDataBlob> pCompilerOutput;
+    CI.ppCompilerOutput = &pCompilerOutput;
+
+    RefCntAutoPtr<IShader> pShader;
+    m_CI.pDevice->CreateShader(CI, &pShader);
+    if (!pShader)
+    {
+        const auto* Name = ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : (ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "");
+        if (pCompilerOutput)
+        {
+            // The blob contains the compiler message followed by the full source; print the message only
+            const auto* Msg = static_cast<const char*>(pCompilerOutput->GetConstDataPtr());
+            LOG_ERROR_MESSAGE("Failed to compile shader '", Name, "':\n", std::string{Msg, strnlen(Msg, pCompilerOutput->GetSize())});
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Failed to compile shader '", Name, "'");
+        }
+    }
+    return pShader;
+}
+
+Uint32 ShaderHotReloader::AddPipeline(const PipelineDesc& Desc)
+{
+    DEV_CHECK_ERR(Desc.CreatePipeline, "Create pipeline callback must not be null");
+
+    std::unique_ptr<PipelineInfo> pPipeline{new PipelineInfo{}};
+    pPipeline->Desc = Desc;
+    pPipeline->Shaders.resize(Desc.Shaders.size());
+
+    std::vector<IShader*> Shaders(Desc.Shaders.size());
+
+    bool AllCompiled = true;
+    for (size_t s = 0; s < Desc.Shaders.size(); ++s)
+    {
+        auto& Shader        = pPipeline->Shaders[s];
+        Shader.Dependencies = FindDependencies(Desc.Shaders[s]);
+        Shader.pShader      = CompileShader(Desc.Shaders[s]);
+        Shaders[s]          = Shader.pShader;
+        AllCompiled         = AllCompiled && Shader.pShader != nullptr;
+    }
+
+    if (AllCompiled)
+        pPipeline->pPSO = Desc.CreatePipeline(Shaders.data(), static_cast<Uint32>(Shaders.size()));
+
+    std::lock_guard<std::mutex> Lock{m_PipelinesMtx};
+    m_Pipelines.emplace_back(std::move(pPipeline));
+    return static_cast<Uint32>(m_Pipelines.size() - 1);
+}
+
+Uint32 ShaderHotReloader::Update()
+{
+    if (m_ReloadInUpdate)
+    {
+        std::unordered_set<std::string> ChangedFiles;
+        {
+            std::lock_guard<std::mutex> Lock{m_ChangesToReloadMtx};
+            ChangedFiles.swap(m_ChangesToReload);
+        }
+        if (!ChangedFiles.empty())
+            ReloadChangedFiles(ChangedFiles);
+    }
+
+    std::unordered_map<Uint32, RefCntAutoPtr<IPipelineState>> PendingPipelines;
+    {
+        std::lock_guard<std::mutex> Lock{m_PendingPipelinesMtx};
+        if (m_PendingPipelines.empty())
+            return 0;
+        PendingPipelines.swap(m_PendingPipelines);
+    }
+
+    // The previous pipeline may still be used by the commands in flight; the device
+    // keeps it alive until the GPU is done with it
+    for (auto& it : PendingPipelines)
+    {
+        m_Pipelines[it.first]->pPSO = std::move(it.second);
+        if (m_CI.OnPipelineReloaded)
+            m_CI.OnPipelineReloaded(it.first, m_Pipelines[it.first]->pPSO);
+    }
+
+    return static_cast<Uint32>(PendingPipelines.size());
+}
+
+void ShaderHotReloader::NotifyFileChanged(const Char* Path)
+{
+    DEV_CHECK_ERR(Path != nullptr, "Path must not be null");
+    {
+        std::lock_guard<std::mutex> Lock{m_NotifiedFilesMtx};
+        m_NotifiedFiles.emplace_back(NormalizePath(Path));
+    }
+    m_NotifiedFilesCV.notify_one();
+}
+
+void ShaderHotReloader::WorkerThread()
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int PollIntervalMs = 50;
+
+    std::unordered_set<std::string> ChangedFiles;
+    Clock::time_point               LastChangeTime;
+
+    while (!m_StopWorker.load())
+    {
+        bool FilesChanged = false;
+
+#if PLATFORM_LINUX
+        if (m_WatchFd >= 0)
+        {
+            pollfd Fd = {m_WatchFd, POLLIN, 0};
+            if (poll(&Fd, 1, PollIntervalMs) > 0)
+            {
+                alignas(inotify_event) char Buffer[4096];
+
+                ssize_t Size = 0;
+                while ((Size = read(m_WatchFd, Buffer, sizeof(Buffer))) > 0)
+                {
+                    for (ssize_t Offset = 0; Offset < Size;)
+                    {
+                        const auto* pEvent = reinterpret_cast<const inotify_event*>(Buffer + Offset);
+                        Offset += sizeof(inotify_event) + pEvent->len;
+
+                        auto DirIt = m_WatchedDirs.find(pEvent->wd);
+                        if (DirIt == m_WatchedDirs.end() || pEvent->len == 0)
+                            continue;
+
+                        if (pEvent->mask & IN_ISDIR)
+                        {
+                            // Directories created after the reloader has started are watched too
+                            if (pEvent->mask & (IN_CREATE | IN_MOVED_TO))
+                            {
+                                const auto Dir = DirIt->second;
+                                WatchDirectory(Dir.Path + '/' + pEvent->name, Dir.RelativePath + pEvent->name + '/');
+                            }
+                        }
+                        else if (pEvent->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                        {
+                            ChangedFiles.emplace(DirIt->second.RelativePath + pEvent->name);
+                            FilesChanged = true;
+                        }
+                    }
+                }
+            }
+        }
+#endif
+
+        {
+            std::unique_lock<std::mutex> Lock{m_NotifiedFilesMtx};
+            if (m_WatchFd < 0 && m_NotifiedFiles.empty() && ChangedFiles.empty())
+            {
+                // Nothing is pending, so sleep until a change is reported
+                m_NotifiedFilesCV.wait(Lock, [this]() { return m_StopWorker.load() || !m_NotifiedFiles.empty(); });
+            }
+            else if (m_WatchFd < 0)
+            {
+                m_NotifiedFilesCV.wait_for(Lock, std::chrono::milliseconds{PollIntervalMs}, [this]() { return m_StopWorker.load() || !m_NotifiedFiles.empty(); });
+            }
+
+            if (!m_NotifiedFiles.empty())
+            {
+                ChangedFiles.insert(m_NotifiedFiles.begin(), m_NotifiedFiles.end());
+                m_NotifiedFiles.clear();
+                FilesChanged = true;
+            }
+        }
+
+        if (FilesChanged)
+        {
+            LastChangeTime = Clock::now();
+        }
+        else if (!ChangedFiles.empty() && Clock::now() - LastChangeTime >= std::chrono::milliseconds{m_CI.ReloadDelayMs})
+        {
+            if (m_ReloadInUpdate)
+            {
+                std::lock_guard<std::mutex> Lock{m_ChangesToReloadMtx};
+                m_ChangesToReload.insert(ChangedFiles.begin(), ChangedFiles.end());
+            }
+            else
+            {
+                ReloadChangedFiles(ChangedFiles);
+            }
+            ChangedFiles.clear();
+        }
+    }
+}
+
+void ShaderHotReloader::ReloadChangedFiles(const std::unordered_set<std::string>& ChangedFiles)
+{
+    auto IsAffected = [&ChangedFiles](const ShaderInfo& Shader) {
+        for (const auto& Dependency : Shader.Dependencies)
+        {
+            for (const auto& File : ChangedFiles)
+            {
+                if (PathsMatch(Dependency, File))
+                    return true;
+            }
+        }
+        return false;
+    };
+
+    // Pipelines are only appended and their addresses are stable, so the lock is only held to
+    // read the list. Compiling shaders and creating pipelines may take a long time and must not
+    // block AddPipeline().
+    std::vector<PipelineInfo*> Pipelines;
+    {
+        std::lock_guard<std::mutex> Lock{m_PipelinesMtx};
+        Pipelines.reserve(m_Pipelines.size());
+        for (auto& pPipeline : m_Pipelines)
+            Pipelines.push_back(pPipeline.get());
+    }
+
+    for (Uint32 p = 0; p < Pipelines.size(); ++p)
+    {
+        auto& Pipeline = *Pipelines[p];
+
+        // Shaders are recompiled into a copy, which is swapped in under the lock
+        auto Shaders = Pipeline.Shaders;
+
+        bool Affected    = false;
+        bool AllCompiled = true;
+        for (size_t s = 0; s < Shaders.size(); ++s)
+        {
+            auto& Shader = Shaders[s];
+            if (IsAffected(Shader))
+            {
+                // Includes may have been added or removed
+                Shader.Dependencies = FindDependencies(Pipeline.Desc.Shaders[s]);
+
+                // A shader that fails to compile keeps its previous version, so that other shaders
+                // of the pipeline do not need to be recompiled once the error is fixed
+                if (auto pShader = CompileShader(Pipeline.Desc.Shaders[s]))
+                    Shader.pShader = std::move(pShader);
+                else
+                    AllCompiled = false;
+
+                Affected = true;
+            }
+            AllCompiled = AllCompiled && Shader.pShader != nullptr;
+        }
+
+        if (!Affected)
+            continue;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        if (AllCompiled)
+        {
+            std::vector<IShader*> ppShaders(Shaders.size());
+            for (size_t s = 0; s < Shaders.size(); ++s)
+                ppShaders[s] = Shaders[s].pShader;
+
+            pPSO = Pipeline.Desc.CreatePipeline(ppShaders.data(), static_cast<Uint32>(ppShaders.size()));
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_PipelinesMtx};
+            Pipeline.Shaders.swap(Shaders);
+        }
+
+        if (!AllCompiled)
+        {
+            LOG_ERROR_MESSAGE("Pipeline ", p, " was not reloaded as some of its shaders failed to compile. The previous version remains in use.");
+            continue;
+        }
+
+        if (!pPSO)
+        {
+            LOG_ERROR_MESSAGE("Failed to rebuild pipeline ", p, ". The previous version remains in use.");
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> PendingLock{m_PendingPipelinesMtx};
+            m_PendingPipelines[p] = std::move(pPSO);
+        }
+        LOG_INFO_MESSAGE("Reloaded pipeline ", p);
+    }
+}
+
+} // namespace Diligent
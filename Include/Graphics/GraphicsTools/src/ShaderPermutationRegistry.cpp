@@ -0,0 +1,240 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderPermutationRegistry.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+ShaderPermutationRegistry::ShaderPermutationRegistry(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_ShaderCI{CI.ShaderCI}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    DEV_CHECK_ERR(CI.NumAxes == 0 || CI.pAxes != nullptr, "Axes must not be null");
+
+    const auto SpecializationConstantsSupported = m_pDevice->GetDeviceCaps().IsVulkanDevice();
+
+    Uint32 TotalBits = 0;
+    m_Axes.resize(CI.NumAxes);
+    for (Uint32 a = 0; a < CI.NumAxes; ++a)
+    {
+        const auto& Desc = CI.pAxes[a];
+        if (Desc.Name == nullptr || Desc.Name[0] == '\0')
+            LOG_ERROR_AND_THROW("Name of axis ", a, " must not be null or empty");
+        if (Desc.NumValues == 0)
+            LOG_ERROR_AND_THROW("Axis '", Desc.Name, "' must have at least one value");
+
+        auto& Axis     = m_Axes[a];
+        Axis.Name      = Desc.Name;
+        Axis.NumValues = Desc.NumValues;
+        Axis.Shift     = TotalBits;
+        while (Axis.NumBits < 32 && (Uint32{1} << Axis.NumBits) < Desc.NumValues)
+            ++Axis.NumBits;
+
+        TotalBits += Axis.NumBits;
+        if (TotalBits > 64)
+            LOG_ERROR_AND_THROW("Axes of shader '", (m_ShaderCI.Desc.Name != nullptr ? m_ShaderCI.Desc.Name : ""), "' require ", TotalBits, " bits, while the key only has 64");
+
+        Axis.IsSpecializationConstant = Desc.UseSpecializationConstant && SpecializationConstantsSupported;
+        if (Axis.IsSpecializationConstant)
+        {
+            Axis.Values.resize(Desc.NumValues);
+            for (Uint32 v = 0; v < Desc.NumValues; ++v)
+                Axis.Values[v] = v;
+            m_SpecializationConstantMask |= Axis.GetMask();
+        }
+    }
+}
+
+void ShaderPermutationRegistry::DeclareUsed(KeyType Key)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_UsedKeys.insert(Key);
+}
+
+std::vector<ShaderPermutationRegistry::KeyType> ShaderPermutationRegistry::GetUsedPermutations() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return std::vector<KeyType>{m_UsedKeys.begin(), m_UsedKeys.end()};
+}
+
+std::string ShaderPermutationRegistry::GetPermutationName(KeyType ShaderKey) const
+{
+    std::stringstream ss;
+    ss << (m_ShaderCI.Desc.Name != nullptr ? m_ShaderCI.Desc.Name : "") << " [";
+    bool First = true;
+    for (Uint32 a = 0; a < m_Axes.size(); ++a)
+    {
+        if (m_Axes[a].IsSpecializationConstant)
+            continue;
+        if (!First)
+            ss << ' ';
+        ss << m_Axes[a].Name << '=' << GetAxisValue(ShaderKey, a);
+        First = false;
+    }
+    ss << ']';
+    return ss.str();
+}
+
+void ShaderPermutationRegistry::InitMacros(KeyType ShaderKey, ShaderMacroHelper& Macros) const
+{
+    if (m_ShaderCI.Macros != nullptr)
+    {
+        for (const auto* pMacro = m_ShaderCI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+            Macros.AddShaderMacro(pMacro->Name, pMacro->Definition);
+    }
+
+    for (Uint32 a = 0; a < m_Axes.size(); ++a)
+    {
+        if (!m_Axes[a].IsSpecializationConstant)
+            Macros.AddShaderMacro(m_Axes[a].Name.c_str(), static_cast<int>(GetAxisValue(ShaderKey, a)));
+    }
+}
+
+void ShaderPermutationRegistry::LogCompilationError(KeyType ShaderKey, const std::string& Log) const
+{
+    LOG_ERROR_MESSAGE("Failed to compile shader permutation '", GetPermutationName(ShaderKey), "'",
+                      (Log.empty() ? "" : ":\n"), Log);
+}
+
+Uint32 ShaderPermutationRegistry::CompileUsed(const ShaderBatchCompiler& Compiler)
+{
+    std::vector<KeyType> ShaderKeys;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        std::unordered_set<KeyType> UniqueKeys;
+        for (auto Key : m_UsedKeys)
+        {
+            // Permutations that only differ by specialization constants share the shader
+            const auto ShaderKey = GetShaderKey(Key);
+            if (m_Shaders.find(ShaderKey) == m_Shaders.end() && UniqueKeys.insert(ShaderKey).second)
+                ShaderKeys.push_back(ShaderKey);
+        }
+    }
+
+    if (ShaderKeys.empty())
+        return 0;
+
+    // Macro helpers and names must stay alive until the shaders are compiled
+    std::vector<ShaderMacroHelper> Macros(ShaderKeys.size());
+    std::vector<std::string>       Names(ShaderKeys.size());
+    std::vector<ShaderCreateInfo>  ShaderCIs(ShaderKeys.size(), m_ShaderCI);
+    for (size_t i = 0; i < ShaderKeys.size(); ++i)
+    {
+        InitMacros(ShaderKeys[i], Macros[i]);
+        Names[i] = GetPermutationName(ShaderKeys[i]);
+
+        ShaderCIs[i].Macros    = Macros[i];
+        ShaderCIs[i].Desc.Name = Names[i].c_str();
+    }
+
+    auto Results = Compiler.Compile(ShaderCIs);
+
+    Uint32 NumFailed = 0;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    for (size_t i = 0; i < ShaderKeys.size(); ++i)
+    {
+        auto& Res = Results[i];
+        if (!Res.pShader)
+        {
+            LogCompilationError(ShaderKeys[i], Res.Log);
+            ++NumFailed;
+        }
+        // Failed permutations are stored as null so that they are not compiled again
+        m_Shaders.emplace(ShaderKeys[i], std::move(Res.pShader));
+    }
+
+    return NumFailed;
+}
+
+IShader* ShaderPermutationRegistry::GetShader(KeyType Key)
+{
+    const auto ShaderKey = GetShaderKey(Key);
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Shaders.find(ShaderKey);
+        if (it != m_Shaders.end())
+            return it->second;
+    }
+
+    // Compile the shader without holding the lock so that other permutations can still be retrieved
+    ShaderMacroHelper Macros;
+    InitMacros(ShaderKey, Macros);
+    const auto Name = GetPermutationName(ShaderKey);
+
+    auto ShaderCI      = m_ShaderCI;
+    ShaderCI.Macros    = Macros;
+    ShaderCI.Desc.Name = Name.c_str();
+
+    RefCntAutoPtr<IDataBlob> pCompilerOutput;
+    ShaderCI.ppCompilerOutput = &pCompilerOutput;
+
+    RefCntAutoPtr<IShader> pShader;
+    m_pDevice->CreateShader(ShaderCI, &pShader);
+    if (!pShader)
+    {
+        std::string Log;
+        if (pCompilerOutput)
+        {
+            const auto* Msg = static_cast<const char*>(pCompilerOutput->GetConstDataPtr());
+            Log.assign(Msg, strnlen(Msg, pCompilerOutput->GetSize()));
+        }
+        LogCompilationError(ShaderKey, Log);
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // Another thread may have created the same permutation in the meantime, in which case its shader is kept
+    return m_Shaders.emplace(ShaderKey, std::move(pShader)).first->second;
+}
+
+void ShaderPermutationRegistry::GetSpecializationConstants(KeyType Key, std::vector<SpecializationConstant>& Constants) const
+{
+    for (Uint32 a = 0; a < m_Axes.size(); ++a)
+    {
+        const auto& Axis = m_Axes[a];
+        if (!Axis.IsSpecializationConstant)
+            continue;
+
+        const auto Value = GetAxisValue(Key, a);
+        VERIFY(Value < Axis.NumValues, "Value (", Value, ") of axis '", Axis.Name, "' is out of range");
+        Constants.emplace_back(m_ShaderCI.Desc.ShaderType, Axis.Name.c_str(), Uint32{sizeof(Uint32)}, &Axis.Values[Value]);
+    }
+}
+
+} // namespace Diligent
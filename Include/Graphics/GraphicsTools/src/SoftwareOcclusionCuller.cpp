@@ -0,0 +1,296 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "SoftwareOcclusionCuller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+float4 TransformToClip(const float3& Pos, const float4x4& M)
+{
+    // clang-format off
+    return float4
+    {
+        Pos.x * M.m[0][0] + Pos.y * M.m[1][0] + Pos.z * M.m[2][0] + M.m[3][0],
+        Pos.x * M.m[0][1] + Pos.y * M.m[1][1] + Pos.z * M.m[2][1] + M.m[3][1],
+        Pos.x * M.m[0][2] + Pos.y * M.m[1][2] + Pos.z * M.m[2][2] + M.m[3][2],
+        Pos.x * M.m[0][3] + Pos.y * M.m[1][3] + Pos.z * M.m[2][3] + M.m[3][3]
+    };
+    // clang-format on
+}
+
+// Screen-space position: x and y are in pixels with the origin in the top-left corner, z is the depth in [0, 1]
+struct ScreenPos
+{
+    float x, y, z;
+};
+
+} // namespace
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller(const SoftwareOcclusionCullerCreateInfo& CI) :
+    m_CI{CI}
+{
+    DEV_CHECK_ERR(m_CI.Width > 0 && m_CI.Height > 0, "Depth buffer dimensions must not be zero");
+
+    Uint32 Width  = m_CI.Width;
+    Uint32 Height = m_CI.Height;
+    while (true)
+    {
+        m_Mips.emplace_back();
+        auto& Mip  = m_Mips.back();
+        Mip.Width  = Width;
+        Mip.Height = Height;
+        Mip.Depth.resize(size_t{Width} * Height, 1.f);
+        if (Width == 1 && Height == 1)
+            break;
+        Width  = std::max(Width >> 1, 1u);
+        Height = std::max(Height >> 1, 1u);
+    }
+}
+
+void SoftwareOcclusionCuller::Clear()
+{
+    for (auto& Mip : m_Mips)
+        std::fill(Mip.Depth.begin(), Mip.Depth.end(), 1.f);
+}
+
+void SoftwareOcclusionCuller::RasterizeOccluder(const float3*   pPositions,
+                                                Uint32          NumVertices,
+                                                const Uint32*   pIndices,
+                                                Uint32          NumIndices,
+                                                const float4x4& WorldViewProj)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") is not a multiple of 3");
+
+    auto&       Buffer = m_Mips[0];
+    const float Width  = static_cast<float>(Buffer.Width);
+    const float Height = static_cast<float>(Buffer.Height);
+
+    for (Uint32 tri = 0; tri + 2 < NumIndices; tri += 3)
+    {
+        ScreenPos V[3];
+        bool      CrossesNearPlane = false;
+        for (Uint32 v = 0; v < 3 && !CrossesNearPlane; ++v)
+        {
+            const auto Index = pIndices[tri + v];
+            DEV_CHECK_ERR(Index < NumVertices, "Vertex index (", Index, ") is out of range");
+            (void)NumVertices;
+
+            const auto ClipPos = TransformToClip(pPositions[Index], WorldViewProj);
+            const auto MinZ    = m_CI.NDCDepthMinusOneToOne ? -ClipPos.w : 0.f;
+            if (ClipPos.w <= 1e-6f || ClipPos.z < MinZ)
+            {
+                CrossesNearPlane = true;
+                break;
+            }
+
+            const auto InvW = 1.f / ClipPos.w;
+            const auto NDCz = ClipPos.z * InvW;
+
+            V[v].x = (0.5f + 0.5f * ClipPos.x * InvW) * Width;
+            V[v].y = (0.5f - 0.5f * ClipPos.y * InvW) * Height;
+            V[v].z = m_CI.NDCDepthMinusOneToOne ? 0.5f + 0.5f * NDCz : NDCz;
+        }
+        if (CrossesNearPlane)
+            continue;
+
+        auto Area = (V[1].x - V[0].x) * (V[2].y - V[0].y) - (V[1].y - V[0].y) * (V[2].x - V[0].x);
+        if (std::abs(Area) < 1e-12f)
+            continue;
+        // Make the winding consistent, so that all edge functions are positive inside the triangle
+        if (Area < 0)
+        {
+            std::swap(V[1], V[2]);
+            Area = -Area;
+        }
+        const auto InvArea = 1.f / Area;
+
+        // clang-format off
+        const auto MinX = std::max(static_cast<Int32>(std::floor(std::min({V[0].x, V[1].x, V[2].x}))), 0);
+        const auto MinY = std::max(static_cast<Int32>(std::floor(std::min({V[0].y, V[1].y, V[2].y}))), 0);
+        const auto MaxX = std::min(static_cast<Int32>(std::ceil (std::max({V[0].x, V[1].x, V[2].x}))), static_cast<Int32>(Buffer.Width)  - 1);
+        const auto MaxY = std::min(static_cast<Int32>(std::ceil (std::max({V[0].y, V[1].y, V[2].y}))), static_cast<Int32>(Buffer.Height) - 1);
+        // clang-format on
+
+        for (Int32 y = MinY; y <= MaxY; ++y)
+        {
+            const auto Py = static_cast<float>(y) + 0.5f;
+            for (Int32 x = MinX; x <= MaxX; ++x)
+            {
+                const auto Px = static_cast<float>(x) + 0.5f;
+
+                // Edge functions are the barycentric coordinates scaled by the triangle area
+                const auto W0 = (V[2].x - V[1].x) * (Py - V[1].y) - (V[2].y - V[1].y) * (Px - V[1].x);
+                const auto W1 = (V[0].x - V[2].x) * (Py - V[2].y) - (V[0].y - V[2].y) * (Px - V[2].x);
+                const auto W2 = (V[1].x - V[0].x) * (Py - V[0].y) - (V[1].y - V[0].y) * (Px - V[0].x);
+                if (W0 < 0 || W1 < 0 || W2 < 0)
+                    continue;
+
+                // NDC depth is linear in screen space
+                const auto Depth = (W0 * V[0].z + W1 * V[1].z + W2 * V[2].z) * InvArea;
+
+                auto& Dst = Buffer.Depth[size_t{Buffer.Width} * y + x];
+                Dst       = std::min(Dst, Depth);
+            }
+        }
+    }
+}
+
+void SoftwareOcclusionCuller::BuildHiZ()
+{
+    for (size_t m = 1; m < m_Mips.size(); ++m)
+    {
+        const auto& Src = m_Mips[m - 1];
+        auto&       Dst = m_Mips[m];
+
+        auto LoadSrc = [&Src](Uint32 x, Uint32 y) {
+            return Src.Depth[size_t{Src.Width} * std::min(y, Src.Height - 1) + std::min(x, Src.Width - 1)];
+        };
+
+        for (Uint32 y = 0; y < Dst.Height; ++y)
+        {
+            for (Uint32 x = 0; x < Dst.Width; ++x)
+            {
+                const auto SrcX = x * 2;
+                const auto SrcY = y * 2;
+
+                auto Depth = std::max(std::max(LoadSrc(SrcX, SrcY), LoadSrc(SrcX + 1, SrcY)),
+                                      std::max(LoadSrc(SrcX, SrcY + 1), LoadSrc(SrcX + 1, SrcY + 1)));
+
+                // When a source dimension is odd, the last destination texel also covers the last source row or column
+                const bool LastX = (Src.Width & 1u) != 0 && x == Dst.Width - 1;
+                const bool LastY = (Src.Height & 1u) != 0 && y == Dst.Height - 1;
+                if (LastX)
+                    Depth = std::max(Depth, std::max(LoadSrc(SrcX + 2, SrcY), LoadSrc(SrcX + 2, SrcY + 1)));
+                if (LastY)
+                    Depth = std::max(Depth, std::max(LoadSrc(SrcX, SrcY + 2), LoadSrc(SrcX + 1, SrcY + 2)));
+                if (LastX && LastY)
+                    Depth = std::max(Depth, LoadSrc(SrcX + 2, SrcY + 2));
+
+                Dst.Depth[size_t{Dst.Width} * y + x] = Depth;
+            }
+        }
+    }
+}
+
+bool SoftwareOcclusionCuller::IsOccluded(const BoundBox& Box, const float4x4& ViewProj) const
+{
+    float MinU     = 1.f;
+    float MinV     = 1.f;
+    float MaxU     = 0.f;
+    float MaxV     = 0.f;
+    float MinDepth = 1.f;
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        const float3 Corner //
+            {
+                (i & 1u) != 0 ? Box.Max.x : Box.Min.x,
+                (i & 2u) != 0 ? Box.Max.y : Box.Min.y,
+                (i & 4u) != 0 ? Box.Max.z : Box.Min.z //
+            };
+
+        const auto ClipPos = TransformToClip(Corner, ViewProj);
+        // Boxes that cross the camera plane can't be projected
+        if (ClipPos.w <= 1e-6f)
+            return false;
+
+        const auto InvW = 1.f / ClipPos.w;
+        const auto NDCz = ClipPos.z * InvW;
+
+        const auto U     = 0.5f + 0.5f * ClipPos.x * InvW;
+        const auto V     = 0.5f - 0.5f * ClipPos.y * InvW;
+        const auto Depth = m_CI.NDCDepthMinusOneToOne ? 0.5f + 0.5f * NDCz : NDCz;
+
+        MinU     = std::min(MinU, U);
+        MinV     = std::min(MinV, V);
+        MaxU     = std::max(MaxU, U);
+        MaxV     = std::max(MaxV, V);
+        MinDepth = std::min(MinDepth, Depth);
+    }
+    MinU = std::max(MinU, 0.f);
+    MinV = std::max(MinV, 0.f);
+    MaxU = std::min(MaxU, 1.f);
+    MaxV = std::min(MaxV, 1.f);
+    if (MinU > MaxU || MinV > MaxV)
+        return false; // Outside of the screen; the frustum test is responsible for this case
+
+    // Select the level where the rectangle spans at most 2x2 texels
+    const auto RectSize = std::max((MaxU - MinU) * static_cast<float>(m_CI.Width), (MaxV - MinV) * static_cast<float>(m_CI.Height));
+    const auto Mip      = std::min(static_cast<Uint32>(std::ceil(std::log2(std::max(RectSize, 1.f)))), GetNumMipLevels() - 1);
+
+    const auto& Level = m_Mips[Mip];
+    // clang-format off
+    const auto MinX = std::min(static_cast<Uint32>(MinU * static_cast<float>(Level.Width)),  Level.Width  - 1);
+    const auto MinY = std::min(static_cast<Uint32>(MinV * static_cast<float>(Level.Height)), Level.Height - 1);
+    const auto MaxX = std::min(static_cast<Uint32>(MaxU * static_cast<float>(Level.Width)),  Level.Width  - 1);
+    const auto MaxY = std::min(static_cast<Uint32>(MaxV * static_cast<float>(Level.Height)), Level.Height - 1);
+    // clang-format on
+
+    auto MaxDepth = 0.f;
+    for (auto y = MinY; y <= MaxY; ++y)
+    {
+        for (auto x = MinX; x <= MaxX; ++x)
+            MaxDepth = std::max(MaxDepth, Level.Depth[size_t{Level.Width} * y + x]);
+    }
+
+    // The box is hidden if it is entirely behind the farthest occluder depth
+    return MinDepth > MaxDepth;
+}
+
+void SoftwareOcclusionCuller::Cull(const BoundBox*      pBoxes,
+                                   const Uint32*        pIndices,
+                                   Uint32               NumIndices,
+                                   const float4x4&      ViewProj,
+                                   std::vector<Uint32>& Visible) const
+{
+    Visible.clear();
+    for (Uint32 i = 0; i < NumIndices; ++i)
+    {
+        const auto Index = pIndices[i];
+        if (!IsOccluded(pBoxes[Index], ViewProj))
+            Visible.push_back(Index);
+    }
+}
+
+float SoftwareOcclusionCuller::GetDepth(Uint32 x, Uint32 y, Uint32 Mip) const
+{
+    DEV_CHECK_ERR(Mip < GetNumMipLevels(), "Mip level (", Mip, ") is out of range");
+    const auto& Level = m_Mips[Mip];
+    DEV_CHECK_ERR(x < Level.Width && y < Level.Height, "Texel (", x, ", ", y, ") is out of range");
+    return Level.Depth[size_t{Level.Width} * y + x];
+}
+
+} // namespace Diligent
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "UniformBufferRing.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+UniformBufferRing::UniformBufferRing(const UniformBufferRingCreateInfo& CI) :
+    // clang-format off
+    m_FrameSize         {Align(CI.FrameSize, BlockAlignment)},
+    m_MaxBlockSize      {Align(CI.MaxBlockSize, Uint32{16})},
+    m_NumFramesInFlight {std::max(CI.NumFramesInFlight, Uint32{1})},
+    m_PersistentMap     {CI.pDevice != nullptr && CI.pDevice->GetDeviceCaps().AdapterInfo.UnifiedMemory != 0 &&
+                         (CI.pDevice->GetDeviceCaps().AdapterInfo.UnifiedMemoryCPUAccess & CPU_ACCESS_WRITE) != 0}
+// clang-format on
+{
+    DEV_CHECK_ERR(CI.pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(CI.MaxBlockSize > 0 && CI.MaxBlockSize <= CI.FrameSize, "Max block size (", CI.MaxBlockSize, ") must be in range 1 .. FrameSize (", CI.FrameSize, ")");
+    if (!CI.pDevice->GetDeviceCaps().IsVulkanDevice())
+        LOG_ERROR_AND_THROW("Uniform buffer ring requires dynamic buffer offsets that are only supported in Vulkan backend");
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = CI.Name;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    // The range bound to shader variables always spans MaxBlockSize bytes, so the last block in
+    // the buffer needs that much space after its offset even if the allocation is smaller.
+    if (m_PersistentMap)
+    {
+        BuffDesc.Usage         = USAGE_UNIFIED;
+        BuffDesc.uiSizeInBytes = m_FrameSize * m_NumFramesInFlight + m_MaxBlockSize;
+    }
+    else
+    {
+        BuffDesc.Usage         = USAGE_DYNAMIC;
+        BuffDesc.uiSizeInBytes = m_FrameSize + m_MaxBlockSize;
+    }
+    CI.pDevice->CreateBuffer(BuffDesc, nullptr, &m_pBuffer);
+    if (!m_pBuffer)
+        LOG_ERROR_AND_THROW("Failed to create uniform buffer ring '", CI.Name, "'");
+
+    if (m_PersistentMap)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Uniform buffer ring fence";
+        CI.pDevice->CreateFence(Desc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create uniform buffer ring fence");
+    }
+}
+
+void UniformBufferRing::BeginFrame(IDeviceContext* pContext)
+{
+    VERIFY_EXPR(pContext != nullptr);
+
+    if (m_PersistentMap)
+    {
+        if (m_FrameNumber >= m_NumFramesInFlight)
+        {
+            // Frame N signals value N + 1 when it ends
+            const auto RequiredValue = m_FrameNumber - m_NumFramesInFlight + 1;
+            if (m_pFence->GetCompletedValue() < RequiredValue)
+                pContext->WaitForFence(m_pFence, RequiredValue, true);
+        }
+
+        if (!m_MappedData)
+            m_MappedData.Map(pContext, m_pBuffer, MAP_WRITE, MAP_FLAG_NONE);
+
+        m_SegmentStart = static_cast<Uint32>(m_FrameNumber % m_NumFramesInFlight) * m_FrameSize;
+    }
+    else
+    {
+        VERIFY(!m_MappedData, "EndFrame() has not been called for the previous frame");
+        m_MappedData.Map(pContext, m_pBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        m_SegmentStart = 0;
+    }
+    VERIFY_EXPR(m_MappedData);
+
+    m_CurrOffset = m_SegmentStart;
+}
+
+UniformBufferRing::Block UniformBufferRing::Allocate(Uint32 Size)
+{
+    DEV_CHECK_ERR(m_MappedData, "BeginFrame() must be called before allocating blocks");
+    DEV_CHECK_ERR(Size > 0 && Size <= m_MaxBlockSize, "Block size (", Size, ") must be in range 1 .. ", m_MaxBlockSize);
+
+    Block NewBlock;
+    if (m_CurrOffset + Size > m_SegmentStart + m_FrameSize)
+    {
+        LOG_ERROR_MESSAGE("Uniform buffer ring '", m_pBuffer->GetDesc().Name, "' is out of space. Increase the frame size (", m_FrameSize, ").");
+        return NewBlock;
+    }
+
+    NewBlock.pData  = static_cast<Uint8*>(m_MappedData) + m_CurrOffset;
+    NewBlock.Offset = m_CurrOffset;
+    m_CurrOffset    = Align(m_CurrOffset + Size, BlockAlignment);
+    return NewBlock;
+}
+
+void UniformBufferRing::Bind(IShaderResourceVariable* pVar)
+{
+    VERIFY_EXPR(pVar != nullptr);
+    pVar->SetBufferRange(m_pBuffer, 0, m_MaxBlockSize);
+}
+
+void UniformBufferRing::EndFrame(IDeviceContext* pContext)
+{
+    if (m_PersistentMap)
+        pContext->SignalFence(m_pFence, m_FrameNumber + 1);
+    else
+        m_MappedData.Unmap();
+
+    ++m_FrameNumber;
+}
+
+} // namespace Diligent
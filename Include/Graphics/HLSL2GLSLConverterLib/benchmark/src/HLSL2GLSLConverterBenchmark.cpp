@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// HLSL to GLSL conversion benchmark.
+//
+// Usage:
+//
+//     Diligent-HLSL2GLSLConverterBenchmark [-n <iterations>] [-e <entry point>] [-t vs|ps|cs] [<HLSL file>]
+//
+// Without an input file, the benchmark generates a large pixel shader with many constant buffers,
+// textures, structs and functions. Every iteration appends a unique comment to the source, so that
+// the conversion cache is missed and the full conversion is measured. The time of a cached
+// conversion of the same source is reported separately.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "HLSL2GLSLConverterImpl.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::string GenerateShader(int NumFunctions)
+{
+    std::stringstream ss;
+    for (int i = 0; i < NumFunctions; ++i)
+    {
+        ss << "cbuffer Constants" << i << "\n"
+           << "{\n"
+           << "    float4x4 g_Transform" << i << ";\n"
+           << "    float4   g_Params" << i << ";\n"
+           << "};\n"
+           << "Texture2D    g_Texture" << i << ";\n"
+           << "SamplerState g_Texture" << i << "_sampler;\n\n"
+           << "struct SurfaceInfo" << i << "\n"
+           << "{\n"
+           << "    float4 Color;\n"
+           << "    float3 Normal;\n"
+           << "    float  Roughness;\n"
+           << "};\n\n"
+           << "// Samples the texture and applies the material parameters\n"
+           << "float4 Shade" << i << "(float2 UV, float3 Normal)\n"
+           << "{\n"
+           << "    SurfaceInfo" << i << " Surface;\n"
+           << "    Surface.Color     = g_Texture" << i << ".Sample(g_Texture" << i << "_sampler, UV);\n"
+           << "    Surface.Normal    = normalize(mul(float4(Normal, 0.0), g_Transform" << i << ").xyz);\n"
+           << "    Surface.Roughness = saturate(g_Params" << i << ".w);\n"
+           << "    float NdotL = max(dot(Surface.Normal, normalize(g_Params" << i << ".xyz)), 0.0);\n"
+           << "    [unroll]\n"
+           << "    for (int j = 0; j < 4; ++j)\n"
+           << "    {\n"
+           << "        Surface.Color.rgb += g_Texture" << i << ".SampleLevel(g_Texture" << i << "_sampler, UV * float(j + 1), float(j)).rgb * 0.25;\n"
+           << "    }\n"
+           << "    return float4(Surface.Color.rgb * NdotL * (1.0 - Surface.Roughness), Surface.Color.a);\n"
+           << "}\n\n";
+    }
+
+    ss << "struct PSInput\n"
+       << "{\n"
+       << "    float4 Pos    : SV_POSITION;\n"
+       << "    float2 UV     : TEX_COORD;\n"
+       << "    float3 Normal : NORMAL;\n"
+       << "};\n\n"
+       << "void main(in  PSInput PSIn,\n"
+       << "          out float4  Color : SV_Target)\n"
+       << "{\n"
+       << "    Color = float4(0.0, 0.0, 0.0, 0.0);\n";
+    for (int i = 0; i < NumFunctions; ++i)
+        ss << "    Color += Shade" << i << "(PSIn.UV, PSIn.Normal);\n";
+    ss << "}\n";
+
+    return ss.str();
+}
+
+SHADER_TYPE ParseShaderType(const char* Type)
+{
+    if (strcmp(Type, "vs") == 0) return SHADER_TYPE_VERTEX;
+    if (strcmp(Type, "ps") == 0) return SHADER_TYPE_PIXEL;
+    if (strcmp(Type, "cs") == 0) return SHADER_TYPE_COMPUTE;
+    return SHADER_TYPE_UNKNOWN;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int         NumIterations = 20;
+    const char* EntryPoint    = "main";
+    SHADER_TYPE ShaderType    = SHADER_TYPE_PIXEL;
+    const char* InputFile     = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            NumIterations = std::max(std::atoi(argv[++i]), 1);
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+            EntryPoint = argv[++i];
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            ShaderType = ParseShaderType(argv[++i]);
+        else
+            InputFile = argv[i];
+    }
+
+    if (ShaderType == SHADER_TYPE_UNKNOWN)
+    {
+        std::cerr << "Unknown shader type\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string Source;
+    if (InputFile != nullptr)
+    {
+        std::ifstream File{InputFile};
+        if (!File)
+        {
+            std::cerr << "Failed to open " << InputFile << '\n';
+            return EXIT_FAILURE;
+        }
+        std::stringstream ss;
+        ss << File.rdbuf();
+        Source = ss.str();
+    }
+    else
+    {
+        Source = GenerateShader(500);
+    }
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+    Attribs.EntryPoint    = EntryPoint;
+    Attribs.ShaderType    = ShaderType;
+    Attribs.InputFileName = InputFile != nullptr ? InputFile : "<generated>";
+
+    std::string IterSource;
+    size_t      GLSLLength = 0;
+    double      TotalTime  = 0;
+    for (int i = 0; i <= NumIterations; ++i)
+    {
+        // Make every source unique so that the conversion cache is missed
+        IterSource = Source + "\n// Iteration " + std::to_string(i) + "\n";
+
+        Attribs.HLSLSource = IterSource.c_str();
+        Attribs.NumSymbols = IterSource.length();
+
+        const auto StartTime = std::chrono::high_resolution_clock::now();
+        const auto GLSL      = Converter.Convert(Attribs);
+        const auto EndTime   = std::chrono::high_resolution_clock::now();
+        if (GLSL.empty())
+        {
+            std::cerr << "Failed to convert the shader\n";
+            return EXIT_FAILURE;
+        }
+        GLSLLength = GLSL.length();
+
+        // The first iteration is a warm-up
+        if (i > 0)
+            TotalTime += std::chrono::duration<double>(EndTime - StartTime).count();
+    }
+
+    // The last source is now in the conversion cache
+    const auto CachedStartTime = std::chrono::high_resolution_clock::now();
+    const auto CachedGLSL      = Converter.Convert(Attribs);
+    const auto CachedTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - CachedStartTime).count();
+
+    if (CachedGLSL.length() != GLSLLength)
+    {
+        std::cerr << "Cached conversion does not match\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "HLSL source: " << Source.length() / 1024 << " KB, GLSL output: " << GLSLLength / 1024 << " KB\n"
+              << "Conversion:        " << TotalTime / NumIterations * 1000.0 << " ms (average of " << NumIterations << ")\n"
+              << "Cached conversion: " << CachedTime * 1000.0 << " ms\n";
+
+    return EXIT_SUCCESS;
+}
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -89,6 +91,60 @@ struct FunctionStubHashKey
     };
 };
 
+/// Identifies the result of converting the source with the given parameters
+struct ConversionCacheKey
+{
+    String      Source;         // Source code with all includes inserted
+    size_t      SourceHash = 0; // Hash of the Source
+    String      EntryPoint;
+    SHADER_TYPE ShaderType                 = SHADER_TYPE_UNKNOWN;
+    bool        IncludeDefinitions         = false;
+    String      SamplerSuffix;
+    bool        UseInOutLocationQualifiers = false;
+
+    ConversionCacheKey(String      _Source,
+                       size_t      _SourceHash,
+                       const Char* _EntryPoint,
+                       SHADER_TYPE _ShaderType,
+                       bool        _IncludeDefinitions,
+                       const Char* _SamplerSuffix,
+                       bool        _UseInOutLocationQualifiers) :
+        // clang-format off
+        Source                    {std::move(_Source)},
+        SourceHash                {_SourceHash},
+        EntryPoint                {_EntryPoint    != nullptr ? _EntryPoint    : ""},
+        ShaderType                {_ShaderType},
+        IncludeDefinitions        {_IncludeDefinitions},
+        SamplerSuffix             {_SamplerSuffix != nullptr ? _SamplerSuffix : ""},
+        UseInOutLocationQualifiers{_UseInOutLocationQualifiers}
+    // clang-format on
+    {}
+
+    bool operator==(const ConversionCacheKey& rhs) const
+    {
+        // The source is compared in full, so that a hash collision can never
+        // return GLSL converted from a different source.
+        // clang-format off
+        return SourceHash                 == rhs.SourceHash                 &&
+               ShaderType                 == rhs.ShaderType                 &&
+               IncludeDefinitions         == rhs.IncludeDefinitions         &&
+               UseInOutLocationQualifiers == rhs.UseInOutLocationQualifiers &&
+               EntryPoint                 == rhs.EntryPoint                 &&
+               SamplerSuffix              == rhs.SamplerSuffix              &&
+               Source                     == rhs.Source;
+        // clang-format on
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const ConversionCacheKey& Key) const
+        {
+            return ComputeHash(Key.SourceHash, Key.EntryPoint, static_cast<Uint32>(Key.ShaderType),
+                               Key.IncludeDefinitions, Key.SamplerSuffix, Key.UseInOutLocationQualifiers);
+        }
+    };
+};
+
 /// HLSL to GLSL shader source code converter implementation
 class HLSL2GLSLConverterImpl
 {
@@ -166,6 +222,9 @@ public:
 private:
     HLSL2GLSLConverterImpl();
 
+    bool FindCachedConversion(const ConversionCacheKey& Key, String& GLSLSource) const;
+    void CacheConversion(ConversionCacheKey&& Key, const String& GLSLSource) const;
+
     struct HLSLObjectInfo
     {
         String GLSLType;      // sampler2D, sampler2DShadow, image2D, etc.
@@ -269,7 +328,94 @@ private:
             Delimiter{_Delimiter}
         {}
     };
-    typedef std::list<TokenInfo> TokenListType;
+
+    // Memory arena for the token list nodes. Nodes are carved out of large pages in the order
+    // in which the tokens are created, so the tokens of the source end up in contiguous memory,
+    // and all pages are released at once when the arena is destroyed. Nodes removed by the converter
+    // are recycled through the free list. The arena is not thread-safe.
+    class TokenArena
+    {
+    public:
+        TokenArena() noexcept {}
+
+        // clang-format off
+        TokenArena           (const TokenArena&)  = delete;
+        TokenArena           (      TokenArena&&) = delete;
+        TokenArena& operator=(const TokenArena&)  = delete;
+        TokenArena& operator=(      TokenArena&&) = delete;
+        // clang-format on
+
+        void* Allocate(size_t Size);
+        void  Free(void* Ptr, size_t Size);
+
+    private:
+        static constexpr size_t NumSlotsInPage = 4096;
+
+        // List node layout is implementation-defined, but all major STL implementations store two
+        // links and the value. Requests that don't fit into a slot are forwarded to the global heap.
+        static constexpr size_t SlotAlignment = alignof(TokenInfo) > alignof(void*) ? alignof(TokenInfo) : alignof(void*);
+        static constexpr size_t SlotSize      = (sizeof(TokenInfo) + 2 * sizeof(void*) + SlotAlignment - 1) / SlotAlignment * SlotAlignment;
+
+        struct FreeSlot
+        {
+            FreeSlot* pNext;
+        };
+
+        std::vector<std::unique_ptr<Uint8[]>> m_Pages;
+
+        size_t    m_NumUsedSlotsInPage = NumSlotsInPage;
+        FreeSlot* m_pFreeList          = nullptr;
+    };
+
+    // STL allocator that allocates token list nodes from the TokenArena
+    template <typename T>
+    struct TokenAllocator
+    {
+        using value_type = T;
+
+        // clang-format off
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        // clang-format on
+
+        explicit TokenAllocator(TokenArena& Arena) noexcept :
+            pArena{&Arena}
+        {}
+
+        template <typename U>
+        TokenAllocator(const TokenAllocator<U>& rhs) noexcept :
+            pArena{rhs.pArena}
+        {}
+
+        T* allocate(size_t Count)
+        {
+            return static_cast<T*>(pArena->Allocate(Count * sizeof(T)));
+        }
+
+        void deallocate(T* Ptr, size_t Count)
+        {
+            pArena->Free(Ptr, Count * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const TokenAllocator<U>& rhs) const noexcept
+        {
+            return pArena == rhs.pArena;
+        }
+
+        template <typename U>
+        bool operator!=(const TokenAllocator<U>& rhs) const noexcept
+        {
+            return pArena != rhs.pArena;
+        }
+
+        TokenArena* pArena;
+    };
+
+    // The converter inserts and removes tokens everywhere in the source and keeps
+    // iterators to them in hash maps, so the tokens are kept in a list.
+    typedef std::list<TokenInfo, TokenAllocator<TokenInfo>> TokenListType;
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -300,6 +446,20 @@ private:
                          size_t                           NumSymbols,
                          bool                             bPreserveTokens);
 
+        /// Creates the stream from the source code that has already been loaded with LoadSource().
+        ConversionStream(IReferenceCounters*           pRefCounters,
+                         const HLSL2GLSLConverterImpl& Converter,
+                         const char*                   InputFileName,
+                         String                        Source,
+                         bool                          bPreserveTokens);
+
+        /// Loads the source code (from the stream factory if HLSLSource is null) and inserts all includes.
+        /// The parameters have the same meaning as in the constructor.
+        static String LoadSource(const char*                      InputFileName,
+                                 IShaderSourceInputStreamFactory* pInputStreamFactory,
+                                 const Char*                      HLSLSource,
+                                 size_t                           NumSymbols);
+
         String Convert(const Char* EntryPoint,
                        SHADER_TYPE ShaderType,
                        bool        IncludeDefintions,
@@ -317,8 +477,15 @@ private:
 
         const String& GetInputFileName() const { return m_InputFileName; }
 
+        // Converts the tokens without looking up the conversion cache
+        String ConvertImpl(const Char* EntryPoint,
+                           SHADER_TYPE ShaderType,
+                           bool        IncludeDefintions,
+                           const char* SamplerSuffix,
+                           bool        UseInOutLocationQualifiers);
+
     private:
-        void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
+        static void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
         void Tokenize(const String& Source);
 
         typedef std::unordered_map<String, bool> SamplerHashType;
@@ -503,12 +670,23 @@ private:
 
         String BuildGLSLSource();
 
+        // Memory for the tokens. Must be declared before all token lists.
+        TokenArena m_TokenArena;
+
         // Tokenized source code
-        TokenListType m_Tokens;
+        TokenListType m_Tokens{TokenAllocator<TokenInfo>{m_TokenArena}};
 
         // List of tokens defining structs
         std::unordered_map<HashMapStringKey, TokenListType::iterator, HashMapStringKey::Hasher> m_StructDefinitions;
 
+        // Global function name -> name token of its first definition, filled when
+        // the function declarations are parsed
+        std::unordered_map<HashMapStringKey, TokenListType::iterator, HashMapStringKey::Hasher> m_FunctionDefinitions;
+
+        // Source code with all includes inserted and its hash, used as the conversion cache key
+        const String m_Source;
+        const size_t m_SourceHash;
+
         // Stack of parsed objects, for every scope level.
         // There are currently only two levels:
         // level 0 - global scope, contains all global objects
@@ -545,6 +723,15 @@ private:
     static constexpr int MaxShaderStages = 6; // Maximum supported shader stages: VS, GS, PS, DS, HS, CS
 
     std::array<std::array<std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher>, 2>, MaxShaderStages> m_HLSLSemanticToGLSLVar;
+
+    // Converted sources. The same file is typically converted many times
+    // for different permutations, stages and pipelines. The size accounts for
+    // both the sources stored in the keys and the converted GLSL.
+    static constexpr size_t MaxConversionCacheSize = 32 << 20;
+
+    mutable std::mutex                                                                m_ConversionCacheMtx;
+    mutable std::unordered_map<ConversionCacheKey, String, ConversionCacheKey::Hasher> m_ConversionCache;
+    mutable size_t                                                                    m_ConversionCacheSize = 0;
 };
 
 } // namespace Diligent
@@ -386,8 +386,19 @@ inline bool IsNewLine(Char Symbol)
 
 inline bool IsDelimiter(Char Symbol)
 {
-    static const Char* Delimeters = " \t\r\n";
-    return strchr(Delimeters, Symbol) != nullptr;
+    return IsWhitespace(Symbol) || IsNewLine(Symbol);
+}
+
+// Unlike isalpha() and isalnum(), these do not depend on the current locale
+// and are inlined into the tokenizer loops
+inline bool IsIdentifierStart(Char Symbol)
+{
+    return (Symbol >= 'a' && Symbol <= 'z') || (Symbol >= 'A' && Symbol <= 'Z') || Symbol == '_';
+}
+
+inline bool IsIdentifierSymbol(Char Symbol)
+{
+    return IsIdentifierStart(Symbol) || (Symbol >= '0' && Symbol <= '9');
 }
 
 inline bool IsStatementSeparator(Char Symbol)
@@ -495,7 +506,7 @@ inline bool SkipIdentifier(const String& Input, String::const_iterator& SrcChar)
     if (SrcChar == Input.end())
         return true;
 
-    if (isalpha(*SrcChar) || *SrcChar == '_')
+    if (IsIdentifierStart(*SrcChar))
     {
         ++SrcChar;
         if (SrcChar == Input.end())
@@ -504,7 +515,7 @@ inline bool SkipIdentifier(const String& Input, String::const_iterator& SrcChar)
     else
         return false;
 
-    for (; SrcChar != Input.end() && (isalnum(*SrcChar) || *SrcChar == '_'); ++SrcChar)
+    for (; SrcChar != Input.end() && IsIdentifierSymbol(*SrcChar); ++SrcChar)
         ;
 
     return SrcChar == Input.end();
@@ -517,6 +528,39 @@ const HLSL2GLSLConverterImpl& HLSL2GLSLConverterImpl::GetInstance()
     return Converter;
 }
 
+void* HLSL2GLSLConverterImpl::TokenArena::Allocate(size_t Size)
+{
+    if (Size > SlotSize)
+        return ::operator new(Size);
+
+    if (m_pFreeList != nullptr)
+    {
+        auto* pSlot = m_pFreeList;
+        m_pFreeList = pSlot->pNext;
+        return pSlot;
+    }
+
+    if (m_NumUsedSlotsInPage == NumSlotsInPage)
+    {
+        m_Pages.emplace_back(new Uint8[SlotSize * NumSlotsInPage]);
+        m_NumUsedSlotsInPage = 0;
+    }
+    return m_Pages.back().get() + SlotSize * m_NumUsedSlotsInPage++;
+}
+
+void HLSL2GLSLConverterImpl::TokenArena::Free(void* Ptr, size_t Size)
+{
+    if (Size > SlotSize)
+    {
+        ::operator delete(Ptr);
+        return;
+    }
+
+    auto* pSlot  = static_cast<FreeSlot*>(Ptr);
+    pSlot->pNext = m_pFreeList;
+    m_pFreeList  = pSlot;
+}
+
 HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 {
     // Populate HLSL keywords hash map
@@ -977,13 +1021,19 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
 
+    // The text before the last processed #include does not change, so the search
+    // resumes from the position of that directive
+    size_t SearchStart = 0;
     do
     {
-        // Find the first #include statement
-        auto Pos             = GLSLSource.begin();
+        // Find the next #include statement
+        auto Pos             = GLSLSource.begin() + SearchStart;
         auto IncludeStartPos = GLSLSource.end();
         while (Pos != GLSLSource.end())
         {
+            // Only '#' and comments are of interest here
+            while (Pos != GLSLSource.end() && *Pos != '#' && *Pos != '/')
+                ++Pos;
             // #   include "TestFile.fxh"
             if (SkipDelimetersAndComments(GLSLSource, Pos))
                 break;
@@ -1047,6 +1097,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         // #   include "TestFile.fxh"
         // ^                         ^
         // IncludeStartPos           Pos
+        SearchStart = IncludeStartPos - GLSLSource.begin();
         GLSLSource.erase(IncludeStartPos, Pos);
 
         // Convert the name to lower case
@@ -1069,7 +1120,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             size_t NumSymbols  = pIncludeData->GetSize();
 
             // Insert the text into source
-            GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+            GLSLSource.insert(SearchStart, IncludeText, NumSymbols);
         }
     } while (true);
 }
@@ -1178,7 +1229,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 break;
 
             case '=':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "")
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty())
                 {
                     auto& LastToken = m_Tokens.back();
                     // +=, -=, *=, /=, %=, <<=, >>=, &=, |=, ^=
@@ -1214,7 +1265,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '|':
             case '&':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::BooleanOp;
@@ -1230,7 +1281,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '<':
             case '>':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::BitwiseOp;
@@ -1249,7 +1300,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '+':
             case '-':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::IncDecOp;
@@ -1366,7 +1417,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
             }
         }
 
-        m_Tokens.push_back(NewToken);
+        m_Tokens.push_back(std::move(NewToken));
     }
 #undef CHECK_END
 }
@@ -3545,19 +3596,27 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
     // Search for the function in the global scope
     auto EntryPointToken = m_Tokens.end();
     auto Token           = m_Tokens.begin();
-    ProcessScope(
-        Token, m_Tokens.end(), TokenType::OpenBrace, TokenType::ClosingBrace,
-        [&](TokenListType::iterator& tkn, int ScopeDepth) //
-        {
-            if (ScopeDepth == 0 && tkn->Type == TokenType::Identifier && tkn->Literal == FuncName)
+    auto FuncIt          = m_FunctionDefinitions.find(FuncName);
+    if (FuncIt != m_FunctionDefinitions.end())
+    {
+        EntryPointToken = FuncIt->second;
+    }
+    else
+    {
+        ProcessScope(
+            Token, m_Tokens.end(), TokenType::OpenBrace, TokenType::ClosingBrace,
+            [&](TokenListType::iterator& tkn, int ScopeDepth) //
             {
-                EntryPointToken = tkn;
-                tkn             = m_Tokens.end();
-            }
-            else
-                ++tkn;
-        } //
-    );
+                if (ScopeDepth == 0 && tkn->Type == TokenType::Identifier && tkn->Literal == FuncName)
+                {
+                    EntryPointToken = tkn;
+                    tkn             = m_Tokens.end();
+                }
+                else
+                    ++tkn;
+            } //
+        );
+    }
     VERIFY_PARSER_STATE(EntryPointToken, EntryPointToken != m_Tokens.end(), "Unable to find hull shader constant function \"", FuncName, '\"');
     const auto* EntryPoint = EntryPointToken->Literal.c_str();
 
@@ -4575,12 +4634,31 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            const Char*                      HLSLSource,
                                                            size_t                           NumSymbols,
                                                            bool                             bPreserveTokens) :
+    ConversionStream{pRefCounters, Converter, InputFileName, LoadSource(InputFileName, pInputStreamFactory, HLSLSource, NumSymbols), bPreserveTokens}
+{
+}
+
+HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*           pRefCounters,
+                                                           const HLSL2GLSLConverterImpl& Converter,
+                                                           const char*                   InputFileName,
+                                                           String                        Source,
+                                                           bool                          bPreserveTokens) :
     // clang-format off
-    TBase            {pRefCounters   },
-    m_bPreserveTokens{bPreserveTokens},
-    m_Converter      {Converter      },
+    TBase            {pRefCounters     },
+    m_Source         {std::move(Source)},
+    m_SourceHash     {std::hash<String>{}(m_Source)},
+    m_bPreserveTokens{bPreserveTokens  },
+    m_Converter      {Converter        },
     m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
 // clang-format on
+{
+    Tokenize(m_Source);
+}
+
+String HLSL2GLSLConverterImpl::ConversionStream::LoadSource(const char*                      InputFileName,
+                                                            IShaderSourceInputStreamFactory* pInputStreamFactory,
+                                                            const Char*                      HLSLSource,
+                                                            size_t                           NumSymbols)
 {
     RefCntAutoPtr<IDataBlob> pFileData;
     if (HLSLSource == nullptr)
@@ -4606,7 +4684,34 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
 
     InsertIncludes(Source, pInputStreamFactory);
 
-    Tokenize(Source);
+    return Source;
+}
+
+bool HLSL2GLSLConverterImpl::FindCachedConversion(const ConversionCacheKey& Key, String& GLSLSource) const
+{
+    std::lock_guard<std::mutex> Lock{m_ConversionCacheMtx};
+
+    auto it = m_ConversionCache.find(Key);
+    if (it == m_ConversionCache.end())
+        return false;
+
+    GLSLSource = it->second;
+    return true;
+}
+
+void HLSL2GLSLConverterImpl::CacheConversion(ConversionCacheKey&& Key, const String& GLSLSource) const
+{
+    std::lock_guard<std::mutex> Lock{m_ConversionCacheMtx};
+
+    const auto EntrySize = Key.Source.size() + GLSLSource.size();
+    if (m_ConversionCacheSize + EntrySize > MaxConversionCacheSize)
+    {
+        m_ConversionCache.clear();
+        m_ConversionCacheSize = 0;
+    }
+
+    if (m_ConversionCache.emplace(std::move(Key), GLSLSource).second)
+        m_ConversionCacheSize += EntrySize;
 }
 
 
@@ -4616,8 +4721,20 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
     {
         try
         {
-            ConversionStream Stream(nullptr, *this, Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, false);
-            return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+            // Look up the cache before the source is tokenized, which is the bulk of the
+            // stream construction cost.
+            auto               Source     = ConversionStream::LoadSource(Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols);
+            const auto         SourceHash = std::hash<String>{}(Source);
+            ConversionCacheKey CacheKey{Source, SourceHash, Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers};
+
+            String GLSLSource;
+            if (FindCachedConversion(CacheKey, GLSLSource))
+                return GLSLSource;
+
+            ConversionStream Stream(nullptr, *this, Attribs.InputFileName, std::move(Source), false);
+            GLSLSource = Stream.ConvertImpl(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+            CacheConversion(std::move(CacheKey), GLSLSource);
+            return GLSLSource;
         }
         catch (std::runtime_error&)
         {
@@ -4691,9 +4808,26 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          bool        IncludeDefintions,
                                                          const char* SamplerSuffix,
                                                          bool        UseInOutLocationQualifiers)
+{
+    ConversionCacheKey CacheKey{m_Source, m_SourceHash, EntryPoint, ShaderType, IncludeDefintions, SamplerSuffix, UseInOutLocationQualifiers};
+
+    String GLSLSource;
+    if (m_Converter.FindCachedConversion(CacheKey, GLSLSource))
+        return GLSLSource;
+
+    GLSLSource = ConvertImpl(EntryPoint, ShaderType, IncludeDefintions, SamplerSuffix, UseInOutLocationQualifiers);
+    m_Converter.CacheConversion(std::move(CacheKey), GLSLSource);
+    return GLSLSource;
+}
+
+String HLSL2GLSLConverterImpl::ConversionStream::ConvertImpl(const Char* EntryPoint,
+                                                             SHADER_TYPE ShaderType,
+                                                             bool        IncludeDefintions,
+                                                             const char* SamplerSuffix,
+                                                             bool        UseInOutLocationQualifiers)
 {
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType(m_Tokens.get_allocator()));
 
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
@@ -4793,6 +4927,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                 {
                     if (Token->Literal == EntryPoint)
                         ShaderEntryPointToken = Token;
+                    m_FunctionDefinitions.emplace(Token->Literal, Token);
 
                     Token = OpenParenToken;
                     // float4 Func ( in float2 f2UV,
@@ -4923,6 +5058,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     {
         m_Tokens.swap(TokensCopy);
         m_StructDefinitions.clear();
+        m_FunctionDefinitions.clear();
         m_Objects.clear();
     }
 
@@ -0,0 +1,345 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Offline SPIR-V compiler for shader permutations.
+//
+// Usage:
+//
+//     Diligent-ShaderBatchCompiler [-I <dir;dir...>] [-o <output dir>] [-j <threads>] [--spirv 1.0|1.4|1.5] <manifest>
+//
+// Every non-empty line of the manifest that does not start with '#' describes one permutation:
+//
+//     <source file> <stage> <entry point> <output file> [NAME=VALUE ...]
+//
+// where stage is one of vs, ps, gs, hs, ds, cs, as, ms. Files with .glsl, .vert, .frag, .geom,
+// .tesc, .tese and .comp extensions are compiled as verbatim GLSL, all others as HLSL.
+// The output files contain SPIR-V bytecode that can be passed to IRenderDevice::CreateShader()
+// through ShaderCreateInfo::ByteCode.
+//
+// Permutations are compiled in parallel on all cores with enkiTS. glslang is initialized once
+// per process and keeps its parser state in thread-local pools, so every worker thread has its
+// own compiler state.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TaskScheduler.h"
+
+#include "GLSLangUtils.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlob.h"
+#include "DebugOutput.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct Permutation
+{
+    std::string              SourceFile;
+    SHADER_TYPE              ShaderType = SHADER_TYPE_UNKNOWN;
+    std::string              EntryPoint;
+    std::string              OutputFile;
+    std::vector<std::string> MacroStrings; // Name and definition pairs
+    std::vector<ShaderMacro> Macros;
+    SHADER_SOURCE_LANGUAGE   Language = SHADER_SOURCE_LANGUAGE_HLSL;
+    std::string              Log;
+    bool                     Succeeded = false;
+};
+
+SHADER_TYPE ParseShaderStage(const std::string& Stage)
+{
+    // clang-format off
+    if (Stage == "vs") return SHADER_TYPE_VERTEX;
+    if (Stage == "ps") return SHADER_TYPE_PIXEL;
+    if (Stage == "gs") return SHADER_TYPE_GEOMETRY;
+    if (Stage == "hs") return SHADER_TYPE_HULL;
+    if (Stage == "ds") return SHADER_TYPE_DOMAIN;
+    if (Stage == "cs") return SHADER_TYPE_COMPUTE;
+    if (Stage == "as") return SHADER_TYPE_AMPLIFICATION;
+    if (Stage == "ms") return SHADER_TYPE_MESH;
+    // clang-format on
+    return SHADER_TYPE_UNKNOWN;
+}
+
+bool IsGLSLFile(const std::string& Path)
+{
+    static const char* const GLSLExtensions[] = {".glsl", ".vert", ".frag", ".geom", ".tesc", ".tese", ".comp"};
+
+    const auto Dot = Path.find_last_of('.');
+    if (Dot == std::string::npos)
+        return false;
+
+    const auto Ext = Path.substr(Dot);
+    for (const auto* GLSLExt : GLSLExtensions)
+    {
+        if (Ext == GLSLExt)
+            return true;
+    }
+    return false;
+}
+
+bool ParseManifest(const char* ManifestPath, std::vector<Permutation>& Permutations)
+{
+    std::ifstream Manifest{ManifestPath};
+    if (!Manifest)
+    {
+        std::cerr << "Failed to open manifest file '" << ManifestPath << "'\n";
+        return false;
+    }
+
+    std::string Line;
+    for (int LineNum = 1; std::getline(Manifest, Line); ++LineNum)
+    {
+        std::istringstream Tokens{Line};
+
+        Permutation Perm;
+        std::string Stage;
+        if (!(Tokens >> Perm.SourceFile) || Perm.SourceFile[0] == '#')
+            continue;
+
+        if (!(Tokens >> Stage >> Perm.EntryPoint >> Perm.OutputFile))
+        {
+            std::cerr << ManifestPath << '(' << LineNum << "): expected <source file> <stage> <entry point> <output file>\n";
+            return false;
+        }
+
+        Perm.ShaderType = ParseShaderStage(Stage);
+        if (Perm.ShaderType == SHADER_TYPE_UNKNOWN)
+        {
+            std::cerr << ManifestPath << '(' << LineNum << "): unknown shader stage '" << Stage << "'\n";
+            return false;
+        }
+
+        std::string Macro;
+        while (Tokens >> Macro)
+        {
+            const auto Eq = Macro.find('=');
+            Perm.MacroStrings.emplace_back(Macro.substr(0, Eq));
+            Perm.MacroStrings.emplace_back(Eq != std::string::npos ? Macro.substr(Eq + 1) : "1");
+        }
+
+        Perm.Language = IsGLSLFile(Perm.SourceFile) ? SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM : SHADER_SOURCE_LANGUAGE_HLSL;
+        Permutations.emplace_back(std::move(Perm));
+    }
+
+    // Macro pointers are set up after all permutations are in place, so that they are not invalidated by moves
+    for (auto& Perm : Permutations)
+    {
+        for (size_t m = 0; m < Perm.MacroStrings.size(); m += 2)
+            Perm.Macros.emplace_back(Perm.MacroStrings[m].c_str(), Perm.MacroStrings[m + 1].c_str());
+        Perm.Macros.emplace_back(nullptr, nullptr);
+    }
+
+    return true;
+}
+
+void CompilePermutation(Permutation&                     Perm,
+                        IShaderSourceInputStreamFactory* pStreamFactory,
+                        GLSLangUtils::SpirvVersion       SpvVersion)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = Perm.SourceFile.c_str();
+    ShaderCI.pShaderSourceStreamFactory = pStreamFactory;
+    ShaderCI.EntryPoint                 = Perm.EntryPoint.c_str();
+    ShaderCI.Macros                     = Perm.Macros.data();
+    ShaderCI.Desc.Name                  = Perm.OutputFile.c_str();
+    ShaderCI.Desc.ShaderType            = Perm.ShaderType;
+    ShaderCI.SourceLanguage             = Perm.Language;
+
+    RefCntAutoPtr<IDataBlob>  pCompilerOutput;
+    std::vector<unsigned int> SPIRV;
+    try
+    {
+        if (Perm.Language == SHADER_SOURCE_LANGUAGE_HLSL)
+        {
+            SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, SpvVersion, &pCompilerOutput);
+        }
+        else
+        {
+            RefCntAutoPtr<IDataBlob> pSourceData;
+            size_t                   SourceLength = 0;
+
+            const auto* Source = ReadShaderSourceFile(nullptr, pStreamFactory, ShaderCI.FilePath, pSourceData, SourceLength);
+            SPIRV              = GLSLangUtils::GLSLtoSPIRV(Perm.ShaderType, Source, static_cast<int>(SourceLength), ShaderCI.Macros,
+                                                           pStreamFactory, SpvVersion, &pCompilerOutput);
+        }
+    }
+    catch (const std::exception& Err)
+    {
+        Perm.Log = Err.what();
+        return;
+    }
+
+    if (pCompilerOutput)
+    {
+        const auto* Msg = static_cast<const char*>(pCompilerOutput->GetConstDataPtr());
+        Perm.Log.assign(Msg, strnlen(Msg, pCompilerOutput->GetSize()));
+    }
+
+    if (SPIRV.empty())
+        return;
+
+    std::ofstream Output{Perm.OutputFile, std::ios::binary};
+    if (!Output.write(reinterpret_cast<const char*>(SPIRV.data()), SPIRV.size() * sizeof(SPIRV[0])))
+    {
+        Perm.Log += "Failed to write output file '" + Perm.OutputFile + "'\n";
+        return;
+    }
+
+    Perm.Succeeded = true;
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: Diligent-ShaderBatchCompiler [-I <dir;dir...>] [-o <output dir>] [-j <threads>] [--spirv 1.0|1.4|1.5] <manifest>\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string SearchDirectories;
+    std::string OutputDir;
+    std::string SpirvVersionStr = "1.0";
+    Uint32      NumThreads      = 0;
+    const char* ManifestPath    = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg = argv[i];
+        if ((strcmp(Arg, "-I") == 0 || strcmp(Arg, "-o") == 0 || strcmp(Arg, "-j") == 0 || strcmp(Arg, "--spirv") == 0) && i + 1 < argc)
+        {
+            const char* Val = argv[++i];
+            if (Arg[1] == 'I')
+                SearchDirectories += (SearchDirectories.empty() ? "" : ";") + std::string{Val};
+            else if (Arg[1] == 'o')
+                OutputDir = Val;
+            else if (Arg[1] == 'j')
+                NumThreads = static_cast<Uint32>(atoi(Val));
+            else
+                SpirvVersionStr = Val;
+        }
+        else if (Arg[0] != '-' && ManifestPath == nullptr)
+        {
+            ManifestPath = Arg;
+        }
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (ManifestPath == nullptr)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    GLSLangUtils::SpirvVersion SpvVersion = GLSLangUtils::SpirvVersion::Vk100;
+    if (SpirvVersionStr == "1.4")
+        SpvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
+    else if (SpirvVersionStr == "1.5")
+        SpvVersion = GLSLangUtils::SpirvVersion::Vk120;
+    else if (SpirvVersionStr != "1.0")
+    {
+        std::cerr << "Unsupported SPIR-V version '" << SpirvVersionStr << "'\n";
+        return -1;
+    }
+
+    std::vector<Permutation> Permutations;
+    if (!ParseManifest(ManifestPath, Permutations))
+        return -1;
+
+    if (Permutations.empty())
+    {
+        std::cout << "Manifest '" << ManifestPath << "' contains no shader permutations\n";
+        return 0;
+    }
+
+    if (!OutputDir.empty())
+    {
+        if (OutputDir.back() != '/' && OutputDir.back() != '\\')
+            OutputDir.push_back('/');
+        for (auto& Perm : Permutations)
+            Perm.OutputFile = OutputDir + Perm.OutputFile;
+    }
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+    CreateDefaultShaderSourceStreamFactory(SearchDirectories.c_str(), &pStreamFactory);
+
+    GLSLangUtils::InitializeGlslang();
+
+    enki::TaskScheduler Scheduler;
+    if (NumThreads != 0)
+        Scheduler.Initialize(NumThreads);
+    else
+        Scheduler.Initialize();
+
+    // One permutation per partition: compile times vary a lot, so fine-grained
+    // tasks keep all workers busy until the very end.
+    enki::TaskSet CompileTask{
+        static_cast<uint32_t>(Permutations.size()),
+        [&](enki::TaskSetPartition Range, uint32_t /*ThreadNum*/) {
+            for (auto p = Range.start; p < Range.end; ++p)
+                CompilePermutation(Permutations[p], pStreamFactory, SpvVersion);
+        } //
+    };
+    CompileTask.m_MinRange = 1;
+
+    Scheduler.AddTaskSetToPipe(&CompileTask);
+    Scheduler.WaitforTask(&CompileTask);
+    Scheduler.WaitforAllAndShutdown();
+
+    GLSLangUtils::FinalizeGlslang();
+
+    Uint32 NumFailed = 0;
+    for (const auto& Perm : Permutations)
+    {
+        if (!Perm.Succeeded)
+        {
+            ++NumFailed;
+            std::cerr << "Failed to compile " << Perm.SourceFile << " (" << Perm.EntryPoint << ") -> " << Perm.OutputFile << '\n';
+        }
+        if (!Perm.Log.empty())
+            std::cerr << Perm.Log << '\n';
+    }
+
+    std::cout << Permutations.size() - NumFailed << " of " << Permutations.size() << " shader permutations compiled\n";
+
+    return NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,795 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Offline pipeline state baker.
+//
+// Usage:
+//
+//     Diligent-PipelineBaker [-I <dir;dir...>] [-j <threads>] [--spirv 1.0|1.4|1.5] <manifest> <archive>
+//
+// The manifest is a JSON file that lists pipeline states. Member names follow the engine structures:
+//
+//     {
+//         "Pipelines": [
+//             {
+//                 "Name": "Mesh",
+//                 "PipelineType": "PIPELINE_TYPE_GRAPHICS",
+//                 "Shaders": {
+//                     "VS": {"FilePath": "Mesh.vsh", "EntryPoint": "main", "Macros": {"SKINNED": 1}},
+//                     "PS": {"FilePath": "Mesh.psh", "UseCombinedTextureSamplers": true}
+//                 },
+//                 "GraphicsPipeline": {
+//                     "RTVFormats": ["TEX_FORMAT_RGBA8_UNORM_SRGB"],
+//                     "DSVFormat": "TEX_FORMAT_D32_FLOAT",
+//                     "PrimitiveTopology": "PRIMITIVE_TOPOLOGY_TRIANGLE_LIST",
+//                     "RasterizerDesc": {"CullMode": "CULL_MODE_BACK"},
+//                     "DepthStencilDesc": {"DepthFunc": "COMPARISON_FUNC_LESS_EQUAL"},
+//                     "BlendDesc": {"RenderTargets": [{"BlendEnable": false}]},
+//                     "InputLayout": [{"InputIndex": 0, "NumComponents": 3, "ValueType": "VT_FLOAT32", "IsNormalized": false}]
+//                 },
+//                 "ResourceLayout": {
+//                     "DefaultVariableType": "SHADER_RESOURCE_VARIABLE_TYPE_STATIC",
+//                     "Variables": [{"ShaderStages": ["PS"], "Name": "g_Texture", "Type": "SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE"}],
+//                     "ImmutableSamplers": [{"ShaderStages": ["PS"], "SamplerOrTextureName": "g_Texture", "Desc": {"AddressU": "TEXTURE_ADDRESS_WRAP"}}]
+//                 }
+//             }
+//         ]
+//     }
+//
+// Shader stages are VS, PS, GS, HS, DS, AS, MS and CS. Files with .glsl, .vert, .frag, .geom, .tesc,
+// .tese and .comp extensions are compiled as verbatim GLSL, all others as HLSL. Shaders that are used
+// by several pipelines with the same parameters are compiled and stored once.
+//
+// Every shader, HLSL or GLSL, is compiled to the SPIR-V version selected with --spirv on all cores
+// with enkiTS (glslang output is optimized by GLSLangUtils) and reflected to check that the
+// resource layout of the pipeline refers to existing resources. The archive is loaded at run time with Diligent::PipelineArchive, which
+// creates all pipelines from the bytecode without compiling any source code.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TaskScheduler.h"
+#include "json.hpp"
+
+#include "GLSLangUtils.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "SPIRVShaderResources.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "GraphicsAccessories.hpp"
+#include "EngineMemory.h"
+#include "PipelineArchive.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlob.h"
+
+using namespace Diligent;
+using json = nlohmann::json;
+
+namespace
+{
+
+struct ShaderJob
+{
+    std::string              FilePath;
+    SHADER_TYPE              ShaderType = SHADER_TYPE_UNKNOWN;
+    std::string              EntryPoint = "main";
+    std::vector<std::string> MacroStrings; // Name and definition pairs
+    std::vector<ShaderMacro> Macros;
+    SHADER_SOURCE_LANGUAGE   Language = SHADER_SOURCE_LANGUAGE_HLSL;
+
+    bool        UseCombinedTextureSamplers = false;
+    std::string CombinedSamplerSuffix      = "_sampler";
+
+    std::string         Name;
+    std::vector<Uint32> SPIRV;
+    std::string         Log;
+
+    std::unique_ptr<SPIRVShaderResources> pResources;
+};
+
+struct ShaderStageInfo
+{
+    const char* Name;
+    SHADER_TYPE Type;
+};
+
+// clang-format off
+constexpr ShaderStageInfo ShaderStages[] =
+{
+    {"VS", SHADER_TYPE_VERTEX},
+    {"PS", SHADER_TYPE_PIXEL},
+    {"GS", SHADER_TYPE_GEOMETRY},
+    {"HS", SHADER_TYPE_HULL},
+    {"DS", SHADER_TYPE_DOMAIN},
+    {"AS", SHADER_TYPE_AMPLIFICATION},
+    {"MS", SHADER_TYPE_MESH},
+    {"CS", SHADER_TYPE_COMPUTE}
+};
+// clang-format on
+
+SHADER_TYPE ParseShaderStage(const std::string& Stage)
+{
+    for (const auto& Info : ShaderStages)
+    {
+        if (Stage == Info.Name)
+            return Info.Type;
+    }
+    throw std::runtime_error("unknown shader stage '" + Stage + "'");
+}
+
+SHADER_TYPE ParseShaderStages(const json& Stages)
+{
+    if (Stages.is_string())
+        return ParseShaderStage(Stages.get<std::string>());
+
+    Uint32 Flags = SHADER_TYPE_UNKNOWN;
+    for (const auto& Stage : Stages)
+        Flags |= ParseShaderStage(Stage.get<std::string>());
+    return static_cast<SHADER_TYPE>(Flags);
+}
+
+bool IsGLSLFile(const std::string& Path)
+{
+    static const char* const GLSLExtensions[] = {".glsl", ".vert", ".frag", ".geom", ".tesc", ".tese", ".comp"};
+
+    const auto Dot = Path.find_last_of('.');
+    if (Dot == std::string::npos)
+        return false;
+
+    const auto Ext = Path.substr(Dot);
+    for (const auto* GLSLExt : GLSLExtensions)
+    {
+        if (Ext == GLSLExt)
+            return true;
+    }
+    return false;
+}
+
+// Enum values are spelled as in C++, e.g. "TEX_FORMAT_RGBA8_UNORM", and are
+// looked up through the literal names provided by the graphics accessories
+template <typename EnumType, typename NameFuncType>
+EnumType ParseEnum(const json& Val, const char* Member, EnumType NumValues, NameFuncType GetName)
+{
+    const auto Str = Val.get<std::string>();
+    for (Uint32 v = 0; v < static_cast<Uint32>(NumValues); ++v)
+    {
+        if (Str == GetName(static_cast<EnumType>(v)))
+            return static_cast<EnumType>(v);
+    }
+    throw std::runtime_error(std::string{"unknown "} + Member + " value '" + Str + "'");
+}
+
+template <typename EnumType, typename NameFuncType>
+void ReadEnum(const json& Obj, const char* Member, EnumType NumValues, NameFuncType GetName, EnumType& Val)
+{
+    auto it = Obj.find(Member);
+    if (it != Obj.end())
+        Val = ParseEnum(*it, Member, NumValues, GetName);
+}
+
+template <typename T>
+void ReadValue(const json& Obj, const char* Member, T& Val)
+{
+    auto it = Obj.find(Member);
+    if (it != Obj.end())
+        Val = it->template get<T>();
+}
+
+// clang-format off
+const char* GetTexFormatName     (TEXTURE_FORMAT Fmt)                { return GetTextureFormatAttribs(Fmt).Name; }
+const char* GetComparisonFuncName(COMPARISON_FUNCTION Func)          { return GetComparisonFunctionLiteralName(Func, true); }
+const char* GetFilterTypeName    (FILTER_TYPE Filter)                { return GetFilterTypeLiteralName(Filter, true); }
+const char* GetAddressModeName   (TEXTURE_ADDRESS_MODE Mode)         { return GetTextureAddressModeLiteralName(Mode, true); }
+const char* GetVariableTypeName  (SHADER_RESOURCE_VARIABLE_TYPE Type){ return GetShaderVariableTypeLiteralName(Type, true); }
+// clang-format on
+
+const char* GetPrimitiveTopologyName(PRIMITIVE_TOPOLOGY Topology)
+{
+    static std::vector<std::string> Names;
+    if (Names.empty())
+    {
+        Names.resize(PRIMITIVE_TOPOLOGY_NUM_TOPOLOGIES);
+        // clang-format off
+        Names[PRIMITIVE_TOPOLOGY_UNDEFINED]      = "PRIMITIVE_TOPOLOGY_UNDEFINED";
+        Names[PRIMITIVE_TOPOLOGY_TRIANGLE_LIST]  = "PRIMITIVE_TOPOLOGY_TRIANGLE_LIST";
+        Names[PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP] = "PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP";
+        Names[PRIMITIVE_TOPOLOGY_POINT_LIST]     = "PRIMITIVE_TOPOLOGY_POINT_LIST";
+        Names[PRIMITIVE_TOPOLOGY_LINE_LIST]      = "PRIMITIVE_TOPOLOGY_LINE_LIST";
+        Names[PRIMITIVE_TOPOLOGY_LINE_STRIP]     = "PRIMITIVE_TOPOLOGY_LINE_STRIP";
+        // clang-format on
+        for (Uint32 n = 1; n <= 32; ++n)
+            Names[PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST + n - 1] = "PRIMITIVE_TOPOLOGY_" + std::to_string(n) + "_CONTROL_POINT_PATCHLIST";
+    }
+    return Names[Topology].c_str();
+}
+
+const char* GetPipelineTypeName(PIPELINE_TYPE Type)
+{
+    switch (Type)
+    {
+        // clang-format off
+        case PIPELINE_TYPE_GRAPHICS:    return "PIPELINE_TYPE_GRAPHICS";
+        case PIPELINE_TYPE_COMPUTE:     return "PIPELINE_TYPE_COMPUTE";
+        case PIPELINE_TYPE_MESH:        return "PIPELINE_TYPE_MESH";
+        case PIPELINE_TYPE_RAY_TRACING: return "PIPELINE_TYPE_RAY_TRACING";
+        // clang-format on
+        default: return "";
+    }
+}
+
+const char* GetFrequencyName(INPUT_ELEMENT_FREQUENCY Frequency)
+{
+    switch (Frequency)
+    {
+        // clang-format off
+        case INPUT_ELEMENT_FREQUENCY_UNDEFINED:    return "INPUT_ELEMENT_FREQUENCY_UNDEFINED";
+        case INPUT_ELEMENT_FREQUENCY_PER_VERTEX:   return "INPUT_ELEMENT_FREQUENCY_PER_VERTEX";
+        case INPUT_ELEMENT_FREQUENCY_PER_INSTANCE: return "INPUT_ELEMENT_FREQUENCY_PER_INSTANCE";
+        // clang-format on
+        default: return "";
+    }
+}
+
+void ParseStencilOp(const json& Obj, StencilOpDesc& Desc)
+{
+    ReadEnum(Obj, "StencilFailOp", STENCIL_OP_NUM_OPS, GetStencilOpLiteralName, Desc.StencilFailOp);
+    ReadEnum(Obj, "StencilDepthFailOp", STENCIL_OP_NUM_OPS, GetStencilOpLiteralName, Desc.StencilDepthFailOp);
+    ReadEnum(Obj, "StencilPassOp", STENCIL_OP_NUM_OPS, GetStencilOpLiteralName, Desc.StencilPassOp);
+    ReadEnum(Obj, "StencilFunc", COMPARISON_FUNC_NUM_FUNCTIONS, GetComparisonFuncName, Desc.StencilFunc);
+}
+
+void ParseGraphicsPipeline(const json& Obj, PipelineArchive::PipelineData& Pipeline)
+{
+    auto& GraphicsPipeline = Pipeline.GraphicsPipeline;
+
+    auto RTVFormats = Obj.find("RTVFormats");
+    if (RTVFormats != Obj.end())
+    {
+        if (RTVFormats->size() > _countof(GraphicsPipeline.RTVFormats))
+            throw std::runtime_error("too many render targets");
+
+        GraphicsPipeline.NumRenderTargets = static_cast<Uint8>(RTVFormats->size());
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            GraphicsPipeline.RTVFormats[rt] = ParseEnum((*RTVFormats)[rt], "RTVFormats", TEX_FORMAT_NUM_FORMATS, GetTexFormatName);
+    }
+    ReadEnum(Obj, "DSVFormat", TEX_FORMAT_NUM_FORMATS, GetTexFormatName, GraphicsPipeline.DSVFormat);
+    ReadEnum(Obj, "PrimitiveTopology", PRIMITIVE_TOPOLOGY_NUM_TOPOLOGIES, GetPrimitiveTopologyName, GraphicsPipeline.PrimitiveTopology);
+    ReadValue(Obj, "SampleMask", GraphicsPipeline.SampleMask);
+    ReadValue(Obj, "NumViewports", GraphicsPipeline.NumViewports);
+    ReadValue(Obj, "NodeMask", GraphicsPipeline.NodeMask);
+
+    auto SmplDesc = Obj.find("SmplDesc");
+    if (SmplDesc != Obj.end())
+    {
+        ReadValue(*SmplDesc, "Count", GraphicsPipeline.SmplDesc.Count);
+        ReadValue(*SmplDesc, "Quality", GraphicsPipeline.SmplDesc.Quality);
+    }
+
+    auto RasterizerDesc = Obj.find("RasterizerDesc");
+    if (RasterizerDesc != Obj.end())
+    {
+        auto& Desc = GraphicsPipeline.RasterizerDesc;
+        ReadEnum(*RasterizerDesc, "FillMode", FILL_MODE_NUM_MODES, GetFillModeLiteralName, Desc.FillMode);
+        ReadEnum(*RasterizerDesc, "CullMode", CULL_MODE_NUM_MODES, GetCullModeLiteralName, Desc.CullMode);
+        ReadValue(*RasterizerDesc, "FrontCounterClockwise", Desc.FrontCounterClockwise);
+        ReadValue(*RasterizerDesc, "DepthClipEnable", Desc.DepthClipEnable);
+        ReadValue(*RasterizerDesc, "ScissorEnable", Desc.ScissorEnable);
+        ReadValue(*RasterizerDesc, "AntialiasedLineEnable", Desc.AntialiasedLineEnable);
+        ReadValue(*RasterizerDesc, "DepthBias", Desc.DepthBias);
+        ReadValue(*RasterizerDesc, "DepthBiasClamp", Desc.DepthBiasClamp);
+        ReadValue(*RasterizerDesc, "SlopeScaledDepthBias", Desc.SlopeScaledDepthBias);
+    }
+
+    auto DepthStencilDesc = Obj.find("DepthStencilDesc");
+    if (DepthStencilDesc != Obj.end())
+    {
+        auto& Desc = GraphicsPipeline.DepthStencilDesc;
+        ReadValue(*DepthStencilDesc, "DepthEnable", Desc.DepthEnable);
+        ReadValue(*DepthStencilDesc, "DepthWriteEnable", Desc.DepthWriteEnable);
+        ReadEnum(*DepthStencilDesc, "DepthFunc", COMPARISON_FUNC_NUM_FUNCTIONS, GetComparisonFuncName, Desc.DepthFunc);
+        ReadValue(*DepthStencilDesc, "StencilEnable", Desc.StencilEnable);
+        ReadValue(*DepthStencilDesc, "StencilReadMask", Desc.StencilReadMask);
+        ReadValue(*DepthStencilDesc, "StencilWriteMask", Desc.StencilWriteMask);
+        if (DepthStencilDesc->contains("FrontFace"))
+            ParseStencilOp((*DepthStencilDesc)["FrontFace"], Desc.FrontFace);
+        if (DepthStencilDesc->contains("BackFace"))
+            ParseStencilOp((*DepthStencilDesc)["BackFace"], Desc.BackFace);
+    }
+
+    auto BlendDesc = Obj.find("BlendDesc");
+    if (BlendDesc != Obj.end())
+    {
+        auto& Desc = GraphicsPipeline.BlendDesc;
+        ReadValue(*BlendDesc, "AlphaToCoverageEnable", Desc.AlphaToCoverageEnable);
+        ReadValue(*BlendDesc, "IndependentBlendEnable", Desc.IndependentBlendEnable);
+
+        auto RenderTargets = BlendDesc->find("RenderTargets");
+        if (RenderTargets != BlendDesc->end())
+        {
+            if (RenderTargets->size() > _countof(Desc.RenderTargets))
+                throw std::runtime_error("too many render target blend states");
+
+            for (size_t rt = 0; rt < RenderTargets->size(); ++rt)
+            {
+                const auto& RTObj = (*RenderTargets)[rt];
+                auto&       RT    = Desc.RenderTargets[rt];
+                ReadValue(RTObj, "BlendEnable", RT.BlendEnable);
+                ReadEnum(RTObj, "SrcBlend", BLEND_FACTOR_NUM_FACTORS, GetBlendFactorLiteralName, RT.SrcBlend);
+                ReadEnum(RTObj, "DestBlend", BLEND_FACTOR_NUM_FACTORS, GetBlendFactorLiteralName, RT.DestBlend);
+                ReadEnum(RTObj, "BlendOp", BLEND_OPERATION_NUM_OPERATIONS, GetBlendOperationLiteralName, RT.BlendOp);
+                ReadEnum(RTObj, "SrcBlendAlpha", BLEND_FACTOR_NUM_FACTORS, GetBlendFactorLiteralName, RT.SrcBlendAlpha);
+                ReadEnum(RTObj, "DestBlendAlpha", BLEND_FACTOR_NUM_FACTORS, GetBlendFactorLiteralName, RT.DestBlendAlpha);
+                ReadEnum(RTObj, "BlendOpAlpha", BLEND_OPERATION_NUM_OPERATIONS, GetBlendOperationLiteralName, RT.BlendOpAlpha);
+                ReadValue(RTObj, "RenderTargetWriteMask", RT.RenderTargetWriteMask);
+            }
+        }
+    }
+
+    auto InputLayout = Obj.find("InputLayout");
+    if (InputLayout != Obj.end())
+    {
+        for (const auto& ElemObj : *InputLayout)
+        {
+            PipelineArchive::LayoutElementData Elem;
+            Elem.HLSLSemantic = Elem.Element.HLSLSemantic;
+            ReadValue(ElemObj, "HLSLSemantic", Elem.HLSLSemantic);
+            ReadValue(ElemObj, "InputIndex", Elem.Element.InputIndex);
+            ReadValue(ElemObj, "BufferSlot", Elem.Element.BufferSlot);
+            ReadValue(ElemObj, "NumComponents", Elem.Element.NumComponents);
+            ReadEnum(ElemObj, "ValueType", VT_NUM_TYPES, GetValueTypeString, Elem.Element.ValueType);
+            ReadValue(ElemObj, "IsNormalized", Elem.Element.IsNormalized);
+            ReadValue(ElemObj, "RelativeOffset", Elem.Element.RelativeOffset);
+            ReadValue(ElemObj, "Stride", Elem.Element.Stride);
+            ReadEnum(ElemObj, "Frequency", INPUT_ELEMENT_FREQUENCY_NUM_FREQUENCIES, GetFrequencyName, Elem.Element.Frequency);
+            ReadValue(ElemObj, "InstanceDataStepRate", Elem.Element.InstanceDataStepRate);
+            Pipeline.InputLayout.emplace_back(std::move(Elem));
+        }
+    }
+}
+
+void ParseResourceLayout(const json& Obj, PipelineArchive::PipelineData& Pipeline)
+{
+    ReadEnum(Obj, "DefaultVariableType", SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES, GetVariableTypeName, Pipeline.DefaultVariableType);
+
+    auto Variables = Obj.find("Variables");
+    if (Variables != Obj.end())
+    {
+        for (const auto& VarObj : *Variables)
+        {
+            PipelineArchive::VariableData Var;
+            Var.ShaderStages = ParseShaderStages(VarObj.at("ShaderStages"));
+            Var.Name         = VarObj.at("Name").get<std::string>();
+            ReadEnum(VarObj, "Type", SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES, GetVariableTypeName, Var.Type);
+            Pipeline.Variables.emplace_back(std::move(Var));
+        }
+    }
+
+    auto ImmutableSamplers = Obj.find("ImmutableSamplers");
+    if (ImmutableSamplers != Obj.end())
+    {
+        for (const auto& SamplerObj : *ImmutableSamplers)
+        {
+            PipelineArchive::ImmutableSamplerData Sampler;
+            Sampler.ShaderStages         = ParseShaderStages(SamplerObj.at("ShaderStages"));
+            Sampler.SamplerOrTextureName = SamplerObj.at("SamplerOrTextureName").get<std::string>();
+
+            auto DescObj = SamplerObj.find("Desc");
+            if (DescObj != SamplerObj.end())
+            {
+                auto& Desc = Sampler.Desc;
+                ReadEnum(*DescObj, "MinFilter", FILTER_TYPE_NUM_FILTERS, GetFilterTypeName, Desc.MinFilter);
+                ReadEnum(*DescObj, "MagFilter", FILTER_TYPE_NUM_FILTERS, GetFilterTypeName, Desc.MagFilter);
+                ReadEnum(*DescObj, "MipFilter", FILTER_TYPE_NUM_FILTERS, GetFilterTypeName, Desc.MipFilter);
+                ReadEnum(*DescObj, "AddressU", TEXTURE_ADDRESS_NUM_MODES, GetAddressModeName, Desc.AddressU);
+                ReadEnum(*DescObj, "AddressV", TEXTURE_ADDRESS_NUM_MODES, GetAddressModeName, Desc.AddressV);
+                ReadEnum(*DescObj, "AddressW", TEXTURE_ADDRESS_NUM_MODES, GetAddressModeName, Desc.AddressW);
+                ReadValue(*DescObj, "MipLODBias", Desc.MipLODBias);
+                ReadValue(*DescObj, "MaxAnisotropy", Desc.MaxAnisotropy);
+                ReadEnum(*DescObj, "ComparisonFunc", COMPARISON_FUNC_NUM_FUNCTIONS, GetComparisonFuncName, Desc.ComparisonFunc);
+                ReadValue(*DescObj, "MinLOD", Desc.MinLOD);
+                ReadValue(*DescObj, "MaxLOD", Desc.MaxLOD);
+
+                auto BorderColor = DescObj->find("BorderColor");
+                if (BorderColor != DescObj->end())
+                {
+                    for (size_t c = 0; c < BorderColor->size() && c < _countof(Desc.BorderColor); ++c)
+                        Desc.BorderColor[c] = (*BorderColor)[c].get<Float32>();
+                }
+            }
+            Pipeline.ImmutableSamplers.emplace_back(std::move(Sampler));
+        }
+    }
+}
+
+// Returns the index of the shader job, adding a new job if no pipeline has used the same shader before
+Uint32 AddShaderJob(const json& ShaderObj, SHADER_TYPE ShaderType, std::vector<ShaderJob>& Jobs, std::unordered_map<std::string, Uint32>& JobIndices)
+{
+    // Objects are stored with sorted keys, so identical shaders produce identical strings
+    auto Key = ShaderObj.dump() + GetShaderTypeLiteralName(ShaderType);
+
+    auto it = JobIndices.find(Key);
+    if (it != JobIndices.end())
+        return it->second;
+
+    ShaderJob Job;
+    Job.ShaderType = ShaderType;
+    Job.FilePath   = ShaderObj.at("FilePath").get<std::string>();
+    ReadValue(ShaderObj, "EntryPoint", Job.EntryPoint);
+    ReadValue(ShaderObj, "UseCombinedTextureSamplers", Job.UseCombinedTextureSamplers);
+    ReadValue(ShaderObj, "CombinedSamplerSuffix", Job.CombinedSamplerSuffix);
+
+    auto Macros = ShaderObj.find("Macros");
+    if (Macros != ShaderObj.end())
+    {
+        for (auto Macro = Macros->begin(); Macro != Macros->end(); ++Macro)
+        {
+            Job.MacroStrings.emplace_back(Macro.key());
+            Job.MacroStrings.emplace_back(Macro->is_string() ? Macro->get<std::string>() : Macro->dump());
+        }
+    }
+
+    Job.Language = IsGLSLFile(Job.FilePath) ? SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM : SHADER_SOURCE_LANGUAGE_HLSL;
+    Job.Name     = Job.FilePath + " (" + Job.EntryPoint + ")";
+
+    const auto Index = static_cast<Uint32>(Jobs.size());
+    Jobs.emplace_back(std::move(Job));
+    JobIndices.emplace(std::move(Key), Index);
+    return Index;
+}
+
+void ParseManifest(const char* ManifestPath, std::vector<ShaderJob>& Jobs, std::vector<PipelineArchive::PipelineData>& Pipelines)
+{
+    std::ifstream ManifestFile{ManifestPath};
+    if (!ManifestFile)
+        throw std::runtime_error(std::string{"failed to open manifest file '"} + ManifestPath + "'");
+
+    json Manifest;
+    ManifestFile >> Manifest;
+
+    std::unordered_map<std::string, Uint32> JobIndices;
+    for (const auto& PipelineObj : Manifest.at("Pipelines"))
+    {
+        PipelineArchive::PipelineData Pipeline;
+        Pipeline.Name = PipelineObj.at("Name").get<std::string>();
+        try
+        {
+            ReadEnum(PipelineObj, "PipelineType", PIPELINE_TYPE_RAY_TRACING, GetPipelineTypeName, Pipeline.PipelineType);
+
+            for (auto Shader = PipelineObj.at("Shaders").begin(); Shader != PipelineObj.at("Shaders").end(); ++Shader)
+            {
+                const auto Stage = ParseShaderStage(Shader.key());
+                Pipeline.Shaders.push_back({Stage, AddShaderJob(*Shader, Stage, Jobs, JobIndices)});
+            }
+
+            Uint32 Stages = SHADER_TYPE_UNKNOWN;
+            for (const auto& Shader : Pipeline.Shaders)
+                Stages |= Shader.Stage;
+
+            if (Pipeline.PipelineType == PIPELINE_TYPE_COMPUTE && Stages != SHADER_TYPE_COMPUTE)
+                throw std::runtime_error("compute pipeline must have a single CS shader");
+            if (Pipeline.PipelineType == PIPELINE_TYPE_GRAPHICS && (Stages & SHADER_TYPE_VERTEX) == 0)
+                throw std::runtime_error("graphics pipeline must have a VS shader");
+            if (Pipeline.PipelineType == PIPELINE_TYPE_MESH && (Stages & SHADER_TYPE_MESH) == 0)
+                throw std::runtime_error("mesh pipeline must have a MS shader");
+
+            if (PipelineObj.contains("GraphicsPipeline"))
+                ParseGraphicsPipeline(PipelineObj["GraphicsPipeline"], Pipeline);
+            if (PipelineObj.contains("ResourceLayout"))
+                ParseResourceLayout(PipelineObj["ResourceLayout"], Pipeline);
+        }
+        catch (const std::exception& Err)
+        {
+            throw std::runtime_error("pipeline '" + Pipeline.Name + "': " + Err.what());
+        }
+        Pipelines.emplace_back(std::move(Pipeline));
+    }
+
+    // Macro pointers are set up after all jobs are in place, so that they are not invalidated by moves
+    for (auto& Job : Jobs)
+    {
+        for (size_t m = 0; m < Job.MacroStrings.size(); m += 2)
+            Job.Macros.emplace_back(Job.MacroStrings[m].c_str(), Job.MacroStrings[m + 1].c_str());
+        Job.Macros.emplace_back(nullptr, nullptr);
+    }
+}
+
+void CompileShader(ShaderJob&                       Job,
+                   IShaderSourceInputStreamFactory* pStreamFactory,
+                   GLSLangUtils::SpirvVersion       SpvVersion)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = Job.FilePath.c_str();
+    ShaderCI.pShaderSourceStreamFactory = pStreamFactory;
+    ShaderCI.EntryPoint                 = Job.EntryPoint.c_str();
+    ShaderCI.Macros                     = Job.Macros.data();
+    ShaderCI.Desc.Name                  = Job.Name.c_str();
+    ShaderCI.Desc.ShaderType            = Job.ShaderType;
+    ShaderCI.SourceLanguage             = Job.Language;
+
+    RefCntAutoPtr<IDataBlob> pCompilerOutput;
+    try
+    {
+        if (Job.Language == SHADER_SOURCE_LANGUAGE_HLSL)
+        {
+            Job.SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, SpvVersion, &pCompilerOutput);
+        }
+        else
+        {
+            RefCntAutoPtr<IDataBlob> pSourceData;
+            size_t                   SourceLength = 0;
+
+            const auto* Source = ReadShaderSourceFile(nullptr, pStreamFactory, ShaderCI.FilePath, pSourceData, SourceLength);
+            Job.SPIRV          = GLSLangUtils::GLSLtoSPIRV(Job.ShaderType, Source, static_cast<int>(SourceLength), ShaderCI.Macros,
+                                                           pStreamFactory, SpvVersion, &pCompilerOutput);
+        }
+    }
+    catch (const std::exception& Err)
+    {
+        Job.Log = Err.what();
+        return;
+    }
+
+    if (pCompilerOutput)
+    {
+        const auto* Msg = static_cast<const char*>(pCompilerOutput->GetConstDataPtr());
+        Job.Log.assign(Msg, strnlen(Msg, pCompilerOutput->GetSize()));
+    }
+
+    if (Job.SPIRV.empty())
+        return;
+
+    // Reflect the final bytecode the same way the Vulkan backend does when it creates the shader
+    try
+    {
+        ShaderDesc Desc;
+        Desc.Name       = Job.Name.c_str();
+        Desc.ShaderType = Job.ShaderType;
+
+        std::string EntryPoint;
+        Job.pResources.reset(new SPIRVShaderResources{
+            GetRawAllocator(),
+            nullptr,
+            Job.SPIRV,
+            Desc,
+            Job.UseCombinedTextureSamplers ? Job.CombinedSamplerSuffix.c_str() : nullptr,
+            false,
+            EntryPoint //
+        });
+    }
+    catch (const std::exception& Err)
+    {
+        Job.Log += std::string{"Failed to reflect SPIR-V bytecode: "} + Err.what() + '\n';
+        Job.SPIRV.clear();
+    }
+}
+
+bool HasResource(const ShaderJob& Job, const std::string& Name, bool AllowSamplerSuffix)
+{
+    const auto& Resources = *Job.pResources;
+    for (Uint32 r = 0; r < Resources.GetTotalResources(); ++r)
+    {
+        const auto& Res = Resources.GetResource(r);
+        if (Name == Res.Name)
+            return true;
+        if (AllowSamplerSuffix && Job.UseCombinedTextureSamplers && Name + Job.CombinedSamplerSuffix == Res.Name)
+            return true;
+    }
+    return false;
+}
+
+// Reports resource layout entries that do not match any resource in the shaders of the given stages.
+// These are most likely typos, as the engine silently ignores such entries.
+Uint32 ValidateResourceLayout(const PipelineArchive::PipelineData& Pipeline, const std::vector<ShaderJob>& Jobs)
+{
+    auto IsUsed = [&](SHADER_TYPE Stages, const std::string& Name, bool AllowSamplerSuffix) {
+        for (const auto& Shader : Pipeline.Shaders)
+        {
+            if ((Shader.Stage & Stages) != 0 && HasResource(Jobs[Shader.ShaderIndex], Name, AllowSamplerSuffix))
+                return true;
+        }
+        return false;
+    };
+
+    Uint32 NumWarnings = 0;
+    for (const auto& Var : Pipeline.Variables)
+    {
+        if (!IsUsed(Var.ShaderStages, Var.Name, false))
+        {
+            std::cerr << "Warning: variable '" << Var.Name << "' of pipeline '" << Pipeline.Name << "' is not found in " << GetShaderStagesString(Var.ShaderStages) << '\n';
+            ++NumWarnings;
+        }
+    }
+    for (const auto& Sampler : Pipeline.ImmutableSamplers)
+    {
+        if (!IsUsed(Sampler.ShaderStages, Sampler.SamplerOrTextureName, true))
+        {
+            std::cerr << "Warning: immutable sampler '" << Sampler.SamplerOrTextureName << "' of pipeline '" << Pipeline.Name << "' is not found in " << GetShaderStagesString(Sampler.ShaderStages) << '\n';
+            ++NumWarnings;
+        }
+    }
+    return NumWarnings;
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: Diligent-PipelineBaker [-I <dir;dir...>] [-j <threads>] [--spirv 1.0|1.4|1.5] <manifest> <archive>\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string SearchDirectories;
+    std::string SpirvVersionStr = "1.0";
+    Uint32      NumThreads      = 0;
+    const char* ManifestPath    = nullptr;
+    const char* ArchivePath     = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg = argv[i];
+        if ((strcmp(Arg, "-I") == 0 || strcmp(Arg, "-j") == 0 || strcmp(Arg, "--spirv") == 0) && i + 1 < argc)
+        {
+            const char* Val = argv[++i];
+            if (Arg[1] == 'I')
+                SearchDirectories += (SearchDirectories.empty() ? "" : ";") + std::string{Val};
+            else if (Arg[1] == 'j')
+                NumThreads = static_cast<Uint32>(atoi(Val));
+            else
+                SpirvVersionStr = Val;
+        }
+        else if (Arg[0] != '-' && ManifestPath == nullptr)
+        {
+            ManifestPath = Arg;
+        }
+        else if (Arg[0] != '-' && ArchivePath == nullptr)
+        {
+            ArchivePath = Arg;
+        }
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (ManifestPath == nullptr || ArchivePath == nullptr)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    GLSLangUtils::SpirvVersion SpvVersion = GLSLangUtils::SpirvVersion::Vk100;
+    if (SpirvVersionStr == "1.4")
+        SpvVersion = GLSLangUtils::SpirvVersion::Vk110_Spirv14;
+    else if (SpirvVersionStr == "1.5")
+        SpvVersion = GLSLangUtils::SpirvVersion::Vk120;
+    else if (SpirvVersionStr != "1.0")
+    {
+        std::cerr << "Unsupported SPIR-V version '" << SpirvVersionStr << "'\n";
+        return -1;
+    }
+
+    std::vector<ShaderJob>                     Jobs;
+    std::vector<PipelineArchive::PipelineData> Pipelines;
+    try
+    {
+        ParseManifest(ManifestPath, Jobs, Pipelines);
+    }
+    catch (const std::exception& Err)
+    {
+        std::cerr << ManifestPath << ": " << Err.what() << '\n';
+        return -1;
+    }
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+    CreateDefaultShaderSourceStreamFactory(SearchDirectories.c_str(), &pStreamFactory);
+
+    GLSLangUtils::InitializeGlslang();
+
+    enki::TaskScheduler Scheduler;
+    if (NumThreads != 0)
+        Scheduler.Initialize(NumThreads);
+    else
+        Scheduler.Initialize();
+
+    // One shader per partition: compile times vary a lot, so fine-grained
+    // tasks keep all workers busy until the very end.
+    enki::TaskSet CompileTask{
+        static_cast<uint32_t>(Jobs.size()),
+        [&](enki::TaskSetPartition Range, uint32_t /*ThreadNum*/) {
+            for (auto j = Range.start; j < Range.end; ++j)
+                CompileShader(Jobs[j], pStreamFactory, SpvVersion);
+        } //
+    };
+    CompileTask.m_MinRange = 1;
+
+    Scheduler.AddTaskSetToPipe(&CompileTask);
+    Scheduler.WaitforTask(&CompileTask);
+    Scheduler.WaitforAllAndShutdown();
+
+    GLSLangUtils::FinalizeGlslang();
+
+    Uint32 NumFailed = 0;
+    for (const auto& Job : Jobs)
+    {
+        if (Job.SPIRV.empty())
+        {
+            ++NumFailed;
+            std::cerr << "Failed to compile " << Job.Name << '\n';
+        }
+        if (!Job.Log.empty())
+            std::cerr << Job.Log << '\n';
+    }
+    if (NumFailed != 0)
+    {
+        std::cerr << NumFailed << " of " << Jobs.size() << " shaders failed to compile. The archive was not written.\n";
+        return 1;
+    }
+
+    Uint32 NumWarnings = 0;
+    for (const auto& Pipeline : Pipelines)
+        NumWarnings += ValidateResourceLayout(Pipeline, Jobs);
+
+    std::vector<PipelineArchive::ShaderData> Shaders(Jobs.size());
+    for (size_t s = 0; s < Jobs.size(); ++s)
+    {
+        auto& Job    = Jobs[s];
+        auto& Shader = Shaders[s];
+
+        Shader.Name                       = Job.Name;
+        Shader.ShaderType                 = Job.ShaderType;
+        Shader.EntryPoint                 = Job.EntryPoint;
+        Shader.SPIRV                      = std::move(Job.SPIRV);
+        Shader.UseCombinedTextureSamplers = Job.UseCombinedTextureSamplers;
+        Shader.CombinedSamplerSuffix      = Job.CombinedSamplerSuffix;
+    }
+
+    std::vector<Uint8> ArchiveData;
+    PipelineArchive::Serialize(Shaders, Pipelines, ArchiveData);
+
+    std::ofstream Archive{ArchivePath, std::ios::binary};
+    if (!Archive.write(reinterpret_cast<const char*>(ArchiveData.data()), ArchiveData.size()))
+    {
+        std::cerr << "Failed to write archive file '" << ArchivePath << "'\n";
+        return 1;
+    }
+
+    std::cout << Pipelines.size() << " pipelines with " << Shaders.size() << " shaders written to " << ArchivePath;
+    if (NumWarnings != 0)
+        std::cout << " (" << NumWarnings << " warnings)";
+    std::cout << '\n';
+
+    return 0;
+}
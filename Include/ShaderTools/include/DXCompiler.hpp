@@ -63,6 +63,10 @@ public:
 
     virtual bool IsLoaded() = 0;
 
+    /// Returns the version and commit information reported by the compiler library,
+    /// or an empty string if the library is not loaded.
+    virtual std::string GetVersionString() = 0;
+
     struct CompileAttribs
     {
         const char*                      Source                     = nullptr;
@@ -45,4 +45,8 @@ String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
                              TargetGLSLCompiler      TargetCompiler,
                              const char*             ExtraDefinitions = nullptr);
 
+/// Returns a string that identifies the device capabilities that BuildGLSLSourceString()
+/// reads. Sources built for devices with different strings may differ.
+String GetGLSLSourceStringCapsInfo(const DeviceCaps& deviceCaps);
+
 } // namespace Diligent
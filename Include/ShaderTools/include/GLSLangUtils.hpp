@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include "Shader.h"
 #include "DataBlob.h"
 
@@ -48,6 +49,9 @@ enum class SpirvVersion
 void InitializeGlslang();
 void FinalizeGlslang();
 
+/// Returns a string that identifies the glslang build and the SPIR-V generator version.
+std::string GetVersionString();
+
 std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE                      ShaderType,
                                       const char*                      ShaderSource,
                                       int                              SourceCodeLen,
@@ -58,6 +62,7 @@ std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE                      ShaderTyp
 
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
+                                      SpirvVersion            Version,
                                       IDataBlob**             ppCompilerOutput);
 
 } // namespace GLSLangUtils
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Helpers shared by the persistent on-disk caches (SPIR-V bytecode, GL program binaries)
+
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// 128-bit key that identifies a cache entry
+struct CacheEntryKey
+{
+    Uint64 Hash[2] = {};
+
+    bool operator==(const CacheEntryKey& rhs) const
+    {
+        return Hash[0] == rhs.Hash[0] && Hash[1] == rhs.Hash[1];
+    }
+
+    /// Returns the key as a 32-character hexadecimal string
+    std::string ToString() const;
+};
+
+
+/// Computes cache entry keys.
+
+/// Two independent FNV-1a lanes give a 128-bit key that makes accidental collisions
+/// between different entries practically impossible.
+class CacheKeyHasher
+{
+public:
+    void Update(const void* pData, size_t Size)
+    {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        for (size_t i = 0; i < Size; ++i)
+        {
+            m_Hash[0] = (m_Hash[0] ^ pBytes[i]) * 0x100000001B3ull;
+            m_Hash[1] = (m_Hash[1] ^ pBytes[i]) * 0x100000001B3ull;
+            m_Hash[1] ^= m_Hash[1] >> 29;
+        }
+    }
+
+    template <typename T>
+    void Update(const T& Val)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only arithmetic and enum types are allowed");
+        Update(&Val, sizeof(Val));
+    }
+
+    // Strings are prefixed with their length so that adjacent strings can't be confused,
+    // and null strings are distinguished from empty ones.
+    void UpdateStr(const char* Str);
+
+    void UpdateStr(const char* Str, size_t Len)
+    {
+        Update(static_cast<Uint64>(Len));
+        Update(Str, Len);
+    }
+
+    CacheEntryKey Get() const
+    {
+        CacheEntryKey Key;
+        Key.Hash[0] = m_Hash[0];
+        Key.Hash[1] = m_Hash[1];
+        return Key;
+    }
+
+private:
+    Uint64 m_Hash[2] = {0xCBF29CE484222325ull, 0x84222325CBF29CE4ull};
+};
+
+
+/// Header of a cache entry file. The header is immediately followed by DataSize bytes of data.
+struct CacheEntryHeader
+{
+    Uint32        Magic         = 0;
+    Uint32        FormatVersion = 0;
+    CacheEntryKey Key;
+    // Values that describe the data, their meaning is defined by the cache
+    Uint32 Params[2] = {};
+    Uint32 DataSize  = 0;
+    Uint32 Checksum  = 0;
+};
+
+
+/// Part of the data written by WriteCacheEntry()
+struct CacheEntryChunk
+{
+    const void* pData = nullptr;
+    size_t      Size  = 0;
+};
+
+
+/// Reads a cache entry.
+
+/// \param [in]  Path   - Path to the entry file.
+/// \param [in]  Magic, FormatVersion, Key - Values the header must contain.
+/// \param [out] Header - Header of the entry.
+/// \param [out] Data   - Entry data.
+///
+/// \return true if the entry exists, and its header and checksum are valid.
+///         Invalid entries are reported as warnings.
+bool ReadCacheEntry(const std::string&   Path,
+                    Uint32               Magic,
+                    Uint32               FormatVersion,
+                    const CacheEntryKey& Key,
+                    CacheEntryHeader&    Header,
+                    std::vector<Uint8>&  Data);
+
+
+/// Writes a cache entry.
+
+/// \param [in] Path   - Path to the entry file.
+/// \param [in] Header - Entry header. DataSize and Checksum are computed from the chunks.
+/// \param [in] Chunks - Data of the entry.
+///
+/// \remarks The entry is written to a uniquely named temporary file that is then renamed,
+///          so that other processes never observe a partially written entry.
+void WriteCacheEntry(const std::string&                     Path,
+                     CacheEntryHeader                       Header,
+                     std::initializer_list<CacheEntryChunk> Chunks);
+
+} // namespace Diligent
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Persistent on-disk cache of SPIR-V bytecode
+
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "PersistentCacheUtils.hpp"
+
+namespace Diligent
+{
+
+/// Content-addressed cache that stores SPIR-V bytecode compiled from shader source code on disk.
+
+/// Every entry is identified by a 128-bit key that is computed from the shader source,
+/// the contents of all files it includes (resolved through the shader source input stream factory),
+/// macros, entry point, shader stage, source language and the compiler identification string.
+/// Entries are written to a temporary file first and are then atomically renamed, so the same
+/// directory may be shared by multiple processes. An entry may also hold the shader reflection data,
+/// so that a cache hit skips both compilation and reflection. All methods are thread-safe.
+class SPIRVShaderCache
+{
+public:
+    using Key = CacheEntryKey;
+
+    /// \param [in] CacheDirectory - Directory where cache entries are stored. The directory is created if it does not exist.
+    explicit SPIRVShaderCache(const char* CacheDirectory) noexcept(false);
+
+    /// Computes the cache key for the shader.
+
+    /// \param [in] ShaderCI     - Shader create info. Source or FilePath must not be null.
+    /// \param [in] CompilerInfo - String that identifies the compiler and all options that affect
+    ///                            the generated bytecode and are not part of ShaderCI (compiler
+    ///                            version, target SPIR-V version, extra definitions, etc.).
+    Key ComputeKey(const ShaderCreateInfo& ShaderCI, const char* CompilerInfo) const noexcept(false);
+
+    /// Loads the bytecode from the cache. Returns false if there is no valid entry for the key.
+
+    /// \param [in]  CacheKey    - Cache key, see ComputeKey().
+    /// \param [out] SPIRV       - SPIR-V bytecode.
+    /// \param [out] pReflection - Optional pointer to the reflection data stored with the bytecode.
+    ///                            Empty if the entry contains no reflection data.
+    bool Load(const Key& CacheKey, std::vector<Uint32>& SPIRV, std::vector<Uint8>* pReflection = nullptr) const;
+
+    /// Stores the bytecode and optional reflection data (see SPIRVShaderResources::Serialize()) in the cache.
+    void Store(const Key& CacheKey, const std::vector<Uint32>& SPIRV, const std::vector<Uint8>* pReflection = nullptr) const;
+
+    const std::string& GetDirectory() const { return m_Directory; }
+
+private:
+    std::string GetEntryPath(const Key& CacheKey) const;
+
+    std::string m_Directory;
+};
+
+} // namespace Diligent
@@ -109,6 +109,23 @@ public:
                                Uint32                                _BufferStaticSize   = 0,
                                Uint32                                _BufferStride       = 0) noexcept;
 
+    // Creates the attributes from previously reflected values, see SPIRVShaderResources::Serialize()
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               Uint32             _SepSmplrOrImgInd,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept;
+
+    Uint32 GetSepSmplrOrImgInd() const
+    {
+        return SepSmplrOrImgInd;
+    }
+
     bool IsValidSepSamplerAssigned() const
     {
         VERIFY_EXPR(Type == ResourceType::SeparateImage);
@@ -145,6 +162,12 @@ public:
         SepSmplrOrImgInd = SepImageInd;
     }
 
+    // Unsized (runtime) arrays are reflected with zero array size
+    bool IsRuntimeArray() const
+    {
+        return ArraySize == 0;
+    }
+
     bool IsCompatibleWith(const SPIRVShaderResourceAttribs& Attribs) const
     {
         // clang-format off
@@ -198,6 +221,15 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    // Creates the resources from the data produced by Serialize() without reflecting the SPIRV binary.
+    // The data is only read during construction and may reside in a memory-mapped file.
+    // Throws an exception if the data is invalid.
+    SPIRVShaderResources(IMemoryAllocator& Allocator,
+                         const void*       pSerializedData,
+                         size_t            DataSize,
+                         const ShaderDesc& shaderDesc,
+                         std::string&      EntryPoint) noexcept(false);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -352,6 +384,11 @@ public:
 
     std::string DumpResources();
 
+    // Writes the resources into a flat, pointer-free binary blob: all names are stored as offsets
+    // in the names pool, so the blob can be stored on disk alongside the SPIRV binary and used
+    // to recreate the resources with a single relocation pass.
+    void Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const;
+
     bool IsCompatibleWith(const SPIRVShaderResources& Resources) const;
 
     // clang-format off
@@ -364,6 +401,13 @@ public:
 
     bool IsHLSLSource() const { return m_IsHLSLSource; }
 
+    // Push constant block is not a descriptor-based resource and is not enumerated by ProcessResources()
+    // clang-format off
+    bool        HasPushConstants()         const { return m_PushConstantBlockSize != 0; }
+    const char* GetPushConstantBlockName() const { return m_PushConstantBlockName; }
+    Uint32      GetPushConstantBlockSize() const { return m_PushConstantBlockSize; }
+    // clang-format on
+
 private:
     void Initialize(IMemoryAllocator&       Allocator,
                     const ResourceCounters& Counters,
@@ -411,6 +455,9 @@ private:
 
     const char* m_CombinedSamplerSuffix = nullptr;
     const char* m_ShaderName            = nullptr;
+    const char* m_PushConstantBlockName = nullptr;
+
+    Uint32 m_PushConstantBlockSize = 0;
 
     using OffsetType                   = Uint16;
     OffsetType m_StorageBufferOffset   = 0;
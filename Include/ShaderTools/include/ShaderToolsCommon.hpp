@@ -35,6 +35,17 @@
 namespace Diligent
 {
 
+/// Definition that is added to every shader compiled for Vulkan, so that
+/// the source code can detect the backend:
+///
+///     #ifndef VULKAN
+///     #   define VULKAN 1
+///     #endif
+static constexpr char VulkanDefine[] =
+    "#ifndef VULKAN\n"
+    "#   define VULKAN 1\n"
+    "#endif\n";
+
 /// Returns shader type definition macro(s), e.g., for a vertex shader:
 ///
 ///     {"VERTEX_SHADER", "1"}, {nullptr, nullptr}
@@ -70,6 +70,13 @@ public:
         return m_MaxShaderModel;
     }
 
+    std::string GetVersionString() override final
+    {
+        Load();
+        // mutex is not needed here
+        return m_VersionString;
+    }
+
     bool IsLoaded() override final
     {
         return GetCreateInstaceProc() != nullptr;
@@ -132,6 +139,32 @@ private:
                     }
                 }
             }
+
+            // The validator version does not change with every compiler build, so the version
+            // string is taken from the compiler and includes the commit it was built from
+            CComPtr<IDxcCompiler> compiler;
+            if (SUCCEEDED(m_pCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler))))
+            {
+                CComPtr<IDxcVersionInfo> info;
+                if (SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&info))))
+                {
+                    UINT32 MajorVer = 0, MinorVer = 0;
+                    info->GetVersion(&MajorVer, &MinorVer);
+                    m_VersionString = std::to_string(MajorVer) + '.' + std::to_string(MinorVer);
+                }
+
+                CComPtr<IDxcVersionInfo2> info2;
+                if (SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&info2))))
+                {
+                    UINT32 CommitCount = 0;
+                    char*  CommitHash  = nullptr;
+                    if (SUCCEEDED(info2->GetCommitInfo(&CommitCount, &CommitHash)))
+                    {
+                        m_VersionString += " (" + std::to_string(CommitCount) + ", " + (CommitHash != nullptr ? CommitHash : "") + ')';
+                        CoTaskMemFree(CommitHash);
+                    }
+                }
+            }
         }
 
         return m_pCreateInstance;
@@ -150,6 +183,7 @@ private:
     // Compiler version
     UINT32 m_MajorVer = 0;
     UINT32 m_MinorVer = 0;
+    String m_VersionString;
 };
 
 
@@ -311,4 +311,16 @@ String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
     return GLSLSource;
 }
 
+String GetGLSLSourceStringCapsInfo(const DeviceCaps& deviceCaps)
+{
+    // Must list every capability that BuildGLSLSourceString() reads
+    std::stringstream ss;
+    ss << "dev" << static_cast<int>(deviceCaps.DevType) << ' ' << deviceCaps.MajorVersion << '.' << deviceCaps.MinorVersion
+       << " sep" << static_cast<int>(deviceCaps.Features.SeparablePrograms)
+       << " cs" << static_cast<int>(deviceCaps.Features.ComputeShaders)
+       << " cubearr" << (deviceCaps.TexCaps.CubemapArraysSupported ? 1 : 0)
+       << " ms" << (deviceCaps.TexCaps.Texture2DMSSupported ? 1 : 0);
+    return ss.str();
+}
+
 } // namespace Diligent
@@ -68,6 +68,14 @@ void FinalizeGlslang()
     ::glslang::FinalizeProcess();
 }
 
+std::string GetVersionString()
+{
+    std::string Version = ::glslang::GetGlslVersionString();
+    Version += " spv-gen ";
+    Version += std::to_string(::spv::GetSpirvGeneratorVersion());
+    return Version;
+}
+
 static EShLanguage ShaderTypeToShLanguage(SHADER_TYPE ShaderType)
 {
     static_assert(SHADER_TYPE_LAST == SHADER_TYPE_CALLABLE, "Please handle the new shader type in the switch below");
@@ -445,8 +453,39 @@ private:
     std::unordered_map<IncludeResult*, RefCntAutoPtr<IDataBlob>> m_DataBlobs;
 };
 
+// Sets the Vulkan and SPIR-V versions the shader is compiled for and returns the matching
+// SPIRV-Tools target environment. Vk100 keeps the environment that is already set in the shader.
+static spv_target_env SetTargetEnvironment(::glslang::TShader& Shader, ::glslang::EShSource Source, EShLanguage ShLang, SpirvVersion Version)
+{
+    switch (Version)
+    {
+        case SpirvVersion::Vk100:
+            // keep default
+            return SPV_ENV_VULKAN_1_0;
+        case SpirvVersion::Vk110:
+            Shader.setEnvInput(Source, ShLang, ::glslang::EShClientVulkan, 110);
+            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_1);
+            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_3);
+            return SPV_ENV_VULKAN_1_1;
+        case SpirvVersion::Vk110_Spirv14:
+            Shader.setEnvInput(Source, ShLang, ::glslang::EShClientVulkan, 110);
+            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_1);
+            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_4);
+            return SPV_ENV_VULKAN_1_1_SPIRV_1_4;
+        case SpirvVersion::Vk120:
+            Shader.setEnvInput(Source, ShLang, ::glslang::EShClientVulkan, 120);
+            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_2);
+            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_4);
+            return SPV_ENV_VULKAN_1_2;
+        default:
+            UNEXPECTED("Unknown SPIRV version");
+            return SPV_ENV_VULKAN_1_0;
+    }
+}
+
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
+                                      SpirvVersion            Version,
                                       IDataBlob**             ppCompilerOutput)
 {
     EShLanguage        ShLang = ShaderTypeToShLanguage(ShaderCI.Desc.ShaderType);
@@ -463,6 +502,7 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
     Shader.setEnvInput(::glslang::EShSourceHlsl, ShLang, ::glslang::EShClientVulkan, 100);
     Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_0);
     Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_0);
+    const auto spvTarget = SetTargetEnvironment(Shader, ::glslang::EShSourceHlsl, ShLang, Version);
     Shader.setHlslIoMapping(true);
     Shader.setEntryPoint(ShaderCI.EntryPoint);
     Shader.setEnvTargetHlslFunctionality1();
@@ -498,7 +538,7 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader
-    spvtools::Optimizer SpirvOptimizer(SPV_ENV_VULKAN_1_0);
+    spvtools::Optimizer SpirvOptimizer(spvTarget);
     SpirvOptimizer.RegisterLegalizationPasses();
     SpirvOptimizer.RegisterPerformancePasses();
     std::vector<uint32_t> LegalizedSPIRV;
@@ -525,34 +565,7 @@ std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE                      ShaderTyp
 
     EShLanguage        ShLang = ShaderTypeToShLanguage(ShaderType);
     ::glslang::TShader Shader(ShLang);
-    spv_target_env     spvTarget = SPV_ENV_VULKAN_1_0;
-
-    switch (Version)
-    {
-        case SpirvVersion::Vk100:
-            // keep default
-            break;
-        case SpirvVersion::Vk110:
-            Shader.setEnvInput(::glslang::EShSourceGlsl, ShLang, ::glslang::EShClientVulkan, 110);
-            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_1);
-            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_3);
-            spvTarget = SPV_ENV_VULKAN_1_1;
-            break;
-        case SpirvVersion::Vk110_Spirv14:
-            Shader.setEnvInput(::glslang::EShSourceGlsl, ShLang, ::glslang::EShClientVulkan, 110);
-            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_1);
-            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_4);
-            spvTarget = SPV_ENV_VULKAN_1_1_SPIRV_1_4;
-            break;
-        case SpirvVersion::Vk120:
-            Shader.setEnvInput(::glslang::EShSourceGlsl, ShLang, ::glslang::EShClientVulkan, 120);
-            Shader.setEnvClient(::glslang::EShClientVulkan, ::glslang::EShTargetVulkan_1_2);
-            Shader.setEnvTarget(::glslang::EShTargetSpv, ::glslang::EShTargetSpv_1_4);
-            spvTarget = SPV_ENV_VULKAN_1_2;
-            break;
-        default:
-            UNEXPECTED("Unknown SPIRV version");
-    }
+    const auto         spvTarget = SetTargetEnvironment(Shader, ::glslang::EShSourceGlsl, ShLang, Version);
 
     EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
 
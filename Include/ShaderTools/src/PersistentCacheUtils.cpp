@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PersistentCacheUtils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "FileSystem.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+Uint32 UpdateChecksum(Uint32 Checksum, const void* pData, size_t Size)
+{
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+    for (size_t i = 0; i < Size; ++i)
+        Checksum = (Checksum ^ pBytes[i]) * 0x01000193u;
+    return Checksum;
+}
+
+constexpr Uint32 ChecksumSeed = 0x811C9DC5u;
+
+} // namespace
+
+
+std::string CacheEntryKey::ToString() const
+{
+    char Str[33];
+    snprintf(Str, sizeof(Str), "%016llx%016llx",
+             static_cast<unsigned long long>(Hash[0]),
+             static_cast<unsigned long long>(Hash[1]));
+    return Str;
+}
+
+void CacheKeyHasher::UpdateStr(const char* Str)
+{
+    if (Str == nullptr)
+    {
+        Update(~Uint64{0});
+        return;
+    }
+    UpdateStr(Str, strlen(Str));
+}
+
+bool ReadCacheEntry(const std::string&   Path,
+                    Uint32               Magic,
+                    Uint32               FormatVersion,
+                    const CacheEntryKey& Key,
+                    CacheEntryHeader&    Header,
+                    std::vector<Uint8>&  Data)
+{
+    if (!FileSystem::FileExists(Path.c_str()))
+        return false;
+
+    FileOpenAttribs OpenAttribs{Path.c_str(), EFileAccessMode::Read};
+
+    std::unique_ptr<CFile> pFile{FileSystem::OpenFile(OpenAttribs)};
+    if (!pFile)
+        return false;
+
+    Header = {};
+    if (!pFile->Read(&Header, sizeof(Header)) ||
+        Header.Magic != Magic ||
+        Header.FormatVersion != FormatVersion ||
+        !(Header.Key == Key) ||
+        pFile->GetSize() != sizeof(Header) + size_t{Header.DataSize})
+    {
+        LOG_WARNING_MESSAGE("Cache entry '", Path, "' is invalid and will be ignored");
+        return false;
+    }
+
+    Data.resize(Header.DataSize);
+    if ((!Data.empty() && !pFile->Read(Data.data(), Data.size())) ||
+        UpdateChecksum(ChecksumSeed, Data.data(), Data.size()) != Header.Checksum)
+    {
+        LOG_WARNING_MESSAGE("Cache entry '", Path, "' is corrupted and will be ignored");
+        Data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void WriteCacheEntry(const std::string&                     Path,
+                     CacheEntryHeader                       Header,
+                     std::initializer_list<CacheEntryChunk> Chunks)
+{
+    size_t DataSize = 0;
+    Header.Checksum = ChecksumSeed;
+    for (const auto& Chunk : Chunks)
+    {
+        DataSize += Chunk.Size;
+        Header.Checksum = UpdateChecksum(Header.Checksum, Chunk.pData, Chunk.Size);
+    }
+    Header.DataSize = static_cast<Uint32>(DataSize);
+
+    std::string TmpPath = Path;
+    {
+        std::random_device RndDevice;
+        char               Suffix[32];
+        snprintf(Suffix, sizeof(Suffix), ".%08x.tmp", static_cast<unsigned int>(RndDevice()));
+        TmpPath += Suffix;
+    }
+
+    bool Written = false;
+    {
+        FileOpenAttribs OpenAttribs{TmpPath.c_str(), EFileAccessMode::Overwrite};
+
+        std::unique_ptr<CFile> pFile{FileSystem::OpenFile(OpenAttribs)};
+        if (!pFile)
+        {
+            LOG_WARNING_MESSAGE("Failed to create cache entry '", TmpPath, '\'');
+            return;
+        }
+
+        Written = pFile->Write(&Header, sizeof(Header));
+        for (const auto& Chunk : Chunks)
+            Written = Written && (Chunk.Size == 0 || pFile->Write(Chunk.pData, Chunk.Size));
+    }
+
+    // If another process has stored the same entry in the meantime, rename may fail on some
+    // platforms. This is fine as the contents are identical.
+    if (!Written || std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+    {
+        if (!Written)
+            LOG_WARNING_MESSAGE("Failed to write cache entry '", TmpPath, '\'');
+        std::remove(TmpPath.c_str());
+    }
+}
+
+} // namespace Diligent
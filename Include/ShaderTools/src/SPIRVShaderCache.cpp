@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "SPIRVShaderCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#include "APIInfo.h"
+#include "FileSystem.hpp"
+#include "DebugUtilities.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ShaderToolsCommon.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Increment when the key derivation or the entry layout changes
+constexpr Uint32 CacheFormatVersion = 3;
+
+constexpr Uint32 CacheEntryMagic = 0x43565053; // 'SPVC'
+
+// Hashes the source and, recursively, every file it includes. Includes are not
+// preprocessed, so files referenced from inactive #if blocks also become part of the key,
+// which may only cause unnecessary cache misses.
+void HashSourceWithIncludes(CacheKeyHasher&                  Hasher,
+                            const char*                      Source,
+                            size_t                           SourceLen,
+                            IShaderSourceInputStreamFactory* pStreamFactory,
+                            std::unordered_set<std::string>& ProcessedIncludes)
+{
+    Hasher.UpdateStr(Source, SourceLen);
+
+    const char* const End = Source + SourceLen;
+    for (const char* Pos = Source; Pos < End;)
+    {
+        const char* LineEnd = std::find(Pos, End, '\n');
+
+        const char* c = Pos;
+        while (c < LineEnd && (*c == ' ' || *c == '\t'))
+            ++c;
+        if (c < LineEnd && *c == '#')
+        {
+            ++c;
+            while (c < LineEnd && (*c == ' ' || *c == '\t'))
+                ++c;
+            static constexpr char IncludeDirective[] = "include";
+            static constexpr auto IncludeLen         = sizeof(IncludeDirective) - 1;
+            if (static_cast<size_t>(LineEnd - c) > IncludeLen && strncmp(c, IncludeDirective, IncludeLen) == 0)
+            {
+                c += IncludeLen;
+                while (c < LineEnd && (*c == ' ' || *c == '\t'))
+                    ++c;
+                if (c < LineEnd && (*c == '"' || *c == '<'))
+                {
+                    const char  Closing   = *c == '"' ? '"' : '>';
+                    const char* NameStart = c + 1;
+                    const char* NameEnd   = std::find(NameStart, LineEnd, Closing);
+                    if (NameEnd != LineEnd)
+                    {
+                        std::string IncludeName{NameStart, NameEnd};
+                        if (ProcessedIncludes.insert(IncludeName).second)
+                        {
+                            RefCntAutoPtr<IFileStream> pIncludeStream;
+                            if (pStreamFactory != nullptr)
+                                pStreamFactory->CreateInputStream2(IncludeName.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pIncludeStream);
+
+                            Hasher.UpdateStr(IncludeName.c_str(), IncludeName.length());
+                            if (pIncludeStream)
+                            {
+                                auto pIncludeData = MakeNewRCObj<DataBlobImpl>{}(0);
+                                pIncludeStream->ReadBlob(pIncludeData);
+                                HashSourceWithIncludes(Hasher, static_cast<const char*>(pIncludeData->GetDataPtr()), pIncludeData->GetSize(),
+                                                       pStreamFactory, ProcessedIncludes);
+                            }
+                            else
+                            {
+                                // The compiler will fail to resolve the include too, so the entry will never be stored.
+                                Hasher.Update(~Uint64{0});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        Pos = LineEnd + 1;
+    }
+}
+
+} // namespace
+
+
+SPIRVShaderCache::SPIRVShaderCache(const char* CacheDirectory) noexcept(false) :
+    m_Directory{CacheDirectory != nullptr ? CacheDirectory : ""}
+{
+    if (m_Directory.empty())
+        LOG_ERROR_AND_THROW("Shader cache directory must not be empty");
+
+    if (m_Directory.back() == '/' || m_Directory.back() == '\\')
+        m_Directory.pop_back();
+
+    if (!FileSystem::PathExists(m_Directory.c_str()))
+    {
+        if (!FileSystem::CreateDirectory(m_Directory.c_str()))
+            LOG_ERROR_AND_THROW("Failed to create shader cache directory '", m_Directory, '\'');
+    }
+}
+
+std::string SPIRVShaderCache::GetEntryPath(const Key& CacheKey) const
+{
+    std::string Path = m_Directory;
+    Path += FileSystem::GetSlashSymbol();
+    Path += CacheKey.ToString();
+    Path += ".spv";
+    return Path;
+}
+
+SPIRVShaderCache::Key SPIRVShaderCache::ComputeKey(const ShaderCreateInfo& ShaderCI, const char* CompilerInfo) const noexcept(false)
+{
+    DEV_CHECK_ERR(ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr, "Shader source or file path must not be null");
+
+    CacheKeyHasher Hasher;
+    Hasher.Update(CacheFormatVersion);
+    Hasher.Update(static_cast<Uint32>(DILIGENT_API_VERSION));
+    Hasher.UpdateStr(CompilerInfo);
+
+    Hasher.Update(ShaderCI.Desc.ShaderType);
+    Hasher.Update(ShaderCI.SourceLanguage);
+    Hasher.UpdateStr(ShaderCI.EntryPoint);
+    Hasher.Update(ShaderCI.UseCombinedTextureSamplers);
+    Hasher.UpdateStr(ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr);
+    Hasher.Update(ShaderCI.HLSLVersion.Major);
+    Hasher.Update(ShaderCI.HLSLVersion.Minor);
+    Hasher.Update(ShaderCI.GLSLVersion.Major);
+    Hasher.Update(ShaderCI.GLSLVersion.Minor);
+
+    if (ShaderCI.Macros != nullptr)
+    {
+        for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr; ++pMacro)
+        {
+            Hasher.UpdateStr(pMacro->Name);
+            Hasher.UpdateStr(pMacro->Definition);
+        }
+    }
+    // Terminate the macro list so that macros can't be confused with the source
+    Hasher.Update(~Uint64{0});
+
+    RefCntAutoPtr<IDataBlob> pFileData;
+    size_t                   SourceLen = 0;
+
+    const auto* Source = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pFileData, SourceLen);
+
+    std::unordered_set<std::string> ProcessedIncludes;
+    HashSourceWithIncludes(Hasher, Source, SourceLen, ShaderCI.pShaderSourceStreamFactory, ProcessedIncludes);
+
+    return Hasher.Get();
+}
+
+bool SPIRVShaderCache::Load(const Key& CacheKey, std::vector<Uint32>& SPIRV, std::vector<Uint8>* pReflection) const
+{
+    const auto Path = GetEntryPath(CacheKey);
+
+    CacheEntryHeader   Header;
+    std::vector<Uint8> Data;
+    if (!ReadCacheEntry(Path, CacheEntryMagic, CacheFormatVersion, CacheKey, Header, Data))
+        return false;
+
+    // Params[0] is the number of bytecode words, Params[1] is the size of the reflection data that follows the bytecode
+    const size_t NumWords       = Header.Params[0];
+    const size_t ReflectionSize = Header.Params[1];
+    if (NumWords == 0 || Data.size() != NumWords * sizeof(Uint32) + ReflectionSize)
+    {
+        LOG_WARNING_MESSAGE("Shader cache entry '", Path, "' is invalid and will be ignored");
+        return false;
+    }
+
+    SPIRV.resize(NumWords);
+    memcpy(SPIRV.data(), Data.data(), NumWords * sizeof(Uint32));
+
+    if (pReflection != nullptr)
+        pReflection->assign(Data.begin() + NumWords * sizeof(Uint32), Data.end());
+
+    return true;
+}
+
+void SPIRVShaderCache::Store(const Key& CacheKey, const std::vector<Uint32>& SPIRV, const std::vector<Uint8>* pReflection) const
+{
+    VERIFY_EXPR(!SPIRV.empty());
+
+    const auto* pReflectionData = pReflection != nullptr ? pReflection->data() : nullptr;
+    const auto  ReflectionSize  = pReflection != nullptr ? pReflection->size() : size_t{0};
+
+    CacheEntryHeader Header;
+    Header.Magic         = CacheEntryMagic;
+    Header.FormatVersion = CacheFormatVersion;
+    Header.Key           = CacheKey;
+    Header.Params[0]     = static_cast<Uint32>(SPIRV.size());
+    Header.Params[1]     = static_cast<Uint32>(ReflectionSize);
+
+    WriteCacheEntry(GetEntryPath(CacheKey), Header,
+                    {
+                        {SPIRV.data(), SPIRV.size() * sizeof(Uint32)},
+                        {pReflectionData, ReflectionSize},
+                    });
+}
+
+} // namespace Diligent
@@ -25,6 +25,7 @@
  *  of the possibility of such damages.
  */
 
+#include <cstring>
 #include <iomanip>
 #include "SPIRVShaderResources.hpp"
 #include "spirv_parser.hpp"
@@ -130,6 +131,31 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cros
            "Only separate images or separate samplers can be assinged valid SepSmplrOrImgInd value");
 }
 
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       Uint16             _ArraySize,
+                                                       ResourceType       _Type,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       Uint32             _SepSmplrOrImgInd,
+                                                       uint32_t           _BindingDecorationOffset,
+                                                       uint32_t           _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
+    // clang-format off
+    Name                          {_Name},
+    ArraySize                     {_ArraySize},
+    Type                          {_Type},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    SepSmplrOrImgInd              {_SepSmplrOrImgInd},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+    BufferStaticSize              {_BufferStaticSize},
+    BufferStride                  {_BufferStride}
+// clang-format on
+{
+}
+
 
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
@@ -316,6 +342,12 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     VERIFY_EXPR(shaderDesc.Name != nullptr);
     ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
 
+    // Push constant blocks do not use descriptors and are not part of the resource list.
+    // There can be at most one push constant block per entry point.
+    VERIFY(resources.push_constant_buffers.size() <= 1, "Only one push constant block is allowed per shader stage");
+    if (!resources.push_constant_buffers.empty())
+        ResourceNamesPoolSize += GetUBName(Compiler, resources.push_constant_buffers[0], ParsedIRSource).length() + 1;
+
     Uint32 NumShaderStageInputs = 0;
 
     if (!m_IsHLSLSource || resources.stage_inputs.empty())
@@ -567,6 +599,15 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 
     m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
 
+    if (!resources.push_constant_buffers.empty())
+    {
+        const auto& PC   = resources.push_constant_buffers[0];
+        const auto& Type = Compiler.get_type(PC.type_id);
+
+        m_PushConstantBlockName = ResourceNamesPool.CopyString(GetUBName(Compiler, PC, ParsedIRSource));
+        m_PushConstantBlockSize = static_cast<Uint32>(Compiler.get_declared_struct_size(Type));
+    }
+
     if (LoadShaderStageInputs)
     {
         Uint32 CurrStageInput = 0;
@@ -662,6 +703,260 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
     }
 }
 
+namespace
+{
+
+// Serialized resources layout:
+//
+//   | Header | Resource attribs [TotalResources] | Stage input attribs [NumShaderStageInputs] | Names pool |
+//
+// All strings are stored as offsets in the names pool. Increment the version when the layout changes.
+constexpr Uint32 SerializedResourcesMagic   = 0x52565053; // 'SPVR'
+constexpr Uint32 SerializedResourcesVersion = 1;
+constexpr Uint32 InvalidNameOffset          = ~Uint32{0};
+
+struct SerializedResourcesHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 ShaderType;
+    Uint32 IsHLSLSource;
+
+    SPIRVShaderResources::ResourceCounters Counters;
+
+    Uint32 NumShaderStageInputs;
+    Uint32 PushConstantBlockSize;
+    Uint32 PushConstantBlockName;
+    Uint32 CombinedSamplerSuffix;
+    Uint32 EntryPoint;
+    Uint32 NamesPoolSize;
+};
+
+struct SerializedResourceAttribs
+{
+    Uint32 Name;
+    Uint16 ArraySize;
+    Uint8  Type;
+    Uint8  ResourceDim;
+    Uint32 IsMS;
+    Uint32 SepSmplrOrImgInd;
+    Uint32 BindingDecorationOffset;
+    Uint32 DescriptorSetDecorationOffset;
+    Uint32 BufferStaticSize;
+    Uint32 BufferStride;
+};
+static_assert(sizeof(SerializedResourceAttribs) == 32, "Unexpected padding in SerializedResourceAttribs");
+
+struct SerializedStageInputAttribs
+{
+    Uint32 Semantic;
+    Uint32 LocationDecorationOffset;
+};
+
+} // namespace
+
+void SPIRVShaderResources::Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const
+{
+    std::string NamesPool;
+
+    auto AddName = [&NamesPool](const char* Name) {
+        if (Name == nullptr)
+            return InvalidNameOffset;
+        const auto Offset = static_cast<Uint32>(NamesPool.size());
+        NamesPool.append(Name);
+        NamesPool.push_back('\0');
+        return Offset;
+    };
+
+    SerializedResourcesHeader Header = {};
+
+    Header.Magic        = SerializedResourcesMagic;
+    Header.Version      = SerializedResourcesVersion;
+    Header.ShaderType   = static_cast<Uint32>(m_ShaderType);
+    Header.IsHLSLSource = m_IsHLSLSource ? 1 : 0;
+
+    // clang-format off
+    Header.Counters.NumUBs          = GetNumUBs();
+    Header.Counters.NumSBs          = GetNumSBs();
+    Header.Counters.NumImgs         = GetNumImgs();
+    Header.Counters.NumSmpldImgs    = GetNumSmpldImgs();
+    Header.Counters.NumACs          = GetNumACs();
+    Header.Counters.NumSepSmplrs    = GetNumSepSmplrs();
+    Header.Counters.NumSepImgs      = GetNumSepImgs();
+    Header.Counters.NumInptAtts     = GetNumInptAtts();
+    Header.Counters.NumAccelStructs = GetNumAccelStructs();
+    // clang-format on
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please serialize the new resource count");
+
+    Header.NumShaderStageInputs  = GetNumShaderStageInputs();
+    Header.PushConstantBlockSize = m_PushConstantBlockSize;
+    Header.PushConstantBlockName = AddName(m_PushConstantBlockName);
+    Header.CombinedSamplerSuffix = AddName(m_CombinedSamplerSuffix);
+    Header.EntryPoint            = AddName(EntryPoint.c_str());
+
+    // The shader name is not serialized as the same byte code may be shared by differently named shaders
+    std::vector<SerializedResourceAttribs> Resources(GetTotalResources());
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto& Res = GetResource(n);
+        auto&       Dst = Resources[n];
+
+        Dst.Name                          = AddName(Res.Name);
+        Dst.ArraySize                     = Res.ArraySize;
+        Dst.Type                          = static_cast<Uint8>(Res.Type);
+        Dst.ResourceDim                   = static_cast<Uint8>(Res.GetResourceDimension());
+        Dst.IsMS                          = Res.IsMultisample() ? 1 : 0;
+        Dst.SepSmplrOrImgInd              = Res.GetSepSmplrOrImgInd();
+        Dst.BindingDecorationOffset       = Res.BindingDecorationOffset;
+        Dst.DescriptorSetDecorationOffset = Res.DescriptorSetDecorationOffset;
+        Dst.BufferStaticSize              = Res.BufferStaticSize;
+        Dst.BufferStride                  = Res.BufferStride;
+    }
+
+    std::vector<SerializedStageInputAttribs> StageInputs(GetNumShaderStageInputs());
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+    {
+        const auto& Input = GetShaderStageInputAttribs(n);
+
+        StageInputs[n].Semantic                 = AddName(Input.Semantic);
+        StageInputs[n].LocationDecorationOffset = Input.LocationDecorationOffset;
+    }
+
+    Header.NamesPoolSize = static_cast<Uint32>(NamesPool.size());
+
+    const auto ResourcesSize   = Resources.size() * sizeof(SerializedResourceAttribs);
+    const auto StageInputsSize = StageInputs.size() * sizeof(SerializedStageInputAttribs);
+
+    Data.resize(sizeof(Header) + ResourcesSize + StageInputsSize + NamesPool.size());
+
+    auto* pDst = Data.data();
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+    if (ResourcesSize != 0)
+        memcpy(pDst, Resources.data(), ResourcesSize);
+    pDst += ResourcesSize;
+    if (StageInputsSize != 0)
+        memcpy(pDst, StageInputs.data(), StageInputsSize);
+    pDst += StageInputsSize;
+    memcpy(pDst, NamesPool.data(), NamesPool.size());
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator& Allocator,
+                                           const void*       pSerializedData,
+                                           size_t            DataSize,
+                                           const ShaderDesc& shaderDesc,
+                                           std::string&      EntryPoint) noexcept(false) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    const auto* pSrc = static_cast<const Uint8*>(pSerializedData);
+
+    SerializedResourcesHeader Header = {};
+    if (pSrc == nullptr || DataSize < sizeof(Header))
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' are truncated");
+    memcpy(&Header, pSrc, sizeof(Header));
+
+    if (Header.Magic != SerializedResourcesMagic || Header.Version != SerializedResourcesVersion)
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' have unexpected format");
+    if (Header.ShaderType != static_cast<Uint32>(shaderDesc.ShaderType))
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' were reflected for a different shader type");
+
+    const auto& Counters = Header.Counters;
+    // clang-format off
+    const size_t TotalResources = size_t{Counters.NumUBs}       + size_t{Counters.NumSBs}       + size_t{Counters.NumImgs}     +
+                                  size_t{Counters.NumSmpldImgs} + size_t{Counters.NumACs}       + size_t{Counters.NumSepSmplrs} +
+                                  size_t{Counters.NumSepImgs}   + size_t{Counters.NumInptAtts}  + size_t{Counters.NumAccelStructs};
+    // clang-format on
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please account for the new resource count");
+
+    constexpr size_t MaxCount = std::numeric_limits<OffsetType>::max();
+    if (TotalResources > MaxCount || Header.NumShaderStageInputs > MaxCount)
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' are invalid");
+
+    const auto ResourcesSize   = TotalResources * sizeof(SerializedResourceAttribs);
+    const auto StageInputsSize = size_t{Header.NumShaderStageInputs} * sizeof(SerializedStageInputAttribs);
+    if (DataSize != sizeof(Header) + ResourcesSize + StageInputsSize + Header.NamesPoolSize)
+        LOG_ERROR_AND_THROW("Size of serialized resources of shader '", shaderDesc.Name, "' is invalid");
+
+    const auto* pResources   = pSrc + sizeof(Header);
+    const auto* pStageInputs = pResources + ResourcesSize;
+    const auto* pSrcNames    = reinterpret_cast<const char*>(pStageInputs + StageInputsSize);
+
+    // Validate everything before any memory is allocated
+    const auto NamesPoolSize = Header.NamesPoolSize;
+    if (NamesPoolSize == 0 || pSrcNames[NamesPoolSize - 1] != '\0')
+        LOG_ERROR_AND_THROW("Names pool of serialized resources of shader '", shaderDesc.Name, "' is invalid");
+
+    auto CheckNameOffset = [&](Uint32 Offset, bool AllowNull) {
+        if ((Offset == InvalidNameOffset && !AllowNull) || (Offset != InvalidNameOffset && Offset >= NamesPoolSize))
+            LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' contain invalid name offset");
+    };
+    CheckNameOffset(Header.EntryPoint, false);
+    CheckNameOffset(Header.PushConstantBlockName, Header.PushConstantBlockSize == 0);
+    CheckNameOffset(Header.CombinedSamplerSuffix, true);
+
+    for (size_t n = 0; n < TotalResources; ++n)
+    {
+        SerializedResourceAttribs Res;
+        memcpy(&Res, pResources + n * sizeof(Res), sizeof(Res));
+        CheckNameOffset(Res.Name, false);
+        if (Res.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes)
+            LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' contain invalid resource type");
+    }
+    for (Uint32 n = 0; n < Header.NumShaderStageInputs; ++n)
+    {
+        SerializedStageInputAttribs Input;
+        memcpy(&Input, pStageInputs + n * sizeof(Input), sizeof(Input));
+        CheckNameOffset(Input.Semantic, false);
+    }
+
+    m_IsHLSLSource = Header.IsHLSLSource != 0;
+    EntryPoint     = pSrcNames + Header.EntryPoint;
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, Counters, Header.NumShaderStageInputs, NamesPoolSize + strlen(shaderDesc.Name) + 1, ResourceNamesPool);
+
+    // Relocate all names at once: copy the pool and turn offsets into pointers
+    auto* pNames = ResourceNamesPool.Allocate(NamesPoolSize);
+    memcpy(pNames, pSrcNames, NamesPoolSize);
+
+    auto GetName = [pNames](Uint32 Offset) -> const char* {
+        return Offset != InvalidNameOffset ? pNames + Offset : nullptr;
+    };
+
+    for (Uint32 n = 0; n < m_TotalResources; ++n)
+    {
+        SerializedResourceAttribs Res;
+        memcpy(&Res, pResources + n * sizeof(Res), sizeof(Res));
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                GetName(Res.Name),
+                Res.ArraySize,
+                static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type),
+                static_cast<RESOURCE_DIMENSION>(Res.ResourceDim),
+                Res.IsMS != 0,
+                Res.SepSmplrOrImgInd,
+                Res.BindingDecorationOffset,
+                Res.DescriptorSetDecorationOffset,
+                Res.BufferStaticSize,
+                Res.BufferStride //
+            };
+    }
+
+    for (Uint32 n = 0; n < m_NumShaderStageInputs; ++n)
+    {
+        SerializedStageInputAttribs Input;
+        memcpy(&Input, pStageInputs + n * sizeof(Input), sizeof(Input));
+        new (&GetShaderStageInputAttribs(n)) SPIRVShaderStageInputAttribs{GetName(Input.Semantic), Input.LocationDecorationOffset};
+    }
+
+    m_CombinedSamplerSuffix = GetName(Header.CombinedSamplerSuffix);
+    m_PushConstantBlockName = GetName(Header.PushConstantBlockName);
+    m_PushConstantBlockSize = Header.PushConstantBlockSize;
+    m_ShaderName            = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+}
+
 SPIRVShaderResources::~SPIRVShaderResources()
 {
     for (Uint32 n = 0; n < GetNumUBs(); ++n)
@@ -704,8 +999,10 @@ std::string SPIRVShaderResources::DumpResources()
     std::stringstream ss;
     ss << "Shader '" << m_ShaderName << "' resource stats: total resources: " << GetTotalResources() << ":" << std::endl
        << "UBs: " << GetNumUBs() << "; SBs: " << GetNumSBs() << "; Imgs: " << GetNumImgs() << "; Smpl Imgs: " << GetNumSmpldImgs()
-       << "; ACs: " << GetNumACs() << "; Sep Imgs: " << GetNumSepImgs() << "; Sep Smpls: " << GetNumSepSmplrs() << '.' << std::endl
-       << "Resources:";
+       << "; ACs: " << GetNumACs() << "; Sep Imgs: " << GetNumSepImgs() << "; Sep Smpls: " << GetNumSepSmplrs() << '.' << std::endl;
+    if (HasPushConstants())
+        ss << "Push constants: '" << m_PushConstantBlockName << "', " << m_PushConstantBlockSize << " bytes." << std::endl;
+    ss << "Resources:";
 
     Uint32 ResNum       = 0;
     auto   DumpResource = [&ss, &ResNum](const SPIRVShaderResourceAttribs& Res) {
@@ -832,7 +1129,8 @@ bool SPIRVShaderResources::IsCompatibleWith(const SPIRVShaderResources& Resource
         GetNumSepImgs()           != Resources.GetNumSepImgs()    ||
         GetNumSepSmplrs()         != Resources.GetNumSepSmplrs()  ||
         GetNumInptAtts()          != Resources.GetNumInptAtts()   ||
-        GetNumAccelStructs()      != Resources.GetNumAccelStructs())
+        GetNumAccelStructs()       != Resources.GetNumAccelStructs() ||
+        GetPushConstantBlockSize() != Resources.GetPushConstantBlockSize())
         return false;
     // clang-format on
     VERIFY_EXPR(GetTotalResources() == Resources.GetTotalResources());